@@ -0,0 +1,47 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license 
+*
+* Abstract: 8-way modular arithmetic using AVX-512 IFMA for P434
+*********************************************************************************************/
+
+#include "../P434_internal.h"
+#include "../../internal.h"
+
+
+// Constants in radix 2^52
+// 2 * p434
+static const uint64_t px2_52[NLIMBS52_FIELD]           = { 0xFFFFFFFFFFFFE, 0xFFFFFFFFFFFFF, 0xFFFFFFFFFFFFF, 0xFFFFFFFFFFFFF,
+                                                           0x7FB82ECF5C5FF, 0x8CB8F062B15D4, 0xFAD038A40ACF7, 0x4E2EE688D9F8B,
+                                                           0x000000004683E };
+// p434 + 1
+static const uint64_t pp1_52[NLIMBS52_FIELD]           = { 0x0000000000000, 0x0000000000000, 0x0000000000000, 0x0000000000000,
+                                                           0x3FDC1767AE300, 0xC65C783158AEA, 0xFD681C520567B, 0x271773446CFC5,
+                                                           0x000000002341F };
+// (2^468)^2/2^448 mod p434, maps a*2^448 to a*2^468 in the Montgomery domain
+static const uint64_t Montgomery_to52[NLIMBS52_FIELD]  = { 0x42C6B854089A1, 0x0000000000007, 0x0000000000000, 0x0000000000000,
+                                                           0x48944F93C3D00, 0xAFF347A606F4C, 0xC432687B6D670, 0x24AECC7938CE9,
+                                                           0x000000001450D };
+// 2^448 mod p434, maps a*2^468 back to a*2^448 in the Montgomery domain
+static const uint64_t Montgomery_from52[NLIMBS52_FIELD] = { 0x000000000742C, 0x0000000000000, 0x0000000000000, 0x0000000000000,
+                                                           0x4B90FF404FC00, 0x01A4FB559FACD, 0x4545F77410CD8, 0xA7BD2EDAE9325,
+                                                           0x000000000ECEE };
+
+#define fpcopy                        fpcopy434
+#define fp_pack_x8                    fp_pack434_x8
+#define fp_unpack_x8                  fp_unpack434_x8
+#define fp2_pack_x8                   fp2_pack434_x8
+#define fp2_unpack_x8                 fp2_unpack434_x8
+#define fpadd_x8                      fpadd434_x8
+#define fpsub_x8                      fpsub434_x8
+#define fpmul_mont_x8                 fpmul434_mont_x8
+#define fpsqr_mont_x8                 fpsqr434_mont_x8
+#define fp2add_x8                     fp2add434_x8
+#define fp2sub_x8                     fp2sub434_x8
+#define fp2mul_mont_x8                fp2mul434_mont_x8
+#define fp2sqr_mont_x8                fp2sqr434_mont_x8
+
+#include "../../fpx_ifma.c"
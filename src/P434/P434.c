@@ -74,6 +74,9 @@ const uint64_t Montgomery_one[NWORDS64_FIELD]    = { 0x000000000000742C, 0x00000
 
 
 // Fixed parameters for isogeny tree computation
+#if defined(_TUNED_STRATEGIES_)
+    #include "P434_strategies.h"
+#else
 const unsigned int strat_Alice[MAX_Alice-1] = { 
 48, 28, 16, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 13, 7, 4, 2, 1, 1, 2, 1, 1, 3, 2, 1, 1, 
 1, 1, 5, 4, 2, 1, 1, 2, 1, 1, 2, 1, 1, 1, 21, 12, 7, 4, 2, 1, 1, 2, 1, 1, 3, 2, 1, 1, 1, 1, 5, 3, 2, 1, 1, 1, 1, 2, 1, 1, 1, 9, 5, 3, 2, 1, 1, 
@@ -83,6 +86,46 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 66, 33, 17, 9, 5, 3, 2, 1, 1, 1, 1, 2, 1, 1, 1, 4, 2, 1, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 16, 8, 4, 2, 1, 1, 1, 
 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 32, 16, 8, 4, 3, 1, 1, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 
 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 16, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1 };
+
+#if defined(_THREADS_)
+// Strategies for the parallel isogeny evaluation with 2, 4 and 8 threads, generated with tools/strategies.c
+// nthreads = 2, p = 2860, q = 2954, modeled cost = 1850046, 8 intermediate points
+const unsigned int strat_Alice_2[MAX_Alice-1] = { 
+43, 28, 16, 9, 5, 3, 2, 1, 1, 1, 1, 2, 1, 1, 1, 4, 2, 1, 1, 1, 2, 1, 1, 7, 4, 2, 1, 1, 1, 2, 1, 1, 3, 2, 1, 1, 1, 1, 12, 7, 4, 2, 1, 1, 1, 2, 
+1, 1, 3, 2, 1, 1, 1, 1, 5, 3, 2, 1, 1, 1, 1, 2, 1, 1, 1, 16, 11, 7, 4, 2, 1, 1, 1, 2, 1, 1, 3, 2, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 2, 1, 1, 
+7, 4, 2, 1, 1, 1, 2, 1, 1, 3, 2, 1, 1, 1, 1 };
+
+// nthreads = 2, p = 4002, q = 2066, modeled cost = 2451102, 13 intermediate points
+const unsigned int strat_Bob_2[MAX_Bob-1] = { 
+41, 28, 19, 14, 10, 7, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 6, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 9, 6, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 3, 2, 1, 1, 
+1, 1, 1, 1, 13, 9, 6, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+// nthreads = 4, p = 2860, q = 2954, modeled cost = 1441404, 13 intermediate points
+const unsigned int strat_Alice_4[MAX_Alice-1] = { 
+29, 20, 17, 13, 9, 6, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 4, 4, 
+3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 6, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 9, 6, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 2, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1 };
+
+// nthreads = 4, p = 4002, q = 2066, modeled cost = 1969038, 20 intermediate points
+const unsigned int strat_Bob_4[MAX_Bob-1] = { 
+28, 22, 17, 13, 10, 8, 7, 6, 5, 4, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 4, 3, 2, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+// nthreads = 8, p = 2860, q = 2954, modeled cost = 1198065, 19 intermediate points
+const unsigned int strat_Alice_8[MAX_Alice-1] = { 
+22, 17, 13, 10, 8, 7, 6, 5, 4, 3, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 4, 3, 2, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+// nthreads = 8, p = 4002, q = 2066, modeled cost = 1645211, 29 intermediate points
+const unsigned int strat_Bob_8[MAX_Bob-1] = { 
+15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+#endif
+#endif
            
 // Setting up macro defines and including GF(p), GF(p^2), curve, isogeny and kex functions
 #define fpcopy                        fpcopy434
@@ -93,11 +136,13 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fpdiv2                        fpdiv2_434
 #define fpcorrection                  fpcorrection434
 #define fpmul                         fpmul434
+#define fpsqr                         fpsqr434
 #define fpmul_mont                    fpmul434_mont
 #define fpsqr_mont                    fpsqr434_mont
 #define fpinv_mont                    fpinv434_mont
 #define fpinv_chain_mont              fpinv434_chain_mont
 #define fpinv_mont_bingcd             fpinv434_mont_bingcd
+#define is_sqr_fp                     is_sqr_fp434
 #define fp2copy                       fp2copy434
 #define fp2zero                       fp2zero434
 #define fp2add                        fp2add434
@@ -110,12 +155,16 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fp2correction                 fp2correction434
 #define fp2mul_mont                   fp2mul434_mont
 #define fp2sqr_mont                   fp2sqr434_mont
+#define ladder3pt_step_asm            ladder3pt_step434_asm
+#define xDBLe_asm                     xDBLe434_asm
+#define xTPLe_asm                     xTPLe434_asm
 #define fp2mul_c0_mont                fp2mul434_c0_mont
 #define fp2mul_c1_mont                fp2mul434_c1_mont
 #define fp2sqr_c0_mont                fp2sqr434_c0_mont
 #define fp2sqr_c1_mont                fp2sqr434_c1_mont
 #define fp2inv_mont                   fp2inv434_mont
 #define fp2inv_mont_bingcd            fp2inv434_mont_bingcd
+#define is_sqr_fp2                    is_sqr_fp2_434
 #define fpequal_non_constant_time     fpequal434_non_constant_time
 #define mp_add_asm                    mp_add434_asm
 #define mp_subaddx2_asm               mp_subadd434x2_asm
@@ -123,6 +172,15 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp434
 #define crypto_kem_enc                crypto_kem_enc_SIKEp434
 #define crypto_kem_dec                crypto_kem_dec_SIKEp434
+#define crypto_kem_enc_batch          crypto_kem_enc_batch_SIKEp434
+#define crypto_kem_dec_batch          crypto_kem_dec_batch_SIKEp434
+#define crypto_kem_expand_pk          crypto_kem_expand_pk_SIKEp434
+#define crypto_kem_enc_expanded       crypto_kem_enc_expanded_SIKEp434
+#define crypto_kem_expand_sk          crypto_kem_expand_sk_SIKEp434
+#define crypto_kem_dec_expanded       crypto_kem_dec_expanded_SIKEp434
+#define crypto_kem_pool_start         crypto_kem_pool_start_SIKEp434
+#define crypto_kem_pool_stop          crypto_kem_pool_stop_SIKEp434
+#define crypto_kem_keypair_pooled     crypto_kem_keypair_pooled_SIKEp434
 #define random_mod_order_A            random_mod_order_A_SIDHp434
 #define random_mod_order_B            random_mod_order_B_SIDHp434
 #define EphemeralKeyGeneration_A      EphemeralKeyGeneration_A_SIDHp434
@@ -130,7 +188,22 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define EphemeralSecretAgreement_A    EphemeralSecretAgreement_A_SIDHp434
 #define EphemeralSecretAgreement_B    EphemeralSecretAgreement_B_SIDHp434
 
+#if defined(_IFMA_)
+#define fp2_pack_x8                   fp2_pack434_x8
+#define fp2_unpack_x8                 fp2_unpack434_x8
+#define fp2add_x8                     fp2add434_x8
+#define fp2sub_x8                     fp2sub434_x8
+#define fp2mul_mont_x8                fp2mul434_mont_x8
+#define fp2sqr_mont_x8                fp2sqr434_mont_x8
+#endif
+
 #include "../fpx.c"
 #include "../ec_isogeny.c"
+#if defined(_FIXED_BASE_)
+#include "P434_ladder_tables.c"
+#endif
 #include "../sidh.c"    
+#if defined(_IFMA_)
+#include "../sidh_x8.c"
+#endif
 #include "../sike.c"
\ No newline at end of file
@@ -170,6 +170,7 @@ const unsigned int strat_Alice[MAX_Alice-1] = {
 const unsigned int strat_Bob[MAX_Bob-1] = { 
     66, 33, 17, 9, 5, 3, 2, 1, 1, 1, 1, 2, 1, 1, 1, 4, 2, 1, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 16, 8, 4, 2, 1, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 32, 16, 8, 4, 3, 1, 1, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 16, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1 };
 
+#if !defined(_DLOG_TABLES_)
 // Fixed traversal strategies for Pohlig-Hellman discrete logs
 const unsigned int ph2_path[PLEN_2] = {
 #ifdef COMPRESSED_TABLES
@@ -190,6 +191,7 @@ const unsigned int ph3_path[PLEN_3] = {
     #endif   
 #endif
 };
+#endif
 
 // Entangled bases related static tables and parameters
 
@@ -198,7 +200,7 @@ const unsigned int ph3_path[PLEN_3] = {
 //      Two tables of 17 elements each for the values r in F_p such that v = 1/(1+ur^2) where r is already converted to Montgomery representation
 //      Also, 2 tables for the quadratic residues (qr) and quadratric non residues (qnr) v in F_{p^2} with 17 GF(p^2) elements each. 
 // For the 3^eB-torsion basis generation:
-//      A table of size 20 for values v = 1/(1+U*r^2)
+//      A table of size 20 for values v = 1/(1+U*r^2), or of size TABLE_V3_LEN generated by "make elligator_tables"
 
 const uint64_t u_entang[2*NWORDS64_FIELD] = {
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0xE858,0x0,0x0,0x721FE809F8000000,0xB00349F6AB3F59A9,0xD264A8A8BEEE8219,0x1D9DD4F7A5DB5};
@@ -318,6 +320,7 @@ const uint64_t table_v_qnr[TABLE_V_LEN][NWORDS64_FIELD] =
 {0x998BF5138DDDD5D2,0xD1F015AF4EA7BF66,0xE3DAF7886068D9AD,0x99E9067025D583AF,0xCC498E253E868EF6,0x618AE02455C9B20A,0x2322145632832},
 {0x333A0330E480A5E0,0xD37D31D37894FFB3,0x4E09921C2CCDB4FD,0xAC7069BEE6F95173,0xA05EDFF1E57DBBEF,0x5C3678A72B135234,0x1BB5DA10EE9DF}};
 
+#if !defined(_ELLIGATOR_TABLES_)
 const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] = 
 {{0x999999999999BC73,0x9999999999999999,0x9999999999999999,0x9C9276B1A0999999,0x24AAB5C6B74B8308,0xBA8CEC66D0E6DA1E,0x1998D7CFA066A,0xCCCCCCCCCCCCC12E,0xCCCCCCCCCCCCCCCC,0xCCCCCCCCCCCCCCCC,0x1EE5F99502CCCCCC,0x1A381FE09EEA2DA1,0xD978110991782CF7,0x1AB9AA8197120},
 {0x41FAB8BE05474CC2,0x54741FAB8BE0547,0xB8BE054741FAB8BE,0xC9AE7F39FF4741FA,0xB1F4EE9D1CDDE556,0x1650D500E95EBA31,0x5023E95DDE16,0x54741FAB8BE04FA9,0x8BE054741FAB8BE0,0x1FAB8BE054741FAB,0x16655C7EB0E05474,0xD849DDDEC437B020,0x2E677A183619E2D7,0x19324B6AFA19D},
@@ -339,6 +342,10 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 {0x9237E2347B57BBD8,0xE16C142FE156484A,0x87E8A48B3B14220,0x34B6225A95A547ED,0xD26CBF294A3E2E72,0x33C06874E35A7F57,0x17DFC7A25D7B7,0x91ECC77A8220B97E,0xBD3818A24751F785,0x2E3FD75D7AE703AB,0xD7E8692B70CA482C,0x53C8B5DDEBA21D6D,0x5FC1E218D7085E99,0x129CD0E49FE6F},
 {0x3945471CC48EF6BB,0x7C3FB717D0165DC8,0x92F83793BFEBC75A,0xD5BF95D93BFE5316,0x209E198DB1F16A4,0xE2086C62914F403A,0x19D6352AA2CC,0xBFFF0BF092E15611,0xFA429EEA322007B3,0x99EFB4184EBBD84C,0xF6C5230835D383A8,0xF1CD8283C93674AF,0x41C64F9EA1AC8458,0x2CD68D0A2571},
 {0x570C567E928211B1,0x70459EE4560443C6,0x1FC204B885DBB2C0,0x7C99D3BCAF19BE0E,0x5BFFD67B5AA530E7,0xF8701F7AE35B9C57,0xF056DF1DFCBE,0x4183962A42D28AD1,0xFF8B6A5752A5FAEB,0xA4B714F92FE41B11,0x8CC5D5EEFFAFB58B,0xA53A15C837E4CFC9,0x1A79CF6122569F16,0x1FE4DB81AE342}};
+#else
+    #define ELLIGATOR_TABLES_DATA
+    #include "P434_elligator_tables.h"    // Larger table and the extension of the tables of the 2^eA-torsion
+#endif
 
 // Setting up macro defines and including GF(p), GF(p^2), curve, isogeny and kex functions
 #define fpcopy                        fpcopy434
@@ -349,11 +356,13 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 #define fpdiv2                        fpdiv2_434
 #define fpcorrection                  fpcorrection434
 #define fpmul                         fpmul434
+#define fpsqr                         fpsqr434
 #define fpmul_mont                    fpmul434_mont
 #define fpsqr_mont                    fpsqr434_mont
 #define fpinv_mont                    fpinv434_mont
 #define fpinv_chain_mont              fpinv434_chain_mont
 #define fpinv_mont_bingcd             fpinv434_mont_bingcd
+#define is_sqr_fp                     is_sqr_fp434
 #define fp2copy                       fp2copy434
 #define fp2zero                       fp2zero434
 #define fp2add                        fp2add434
@@ -366,18 +375,23 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 #define fp2correction                 fp2correction434
 #define fp2mul_mont                   fp2mul434_mont
 #define fp2sqr_mont                   fp2sqr434_mont
+#define ladder3pt_step_asm            ladder3pt_step434_asm
+#define xDBLe_asm                     xDBLe434_asm
+#define xTPLe_asm                     xTPLe434_asm
 #define fp2mul_c0_mont                fp2mul434_c0_mont
 #define fp2mul_c1_mont                fp2mul434_c1_mont
 #define fp2sqr_c0_mont                fp2sqr434_c0_mont
 #define fp2sqr_c1_mont                fp2sqr434_c1_mont
 #define fp2inv_mont                   fp2inv434_mont
 #define fp2inv_mont_bingcd            fp2inv434_mont_bingcd
+#define is_sqr_fp2                    is_sqr_fp2_434
 #define fpequal_non_constant_time     fpequal434_non_constant_time
 #define mp_add_asm                    mp_add434_asm
 #define mp_subaddx2_asm               mp_subadd434x2_asm
 #define mp_dblsubx2_asm               mp_dblsub434x2_asm
 #define random_mod_order_A            random_mod_order_A_SIDHp434
 #define random_mod_order_B            random_mod_order_B_SIDHp434
+#define tables_load                   tables_load_SIDHp434_compressed
 #define EphemeralKeyGeneration_A      EphemeralKeyGeneration_A_SIDHp434_Compressed
 #define EphemeralKeyGeneration_B      EphemeralKeyGeneration_B_SIDHp434_Compressed
 #define EphemeralSecretAgreement_A    EphemeralSecretAgreement_A_SIDHp434_Compressed
@@ -385,14 +399,30 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp434_compressed
 #define crypto_kem_enc                crypto_kem_enc_SIKEp434_compressed
 #define crypto_kem_dec                crypto_kem_dec_SIKEp434_compressed
+#define crypto_kem_enc_batch          crypto_kem_enc_batch_SIKEp434_compressed
+#define crypto_kem_dec_batch          crypto_kem_dec_batch_SIKEp434_compressed
+#define crypto_kem_pool_start         crypto_kem_pool_start_SIKEp434_compressed
+#define crypto_kem_pool_stop          crypto_kem_pool_stop_SIKEp434_compressed
+#define crypto_kem_keypair_pooled     crypto_kem_keypair_pooled_SIKEp434_compressed
 
 
 #include "../fpx.c"
 #include "../ec_isogeny.c"
 #include "../compression/torsion_basis.c"
-#include "P434_compressed_pair_tables.c"
+#define TABLES_BLOB_NAME              "SIDHp434_compressed"
+#define TABLES_BLOB_FILE              "src/P434/P434_compressed_tables.bin"     // Written by "make tables_blob"
+#if defined(_TABLE_BLOB_)
+    #include "../compression/tables_blob.c"
+#else
+    #include "P434_compressed_pair_tables.c"
+#endif
 #include "../compression/pairing.c"
-#include "P434_compressed_dlog_tables.c"
+#if defined(_DLOG_TABLES_)
+    #define DLOG_TABLES_DATA
+    #include "P434_dlog_tables.h"
+#elif !defined(_TABLE_BLOB_)
+    #include "P434_compressed_dlog_tables.c"
+#endif
 #include "../compression/dlog.c"
 #include "../compression/sidh_compressed.c"
 #include "../compression/sike_compressed.c"
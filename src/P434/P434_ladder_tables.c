@@ -0,0 +1,1535 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: precomputed tables for the fixed-base three-point ladder on E0: y^2 = x^3 + 6x^2 + x
+*           Generated for SIDHp434 by "make ladder_tables"
+*********************************************************************************************/
+
+
+// x-coordinates of [2^i]QA for i = 0, ..., OALICE_BITS-1 in Montgomery representation, where QA is the generator in A_gen.
+// Each entry is an element of GF(p^2) stored as 2*NWORDS64_FIELD words.
+const uint64_t A_gen_ladder[OALICE_BITS*2*NWORDS64_FIELD] = {
+0xFEC6E64588B7273B, 0xD2A626D74CBBF1C6, 0xF8F58F07A78098C7, 0xE23941F470841B03,
+0x1B63EDA2045538DD, 0x735CFEB0FFD49215, 0x0001C4CB77542876, 0xADB0F733C17FFDD6,
+0x6AFFBD037DA0A050, 0x680EC43DB144E02F, 0x1E2E5D5FF524E374, 0xE2DDA115260E2995,
+0xA6E4B552E2EDE508, 0x00018ECCDDF4B53E, 0x3CED10547FEAACF0, 0xB2B7AD9D2F3DA15B,
+0x88D90598EA93A292, 0x35343805C002C0AD, 0xE72AD3111F311795, 0x2CECF873AA580387,
+0x000141B894B75444, 0xEB9D57F0D4685ACC, 0xAAA7DA9E345FD3C8, 0x46B4E11E7C972BF2,
+0x31E88E3EB6E8467B, 0x237CD14A9E237AC3, 0x4A89BEF03DB7671D, 0x00008577A8BBB808,
+0x26BDDA667BAD5D92, 0x568A3F8F679D077A, 0x931D6E5D628F7831, 0xAD2C9E044E992DD1,
+0xB353B47945E103CF, 0x9088959A3A4D5D2C, 0x00016618BAA72651, 0x2CE01ABF71617ACE,
+0xECEEF6BC901B3BBD, 0x92268A1C7F995D2F, 0x33B85ACF10397ED6, 0x474C5ED7D26E8740,
+0x95C91DE848307591, 0x000122979284EA4A, 0xF8E1A096834ED631, 0xBFCC032637564776,
+0xAD04FD79582CE618, 0xB8E8DE02941B01CC, 0xED8080CD514C5E00, 0x3751462346ABD21C,
+0x000095E51DF7F393, 0xA8B861E006F2918C, 0x8E6D9663FC3A93DF, 0xEB9AE15A33972964,
+0x314A2F3CA34AFBA1, 0xFC8EF81859C05755, 0x995BFAB398D967AF, 0x00014CE3ADD5562E,
+0xA7A85B74328FC013, 0x61FD0C85623FC461, 0x92928DD0E2197A49, 0xE18A5D5BDE39B9BF,
+0x5BF9986C1BAB6D1B, 0x2387790026C769AF, 0x000209873AF17A0B, 0x2B74687FC0AF456A,
+0xF71C4CCCB04D5967, 0xD96827525673F45B, 0x259EA7FF41EC2632, 0x215036C0763F59B6,
+0x5A7AF05342A1E4CD, 0x00021D807AC80790, 0xE8E953D467DBB7AF, 0x3FD6042D11339595,
+0x8ACE7014173B7CEE, 0x9F74EE559FCED6FC, 0xF04A7991CF8BAB51, 0x838FF87D0520D383,
+0x000195EE106A1A61, 0x954018C577FCB2A8, 0xFD107E9091B0D4D2, 0xEA4153ED82309737,
+0xF346EE5F3B3E4264, 0x3FC2ED841CAE5BD4, 0x6870250D7695B20B, 0x0000BDF50A8AB9C3,
+0xA50B56141BDF7471, 0x28D93C821F05776F, 0xE0A6626DCEF7FB88, 0xAA559F16514A090C,
+0x4CF6A7B4D2D4C9AF, 0xB400711F3418BF5D, 0x00010663679B5711, 0x62DC21132C8A182F,
+0x9429AEE1E5A8C84C, 0xB7681668E4DBB3F0, 0x97ED5B6571E9D660, 0xCEF0D083E6C3FA1D,
+0x7474CE7C62465714, 0x0002269CC75849FA, 0x2165854013F1AB70, 0xBF34DC87A3748777,
+0x304B64597D3C743F, 0x82233674C86C8111, 0xFE83E8F5217FF720, 0x2B877F3DB448F8FC,
+0x0000FF66B44B9530, 0x243B96F023F3964E, 0x265AAE466693F370, 0xE058BC6074131C4D,
+0x3CE699FE548365D7, 0x031806FAB9F83B5E, 0x02246B3A604EDE34, 0x0001C508916D1F9F,
+0xD5F1F203B54B87A8, 0x9D8B6D944CCDA68E, 0x2FA1412646B42AB9, 0x3D6F6BAF9DC3F3DE,
+0x26566FEFEFA7FD70, 0x88338616255D54DC, 0x0001042AB5E778A7, 0x3A7355D765E25AB2,
+0xBB5FB600E0D6B579, 0x13B439DF5B85C836, 0xD1582AE20D5CCA63, 0x001212411064AEEB,
+0x16A3139CF0E2052D, 0x00017F27A5B3736E, 0x1D1AF163432B2B6E, 0xAA5EE84C47DE7E0A,
+0x00E5CB20D33EC881, 0x1E55773F7EFCA006, 0xB8B13F7F1FB2F97A, 0x78A81EA2E6AF24D4,
+0x00007CF4BEC98C0F, 0xF56AE8D97A9811F4, 0x546FE73A0B1FEF2D, 0xED5FF07D2CCC70A0,
+0x81A1EFC2E0C526E6, 0x448A6D6ABF9B749B, 0xF3028F18A57329E4, 0x00017F091A533A56,
+0xC119A4D790663755, 0xA6AEF477C571C99C, 0xBF882DFB1FB4D7EE, 0x81A6B24E21A81FBA,
+0x963321820FE8BBDF, 0x2F855F8495879D8B, 0x0002277E6308713E, 0x088B881EFC1A485A,
+0x122CA204C2BEB712, 0xBAF5B63DF4D70D32, 0x3D3089D8FB790DF5, 0x8C1A42E1619B3AE4,
+0xFFC1DEF99922B84B, 0x00008DBE3A871E1B, 0x51C0DBF131647F85, 0x189640EEFB21D045,
+0xCA9EA05F3C1D977C, 0x00F834B1F5E3AAAA, 0x34226D9B74C9D546, 0x5287CE09F4E5D1B9,
+0x0001A33A6FB9C600, 0x03D1E41DF59BA0EE, 0x7E20F7ADBC717C05, 0x4AEEF8B3CA642385,
+0xC69936E6B1A8A83F, 0x2A8F2DC9C923814E, 0x62D013598AE91A76, 0x00005AC8C39E70E2,
+0x73649B03B1A5615A, 0xA90A99181F0A09AE, 0x166DA101EF5055B0, 0x4A033C63B65E2833,
+0x371C70DDB360B74F, 0xE7C5DCED60C24529, 0x00000206298BE6A5, 0x9CAB593B08A75202,
+0xB166D83059C0C20B, 0x1FE6E1B367807DFE, 0xADC2B9BBAEA15E1D, 0xF39A99777ABC3AB4,
+0xBD946E7DE4E241FC, 0x00008AB6F8CD2147, 0x5D88E17B8521F509, 0x13F83B0BD98DF9B4,
+0x6BD1A092F1F7723D, 0x98FBC1A885DC0126, 0x9FBF51B97CB00981, 0x369BC8E119B8F09F,
+0x0002164D1B5786F6, 0xD2B5BE5975B57C85, 0x0B2CDF047CFCB1E9, 0xA421B6A02AE1AADD,
+0xAFD629B527135F9D, 0x9EB4D056E3765750, 0x61EC610E6365ABFD, 0x000053A18F9C84C6,
+0xA6615EE93365EBFA, 0xB42028D3C2CDE22F, 0x674205ACDEE347EA, 0xBA58FFC80496005A,
+0x1700AAEA5E54F597, 0xD24436267AF24AF4, 0x0001C73CD4EBE6B4, 0x420ABCFF70EB0709,
+0x2D194D50357CEC0C, 0x1CDCEF6F78038FFA, 0xD3649A3130234D79, 0x71F66756592CC35F,
+0xA74F4E4973092E5E, 0x00009FD2B26922CC, 0x1395EAFBDE863B24, 0x49524D62872FD996,
+0x7BD0B1E95016383B, 0x4385AF49F1F7FBE0, 0x477E9E49C00A99DA, 0x342CA84071DFA4B1,
+0x0000EC79C9DA0CBF, 0x8F34D4B26635CE46, 0x9A1FAA3230427603, 0xDCBCFA3F6D474318,
+0x1D5B323D2A33DBAD, 0x3A9570174E5F69C9, 0xF5C272901C441AA9, 0x000103A9618C3A83,
+0x423A91BD5E514552, 0x6A1942B371E98680, 0x7B7637EE8CB53018, 0x0CCB05DA5D183946,
+0x5EF30A0654155810, 0xE483BA25EB29FDD7, 0x0000B4FF2095E5F8, 0x27DEF30E8A8FA97F,
+0x0926911C1695C2B1, 0x5F5E25576F297B58, 0xFB686E394E3D7069, 0xF1BB621449954217,
+0x248ECF350EA88071, 0x0000696A2E634BDB, 0xC3602DEBCE7D7BCD, 0x3A3A7ABA5A0134CC,
+0x4731BABD87D5033E, 0x1AA5B348D333613A, 0x597BE244F1AB92CF, 0x64F5010581D3E7CA,
+0x0001DE81B81AB00E, 0x6AA9C2225B54D4FC, 0x0457E659BA3CC759, 0x24C80E142C29A3A5,
+0x5F12AD929053F13D, 0xE7B40028EE89BD6C, 0x672112F4522E1A0B, 0x0001B2B9CCD240B3,
+0x571A141F8A2BACF7, 0x67304A16862C8B9A, 0xDD409E9A879EDD4F, 0x79357D86C34E1D10,
+0xDC717D77F2C4C833, 0xD41808F5ADA348DE, 0x000130A51A68FFFB, 0x349C5BEC6B0D8250,
+0xC1E07D78FCA93BE8, 0xCC1CC4934B5EB14E, 0x5B6CA8553976C356, 0xBCCAF662A69E65B4,
+0x4E9DAF0A0B2CC11D, 0x0000123514B1DD26, 0x23081150CEBBF856, 0x1097B04A1B5E61A8,
+0x490CCCE91015344C, 0x42D06B36A54281CB, 0xED8FAEA0D79CFB0B, 0xD7CA4860E0212048,
+0x00014340370763D7, 0xA0FF3CA1BE13824A, 0x0895BB09402D8767, 0x170B8EC4944635F5,
+0x37D5CCB54A838DDF, 0xB496DBACAFF95F76, 0xEB53F5C8E99DF7C5, 0x0001238EE6E15F43,
+0xF3637C19805C184B, 0xB5850BCA471CCAD0, 0xB6FAA509B847536B, 0x6BACA09295A82369,
+0xBBA926F2B2E80286, 0x70B2C2F229CF817C, 0x0001F41B23FBFC33, 0xDB54E1BCF21CAB5A,
+0x98EB6C413B06CCE6, 0xBB98AF17A2503320, 0xF48CCF85A54DC41A, 0xC9952E8D5E722955,
+0x4E0C61AB83FEB4D2, 0x0000CE21F9535362, 0x6ED9C99BCF8B0436, 0x4C318FCCE9C07711,
+0xEB12F66598F91FE0, 0xC767A25B334045A0, 0x7E5794DDDFE0CE51, 0x983A67D4A7DD4D47,
+0x000108BA317C723B, 0xE8053B332F4AA422, 0xA56FF903D8045B81, 0x36477EF7F2AACCF5,
+0xC52CEDC1DCE306D4, 0xCB871754F00F8308, 0xA0FEF6F275C945FA, 0x00010F1FD6D069F6,
+0xFC9AE8762553016E, 0xBF681A5E215EE56B, 0xC3E449F422166EF9, 0xCE6C1C62DAABFC7D,
+0x720E1C47821763DA, 0xF1710BAEAD01B921, 0x0000CE5AB277861D, 0x16AF43D4DA6340AD,
+0x4D3961D38F12551A, 0x2E6422069074BDDD, 0xE1AA596DA2B33E13, 0xA144749FBE1785D5,
+0x6331A60CEC1CDD88, 0x00022C157DF003EB, 0xFA7D5B210E81DDBC, 0x35F0BAE8E54012F0,
+0x75999532B1D57015, 0xB3CF939747B9ECFB, 0xD7AC9A22204401E7, 0xE1EABCC8F54BFB56,
+0x00018379D74363C2, 0xF5DB3FFDE678F388, 0x8EA5FF418B7E5E20, 0x1016029284DAE935,
+0xED74A196509DF76F, 0x3119D4623402CC65, 0x3BE146BFC111DB72, 0x000207A98F5F8163,
+0xF080F67A628369F7, 0xAFF22DA35494AB8A, 0x73AB702DFFCD2F26, 0xA0F9C0AC37DEBC5D,
+0xA3093F5A5AEF56F1, 0x68DD31DDD3AB52AA, 0x0000DD324194784B, 0xE3611EB48C5AECAF,
+0x8DD02ABF37FDEAE8, 0x4BE2758C045FF6AB, 0x6A35743938F3DB4A, 0x7A6CA041ED53AAA0,
+0x1E929EA03806A788, 0x00020A528FEA95B7, 0x5CB183962AE366F2, 0x68B695F68D43ADA8,
+0xA66740E03628371E, 0xCC26FABE2A8B33D5, 0x7753D7B36C005A43, 0x42828506CB913B9B,
+0x0001FFDD4B9815C3, 0x7FF2DC30A3755B33, 0x7D3C2B1F4F71C83C, 0xA2D4B226783E52A7,
+0x1EBC0C22DD1CBB8C, 0xF7EFC7C840466A03, 0xB69E90FBC24AA7D8, 0x0000FBD6DBD2F466,
+0x0CD5B361DF7290A7, 0xC97F7A0DB8E3EC00, 0x609BB149B541E00C, 0x9636F9CABB53C19C,
+0xC52D8840086F04C8, 0xC1CC1869D045D74B, 0x00008FAFC44397B1, 0x8BCD4DBEC447A5F2,
+0x79CEB56CF3DC177E, 0xBB0A8BD209FFFF36, 0x2824D1E157E86B8B, 0xD4921C648D36D431,
+0x6F582DA687BBC35D, 0x0000B621FAD80EFC, 0x284DBB4BB91BBCF8, 0xD4127566FD8DA734,
+0xD8355FF0C1ACF202, 0xF693CC684F02D57C, 0xC191FDA20D434367, 0x7E1079F9552F7237,
+0x0001914E0DA55DB1, 0x3549700D562445D3, 0x916FB89C8DA3FC94, 0x2C909BD7506F7CEF,
+0xE307FC0CA14F3F89, 0x44649402963E44AB, 0x5DC41B97E0F476F2, 0x000154DFD12BAF55,
+0x0007DE7F076B52A2, 0xEDF98CC601FBA8D3, 0xE0EFC04EE9B15604, 0x164F4408FD747D21,
+0x8FFDB59E5A6E9DFD, 0x317A50E1EDCCDAD4, 0x000024741848E6FA, 0x7C183DF3F8B27603,
+0xF87FFDD6E23555B7, 0x4A90442B76EDCE29, 0xA47AD7AF2CF55EB1, 0x6C8E6A367DACCE70,
+0xEC2402AFFD8F0864, 0x0000B124E733A4B6, 0xA92A83783520E30B, 0x717A84F7E95A3382,
+0x6CD468EBB240B434, 0x2A50A114380300D9, 0x458561619E13DC26, 0x5CA8172689A26B4E,
+0x000183BEFCB1F1B3, 0xA48CD2B3127B17D7, 0xFE2DB35C0FB9A22B, 0x9818F67329B3CC68,
+0xF72D0AF847819A7E, 0x1F9DF807855B2D0F, 0xB9A140CE5BED8817, 0x0000E3BFCFD51ACE,
+0xCAD9C1DF1F43ABCB, 0x8FB4AE1C4E495EC5, 0x0DD8F29A6BB630F5, 0x76A9E70D54E63F22,
+0x4E561763C7791F3B, 0xD335D5A904D69CF6, 0x000009D6EAB61D52, 0x2DBCB70B1625E38A,
+0x4930915582281051, 0x546426DFE913FE39, 0xD2514B64386FEA0C, 0x9499FFD7D6C0F019,
+0xD35ED74447B71370, 0x0001282C82C8D50D, 0xA01FC181C5B5A197, 0x28B3773A67E625EB,
+0xC231955290E1DD32, 0xA65AC0FC2C7EB832, 0x4543503454249014, 0x9686C01DB5C53860,
+0x000213FAC96AD643, 0x96647C7A9DE11141, 0xFE93202B9BCE7BB5, 0x05AE073A534D191B,
+0xB64A6BBDC6903D39, 0xDB81B6E187A6CD08, 0x7E565ACB1B480F7B, 0x00008B9E5AFAD21E,
+0xEAD98166066FE0C3, 0xAF4241D077519EC8, 0xF9059B5BA65C1668, 0xC08077A39B91071F,
+0x6CAF28C547F146E9, 0x02628F6A0D18A245, 0x00006D7298B379D7, 0x336C77215BD65FE7,
+0xB0A6DEA96DE28BBB, 0x00511EC947E40893, 0x887C322026C5A161, 0x74B4AD6FB2E65936,
+0xB79139158B6D8079, 0x00022E5B5554E824, 0x7B1D035D575E66C1, 0xE1E43060D00F2729,
+0xC5C6472EDA7DF081, 0x4B5BFA12690B04BF, 0x922509EDE427828E, 0x1A8630857937ACF4,
+0x0001153ABF7B188C, 0xA1D46C91CA655A94, 0xE68682189B08E2AE, 0x2EBADD78C7A58BA6,
+0xA87B3706DDBC5DF4, 0x232ECC32D1A4378C, 0xBED3E55A34B922C9, 0x00022D3B9144E963,
+0xD0C4ACB24E34CD59, 0x159322EC424ED4BD, 0xC2772BA0FC2A2666, 0xDF376A01ADE1219D,
+0xB2D9E757DA7F1466, 0x5811F80641D8C704, 0x00012281692002AD, 0xC57BB840ABFF6D12,
+0x492068B127104951, 0xBE5BA6D6B74FCB41, 0x3753B54EA80B7650, 0xC055AF46541FB411,
+0xD6E568B7479255D8, 0x00003BA5AAA3C1FF, 0x6DA12F65BE468C1D, 0x335E42345190938F,
+0xF09D41E0588B6444, 0x835EC9821796F9C7, 0x5E4B19ECB731BD35, 0x0F758A296A13C229,
+0x00006A5161C83EBF, 0xCA2A2A6914D5695A, 0x658978E000D803CF, 0xDDB58B5BECC8574F,
+0x313CF2B2F7AC71D2, 0xC201F3E1ED364DF1, 0xF3292C158F41F200, 0x0001D76F0A454D8B,
+0xDFCC5D243BC64F3E, 0xEDC398D1CC5E1EDB, 0x6DDA16F7EFEA1ABB, 0xAE66501449625DF3,
+0x8E1CA565473E4F07, 0x87894C4ACCF88F16, 0x000168832AF6F1F5, 0x8C8F89EEAD574A47,
+0x99F1CC2D3DFCA770, 0xA8EF4CDAC8DAB1A4, 0x5B93E1DD645A8450, 0x78FE1ED33EAD03DF,
+0xEC1EEAF71CC393B2, 0x0000AEDBE4182E46, 0xC43ADE03EC6ED218, 0x35D172A44D11E31A,
+0x96CDE331011B9625, 0x8C9A0A27E125E135, 0x3774A85624133E54, 0x2AB592453891C293,
+0x00004430C9A259C2, 0xC1E311C562350279, 0xADDAB06211015894, 0x0AC82101D6314CFC,
+0xC2104E80C88B2A35, 0x378E25ECA5D215D8, 0x038B8D6A4D9AA080, 0x000072F3F31861C2,
+0x424A92B6468D6791, 0x50EE4BFC033D8FEC, 0x94E2699D67D34B0B, 0xAF339A58D646BC56,
+0x596DCD9F07BD9CFF, 0x5CAFCF1810D73D97, 0x000161539A052D78, 0x5F171705DF6AB5A0,
+0xBE1DCDC91E832071, 0xCD1538C62521C907, 0xC37362413034DE6D, 0x5D73C78C4BEFF30C,
+0x5BA76A234FB06BC9, 0x0001A6755D97BFE4, 0xEEEC2A52C7C1EBA6, 0x33ED7BACA5FFA92E,
+0x3213E5B11766E2D8, 0xE38EE843249DD226, 0x09A114D165D2B22B, 0x391C53F9AAC3E1A3,
+0x00012E37DBDDF342, 0xE0B9629E9B82E2FC, 0xF02E2E93DC42DD4F, 0xA01B1D2928347F29,
+0xDB8DD406A6E4322B, 0xDA188319BA913BE0, 0x72B8CEEFAA4EB4F6, 0x0000E1F006855878,
+0x1963F2B1AD872B66, 0x67C936B9D6FF3478, 0x79870DE57F4E47E2, 0x49E3FAC842B5D89E,
+0x04A3B2FE6ECEC26F, 0x2241CD38C7B094EE, 0x000026EF24ADEAA5, 0x945B8B0238747703,
+0xAE9D51EE4FBF0E4D, 0x5613837B8D1D978D, 0xD9A5C669F3E671CD, 0x7121449A1A7D12E0,
+0x80593665752D3333, 0x0000D182DB7AB8B1, 0xC8958639410AE1B9, 0x5C97C42C90FE3227,
+0x5552990BA22F98C8, 0x1777F94B40C32B76, 0x1BC67D61B60FAF8A, 0xA7DEFD10EAF141FB,
+0x0000D1CD03F0DD7B, 0xCAACDB9B77FA48A1, 0x1A264A7306F9B38E, 0x4B8B43A983B2AD6A,
+0xF405924A523A2523, 0x57E449E336DC7E8E, 0x7046B15C411929EB, 0x0001959DB6022060,
+0x627B9DB8C257D177, 0x45CCAF5CC1497880, 0x1212984925E2C3CC, 0x0552463C2AA599C2,
+0xFA4742ECD3EFB99D, 0x378EACE64B20D645, 0x00022F40788AED91, 0x152A161CDA6950A3,
+0x6BE95B211CCE73B7, 0x1B68A89440A8576D, 0x3B571EC7E440223F, 0xE0CC0DF7FDE0C145,
+0x181EC7FD8DB5DA31, 0x000062F1819F2E8E, 0x64BD6D89F1A59A5D, 0xC926B0DB05C34919,
+0x1310FF7EFBB5C5BA, 0xE83B70A5FA3A0544, 0xDF806E37930D8412, 0xA3C3E54EFAD44A3E,
+0x0001BA2A116877FA, 0xD3687640EE2068F4, 0xCF1D3BB279DD2CE8, 0x449D4711A9B1D53F,
+0x2496346E74AA05A1, 0x802930E2C4E52618, 0x354B9A90ED19583D, 0x000100AB77BBFE40,
+0x4FDCD1DD97328B92, 0x21517FE0CCC956A9, 0xD57426E288D68EED, 0x8566FDD2FD4389B7,
+0x599800D16293924F, 0xF0D5BBC1ECA2F548, 0x000119C7810B6760, 0xF93F471259644ADE,
+0x934D377D6F596DCC, 0x7D50623CEE2BE726, 0x1E7012740498BFD0, 0x02F2659633A0E51B,
+0x8033362653343C62, 0x0001BAF2147F13DA, 0x3CDE4AA0B8D1D342, 0x4C6C8F03B2E48ED9,
+0x2B8FD0BEF01E8488, 0x398478BF81BC35CC, 0x2A5927C93F46E683, 0xF84DBDEC432D55ED,
+0x0001051EFEAE92B9, 0x802DEE1A4C4BD701, 0x4428798C79448941, 0x7A7CB8BFD371E27B,
+0xAB49C7E96AF0BE2E, 0xE77861E6B7E0FF6F, 0xECAFCD865EC4B3F0, 0x0000B020F9D86A0C,
+0x862DC3D6B921E891, 0xF4B7EDC976412955, 0x5773956F948507F2, 0x68B9DB2DB367C048,
+0x010EB7624DDE34A9, 0xCC9C4D6D8395F348, 0x0000D793E1157C29, 0x76A8AA635BF71ABB,
+0x2F3E67170FF54300, 0x1CC074A1BF4E38FB, 0x3DF8B2571C8E5661, 0x2BA80A33053578A3,
+0x2285D17FBDDB779C, 0x0001FB7D021D599C, 0x6A692DF4829E194F, 0x6A5F4D91F6904F5A,
+0xD737E5D0F9CE4166, 0x736CA88389F977CB, 0x23FC0AC38DCDA6A2, 0x13A8369E94F89D8A,
+0x00002A2510428F86, 0x1E7EF4A6C6BFFF86, 0x6D83DFB9EB712FB6, 0xF918763CE06652B2,
+0x2327A9E8FAD5F8BD, 0xD7F2B725A33974F2, 0x34465383A20A0D88, 0x000097E956535B01,
+0x7E805117961B1440, 0xCECCE23F9D5A8D51, 0x5C8D8B9A10C3FD44, 0x6CE4226F55F13744,
+0x409AFB917F2B16B8, 0x57065C231F41AD17, 0x00021BA18754A3E6, 0x936C2712AA6316D4,
+0xF9BCB151B0A439EC, 0x7C81ACE19A0ACD9A, 0x9DC67E822ED9F0E8, 0x516617EBEC1A2FE1,
+0x13A23A37B50BA7A9, 0x0001D22A16C0FB35, 0x9F1F21FF3BAEE7CC, 0x862EC00F710CBFE9,
+0xD530868F475B27DA, 0x6B937F1F8F5F480B, 0x1C48CB6F021A22D2, 0xBF88BEBF34078397,
+0x000022F9B7328E83, 0x0BEF45295D3F6CDB, 0xC2628DA6F4F4C570, 0x52876708F58AE93E,
+0x21CD8230E5628545, 0x1A03D09B16CA9776, 0x9F622969CC0B85C7, 0x0000654E927362C7,
+0xB179E63E220156A6, 0x37AC22E082117440, 0xAA0C8DA50168B4EE, 0x6664F3243FE74043,
+0x4FE1CB0C0B7C7D9F, 0xADE345180E618708, 0x0000BC45D415F565, 0x5DBA31A391939430,
+0xE843515074C8FE38, 0x15F5E6E066FA1720, 0x74888FF3F6FEC389, 0xD0C33D529ACBFE5A,
+0x9F6F838253CB3B71, 0x00019CB81FF19AF9, 0x70757C97B024502B, 0xC998F8C16E453830,
+0xAA463A1162974736, 0x255648C9C4514F09, 0x992700AC53D16CEC, 0xDF7F61BDE8B483ED,
+0x00005BAA88919FF2, 0xFCC6C9B9DB26FD43, 0xFD75DE6413E8A7CD, 0xD14029B10D632B50,
+0x4C34414789EDA394, 0xCC5580A0F8538B73, 0x84C6923F3EE33E9B, 0x0001D12CF8F0677F,
+0x5F6477CEE1B0D417, 0x92AD9829518BD8C5, 0xE2484346D4A5B844, 0x76E6DFBC96F62D5C,
+0xC80ECBEB962F9FBB, 0x0A1412D066F79E58, 0x0000886D9AF43B92, 0x863797C7398DD7C9,
+0xC27F0953656858AA, 0x492F25FF2D7055DA, 0x897D0F2ACBF13FFB, 0x44E16A040D80033C,
+0x80CA163EFF8935E0, 0x0001499B04E7236A, 0x48A5EAD91DB1C558, 0x5096F3DCB038756F,
+0x4EA5E2EDF2628D62, 0x5BE6C1AE996FAC02, 0x7F2BCD3CAD68294E, 0xEEA746282BC731B0,
+0x000204B46FF0B8FC, 0x7DF1FC8A93BDC52D, 0xAB9C0879D95955E4, 0x4AF05B9F9F843302,
+0xBACC7F13F2CB6FE3, 0xC1F4C829400FFF6B, 0x6F408A55527B0002, 0x000007565B362DAC,
+0xDBB8A76E5C254146, 0x86A4C6EA3F4D533F, 0x13D667FD86C9328F, 0xCB96ADF95F1F7484,
+0xB993358835CB18FE, 0xC1CF9F67C0C3DEB5, 0x0000E6E5E8611A02, 0x31F980AF84FD731A,
+0xD75BF5D6DA9FB272, 0xB76AEEFDA67E31EF, 0x7FBBCA20592B069F, 0x2274BA9532E03258,
+0x5CB6C11EE222C7DC, 0x000150DE30212A09, 0x0A4740C40C821BF4, 0x73338763DB6662D9,
+0xB53F7C2F5F08DF8E, 0xC6AFC1ED7D62A4F2, 0x323B99AE209E3AA7, 0x54CA62E0F3907E52,
+0x0000B6527A8581A0, 0x114FF6630F8A2CBA, 0x0CA0BC8A644226C0, 0xC47990DE53E39404,
+0x9DE21294893A933A, 0x7ED76A0AAD76CA8B, 0x6A6BCBBA2FF7ED76, 0x0000C3EEC61F1C74,
+0x823C9B87307938BE, 0xF5C6DE0AD0C790B4, 0x51038E2C282B0E3C, 0x66DC7B08C9AD7BCE,
+0x2CCD032C6E2991C2, 0x3AD730CFE2C974B0, 0x0001239BFD407BE7, 0x88D5A788C53D4D8D,
+0xBC55C0157BCE3FC5, 0xC2192290AC6BCF12, 0xB2E02DA2B1F30FB0, 0x034CA10D71A73770,
+0xDFB5813EAAC3BF3F, 0x00006AA54FEDCA19, 0xA2FE66056BB148E3, 0x18764A4D4D8F1B3A,
+0xE087FABDCDE8EEBF, 0x3068349DDDAE20C6, 0xFE85BB67621C99A7, 0x942005F634783D2D,
+0x0000BE8ADF83F275, 0x6766F287FE47B066, 0x7EE85138E4D224ED, 0xBDD765688EB55014,
+0x5EFC273D55CE9420, 0x8CCFA6E6DA4C0213, 0x9CE58A8D51801CD2, 0x0000E98C099D89A6,
+0xB1970E0A8512A410, 0xC2EE70097154C447, 0xB6EB798AF9A90157, 0x00179BBAF53FDF08,
+0x5AD2C7B117373E7A, 0x740EC24DB26DBF45, 0x00017E36F6D2E85D, 0xBABDFAC669140D0A,
+0x5DD0B5B245ECA69D, 0x7DFD54B2CEAAE557, 0x67C622AE9BA913A9, 0x8E2D9651544DFFC9,
+0xF81A79BD46331194, 0x000032186A9C9FE6, 0xD50F9C0E0BCE4026, 0x6B1F2BCA881C7D83,
+0x2FD94349764FBB19, 0x37B8850E46AB0700, 0x1EB888C1A597EAA4, 0x128A7D469E906BA9,
+0x0000EF3395967412, 0xD799AD9FFF47C132, 0x1F20D5B8071D57ED, 0xFB93465B32161EE4,
+0x170803FDA358DD53, 0xD49B04C29B6C3A6E, 0x0BAF44E2477F37E4, 0x0001D87148C165BF,
+0x61C5008F66170555, 0xE8FD5D31CED787F7, 0x70BEDE2B2167A207, 0x5D10D8CC280E6180,
+0x66A35E7ED65B68FD, 0xE20D182EC1C371A8, 0x00016B1B8D9FA53C, 0xBA8A278BAE88C40F,
+0x2EFB4BFDF98579D2, 0xA2FC6D7306BF0A25, 0x7CB9C945CDBDC3FF, 0x37CCF1CEFE288441,
+0xAD2FAADB7641FA4B, 0x00018DE2789C463B, 0x159F7CB56719DC09, 0x82446AD24DF20350,
+0x540A83BF9AD3100F, 0xAEC782E4D438530D, 0xE6E70ACD525ABC56, 0xDEECB60999937094,
+0x0001618795F272F6, 0xBE7B2725630095BF, 0xD47EA64E21A7D12F, 0x522E0E1665A5A403,
+0xFE786223B8AFE3EA, 0xED038D9E9245D463, 0xAB30456141680F3C, 0x0000B80F0BF26CA9,
+0xEF966735DFFFB248, 0xD65AA3C59890C8AB, 0x25C6F0FAEB65165E, 0xF8613DE4356A7081,
+0x7959187E6F3E2242, 0xE2DC8FCD3AF4AE9A, 0x00000FDDEE6B6775, 0x1A1BBCEB0B586779,
+0x08723349C820D2D8, 0x47A7BB79EF6791D2, 0x84CA3128CF5936C4, 0x59E7F3660C0D946B,
+0x7A61F236C4B7EA65, 0x00005D61EA5C9A10, 0x6524EB8035A5AD08, 0xC94B3270E3813706,
+0x10F5781A21E528BF, 0x28C40639A3A09003, 0xC2121A765AF88200, 0xDD3E26351D10A0EC,
+0x0001CF176A457781, 0xF356FD536B8117B2, 0x825627456929C122, 0x4F81B13DAD6DC066,
+0xEEB58AC8B7E041E5, 0x5845FDD4E65C29FD, 0x84143C8A193A6333, 0x00011E0FBA981A0C,
+0x5A5E8AA40539F82A, 0x323B3972A868DE88, 0x920D569D1B07977B, 0xAD76E6B7FD813BAA,
+0x738541DAD33D4981, 0x6A8C9F5B4EB3B91B, 0x0000EEE848FFCE1E, 0x57206621B8820D04,
+0x7A3CB53873EBCDA3, 0xC967E24C4DAC3166, 0x46A8D030AF6F05C1, 0x3BA4E0174765DA4B,
+0x0E04C168EDD19D3A, 0x0001C736BC3FD38C, 0x7F5E7466B2955193, 0x7C2086A5EC984D38,
+0xF96BDD508802227C, 0xB10E588AA78F030F, 0x143FFC7417A49BC2, 0x8DE4ACA11803024F,
+0x0000D910DFDB7407, 0x123A5DB3328F22BF, 0xDC7653996C161863, 0x0E1BFB4D3930183A,
+0xB714DFD7623A1DA9, 0x258C12421C923D86, 0xE8B3C52A89CEB469, 0x0002254C66FE3377,
+0xB3D33CF8951355E6, 0xFF27F88C6DA0BF9D, 0xF83C2F0F9A3BBAD5, 0x2910644D921F88A0,
+0x1E04258C874B5864, 0xAF9BEA4A2144BD12, 0x0001FC7187452372, 0x32462E194736829F,
+0xD1308710A8DCB28D, 0xADCBFB70F27AC60A, 0xCDD11F94EDF32BD3, 0x758D4AD16DD046DB,
+0xB6103EBA1CC4C12E, 0x00015E33C76D07DC, 0x46552BD20645B8F1, 0x945D18DA0297E427,
+0xCBE0A12196F7FFC9, 0x899C2198FD5AF704, 0xC9E0021C110354C7, 0xF70613D2025A9C0E,
+0x000192DD52F3D58D, 0x75A1BC9D736FAD66, 0x44B8627993C8E1C8, 0xD3A92795E66F1AD6,
+0x96BAE710B3B86B8A, 0xF767E9D5781E998D, 0x5A1CB04257E8D092, 0x00012E87DA0DEC10,
+0xDAD7BD10216189D3, 0x1FEFD4DB614FCAD3, 0x3940AAD60D0275CF, 0x3EE258EE25387CB0,
+0xC87EEBD2CB1EB434, 0x23D7F838459C3027, 0x0001E569C5F8A659, 0x0B3A0EC9B2519F22,
+0xEB81D040263B7DF6, 0xF3C6CADA956AB25A, 0x334206B71D21830A, 0xE2A0BF818800692D,
+0xD1662E56791C2B73, 0x000008CB7EAAB785, 0xCB255E5BC0B28069, 0xE0B078F1F8E4E156,
+0x8E64DCF32DF4F166, 0xB49F9C8149488E5C, 0x4C15B9AD47FCAF51, 0xA27FB374030BCAD3,
+0x000069DA75F1EA0A, 0xA3146CC24C4ECF3C, 0x63CF2E650323B068, 0xCFCE183BB759DDE3,
+0x193C67A2754AC3C8, 0xE61F894DB88C254A, 0xE034307DEB70E7D2, 0x00012C96AAFEB112,
+0x37FC29EFDEDFB9B2, 0x4F45CCB2D7AAAE6E, 0xB802AA4B76A68AD9, 0x33F05F2610A4122D,
+0x606D66C5C52F55C7, 0x3C641669F869C58C, 0x0000E92FC32613FB, 0x9FF7AC8DEE4D4E86,
+0x50FD2F6B126F6C70, 0xF349335BFC8F96B9, 0x61862139F266466F, 0x1815136E0FFC977A,
+0xC70737C52DAA15A9, 0x0000A3A6FB6F44FC, 0x55DA0F49F89C151D, 0x56C22B59134DF625,
+0xE3AA497961D1B2A1, 0x61F2F9FD16EBFDBC, 0x786FC6E64C115F96, 0xE4074DCC87EC253A,
+0x00008B721A6073EF, 0xF0317273D4C575D1, 0x13360E438F289F13, 0x9DA68640D77B6A62,
+0xB5FECAB15EDA137E, 0xE82C594C8AFC956A, 0x34D70F79C4D752EC, 0x000209673408E037,
+0x80C6935EF055D6DD, 0x8573EEDAAB9B2235, 0xF2A923EDF22DB345, 0xCEB4E6C1B6EB0E8D,
+0x8E4CAA919E819EE1, 0xC9DEBEDBD4C9F3A6, 0x00010E05537235EB, 0xE43D791BB42FA8B6,
+0x94A66B866BF79F56, 0x3C03807D5B72B19F, 0x03D4CE5470BABE62, 0xC57FF0AD5A2299EB,
+0x83DF8E2596400F07, 0x0000E8C2399E9D00, 0x92F7996DE1EB3D3F, 0x45076F1058819830,
+0x66379BB72872FBE2, 0xA3705D3EBABE3D20, 0x93EC37634A6C7028, 0xBA8DA17C06412F8D,
+0x00012398FBE7157C, 0xE2E5932913F4B742, 0x9D4493B9939EC4E6, 0x95F4F4E8A9113005,
+0x36B68250ED16F17D, 0x67FFD09CA41441E2, 0xB0FAE7C529707848, 0x00000139138D8CBC,
+0x1B38B5D6B2937629, 0x2F04170D77AA606D, 0xA38FAD89CA6AFFDE, 0x02DC3A9CE4200B99,
+0x5DA4557908F83A7F, 0x0949EE17F93F0E40, 0x0000893BBDDDEC41, 0xEB71E8043B6686F0,
+0xC541462BBFC45724, 0x1893CED2054EF7D5, 0xE81C6CC9931783E0, 0xCCC7E1CE46D17115,
+0xA496FD82586B1DDE, 0x0001C7C5016257AD, 0x5F102756D15511D5, 0x3E9B0E496A7D77FA,
+0x91FEB32318641AEB, 0xFA13938EA1B96EAB, 0x1AF83B64E56B6881, 0x3EEBC55C3112C1EC,
+0x0001FF85612371AD, 0x17D49D8C45983744, 0x7535312E63943082, 0x7ED6943B5A438D5D,
+0x2C915FC04338AD07, 0x75E1F34A8CD877F7, 0xEF542D6BBB79F36A, 0x00018AE2B79A97DC,
+0x7D7ED2A3F7526456, 0x453E04977B36374F, 0xBDCC1D9FC7D46D45, 0x58ABDC729A50B9A7,
+0xB253AF0B693C4396, 0x7DD5730AD84A3E18, 0x0001539D880BE6A7, 0x8C9ED5F0FA82ADEB,
+0x98D201FA547B8CD7, 0xA10B9D14744AD45E, 0x96131DC778721B30, 0x0FD484413823395A,
+0xC47EECFEE1992D61, 0x00018864EC305943, 0xD3293200B5F5E338, 0x819E2C5F0ED94E9C,
+0x63DEF1FC04F6A11F, 0x829DC962C904F4C2, 0x595BE74E66FC862C, 0x654B2F655B3078BC,
+0x00011417225AC116, 0x2A98D57BC11E25A3, 0x09386755A8888B1F, 0xDA3AB9A6D1A1B5EC,
+0x497FF7A50D3AD60C, 0xA7B7965D68F7A723, 0x3CA4DF9341E7E361, 0x00008841DDD5FE3D,
+0xC1A51D114ABA2763, 0xE81D55C581598E47, 0x1A0DBF9B41E6462E, 0x1D21AAFF739C4AEE,
+0xE9210F5FD851F54A, 0xD916AD98B901CEC3, 0x000015C9C3245189, 0x3A61C9C98D8EFCD3,
+0x5683D37D1A817F91, 0x31CE2D576D4808D3, 0x8855E136B8BC8402, 0xF9A253F8179C58F0,
+0x0136853467D19395, 0x0001E68B8618D122, 0x1EBACC9ECC8672EF, 0xFE716AEDDF1CE6C8,
+0x8B421D0086537A99, 0x5A91DC0294241746, 0x6D800018DDFDE456, 0x5D074F60AA5F2A60,
+0x000071F3EB479B4C, 0x1DAAC2A671E4A91E, 0xDB6E7C1A8F823B9F, 0x4C41F52CC2BCDE76,
+0x85DCC2E4612A2A1C, 0x912699DEC522AA4A, 0xAA75329BA836C55C, 0x000173C04E1FC725,
+0xECC8DB21DC45A118, 0x2BE6CBCD8269E3F3, 0x26C99C0EDDF5F765, 0xD92F0F6DF4303619,
+0x9165C14021D783EA, 0x2C414DE4DDDF8E87, 0x0000B7CA0D924DFB, 0x61CB4AF0A75D2203,
+0x837724C27D3B7125, 0x012D762261F77ED9, 0x7232EB4B5AD0F22A, 0xBF0B0F1B2783A981,
+0xD314D3F37B5E57E4, 0x0000BD584CCDF04E, 0x4190BD99D3904A24, 0xC4B4D722143BD754,
+0x00FDD6B0DE0B960B, 0x5441ADC97944E2E0, 0x2E64641421AE693A, 0x6F6D70BE319FD7B9,
+0x000133EFC253BFAB, 0x8B65808D611ACCFE, 0x513CD02DC8D23F45, 0xB91825D53FA8064E,
+0x4E88A0D2FBB7644A, 0x0CF87C754E8A01A4, 0xB20792096C6CDF31, 0x000195A7EE5D3DC2,
+0x5B57EA205DF9A612, 0xF177D690F7DA66A3, 0x390798154656E388, 0xDF03A624E035290F,
+0x5F2045E9861DC81A, 0x4201C47F0926DCB2, 0x0002264FE270485C, 0x08194D13B2411CCC,
+0xE620010ECD53A005, 0xFEA1985526D25409, 0x46E94BC06F235212, 0xBB5A75429CBD2BCC,
+0x887C147127F00288, 0x0002179902DA25BC, 0x7C06CAA1F3F6A5DF, 0xBD75B8A7877A5F28,
+0x1DD192DA1706A5EB, 0x0B31C50B7EE823EE, 0x0F6B4D21276874BA, 0x076546A885EB9684,
+0x000029D6F52B535B, 0x3670C9745ECBFC67, 0x86C8F2379449BF3D, 0xC24812E2DDFF7BFE,
+0xD1DEF34956EC54E5, 0x07892EAE5E0C9F77, 0x1789A82AA01B493A, 0x0000F8F24FEB37BC,
+0x956A017217127C61, 0x8489CB74228C2586, 0x22389710EEC853C3, 0x8AA269246EDDCDBE,
+0x433DC2D278AF33D5, 0xBBC3862A2B82657C, 0x00002E8D3EF20707, 0xE657B96FDC6557A2,
+0xF2B61079E617D338, 0x6E6AC4F9430C03B3, 0x9BCFC2D6B06FD188, 0x3AA83D74E1140A8C,
+0xC3E798DCAF7EE6DD, 0x0001F7A5F40F5834, 0xC7C15F80E8E31AD1, 0x0806527DAB469E4F,
+0xBEEFE00C19F63FDA, 0xF03A482CE2CAEAD8, 0x64C0304F5249F2FE, 0xC97AB9E811128FE7,
+0x0000A34A1FEBC29F, 0xC3685E628A30FD63, 0xE939B2EBF58FB8EC, 0x591215E096F1EB64,
+0xAA82B2DE0004D91E, 0x9D63997E93D7DE77, 0x73E9F37877B3426E, 0x0000A7686A84AD73,
+0x3E31EAD67F6B26C7, 0x0DC23099712288E2, 0xFD577AB591A985CC, 0xF5C71B241C771CB2,
+0xB9ECE5BF5F2EDDCF, 0xFEAD0FC5BCF6D329, 0x0001950C7405E7E1, 0xD8FDE9B2EFA1555F,
+0x9EA9F207269CC23F, 0x01D4C40E466031FB, 0xB809EBCB6AAF5E8B, 0x836307A1A7E46F13,
+0xFCA643599ED0AE46, 0x0001675A61B192D0, 0x0F4DA0D84C86AF03, 0x8C25769FAB0F9611,
+0x7C8B9D1D0CA2A1BF, 0x718FCE7C74ED69A2, 0xB2ADDA50F1DE326E, 0x6AEB8A8A0E14C30A,
+0x000096442F55425B, 0x2F8F5E193AEEA0B0, 0x2A776384176F56F6, 0xD4A2BB127CA2BB20,
+0xDBBD48DF06E3A147, 0xBE0799DB22EF908D, 0xB71D7660E4012836, 0x0000CE3E8FFB349E,
+0xFD47D3E97DE7DB09, 0x7CE92E2DBE80E955, 0x93F0E238AC867FDD, 0x9D738CC052FAAE8C,
+0x886348B163571465, 0x3D5B0C35F57D2771, 0x00006D2A3AE8E99B, 0x2ADC9091912B0366,
+0xE913E9318AE3E75B, 0xF41B159C146838CC, 0xBEA8BFF250FF29FF, 0x8FD9A281B92C127B,
+0x92E5076826DB34E0, 0x0000AD71A3524DA1, 0x2CA3F733DF5A767A, 0x51F5F6F9A7837F98,
+0x4892FEC97B18B2E0, 0xE1E4777984F9759E, 0xBF80811E41C6DDF5, 0x63958D9756D35E1D,
+0x00000ADD7D20D528, 0xFA3D6DCBE278D4A3, 0x565E478B3B66035E, 0x13864CB5700B01B7,
+0x97D836A976156847, 0x91B8D8BBA0A8EE5E, 0x28AC6FEE758B7E0E, 0x0000FF0620319E31,
+0xB20D6908A26BB2E6, 0xBF602EF944F3548F, 0x76C1531F300F3014, 0x7B70E61110372D3A,
+0xD0D83BA41826373A, 0xEED21F12DD183B0F, 0x000010FCA8321681, 0x7F54BE528B643813,
+0xED03540646F9548D, 0x17BE7BC70081920C, 0x26B40460854C46BD, 0xCEBCBBE07703776D,
+0xBC3C6FA3101B4E5E, 0x00003E7A986DE4D4, 0xE5103D1D2C2DE554, 0x6674880959861DEB,
+0x892ED4B109C7DAAE, 0xFCD4F7A0CDA5FC5A, 0xE031EB892E339DFF, 0x6AF0A62392FB99D8,
+0x0000A1152DFF3176, 0xCA156617E0DCBAE0, 0xFBDE94006489C9A9, 0x6B4EDD7C675BD6A2,
+0x019A5D1EBF2209F0, 0x1582A57C1D7DC1E8, 0x2149FA20B62CE7DA, 0x00020D9B9879F408,
+0xF3AC2DD92CB4CCD5, 0xC4F39A7D53448807, 0xD13670022E1C06DE, 0x200E48CE075FC347,
+0xC6B1C0B1D3E914E9, 0x92CC948C2AA79E60, 0x0000A1815B9DE212, 0x7F67557E7ACD3F6A,
+0x1C037A1844BB4FAA, 0xBFF5E906E42D9FC5, 0xD5DC0B6A58CD365C, 0x9810D19B3ABBC563,
+0xBA8A914EC063FEA4, 0x00013443BD2BD04E, 0xE7EE394BD2C8107B, 0xA177DDEA2C5FC63D,
+0x7AD776EABDFDE119, 0x541AFBE9C61F745E, 0x9665EA25EE57F1EF, 0x8B208CDD15AD0021,
+0x00011F126C521353, 0x7685F1F5730CBD1C, 0x643A7C91F843F092, 0xB321BA2F989FFBF3,
+0x1768018187724750, 0x871A634E7AA0FCD4, 0xF4C9239EDC5150F4, 0x0001E54BBD34A41C,
+0x2CEF68D29A8FC871, 0x59CE5248D4BEF998, 0xABD63669505AD362, 0xBAB700528C507DFC,
+0x7082D269F7B74CCA, 0xD5DFE3770C8B850A, 0x0000E5BEF11683E1, 0xA2419DACBD7D166C,
+0xCD4B7193AC69C3A1, 0x0CF9225155941FC0, 0x90D047343DC53C63, 0x927EC51E8CF9B400,
+0x8D84C7683FE020BE, 0x0000985BD04CF5E7, 0x7001FC8EBFF1DC79, 0x08A4902228877081,
+0xB833D69F5B0372E2, 0xF71D8EB582A07B9C, 0xE77ED91A17ACCCF1, 0xDDC57931DB659974,
+0x0000FCE8AB0A7237, 0x27ED9AFA2740D340, 0x139AF4497BBC4F88, 0xC1DB4183DA2810DF,
+0x75E82EEA1FABE015, 0x2EB455EF698456F4, 0xD944078A273033F9, 0x0001FC3FAB629958,
+0xA9E3922FAFBB85C3, 0x089F5FC7A438000E, 0x82F1AB0A580E0E3C, 0x8CC079377E0916EE,
+0x69A272494E468223, 0xE04DC06F2A0D917B, 0x000007EA6CB48DE6, 0xCE112E9C28625783,
+0x61A0D5369985D832, 0x276822595763387B, 0x1EDFF08032F8E7D1, 0x58F08CF36D31D77F,
+0xBC76F838553EDABD, 0x0001434B41370A2C, 0x6DEFE6B078BC9486, 0x09FCE040A7953FB9,
+0x030D7A14FEE844ED, 0x38F834157917BE9F, 0x204DAF4A909598C7, 0xD7699B5B128966D6,
+0x0001F529315EF355, 0xD2B152C9D279BF00, 0x1AA8B793D0E1D1F7, 0x26017625A6407537,
+0x2140F3EE99FB2152, 0x905A8634501B6FD2, 0x8B302D09D2A164D8, 0x00012210B2ACB5A4,
+0xDDD02EC5D34A0246, 0xC0FA8C4A55DC9365, 0x49237F8AF8DFA54F, 0xAD28D528A608E98A,
+0x9F06D399AD78364A, 0x5970714C2E95E2C9, 0x00020026317ED011, 0xD6044FF396332966,
+0x0B2302DADE7691ED, 0x9320FAF2827F8083, 0xF846E9DB3C643300, 0x08E1DC11E9068C15,
+0x4BF82A9A3C4AE03A, 0x0000EBAF45355510, 0xFD89006F1F9C7405, 0x14D90439B66DC3FA,
+0x3F9831E91126D55F, 0xE038AD01FD5E502B, 0x67FDC5709758D16C, 0x1A134D08BA21437E,
+0x0001DB0841A8EDA9, 0x58DAEED5EE4EE5F3, 0x7EDC320CAEBC17EC, 0xBFE59F55A8DEF85C,
+0xC54B029C0791753C, 0x05BD6EC8D84B7F24, 0x2DA17B34BE3DAD7D, 0x0001C19A6C8D35DC,
+0x429D1F416015AAED, 0xE018DF40B2F04952, 0xF0B7009AB194AD89, 0x19AF16B0BBE2D53D,
+0x203CD30D791A6539, 0x1BC568D92E2F38DE, 0x0000C1EFE661AF63, 0x50271ADDF8168B95,
+0xEB4ADE1FAC32E925, 0xE6328CBEFBAC69DA, 0xD1834440D612B2D9, 0x1FCF375D29B96EBF,
+0x6F2FCC2F2BE231F1, 0x0000239A1D55200D, 0x4ED29AB767BB4EC3, 0x1C2EBBF213777FFC,
+0xC3E591114609DB38, 0x94346D5904CDD008, 0xA6842AF5D525C96E, 0x0AE0157CDFD4F68D,
+0x000067ACCE3D2305, 0xD81B34EB9B34BB0A, 0x583DFF16181F5B58, 0xAB77CEE77CDFFD23,
+0x058902B47E9F7D2D, 0xED378553FDC28F46, 0xA17632D82DC15F0E, 0x0002035659A0A6F8,
+0xB0E4DD6556264353, 0xEF5C4C342C474855, 0x2928D1672B64DC72, 0x4688AD1C3BE00F6F,
+0xE909B22239BFA65E, 0xC86F1095186F0A3F, 0x00008273A99E9499, 0xB1C21E7EFA84DEDC,
+0x65C6E04DDF1F94DB, 0x83B9A9CDF859B1FC, 0x97F064433F44D256, 0xBF1DBDB082B14941,
+0xE1E42CE494199947, 0x00010B788F59FFC9, 0x81B95C51CA5FCCEE, 0x47F29109ACB06B1C,
+0xC5719319BA44AA46, 0xBEA69A3A2DD3E72A, 0x4DD54D05C99A88C4, 0x664B63807E404EAE,
+0x0000D81A701C5559, 0xE8B1B2D26D3FC022, 0xB597964B54233A80, 0xC4E06E216F3F7241,
+0x3FAE6CE39720FD55, 0x44D47CBBF9BD6BDC, 0x600991019B3D0D9C, 0x000114B0A43CD82A,
+0x16A42207A89BEC29, 0x803F5061AA235A11, 0xDD7689D8883C1B53, 0x6181BD2F2FCFEB72,
+0x45EE2085332CEA9C, 0x8DE2B8179B08F888, 0x00003C5E1CAED94C, 0xE0E2194AC85C9BC1,
+0x0E93FC0A6F5196B1, 0x3AE439BBD5F84797, 0xE414F13390482F0A, 0x21BC8394DD1D1D76,
+0xEA5DB0F4627E0031, 0x00003D1E7B0DD7CD, 0xBD267FD831AE3A67, 0xB30A478FF263A128,
+0xAF436F109BC515B1, 0x4C7148D5F035BEF9, 0xEF4CC940148ED782, 0x9DC185F0892A2808,
+0x000046CC88FE54B1, 0x909285D0C4ACBDFE, 0xC6D1C2B00A44C70E, 0x26E2D5A75085A67A,
+0x44CD863D3A53D1CE, 0xB31C03C770383F74, 0xF0D7BE4F3FA087FB, 0x0001FDD1660363AA,
+0x9B2EB168365D3E55, 0x9A3D6A18DE5DF5D9, 0x1476ABA2A76E0169, 0x6453A1A2FE7A8FF9,
+0xAFF02A84A8928A1A, 0xBD206A4BD7B7CDB1, 0x0001E066EBEA2BF6, 0x9829B3B5812BFA9F,
+0x5045BB9E6EA7D3C7, 0x33FF18B1041848BE, 0xD17548FE1B4E4E7A, 0x5F709AA767F40EC0,
+0xEA9FBE321B67BAD1, 0x0002193AEC1FFB17, 0x5A5B13D26DC7DCD2, 0x8F55F4F96516991F,
+0x2EE19D123EF3EFD0, 0xAD1419533DD6D624, 0x9BEAFB8A97A0F70A, 0xC78AC5E586886044,
+0x000224CA7A94A11E, 0x5FD663BF098E7299, 0x21B43ACEC5A2DF25, 0xB6F83BC43C4EE393,
+0x312FC81806F9ACD4, 0x1DE36D59B46DCD94, 0xB6CB7C5CB6CD7F2B, 0x00021FD95FD165D4,
+0xA53CBF431AEC68CC, 0x0C058D2625B565F4, 0xB0D7F121A622296C, 0xE3B4313C0EA5240A,
+0x9EDD9EED39457751, 0x222F36BF81C2C414, 0x0000F0CEAD24CE73, 0x2B5C17C890F0F482,
+0x73BA2B76BA3DC453, 0x56D7124EE669458B, 0x1236832C1DD34C41, 0xCE90DC3DB5CB4FC3,
+0x259117C2255A6061, 0x0000DF05F7E6FAD8, 0x8D7762AA90D1A0AD, 0x338787A263F8B542,
+0x1206D8899CDDA00D, 0x2DB416DF32FD43E6, 0xA6F39D992F2D0906, 0x82C3D1123C3DD3E2,
+0x000008ED992BEB8C, 0xAB95AB5C7E16AF4A, 0xA4BC00079294979E, 0x03C2F8975374FEDD,
+0x5F53DEDD4A3EE6DC, 0xFD8A1FAAE7481AEB, 0x1A3618DF5F218777, 0x0001295E25785A00,
+0x3127A886DA05881C, 0x002654C0F89540F5, 0x85650D956B38900C, 0x1BCDF96B155564B3,
+0x0CAD75B0B676E956, 0x2225079A910A0D64, 0x00021DC4A3303BFD, 0x3904D3675E64EE85,
+0xE228A47568B4BFEF, 0x6A69394FA582BABC, 0xBB56D4FD43F08458, 0x6B239BB4100027FF,
+0xF05A7036CB723EFE, 0x0000F354A1934B19, 0x99E6D7D06F7F4803, 0x6511867C2C559705,
+0xD2715FF86907DBED, 0x2587EAE80B70D903, 0x6AD6F4251C886F51, 0x170597649A1CB97A,
+0x0001A35A8F8E038D, 0x32C5DD2EEBBFD440, 0x1072A6182D385F13, 0x7588A0F56A5CC3C7,
+0x5FCB55D693F6257D, 0xA4757BE3560F80C6, 0x5ED3CD657EC9B9F6, 0x00021395A04BF70C,
+0xCE1FB2448F743FC1, 0x33D3B54730971243, 0x14B5B80C033C13ED, 0x38419A70E8926A73,
+0xBE473A04B91F6A31, 0xBD3FF5425258A349, 0x0001ED222A9FA010, 0x7D5D540ECB6251EE,
+0x92DFEFEEA12B4892, 0x665F9AEC846F19CE, 0x9086B8291BF519AC, 0xFFFE7844CC8162D3,
+0x5E81D9DD058DB194, 0x00017473EF0992CF, 0x86CEFD3A14F37EFC, 0x11B639B9992C793D,
+0xB229D0405476A2B5, 0x8B8E566A3E95B0A7, 0xE6FD716DD733422B, 0x65A5E145307D1B38,
+0x000184F6D2E6643F, 0x9DCCF14BCA8793F5, 0x55252F7F01F31292, 0x92AF49A9A191F7FE,
+0x75BC08CF523DA3FE, 0x9A13209217006EF8, 0x13BAEEFBAE84A6AD, 0x000163B1B54A3395,
+0x153AB9A132BF9451, 0x0328F95033DEE364, 0x8467A9C71947ADC2, 0xC5485E6A9DF7A024,
+0xE5D9C609B2E84B78, 0x48B2753FF42FB610, 0x00005660B6F30543, 0xD51A7E48B32E2F8C,
+0xDED0DAE956EEB59B, 0x09617A2670CAC117, 0x810908C6FE6CD71D, 0x47A5C0268E2325D9,
+0x8B69C8D8D033F3D4, 0x00013CE8F20C494B, 0xA874A2286DB8A889, 0x693D197C608CA063,
+0x64130A9DD8BAAC6A, 0x702F934576A4ADF4, 0x34F2D9415933870C, 0x0E852698B7519DA0,
+0x000225E312EF070F, 0xC89F3D4B540939A0, 0x0DC3B1712FBF23E1, 0x24B98B753E056329,
+0x731727B8669BC696, 0xE21FB25A8EE86D34, 0xD65AB01E04D2B6AC, 0x0001DA178ACFEAA8,
+0xF41EA57BE5655CB0, 0xDD1BD5BC50FFCBF8, 0xF32267B08D4A84A7, 0x50C125168AF05CDD,
+0x9559B804C1217928, 0x6CC7B3E6661336C5, 0x000147688E0E495C, 0x677642C76ABB8449,
+0xA7CAEE9AB9170093, 0x699FFEAD06194849, 0x71D68904707D4356, 0x90008A1FF7B37A23,
+0x2DB06A627083B696, 0x000069FC60293995, 0xCFB68A5D7587AA73, 0x9C6742B3494F4B5A,
+0x5980054FDB5BE8E2, 0xEF0D8772E47558D8, 0x86EA8B1D7F28A226, 0x9B9BB75A8D1478F2,
+0x00014AF0D5B2127B, 0x173860A4A19D5B1D, 0x2310C4AB9E1D11B7, 0xF558A450C5F00571,
+0x34127E6892B9D6E7, 0xE3EE0889E4CC4AE7, 0xC9AF259882AA3997, 0x000191F42FCD4F71,
+0x0A24E0DD411A24CE, 0xEB0211C4ADA8C68B, 0xC2CB99A4A23ED267, 0x6F7E9B9C044DDAEB,
+0x27A39B2A67CFC826, 0xE4BA8C041DF8A04A, 0x0000ABC7555FD68C, 0x9ABDE7DC88D2301A,
+0xB1B742F6CDADF1AA, 0x32EE616B6EB56438, 0x355ABBAAEF6A959F, 0xA2C8B5580937B620,
+0x0368AC563106D25E, 0x0001C56709EB06B7, 0x4822B1F2B0233F38, 0xA685FFBFAD35CFB7,
+0x691015EC212DBCBC, 0x883D910231B7D135, 0x9C8603552A0A3FBF, 0xDEB28F2EFB5EEFEA,
+0x0001E926EA3F8D23, 0xC290A9903E154715, 0xDF31FB7CABEC559C, 0xCE09907D7CEB099F,
+0xEE640712C163B848, 0x2A347C055E32FCA4, 0xFEB7C4F363AC147C, 0x0000DC17E410A173,
+0x38ABD9E82FC0BC83, 0xBF6F4C3FDCD1E3F4, 0x90EA2EB6D9A7C885, 0xCE68612D4380C9D7,
+0x2730D698AEB3BB6C, 0x28B3354795FBB7B0, 0x000074A6693A4F29, 0xED518BBB1F2C3A46,
+0xA33C75C942F2A6FF, 0x85EB807552A2C26C, 0x6DA4801BDCD32B42, 0x960451C58E6BA838,
+0xE6591A8D5F5F4F39, 0x0000DC6856234823, 0xBB2FBFE862F693D4, 0xDDB2654DED809F49,
+0x228CCBDB55B8718F, 0xF63C85918733210F, 0xFF5D48351CFD79D8, 0xF8DFFF2D3CA096CE,
+0x0000383CDEAD9025, 0x6DE01E32034BD912, 0x283ECC4CE469FCC5, 0xCE1E3281D494A5FA,
+0x37D2137BC29BB8E2, 0x50E0FDF181D94109, 0xFB70571E4F33F9CD, 0x0000158A841F9AE7,
+0xE864E1830624CBAF, 0x8A02463D89603220, 0xB2A04933CC1FDA4A, 0xFE2BFDC37C5B69A8,
+0x014BD9D3230F2692, 0x7CDD2CFA802A9282, 0x0001CEB361FC8AEF, 0x212939809B5781B6,
+0xA9BAC0DE2204EFCC, 0xE14D1A60F6804A72, 0x1203F86E50E88850, 0x3075B7F304F03506,
+0xD3682764071759DA, 0x0000AFE75E0EA5FD, 0x589ACA9BBD6B7AAA, 0xA3595EBEEE5DBAB2,
+0x7557BB8EF3FF3C9A, 0x73A2FDFA6927135C, 0x6C816B2204F16384, 0xC1AD2246D02B0D68,
+0x0000F7BF1A61F8B7, 0x97FA46E026EF60C5, 0x09851CA3361209ED, 0x2EFE5A8FD7C9FAF6,
+0x2756DEC22AEEA33E, 0x9218975C96252BAA, 0xE5AD877AA304A374, 0x00015C3B2AE9EDF9,
+0x948006A5667F9057, 0xF3E68BB248080385, 0x3912A96A8E22FCF7, 0x30649D7745B11C62,
+0x8F53DD584F581A75, 0x536E585143704BCA, 0x0001C3EA407C3C78, 0xA149CA905D8982DE,
+0xD3B6CFB44AFDEE76, 0x602D6279CDEC3E56, 0x0C06515CE2FC70A2, 0xF99EF05D7F6C2C59,
+0xAE828980F7E46817, 0x0001F5BBE724A703, 0xE4656C7CA78BBB8A, 0x10C105269F5FF0B7,
+0xD1E9F6A77A360AF9, 0x281EC7A9DAEE4FF2, 0x10DBE9AF83177709, 0x153BA8280B5E8CD3,
+0x000233B45EDACDEA, 0x69C05EEA7928DB80, 0xDD61FFAFB7CE09B4, 0x57E36B6E69BA3072,
+0x5E3211A963D7398C, 0xF7FDEC7F49B96740, 0x4699DC8F114B3DB5, 0x000008D497607AB1,
+0xC0E229C8B7385DB8, 0xAD930C577B81A211, 0x6A4BB1082D54674E, 0x262DE06CC7071770,
+0x31CC2353065422B8, 0xE0A32B146A513648, 0x0001995F63FD10C0, 0x57221B7AECD5DF6B,
+0xB66A05A33B109A04, 0x93F9614BE0E1E814, 0xD52F06002B5F3180, 0x55DC9BD533009D5C,
+0xBB078E29414EE338, 0x00005E1D6E0BB588, 0xEB9252867669E9BD, 0x331C3BC02078BF80,
+0x13B46D46E3A888F0, 0x1787CAC018A16840, 0x1B363ADA5D3CD3E7, 0xA060F6BC9517650A,
+0x0000B2C5FB3C988D, 0x2EFD19865FC698F6, 0x83230F8C6FDBB26B, 0xEE869FAE5878F0A3,
+0xAA196FA9189BF3EF, 0x70B43AC9C7D474A8, 0x47B1C3AEF31332EA, 0x0001DC98B34C4276,
+0x0218EF773D124F7F, 0xC87ABAABFAACA053, 0xA96819A8CCD29A02, 0x8206DE27A2334449,
+0xD3549FA2EEABC3E3, 0xE00F367D32F5AA19, 0x000130435E12AD4F, 0xF905F9A5027B9A12,
+0xCE45D40449B32F43, 0xFE9618C45FA0A939, 0x9CA4E852B4CCF35D, 0x76933BAA68C4C7BA,
+0xCC462E8EA9B0404C, 0x00012557755DB016, 0xC705190966FE1F5E, 0x594DD556C144CBDC,
+0xC357F91EACAE3FFC, 0x1DD5D9110073B99C, 0xEEFB5A037CFC0A00, 0xB45D39E2B1423FD9,
+0x00007222CE683EB0, 0xFD80E990D8542957, 0x9BD430F174A3902C, 0x7893F39F07BFD5D2,
+0xFE17468DB10948FB, 0xCBF39E898733DC3D, 0x2A1F56B8ABC155F9, 0x00008BF85BA9B6FC,
+0x11C7BF87545CA14D, 0x524058A0C6F55ED8, 0x60291601D5FDB0A1, 0xA90102C5A28C6D52,
+0x3E7BD888BB8AED6F, 0x903F300BBA163581, 0x0001DD8AC4511DBF, 0x8C7875DF21FC569D,
+0x35FD95A96C8E969E, 0xDDA0F1C3BC75B49D, 0x73D28C561E25EBFD, 0x2198B8AE813B416E,
+0xC7A30D8146CC2F03, 0x00018B0467A4F45C, 0x944C3DEC4D1764BB, 0x3F0F4CDB720C69DA,
+0x7B170ED4A5206990, 0x2FC1502E2BD62B53, 0xABFAB4DE68AC0F61, 0xAB196CB99F9F10FA,
+0x0001BD54F4E743F2, 0x76B3F2C01B6D1977, 0x30C68ECCB02CA7C2, 0x307994ED818C9850,
+0x793FA7C89C3202C4, 0xCB2B09EBD92AFC10, 0x11149B85126BD2A3, 0x0001C11C663A00DE,
+0x2CFC9C4848DE0E5C, 0x949712C7427740C2, 0x451122326163504B, 0x76319DFB3E6FCE31,
+0xBBB836803465FC87, 0xEC7CFDF99CFCAF45, 0x00018348791EB808, 0xF0B85C8406E9D6A0,
+0x7D25CD6C8FE8B0FF, 0xB08E07926399B210, 0xAFDCB894215E6D6B, 0x3F05F3580B03F10B,
+0x6B2BAB51F2E5166A, 0x00020B741FDBFC72, 0xEBA3009809597D5D, 0xAC7067FDB65670CB,
+0xDB89DE019AADCDF2, 0x5921D943C201E772, 0x681D921912BADF7C, 0x1D674C94FEF9EE99,
+0x0000757A0CF707D6, 0xBA2ECC0F54226384, 0x5DCE860F1E93D738, 0x37B1DEDF1054AB47,
+0xA93603671633E8E3, 0xEA87BE29B537427A, 0x11DFCFA97F587805, 0x0000EA5FA62E18BD,
+0x4132A103F40BF2DA, 0x314B524E6A5AC675, 0xE1E6D45A426F8451, 0x646604AEB3C21317,
+0xFA3E9F2303F7367E, 0xFC56C554A78DE345, 0x0001A080032C9D9A, 0xF266637147F58600,
+0x98F4850E309DC490, 0x84A518BF66B7AAEA, 0xDA2A1401DBC6C5A4, 0x5C6543660B11D5C5,
+0xCBA191523952C1F5, 0x00012A8F35D54E54, 0x01E7AA8D83F65A90, 0x4F6475BBC7459FCD,
+0xBFCCF92B3588376D, 0xE5F1BAA3F2BADC5B, 0xE97107C27C16BD75, 0x8B79A49CD34B4535,
+0x0000F8CBD08CDC8B, 0xCB2EC639B786FD3B, 0x52F995C21D78C073, 0xFB8B56CF6972F80D,
+0xAAF459B63A69C62E, 0x7999703643C3C512, 0xBCEC16326867F3FE, 0x0000957B04519F99,
+0x7BFE36D3591662D3, 0x07204E460BE3D393, 0xAEE354A50DB94B71, 0x015D4B95C74DA3DF,
+0xCF84811201AB7246, 0x520876DF5EF3AF86, 0x00005FC1C5AC6D77, 0xC17A637CF37BA7AF,
+0xCB59EEA2FF43C1CA, 0xBEA97554C3A73C2B, 0x5060063C143D36A7, 0x97FCD8D7AA59E148,
+0x2CEBD7A700CD3E91, 0x0000C1AD5C035EAA, 0xB895A1A29820356B, 0x8ACEF0A3824E3C6C,
+0x44A66724578B75B7, 0x7643C8E2E941F8AD, 0xDC02262D2DD61878, 0xC2702AF789BC02B9,
+0x0001BEBDC1998A96, 0x6D312F65C66CE335, 0x3EC2CAB6E58F71ED, 0x964A4BAD75D34CF2,
+0x97FB3666DC6FFDCC, 0xDCA75727C950F4AD, 0x02B6CB0EBB50CA1C, 0x00008E3A75794CCE,
+0x6F09866A340A7F30, 0x8896730E2C8F3A8E, 0xA7B511394C3EC814, 0x5AE57675DA472CBA,
+0xDEC2D37914B1AB35, 0x76EF72B663929155, 0x000194786BEFF0AB, 0xD05F53EB1D4321FD,
+0x4A9C7825B688419A, 0xF78FFDBC7528ED7A, 0x83A2C86B8B8AEB16, 0xF0C0ADE93DBDB0F6,
+0x3562B808610DE014, 0x0001FF771DD94884, 0x9C6817519CA08B6E, 0x7749512DCD0BCDF8,
+0x3BD79A2F8918D0B4, 0x7E20B1F530F69173, 0x6A911C03836DB4D4, 0x1AC53C9F91E11531,
+0x0001B40534C6FAE2, 0x0E9C5F72BA5AAD79, 0x952763CC54428B06, 0x991ABACB162BF124,
+0xF7F056B77165530A, 0x23A3F8F842CEA6D3, 0x0B5AF9A783293B16, 0x000045016C33FC1C,
+0x9027631AE2327616, 0x46B145EAB81D742C, 0x462959EDFDD151C8, 0x744215287F5F7E8F,
+0x2DE525B4B18C5BD0, 0x850E0935F6C3E4A7, 0x00023414CCD9696A, 0x2EC1CFF469EA9D36,
+0xD312F61D241C0784, 0x178B2F7A36EEE2ED, 0x44DBEA1E51403D7E, 0x9B3F01CDCCD6B865,
+0x172AA1FD4579F4A1, 0x00015F7E4A928BFC, 0x2E8D10B3AEA8BC9A, 0x647463DE186CD3F3,
+0x2661DDF1A4473AB5, 0xDBD85B6F8D47D531, 0xCCF581FFB5E42DB6, 0x9509F2C99833A222,
+0x00021C2898E62F7A, 0x63F081D42F2BADA4, 0xA6FCEC0A3891B741, 0xA5E2F291FB46C909,
+0x985B6EF373D127E7, 0x7963F3788204A08F, 0xA60C1B118AE1E260, 0x0000837010B291EA,
+0x0140B2E295F06F20, 0xBB7834463D552109, 0x335470DF3F6B8383, 0x7101FE6C8B09A79D,
+0xEF3725FC257699A2, 0xAE271356609D455B, 0x00017234A869CB82, 0x59F0818E44BEFABA,
+0x9FF4113E80A04949, 0x4EDF59CE8905FEF7, 0xA18816271E755700, 0xDF9A3157865F0598,
+0x17F23697FD93BBD8, 0x000092E7488F4F2E, 0x434E68486933C902, 0x03C2DEE7C878D78F,
+0xC2B9186A95511E71, 0x98CA68148598946C, 0xD39A4487AAB1E533, 0xC6832BC830D79B50,
+0x0002280DBE068237, 0x40DD6E9C6AB4B971, 0x12E2D07B2ECADA75, 0x18B9BF280235F6E6,
+0x2E4923E21B6A7E6D, 0xC2988D1615B8F720, 0x0D4B356F354ED721, 0x0001398447257C4D,
+0x417AFBA5EF8ADE5D, 0xF1179A2A687A054E, 0x81F361E1EB5CD177, 0x0FC4947382439D24,
+0xF829F8D64DB58868, 0xDE0546A3496721A1, 0x0001870A72F84D6B, 0x9CCE447049B1C78A,
+0x8CD1658A52AFA8A1, 0xBFC54161F2A29A61, 0x5A7BA4A7E5EEEEF7, 0xF5D21601BD3EE009,
+0x620D4B79F904AA3F, 0x00018D293F982794, 0xB4D9D3ADAF515275, 0xCE66B9236E5F57CE,
+0xCBCA7DA797C51C20, 0xC1C271847E5A20A6, 0x54B544EFC600E69A, 0x5EC883055A4BBC51,
+0x00000A6EB7AEBED6, 0x8FB8337209817F48, 0x3982C03DE62BB55D, 0x112B4B5BFF72A0B6,
+0x7D91B1BD03B4972C, 0xB7DC504E5E007911, 0xB80275556DACE77C, 0x0001D58C795F59CC,
+0x95B05E4405C41384, 0xF493B7D9A2F9B7A3, 0x3110E198B14E33F5, 0xA8D9C45095DF580D,
+0x18AB52AEB01E96CB, 0x42A9B25CB94E03B9, 0x0001DFDC21A9FDE1, 0x4E8F46FE9CFF6913,
+0x4ECB3A7E57455D16, 0x6DE5B7DD684A1B6C, 0x718969A713171B8E, 0xC448BFE999A0AF0E,
+0xB58CF774EB510EDB, 0x00006334C19D30C7, 0x6E54E8B264D63F69, 0x6CE4B0A0A18C1892,
+0x24EE9D148DC907DF, 0xE9F47968C75FC7F1, 0x4AA5DC8B15208762, 0xC89FD0937975D3F5,
+0x000190483A5B55A9, 0x33897D4C609F3000, 0x03BA78903E6B4FFA, 0xF8CE26CA7919E728,
+0x1F56F09C69FC8905, 0x5D58C6889FC50DB3, 0xE9FC35A1CDFDD480, 0x000048C5B07AF246,
+0x52C2EF804F5481FE, 0xEB3DEB794E058B5D, 0x843B8808EEE1E842, 0x0E25C16BDFC855B7,
+0xD96147EF90DA07F9, 0x2C0CD80AFC0A2973, 0x0000B35CB1985EDD, 0x998B8575134A33CE,
+0x4FE7A2A2702DA296, 0x2CFC3D078399C705, 0xC5945849B68AD0F9, 0x13FB5C59ADBD2008,
+0x896D1E43012E7101, 0x0000DD559FA261A7, 0x9F2EB9421735DBFA, 0x6CE5FAC4989533DE,
+0xE26F1D132F8010E2, 0x079C251F4BE6C12A, 0xF037E0C3A890FA34, 0xD0C9350BC8770320,
+0x00018A174CCCBED0, 0x735B1C15C1B21567, 0x03B0D3515F2BC621, 0x91321FAA15C97EC1,
+0x05BE7F9A6BC7F78E, 0x5113850267790CA8, 0xA6740D8149458254, 0x0001A4DCEC79ABD8,
+0x3B8A97361897C977, 0x23135E9AA1E035A9, 0x1FE8D1871A57D406, 0x0D7A1A81F278160E,
+0xDF868D0A6209E073, 0xBD12F85B00180767, 0x00007C198A7B398F, 0xDB4CAD455F609021,
+0xF42519AD3D851719, 0x9BDF55052FEBD6D9, 0xC3F64D34666DF853, 0xD6A91A4CA40F29E3,
+0xE82BFA2EF804AE22, 0x000022745DF26239, 0x98A9B5ABD9D50C1D, 0xB52B873F8BCF375A,
+0x9BD40CA46D0D50B7, 0xF861BA391C58B118, 0x7221AB51AB0DC4B9, 0xE5227AD8E16F4170,
+0x000220CE5310257F, 0x98263541A85D3C42, 0x8CB68847F9228493, 0x3CA598ABC8AAD68E,
+0x0D427EA94506176A, 0x528A83C780A66064, 0x0BAFF24423651401, 0x0001F7D643B4FE40,
+0xD6849E0363576965, 0x29AB9610929C7B1F, 0x0B510715636C35C7, 0xC813C88C5B69989C,
+0x67F7EED57C324E9A, 0xE9B31EE2ED9B833A, 0x000109F14407B20E, 0x42E52BEC3D957635,
+0x80D51BF47926ABE6, 0xFEF8192693D07F69, 0x6FC45CECBBE4658F, 0x00A1DD20B44FD4D2,
+0xF2E54380C6275E80, 0x00003E83F700DEAB, 0xD4BFD706F4C74C2A, 0xAC61787808447097,
+0xA6F069CBEC16F00F, 0x846CB1FAF505C2F0, 0xAD6C1C98FEF9A8E2, 0x3C33CB57BCE7F778,
+0x000150E67F21734B, 0x79EB095A3535C171, 0x34613011638D878B, 0xAC2CDA38094F3E90,
+0xDD7D0FF7040DB7AA, 0x3B92541C80C58860, 0x022AB8DA6CC9E576, 0x0000EC30C0DED1D0,
+0xFE00FB04C0EA9B2F, 0x88C1CAD1B8CFB4BF, 0x69150BA6F04F409F, 0x1B9AFD31F1D5E571,
+0xC68E6D5FCD3D1746, 0xBED0CA774D3C3A85, 0x0000039A2376E616, 0x704D513C4777B9CE,
+0x3E6166B31BD9257B, 0x67C9006F0C4DFFFA, 0x66C990016333DF5A, 0xAAB9AA7CA4B5EFFF,
+0xAC35EA95DC29A947, 0x00020497C6E81499, 0xDE1BADE475090379, 0xBE26B7B8ECBF1EC3,
+0x8D6D5E9A0B8AC1D7, 0xE374B9D1BF06EFC4, 0x243A916D0BF373D7, 0x0FF7AA3C3315F9EE,
+0x0000E10837D14850, 0x46D150631E095437, 0x7AE7F6F936817A10, 0x310AAA3CA3A7F52B,
+0x234DCAE9BF9C7846, 0x3CFB88AC1898772D, 0x119326DF5D8C0969, 0x000048F30D744AE3,
+0x06B83CDA3F663316, 0x3F37810113A4B16D, 0xB195A3DE97815E49, 0x9EA50CAF8252BB7F,
+0x75A064575A1AB31B, 0x32B723AEE4F8710D, 0x00022CBD97CB6BD9, 0xFBB6E201267D0E73,
+0x7B88C7BC2FE7E339, 0x91F8580C94BF02E2, 0xC739C54A376E54A8, 0xB67D8EC5233A4BE0,
+0x4819614BB26CE653, 0x0000D219BBE9FE62, 0xC98F646B927A2C6F, 0xE0BDC70DE265B065,
+0xCC97F43C4DF4F2FF, 0x7E5EA34010A9F4D8, 0x73E3B3B1D6B6408A, 0x1D92417372BAA042,
+0x00022467CD4AF78C, 0x1FCA2858EBCCCA29, 0xC41B1E1DBFC461D4, 0xDB31AFE7C6170A30,
+0x3AE8DF43F994172E, 0x3D919424BC1BD95B, 0xB7C888E6B22BF8A6, 0x000019A65D54915A,
+0xE8D8AFEE96EA294C, 0x63A88B7B76ADD5DA, 0xA5EDE15FB1932402, 0xC3A5792DBC5F1AC2,
+0x7D958FA2C8AE8E01, 0xE809F3A3439158DB, 0x00021E64085BE5C8, 0xA1C9DE5ACD9538A6,
+0xD2C689AF3BD5AB9B, 0xD48C2D8BC9696917, 0x81E5C5A2AF828529, 0x2401CDAE421D0493,
+0xA02D980CC6C01A73, 0x00011EF894817BF7, 0xD2899423DF3C37B6, 0x028FFFD8D3675940,
+0xBCEBAD1412C80362, 0x3277D5D5861DE31E, 0x94435E6ED0665356, 0xD7F4EA24139B9751,
+0x0001AE4BA06CCB5D, 0x4B5CBC43BEB6A952, 0xEA53F2415E1C33A2, 0x25D19963D52290E1,
+0x88F65017CDDC68B8, 0x385C2C0267E9DD7C, 0x98231A24CDFE40FF, 0x0000B78FA5735ACB,
+0x62063120F3C75B44, 0x6AF0470D9F2BA6D4, 0xA258D7280D1BA90B, 0x0F3D8F888B3D3823,
+0x443353C99ED8CE53, 0x114D5983EAA58FA8, 0x000153451BCB6036, 0x4442DD49AC7EC0A7,
+0x45068DE82F9869DD, 0xFF48B14777E08E95, 0x43E1E54DC250EDE3, 0x313B39FC29E34931,
+0x5B6CA28A6A7EADB9, 0x0000F0197AD42B3B, 0x628BE13D9AB236ED, 0x209654EEF5AA8A34,
+0xF0132D15DAA86532, 0x6ADE501A6DE9BE96, 0x478673513DA6D3F8, 0xA64CF11BDA95C271,
+0x0001D51DEE6E747B, 0x244825F43E5A61FF, 0x65C10C65C1E1C288, 0x03B62F6A85482EBE,
+0xE1A562EC782876BF, 0x8D8140008F50B3D1, 0xFA3018E3AB32D2EC, 0x0000D9C1FD426C7B,
+0xEF56F6ECA395F9F5, 0xD26CCAD3D8E32E97, 0x6CCDFEB240286D79, 0x346ED49ECA1318CA,
+0x72F9BD9A4ED36CCD, 0x8F5DA5CDC6E929EB, 0x00001606C78C6462, 0x4081297E0E705267,
+0x7A98A64FF379C206, 0xB1ECA1D8F6E8780E, 0x786B7E34C6437597, 0xD77FF2E1FAE7E3E1,
+0x2DBBC4570E8B1D1A, 0x00020F0378C37889, 0x9F83E5A200345126, 0x0CE9A30AAB651F9E,
+0x0FC6014D0949E166, 0x1C527C5711776546, 0x2182627A6520E95A, 0x398A2BB3074B67C9,
+0x000004D2F736A8DC, 0xD969D06099B60DB1, 0xFB30D0C4DA854F6B, 0x8BF48EB9A74698AB,
+0x542FAE7593F3912B, 0x5B9FF54BDB50637E, 0x1BD3A411CCDA024D, 0x0001BEB45594AFB9,
+0x5125C4F476F7A732, 0x65A54A1E10FEA4CA, 0xED146BC2F8FEE6E0, 0x5529165426CC0EBC,
+0x0220995818556BA2, 0x8F160A10B04570F0, 0x00017F08E064E7C9, 0x88B4F7F0E6DC7731,
+0x768FDD550BC64CD2, 0x4117AFCA896FAE7B, 0xEB028745B6B039D8, 0x944E69122C0E0AE4,
+0xF0D1DFD591FF2353, 0x000173824BE6FE98, 0x50243C0F1897A804, 0xB9F82D973FBB1494,
+0xCEA8F072F8A384C5, 0x49A79CC1CC09426F, 0xC9B0AB93710191FC, 0xF453BEF1DF52647F,
+0x0001DD90CA4A3A40, 0x8F6617281E6CBAB9, 0x02C67D1937ADBD18, 0x317CFA265DDC3C5C,
+0x57FA4D425FA9DF45, 0x10D487CA626382A8, 0x6BDC7D1810776B6A, 0x000152BA583779FA,
+0xB8CBDE1B5F829D75, 0x3EE38379E25D053E, 0x354EB38A387B0117, 0x9DCD26ED67C6D6D5,
+0x953C1C5DB8CFA0E9, 0x7803128A1DA268EE, 0x0001B6A0D866BD47, 0x0540FC0E83B00EA2,
+0xC626B76C56673A50, 0x8218791B0FD572DF, 0x31DD8E88CED81237, 0x673FD25B7FBC640C,
+0x2D15DF558B80371A, 0x00003FF0E83EBEBA, 0x62A4E6D46C9AC492, 0xEAD28D517163D84D,
+0xFFA910BF6BDBF8BF, 0x91DFF909323E32B6, 0x4E8D95B0C36A2869, 0x614AAE21E9558161,
+0x0001E164D30C7076, 0x9A72C37922A6F790, 0x35AEDAC2C4D079AA, 0xBDAD22A722CFF956,
+0xC062CBCD4686C43E, 0xD56CEE01E4472015, 0x059814624C3813EB, 0x00016DF3A8AF7B4D,
+0xDBB2626160221F81, 0xDD9156E94C7494D9, 0xD51A25B4CECA4C22, 0x82A91ED841CAC411,
+0x11B729E577FCBEAF, 0x7EBABA1E0B9C1792, 0x0000915D356A761B, 0x73749A12BF58A014,
+0x66F140F9B7576A4B, 0x31A7B238713508B1, 0x32E59987F068B168, 0x898D58F5CDF1D3D0,
+0x6FCCD92B5100416D, 0x0001E5420BE53992, 0xC511E968F3E3F5ED, 0x02C6236A0D152D3A,
+0x06B7F2322AB6D161, 0xBFA38A3521FA5ADA, 0x89E5EAD7DE346735, 0xE058EAACC90A43EC,
+0x00016EE6D59A8E91, 0x64AD375A2EF15890, 0x6EDFF357B11D2B1C, 0xFB2CD2021C94286A,
+0xFFF8C23416034271, 0x8DB8A552835CA097, 0x635FA0219A60A91C, 0x0000981990858C33,
+0x74C6A7B1945DE91A, 0xBA30010083CD5FCC, 0x0549BCE3AA4586FB, 0x33D083E4F4EFDCFF,
+0xECE40912B42A20F5, 0x0CABFC6FCA5A818A, 0x00020E54C344D3D8, 0xF7761C81916B8246,
+0x03BB390155EBEF93, 0x5F91B8C7B3D7E060, 0xF62FB5322E8A85AD, 0x4016AA503180F2DD,
+0x42B674B9257F6E47, 0x0001C14A6618A9AC, 0x4CFD7CE975F0915D, 0x44F97A7511E9C9EE,
+0xB3D33C8DADED2011, 0x1AF85E9923EA5BC4, 0xA42C67E1E40ACDC3, 0x2EF2F788F3A856EC,
+0x00001306208CCF87, 0x63CC06818E97246E, 0xAD4D38B21D63AC89, 0xB48703860E3AB4ED,
+0x549EFE094AD24645, 0x7B1EEDEC0932BBA9, 0xDBEEAE92566B8CC7, 0x0001B5BCF10C0792,
+0x2EC0AEB8771F268F, 0xA84F34EBA887163D, 0x1014F6F2ADA4457A, 0x88205AFF2E3F2366,
+0x6264E68FE1D8C223, 0xAEAE02DC1A0D023A, 0x0001DACBAAE1C206, 0x3DE0EFD9800220C1,
+0xFE6AD1B34E04550E, 0xDF6A0189B80E7A39, 0x98CA351F4DA70AF5, 0x86B2063DCF2F3E37,
+0x1FB89BA5D1A9D9FB, 0x0001E28B158EFD06, 0x3F4342FB4917BAD9, 0xAED3E9BBDE895F64,
+0xCF34DA0059C86989, 0x3C2D2E08E00B9277, 0x48ABAD40CB98E326, 0x02051B3E8867D9B6,
+0x00012C1440D9A158, 0x9D5091BE9EF48631, 0xB502B1189F4A4671, 0x1E0BD04C72643312,
+0xF79F2FE9EDC99FCB, 0xC9DF0B8A219B7390, 0x58E243682B2E7309, 0x00014DF70ADCE812,
+0x9C92609739FCD519, 0xA51350BFBC4ECFA7, 0xBC93212248AE545D, 0xA90CB99DB015577A,
+0xCB209D5EC575E837, 0x51D53FBEBC4A186F, 0x000000922D147B8E, 0xE0CA727ED8EA352C,
+0xFDBAD111416F93AF, 0x8E79E7908EC087A2, 0x33B328F5CFF9FA00, 0x2A9973A28018B92B,
+0x99AC454BB7E038B1, 0x000129EF60CB0B0E, 0xC580D0BA9C4EF14C, 0x025555A17E8D5209,
+0x31320AC61512BF10, 0x4CA81EF32D2638D3, 0x245736E187DBE791, 0x4EE37F7BA4FDCB6E,
+0x0000DC02C41901A7, 0xF5E74FC92E5EDB36, 0x4B83A386F7AAEF23, 0x2243493BDA652D74,
+0x052DC69396C1735E, 0xF192544C24DBB511, 0x5893ADCEC523E9C7, 0x000145D54DE1D6BD,
+0x233E3C665F800B0B, 0x2B6B412AA5438287, 0xA41FDEF2EEF0C731, 0xCB067AE91F07DF05,
+0xC957424D26677788, 0x8103C3FEDD721025, 0x00015BD764CE2DD9, 0x1813AFBF2A0486A0,
+0x389A8A76F9E34322, 0xF7C1DCF967A1F26E, 0xDF3CC03B974F8414, 0x29CB769FF8519FED,
+0x0CA50DEE9BF65173, 0x000021E298F4C5CA, 0x246395CA0F769926, 0xFEBDF38372A98420,
+0x18A4F720A8CCC9BD, 0x71D24B79E69C3614, 0x777A2D6CFDCF07D5, 0xF1F4A1CD12654C1D,
+0x0001C3EBABA316E7, 0xBDA6E5DC1319D36D, 0x91C2E83956CB9361, 0x2A0C66283F8AC690,
+0x5F03799244039053, 0x0E5C3FE9A7071E20, 0xE72444FBE07760A1, 0x00022407230E71A1,
+0xE445273DA3175C37, 0xC195E53D9F93746F, 0x82809426CECB0431, 0x723EDF055A76CFAC,
+0xFA6250C90A88EE67, 0xC3E4B06DBDAB337C, 0x0001767C489B94D1, 0xAAF5C31891F39E24,
+0xBE1FBAB0C733CA5B, 0x46C3D93A41AB98FC, 0x46ECBAE19028631C, 0x13854D5D79CF73F7,
+0x6CAFE238018A5532, 0x00021EA8D696045F, 0xE29B783D287527D0, 0xE105DE8C4ED9A33E,
+0x3BCA7EF5A77C2FE1, 0xE52B8233EF92D9D9, 0xBE8D4264E52CD93C, 0x875D30593DB6A72F,
+0x0001C206F70A3D36, 0x2800C244704FECC6, 0x72F6C67DFFE44FF5, 0xCB1AE282DBF5221D,
+0xD41EEC1425DCB36A, 0xBAE30B87DAFC3775, 0x9B853230F1019A2B, 0x0000D52B4A0161FB,
+0x8FD003015166786A, 0x1FC559CB444CF207, 0x615A8191D2F13935, 0x8CE3976991F615D6,
+0x4F47341551EE1C1E, 0x35F5E6969E45A164, 0x0000C591C0116675, 0xC6B34A872377703E,
+0x203E61FA14AE41A1, 0x374A1DBE9B96EE26, 0xBD689ED391A68E8B, 0x2DA1EC8174066FCD,
+0xD9AF2400DC74474B, 0x000029937A605904, 0x3C3D06E87EE8D9E6, 0xAF6DBF127B68CA5B,
+0x941931FB3AA88ABC, 0x53D3C46A5FAEB844, 0x1891C325ECB96911, 0xCE215B2685701D8A,
+0x0000A97FBB804233, 0xC40876AEDC8380A4, 0x0A17549ACE517FC7, 0xB7DEF3439D40E74D,
+0x32308BFAB3B965CE, 0x6B52A2E758AF1A6F, 0xDAA43B9CE5662B67, 0x0001B4E80762F532,
+0x71F0C0D337D1591C, 0x3E0ADAEF91D6DBC7, 0x93770A8F075DD973, 0x69109CF60AF7EE5B,
+0xE59C01C44A8BEF75, 0xC9A777156F27E22E, 0x0001E9E2FBB8299A, 0x21F6C2C7AD8BD64C,
+0x25507C7C87159586, 0xAA5CF7C5AF66F802, 0xC2039AB8965D901E, 0xF136FB0FF32E4936,
+0x00354547B2E64419, 0x00013351A34F1073, 0x3D443CA1714EACED, 0xD064AE0980CF5B07,
+0x5DFC1FDFDE9AA8AF, 0x2B91D0DF42C32BA8, 0x56BDF06B232C29F3, 0xB0F8DF3F9B3B3E17,
+0x0001A421D2AB6352, 0xC4001AB18F0407CC, 0xEC6269FF7E3E88D2, 0x2C5DCABE170AF27F,
+0x3F6FA1CD90073DD1, 0x0C62FB51633AF6A4, 0xF79B126829D0335B, 0x0001C88E98710E1A,
+0xFA5852FB5EDBCCA8, 0xEE24E0AEF6296084, 0x7FD512FA26E97F92, 0xDFD83C8E2FD10811,
+0x94925AFE8F0A7A9C, 0x109A09C57D2C284E, 0x0001789769F5AA96, 0x2349A67D8F933FB7,
+0x607786C468DD85E2, 0x061D3A7B8831C22B, 0x89CDD82FE797423F, 0x78FD935BF8B50833,
+0x892A8C6C2E317BA9, 0x00015B3D9F4FCAFD, 0x2DD8C39D1D9D5026, 0x0B4A6E29B7698EDE,
+0xAEC5EDBC2D793C58, 0xC59E0CDD76A769F5, 0x86D705B5A98D4303, 0xE6074FA20C4F3DDD,
+0x0001EC9CD3248375, 0x1C1EF17FE640CF3C, 0x390D98A06AC6F17D, 0x28B425902CE62195,
+0x1B7900F51FB3E221, 0xEF7A3474F51FDA10, 0x282337783E8076B7, 0x0000455F178B160F,
+0x68D3CBB5A6B4D773, 0x508A2D700472F1CB, 0xC4D459F34691468C, 0xEE3EF6C7A0902D8F,
+0xE0BE37ED9EA22472, 0x4BA4D5FEDFB146A5, 0x000131D8CE1514F5, 0xDA1756318E7442EE,
+0xC82C4C6C12AC0207, 0xB6AD116B8E789823, 0xE6B657BFB0208758, 0xC1B34598EF371F25,
+0x272C2A88E809F62A, 0x0001FA42C0B8C024, 0xCCE4821D01C3EDEE, 0x9ACA6A9D2CC37173,
+0x4D5D158021BB7709, 0x33CCE9C9740CF16B, 0x8FB94A57808AF2FB, 0x4E43DC26A51ABE39,
+0x0001842E4FBEA26B, 0x9A18151EAB5F637F, 0xCA02A4719DA016F8, 0x6C73826A4D49252D,
+0x137689749C1FAF65, 0xBCE34D7042B1C404, 0x5BA2CC14ACB0A7F0, 0x00008CE60AEE4601,
+0x2481100081F9211F, 0x47466AE5646CB963, 0x616EEF26DD30348C, 0x4FF889F401E5B07C,
+0xD2814A64702D21BE, 0xB8C05EDA6F9D24C9, 0x0000D4715D10F42C, 0x9A416FC9400CFA29,
+0xDCBB79447BBAEF25, 0xD7964B6E50956356, 0x91DC2D45F6EAF092, 0x0EF7A16CCE5F8D9C,
+0x595AEEA50846A5F8, 0x0000696B4C1AB218, 0x6560CB53FBCC180B, 0x6614D961FC93BE5D,
+0x3EC9AE220231BEC1, 0x6E6490936F5374DE, 0x917635FAAC01D3A2, 0x2E5A86B6AC2EFD74,
+0x000112069D14CECC, 0xB00CD555A2BA9348, 0x8184DC7CCC9EC91C, 0x167553DC4A550F24,
+0x66129C563D2D57BC, 0xD338496E76917369, 0xAF3F1159303F577C, 0x0000157C19AF0BF9,
+0x2937402EFD1E1937, 0x29A3B8D71508FE18, 0xDB73742EF7267763, 0xB4716EC7B3171524,
+0x55C70F33C7B8666C, 0x4F221ACF018C65B3, 0x0000B5C525BE1AD3, 0x0E2CE6AB7123D61A,
+0xDAA4F5B12403804A, 0x3F14DDCCDA46F59B, 0x2F9639071833DBCB, 0x95EAF6F596E9DF1B,
+0x1A07EAAB9598CAEE, 0x0000C08C244B9581, 0x758F22C4E0EC6CF0, 0x1D87E2FD7AE35441,
+0xAA2D0A642DAE7A33, 0x71E9B6D33543C8F0, 0xA7FC0D879384D800, 0x3F2A357D108FD6AE,
+0x0000A6F90C2AF1BD, 0xE071E191288FF819, 0x600C38D4931523AF, 0xCD990BF771525420,
+0x91FD383C0948720E, 0x8BB486881EA424FB, 0x0ED2B6A1CD1CF643, 0x00022DDB598D6DB9,
+0x7DE7349165202FCC, 0x2038850A9E8B2B48, 0xAEEDA66646A54FCD, 0xC953F73F9582E1B0,
+0x5B36FD70616F6E93, 0x4AEF7E82ABE9DC52, 0x0000F1439E226D0D, 0x3335AF6DF8CCA8DF,
+0x2DE554C7414B6CC0, 0xC65FBF70B4EEB7EB, 0x1C5DC90AE77951A1, 0xC39881E45000BB7E,
+0xACB2D3B103F8D085, 0x00018E17D74E8586, 0x3D6B3E4E0846B1CF, 0xDE2DCE7DB819E323,
+0xB795AF16125DD6A5, 0xFD8A54BD8250F44B, 0x9B1EC7B8FE83829F, 0x1AA36BFEC3AF308C,
+0x00000C58AA83294F, 0x70C593DF0B6AD8D1, 0x08DE5C5E8C7CF17B, 0xF7BBFC8AEFD2B2B6,
+0xB4A17AB64EAE8671, 0xACBF30A82EC11A0D, 0xFCCE7B305657DADF, 0x00019BCD27BA7314,
+0xD0DB1F7E78E06E66, 0x912E45BC9FC1D0F8, 0x5F4E3E6F61CF3C65, 0x3D3A47AF40C65200,
+0xD5FDC7FA52E86781, 0xEFEFB297EF2421DC, 0x0001EABAB96BB9E8, 0x02402B6B572432A7,
+0xA07D99FC30D3D793, 0x0256998C677DF94B, 0xAC17AD7A2BE82D8A, 0x08EA659B89D683D3,
+0x903C5959B273D0A6, 0x0001415C86175DFB, 0x8541F7BB9948D22E, 0x4D7BBC02372F3AC8,
+0x38E434D3E769A27D, 0x8F064833E636E00B, 0x60A3A24E1B81A7D5, 0xFAFC057FC6B69D62,
+0x00007153C696760A, 0x2D3BB1D32A49AACD, 0x7D1E20B79DD49E7D, 0xDC2380607B0102FD,
+0x9E584F8ADD1922D0, 0x025743AC06072DA1, 0x3B2FF06EAC832FC8, 0x000187C06C815287,
+0xE95844417716A60F, 0x884271F33F85C1B9, 0x195181C8EDB817DB, 0xA0656F7C33FBAF50,
+0xD18242102948C2EA, 0x07242C3CEA34647B, 0x0001EF9278A393BF, 0xB467A08F3D77DE16,
+0x99B69259A504DF91, 0x12ADAB68A54150E2, 0x2BB1E1D6924CDBB4, 0x2244CAC4D1A912D5,
+0x12A84D3A26506C6A, 0x00013CB26369C398, 0xBC404EDA06ED33A3, 0xA9C5F22BBD4CBD08,
+0xFDB5B337C0E27721, 0xC84DBFB9823D8622, 0xD31427AEC63DBA32, 0xB2C32C9F475DD3B5,
+0x00014D4E8BECF249, 0x8BFCE23B4308D509, 0x6385BE26FD5D18F5, 0xF885979ED5EAEFB0,
+0x3731A5FF54C085C4, 0x1061F84CB7C79917, 0x08BCF368336D963F, 0x0000D11F004872C4,
+0xBDFFC297A3A2C8F8, 0xD7F554078D47844C, 0x2E96824E5DE187D4, 0x1B7CFCE7DA7DDFC4,
+0xF4E546FB68B9FD02, 0x84ED13D5CC83E5AD, 0x00009496D5183F66, 0xD580D8446DEE3F6D,
+0x82AB728BD0E5E6F2, 0xE457D2AC5FDDE8C4, 0x67C015AF6B83DFA9, 0x37002792E18AF9CA,
+0xBA2EC3D9DBB9D6F6, 0x00002EEC1F0B242F, 0x4784FEAE0488F43D, 0x3DEB2B231843DE34,
+0x33B99BB0809321FF, 0xDD0ED7ACA226F172, 0x46BA83C04C83509C, 0xACC68DC27F4A2B5B,
+0x00009C743207234A, 0xE7101404B50A3358, 0x668FB1CF68155D48, 0x79AB4B8D6B2A167C,
+0x24C9E7815EAE2714, 0xD10501724AE92A1C, 0xD6A9BB317B2D9A45, 0x0001377F2B0EAC12,
+0x1E5F9E509667BC7C, 0xBD69E1A7B752481E, 0x8CA536FDEC854841, 0x1EE61ADC8D4C38D4,
+0x8818FAC4595F554C, 0xACBA77F8954DCE9B, 0x0000A5CAFB6D4CA9, 0x1907E2D6A73CB8E1,
+0x04A72E9D52C6A1E8, 0x60D131232AE95D0E, 0xEF91336261953ED7, 0xC14F792DE0D18732,
+0x8532E7241F482154, 0x000120BB7617E00F, 0xB58F224FC65A429B, 0x06223EDBF86BAA66,
+0xE76B6646C81E4626, 0x61B5CC87C7F2C657, 0x5ACE92F7BA1789E2, 0xCE675F38A1212650,
+0x0000F7AB920C1FB1, 0xE1F4FF2CF0933460, 0x87603E5B02876369, 0x9EF7A6C6715F2D7E,
+0x8B52042DFA06358F, 0x90779F32EE81992D, 0xA087F824D696D958, 0x0001F1662EC66502,
+0xDD10313BFBF69A7F, 0x80F64FDC27069560, 0x6852990F85C655E4, 0x704DB8020D29889E,
+0xBD130688F415713D, 0x1E8C7FB2906627E7, 0x00016B8723074E91, 0x21A742E7FBC1FCC1,
+0x7FA922506D8C0027, 0xAE8CBF4F42A9153B, 0xD7F86559B5D247C6, 0x875B170E7222BDEF,
+0x3597E5536FA356CD, 0x00008C4565932EBD, 0x321468CBDE4041C1, 0x7F677D275562FB33,
+0x33CEED53B16E8ED1, 0x1E09C4585211A813, 0xDDA062F26FD85EFE, 0x0F101FC85BEBAADD,
+0x000143CB79A26E4C, 0xD158042ECD7E5D7F, 0xB0EFAB4BD59EAE9F, 0x778E870CB93B0E2B,
+0xF416BE1C42274B27, 0x20A7CF51A83B878E, 0x7E6EBB36D94857C2, 0x00000DE7AD98C7BE,
+0xAD83CCE48E69794D, 0xF6FA5DA86B161246, 0xC272A99ADFDA05F2, 0x9CAB104457F6C701,
+0x7D77CCC0D607042A, 0x7207F0505E9E0DC9, 0x00017AA03685F796, 0xDD0B273449238715,
+0x0BF8FCCA5D088D1F, 0xB9FEB79A5D7EC4E1, 0xADA1C72CF08130DE, 0xC75CD53CA8D082C5,
+0x40C1C0B11DBE295D, 0x00015EF655E693B7, 0x220AABDF3A23ADAA, 0xF71C21A485121C89,
+0x6B21E85DE7F26919, 0xEA669C4F6D6B6A6D, 0xEFA2ED27FB7B81DC, 0x3863698585BE2EC6,
+0x0001497621554940, 0xE40B4455A304D6DB, 0x467E3A68A1FFC9DC, 0xBBB73360630B89CF,
+0x429CCD81A069CF1D, 0x6B14ED6A11CA0072, 0x781CE4BAB898D8F8, 0x0000EF88AAC31C20,
+0x7F8AE15D6DAF1AD7, 0x4B87A16E58865D98, 0x11B7C4C982C4C679, 0x0E7A0774EF487FDB,
+0x80930439B11E9509, 0x539411F0181730CC, 0x00021C19EC9B8136, 0xCE010461349258E9,
+0x82DBD679F081DBF9, 0x572A7D101AD056C0, 0x0BF2A9FDABBE92FB, 0xC2A9CBBB5208B4EA,
+0x35D86DC9DEC73B79, 0x0000DE17BD080D83, 0x8A97DA94F4921A2F, 0x29DF35D019D0106A,
+0xF8D5274AC606E4B5, 0x4198346759F04AB1, 0xB026CC622BF368EE, 0x256A8420CFB06CFD,
+0x00003A945BA8D9F2, 0x4375185C2717301C, 0xB120D3C15D0E0CC4, 0xFCD08D9DFB2A334B,
+0x530DB8A88ADA3A1A, 0xC420D7600456872E, 0x54855EFF48A1CFE9, 0x00022CD4023A02E8,
+0xFE038E910DE3972E, 0x6FFBBB1CFA8D4AAA, 0x5FB7876B13ED0920, 0xF6C2CB069144559B,
+0x85CD1AC6B30B209B, 0xE8741CD6928F4D7F, 0x00006074DF4E82BA, 0xE2351F98C5604846,
+0xA4C3E6A1A58839F9, 0xA1F92B8F9ED256B1, 0x8C3E1F4500481BA7, 0xF16F076B00F1765C,
+0x29F6E6BC27DDB64D, 0x0000E6F3F584E809, 0xAE6B4FD173EBF862, 0x347F9C15F5AEB048,
+0xAC309CF616E22E91, 0x81773910624D1D30, 0xF098780E5B68A8A7, 0x50D074D33C12EF26,
+0x0002285162F84C8D, 0x62BFE5C89E2C7FB5, 0x5072E019B795C0DA, 0xD0005701C1DEADFB,
+0x7645D6DFB3C1CABE, 0xC9AC948514CD5C20, 0xEC596F809C81D71F, 0x00011DBB887C731A,
+0xBE8136B658ABC29D, 0x50BF992224B15EB9, 0x8BD3882C26662EFC, 0xD4C98985E4F5F6E3,
+0x46D3793E998F2C2B, 0x20B9591D6978A922, 0x00003F5A4E5655D6, 0xDB650FAB73046B37,
+0xC377FA2C919C12D2, 0x659922337193364B, 0x51B425DEB3DE85B5, 0x56A7C9933A464646,
+0xD7228207B494CDCA, 0x000162BE160E5081, 0x8CB8272801DA74A4, 0xB9B027C6D98FCFE1,
+0xD4BC445BD5EF088A, 0x088D76FA99FF209B, 0xCC99AA9087E626D8, 0x0C6925257C89A1D6,
+0x000021F2F3924FE0, 0x11AEF3911A8B830E, 0xAE7C22F141C0FB3D, 0x2A5750A1DB78EDD9,
+0x9AB4807E4ED248E6, 0xC68FBB59923346D1, 0x2F1CD0DD00287684, 0x0001B2059CFE17E9,
+0x9343064674EFDFC8, 0x4965730EE4662423, 0x09488E2365B16698, 0x5B81946BC90D76FF,
+0xCF68430DABA73BA4, 0x4F643A402E7E50D8, 0x0001FC6998105E45, 0x7E79FA9C7FC8A5D4,
+0x3F1108E210D8669F, 0xF51781377BC51641, 0x8CCE069BE4CC3821, 0x054287602FA289AA,
+0xD426B33E34A434BB, 0x00013A1A454A71B8, 0x7ECDDEC46E673107, 0x9783471FF4E7A6C2,
+0x14E1CD42114AAAD8, 0x349521D75AC7364B, 0xF135CBCD67B8AAF5, 0x7EE4F504D46D3CB6,
+0x00010209DD8DFD09, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x000000000000742C, 0x0000000000000000, 0x0000000000000000, 0xB90FF404FC000000,
+0xD801A4FB559FACD4, 0xE93254545F77410C, 0x0000ECEEA7BD2EDA, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000 };
+
+// x-coordinates of [2^i]QB for i = 0, ..., (OBOB_BITS-1)-1 in Montgomery representation, where QB is the generator in B_gen.
+// Each entry is an element of GF(p^2) stored as 2*NWORDS64_FIELD words.
+const uint64_t B_gen_ladder[(OBOB_BITS-1)*2*NWORDS64_FIELD] = {
+0xFAE2A3F93D8B6B8E, 0x494871F51700FE1C, 0xEF1A94228413C27C, 0x498FF4A4AF60BD62,
+0xB00AD2A708267E8A, 0xF4328294E017837F, 0x000034080181D8AE, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x79490B6383109E7A, 0x2ED3D6902924A34A,
+0x0ACE623564CD4636, 0x88413949CE982509, 0x2A7192F03C92915A, 0xB588741B201D4A29,
+0x0000DD3D75835648, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0A38686B43C9F991, 0x4BA6334435727530, 0x32E6EBCA727062E9, 0xDC795C9DDF16DB0E,
+0xDE24DBF8B86BF440, 0x0FC4C76510C73A34, 0x000039FF77E6172A, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xF7154F28C8CD0080, 0x93244B75A58D012F,
+0xD276D8AA606C0004, 0xAB0CE5B461E20215, 0x5562CE3CEBDCEF2C, 0x2D8C740E3022DF4F,
+0x00000A8F15501E84, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x1EEA5DC3267038B6, 0x4FE967CAF82FD44E, 0x7221A9093A675B14, 0x5E14D5F375F8E072,
+0x866BF28ED73DC7BD, 0x62B957700DE5D302, 0x00005EE66A25F67E, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x566F317203F4793E, 0xC489633A9094E611,
+0x9113E037833D3401, 0xB60BF1D0235E7032, 0x1D9DD1049F61F787, 0x7C63F228FAF8E3E4,
+0x000089C79A5A715F, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x59C39BB668BB0AAF, 0xBA771B2D6AC74AB1, 0xD2DA223904B57CD4, 0x38DC3C483277C277,
+0x163F41B38FC1BE1D, 0x0817C523077697D6, 0x0002126D6660FD4F, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xDA6942422A42321C, 0x8B1AE46C1C5154A0,
+0xC6E4C4AEF4B8DD23, 0x9B16B8D947B4F9F3, 0x944B8C43ECF420A0, 0x962444C0A55F9B49,
+0x00013BBAE19C637F, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x408735E92CE3E13E, 0xEDE7F0801900F0E7, 0x7B8667438112BFEE, 0x97BB0F4180BDF64D,
+0x845360213C5C9DD4, 0xDE6939B741B8772B, 0x0002160BA930902F, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x3A767EC2863B9620, 0x093CB0B88572BA85,
+0xD418C16A0646B80A, 0x8F4EBBEC7637C47A, 0x272354C6D14E7518, 0x91EA67B73576C6C3,
+0x00010514B4B0C00E, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xA9DB8827FB7BD92C, 0x6DB641C456541A46, 0x4BBE3C2A8631352E, 0x9E0A3B7E623BA088,
+0xA18B3BAE011EA5FF, 0x9EC6C2DF027268FC, 0x0001F48262819427, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x1CF669B183C4E673, 0x609A703EAA16160C,
+0xF80C3CD84BEB2112, 0xDDC026E9F333822B, 0xFB5BEBDBFB2D6DE2, 0x12D5825D3DF39116,
+0x000181A98DF2F2AE, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xF7ED5F811DB19B22, 0x1ABC582133B8A265, 0x111EDC3F55D6AE9C, 0xC8E92DFE0D550F3A,
+0xDA6D5FD2072181E3, 0x97A9A854953D783A, 0x0001593EBE025419, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xB05C935B928091C4, 0x09F54375436F9BAA,
+0xF005D681BCDFF242, 0xA276BD7B2C781A3B, 0xF10D9499E85593E8, 0x4CD06D76E6DD6601,
+0x00012EEF5D31B6B5, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xA5E83A97FF539A27, 0xCF0F48ECBF2DBE1C, 0x95142975D990AD1D, 0x9BCB953EA37CE8D4,
+0x4B44B62FE9020AE0, 0xA2976365B1F37A8F, 0x00014613CEDC54A5, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x489BDA04DD21D0C2, 0x33CD42EDE9CE8A21,
+0xBB95F53C9AF17A45, 0x09B62672FA5E3978, 0x3550946DFE141D18, 0x7B2B28357CA19908,
+0x0000B293F9DF5FC0, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x11B7F754E25F848C, 0x35E75C1783C64D47, 0x452E4279B1210CF0, 0x8430406C6B22C581,
+0x7A7174485EB5CD48, 0xAB8CCF18A6F953F4, 0x0001E3B37BCC8042, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x098D568CF80EA622, 0xB9996BDFEC753FCC,
+0xBD01CDE8FF8FA8CC, 0x023523674C579F55, 0x498D140CD4618347, 0x381F1DC0F2514055,
+0x00000335342AFF7A, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xE77B8F0834EC50DC, 0xBEAFC84053B287F7, 0x4D220FB8BDD68800, 0x56500A118262A40F,
+0x62625348CC244D8D, 0x0AA5A5D482C010B9, 0x0000ED30307F6BB4, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x2A655E4C36727C21, 0x08BA6E1EE3249B03,
+0x8FB85320E35EEA0F, 0x6A4140162A269E06, 0xDCA92B77560C85A0, 0x68CA143E4E0F4375,
+0x000171BD65747461, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x1047F10E0EB98B13, 0x5CAC4A37283E2A9D, 0xDB32B18AE3E5BC6F, 0x10A4EC56B988B968,
+0x60E4D86D0E1D2E47, 0xD00A3FE64D1A756D, 0x00000CFA2FEA65C8, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xBEC62E8F2760B88B, 0x77B1F00FF713995E,
+0x3839CD5BEEF21F48, 0xE16DE325608EB031, 0xDC3C869DB1CA89E1, 0xF45C207EE962D343,
+0x00017AE56D20CECE, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x90D56E062F3585D4, 0xCB2056D4982DC28E, 0xC85B49684E9F5E64, 0xCD3E7596F7992604,
+0x46A600134D6922A1, 0x873BA76ED7D41805, 0x000155E651176142, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x52E3B3D00B9CB763, 0xF7EAB321BD19435E,
+0x0EE7D581F3AE442F, 0xB49B80A74501110F, 0xE40CDF0DA23F1A9E, 0x1A0080DA382DF6AB,
+0x0000FCC1FB293F37, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0097855E7E4EA10C, 0x5C9DB84B6ABE88D5, 0x56305F2E98BCFAC5, 0xD95E66EEE645CEF8,
+0xD81B23277133670A, 0xEAB39A81AA7287C6, 0x0000C921F3CA3269, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x358F34C0275CDBD6, 0x82EEA8BE0DBE6F5A,
+0xE60D2D3B11A473B5, 0xB3E0BE4E60118AF2, 0x5771459A0C832AB5, 0xC9A525CDA1E19536,
+0x0001B932949C3C20, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xD217CFA2A8D76E95, 0x32859AB6C1741311, 0xB8F5C52A3D534E01, 0xAFD9FE217D443368,
+0x6CEEC4190421538E, 0x42D9B0B3B5549147, 0x00003C7E59CA8A85, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xA3C7B84732168628, 0x096F5740108B3532,
+0xE8A4EC17BA82308B, 0x1C87D3037D367C6C, 0x6BDAAD212A2B2452, 0x31B6410FD9520D9A,
+0x000005F55587D0A3, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xED7A00CC508F2107, 0x65008C96785AF9EE, 0x6D4E578F697F16B6, 0xBF4AF380A96FAF14,
+0xD4CAE9CD831D3679, 0x757918A6C661978F, 0x0001D03D5EBB8F3B, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x6328561228A2A3AC, 0x29264898C8D6CE92,
+0x6D76C1FDDD97E8DC, 0x64F822064CD4B11A, 0xCA2E6D54D83128D2, 0xEDD5D4F93B508586,
+0x000015D0A0A3D30A, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x311682F0EB5F75D3, 0xAF00773C0871F8B2, 0xD45129395623BF0E, 0xF5497EF21B4EF349,
+0xC0A10321A68297A2, 0x0C16635E2929F090, 0x0001CEB9E7347CC7, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x3ADDC29931624C15, 0x08C7DBBD05F6B751,
+0x9ACC4D93507AD30D, 0xC9C634A6099B2A99, 0xAC90F49B8DA5B104, 0x254DCA2FDBE1F7C7,
+0x00013B4D54466FF1, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x97E59A49896D4EBC, 0xF5F6ADB6B5D95893, 0x066D977ED8982A64, 0x31A0E02E13EB6DB5,
+0x2B88950979602CE1, 0xEF33958FCBC69FC6, 0x0000C24905C17699, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x542294AF1DCD8965, 0xE5880827F7E1600F,
+0xB1EA2E5ADF28B881, 0x027E2D081B67F71F, 0x130FDC357A80604F, 0x9A008C31F4ADB062,
+0x0000868182E69FE6, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x306A55A59F20A9F6, 0x00C87312C495D2AF, 0x4351AD37CCCF3A2D, 0x63F7E54F3E5ED98A,
+0xF40DA2313E1447A8, 0xEA564BCBFA860B2E, 0x00004B38DC6F8CC6, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x5352C6E5A1E58085, 0x8E8D7FEA9DCFF984,
+0xF56BD335D939689B, 0xA98EB3C5376F4C1A, 0xF86125390F76526C, 0x3E93E078AD7D7E47,
+0x000028825DFE9C88, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xA67927567AC86BFB, 0x135D678BF093EF58, 0xC2903F5D52733284, 0x120A729B4D17D4F4,
+0xBE4264B7F1117443, 0xE82211D1149BC5B8, 0x000064875A24FEDA, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x610C02BCD0956EA9, 0xB8922205CAE1AFC0,
+0xBA99055FD71C6890, 0x4EF5558252796909, 0x829B01789A983E97, 0xF74BD0E34452DA87,
+0x00013570D9945C1C, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xA7CA0E5332B325AE, 0x86C1656E79651821, 0x864F97DC1897A57F, 0xF5DF9DAD3CD4A7B4,
+0x06E707C06266B928, 0xDA3AB3A2451B17C6, 0x0001A61452FD4357, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xC2ED1BF7850D0D01, 0x3E57C737BB76EF81,
+0xC7E19F6FC6702FAB, 0x5FE7D1C374358371, 0x2F6186799F3B044F, 0x3A8382D6BD2C5C09,
+0x0000786A9E5C0DD6, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xD870BBF521B2DE38, 0x1F658C2FBB1C4450, 0xFC1682FC00893CEB, 0x4C454AAE6C23C277,
+0x7D22C223F4AACDE9, 0x0742E90E7FE7CBCC, 0x00002C26BB2DEAE7, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x554EC57C6853E6FC, 0x1A92B93C464F92EB,
+0xC679E9A574BC3A35, 0xC0002B2C2064F7FA, 0x187E6224B8879C2D, 0xD23C066F047D81BB,
+0x0000C348C044A054, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xBB236B61678A1C8A, 0xFC3A90611FAA0E6B, 0xCD185F8055A16DA5, 0xCB9569F527D10961,
+0xEF95104F47332FF8, 0x9AC15C6EAD1F39F0, 0x00019BDA53973FAC, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0B63A8E70D681907, 0xEDBEABE48D336E4E,
+0x42801E7511DA1E27, 0x58F069875BF14D32, 0x37328549EE3B66F9, 0x287C43EC6B7E1FD3,
+0x0000A77386DDB9A1, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xC78CC327D86DC8E4, 0x852B2FB98F43155A, 0x6E15BAB285836D70, 0xF0D0EB91099470A7,
+0xE02990290423B08E, 0x75ACB3B62200924D, 0x000140C447B835B7, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x522F6B94DF93E7CE, 0x2C602917F930279E,
+0xC6C2E8352EEDEBE4, 0x7875B0CDAA66B643, 0x58F286AE2BBC652D, 0x68DD03E3BBB5F592,
+0x0001600947098775, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x640A5468C3E4F05B, 0x967168426B447F00, 0xE74AAE81641D60F6, 0x5389EB53642F67A5,
+0x74B520C4D9E7EEA0, 0x1A670711EFD718DA, 0x00010B04FAFA45DE, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x6ADBA4664F5A7A75, 0x91DD50287807EDDB,
+0x0FBF876E316B554A, 0x270C8E1EE79F25D9, 0x5D6C597D047662EB, 0x6972A8A3CE3637C6,
+0x0001A1F7CCAB390E, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x8EB00002A83E797B, 0xE863C448B8172359, 0x7C1B34C133FC74B5, 0xD4A454779918D289,
+0xAEA991F2506447C6, 0x70E52A8139975F5C, 0x00018AC009DE9D36, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x4BFC736C31690275, 0x9B67AB91C8A05B86,
+0x8819855737483EC0, 0x4BB6A8714C5A5DCD, 0x58FC65A268A6091F, 0x5D74A52CBE14CC7C,
+0x00010AAFB55D8BC0, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x6CBB61C81C2B9CD2, 0xA92DAF476FC2E01B, 0x1B59FCA4F3F82960, 0xF384E81F122A51C5,
+0x06C8AE3C80233B37, 0xA05B960AC2B7628C, 0x00004AD62A5D2328, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xC014277C38C66A69, 0xC83A557075BB7256,
+0x19E5BF143D0D9644, 0xCE26EC6CE19E0751, 0xBBA807B5890A6DE1, 0x0B0338201643FFD9,
+0x00012247493D7CCE, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xF6CB5A5B39A8453C, 0xADB821F98ED18A18, 0xA9657CEA3423E07C, 0x27EDAC776EF78E0A,
+0x47F07578E7BB2305, 0xDC4A4567BA076CC4, 0x000113C7D8F06680, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x5C2329EF8AC867A7, 0xDE8E7D7A42FB6D0F,
+0x8645514A88A3D27F, 0x01A8B702EEDFDE2C, 0xA41425FA1B9BC08E, 0x7E64A2A2553186FD,
+0x0000EF4A26D9BBFD, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x40575D82B3EDB7E2, 0x97AEF360472C5C9B, 0x9B4B48227EC63F8D, 0xB60C53876677F528,
+0x6D913EE03A546749, 0x0712FBDBC74394E3, 0x000054F7B3C2DFBF, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x6A92FA2E72899FC0, 0x333BA74B7732A5A5,
+0x44A5A95A91310DFC, 0xE6A54F4F8794D179, 0xBB6F7A0338184FD8, 0x77B21CFD9DC2C381,
+0x000074B0E55A8E64, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xE115FC8CF070E2A6, 0xE048CC7E109A3218, 0x4AB44E7B4AA121B0, 0x404FFD75065296A0,
+0x31A57A8F5524F157, 0xDA9F213C2590F02A, 0x00003DE10FBFB800, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x5C4416AE99D991CC, 0x965A265D8F717E93,
+0x799F57F3AFA3470E, 0x4B0E50AED421C199, 0x62152DA4884A8A5D, 0x152A86A3980DC92D,
+0x00005958FC5F3D71, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x4C005D4266CB26D7, 0x7164A79295F264FE, 0x9E990528D2F02C59, 0xB3A43855C617538E,
+0xE7E22EF74BC4F029, 0xD1C95CECC4B6DB48, 0x0000A2905DE0E128, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xCDFD25226450BFC2, 0xD68FE1B5A8183374,
+0x1124D4319195485D, 0x7651BDD8D15BC561, 0x9C95B7D0EDDCDE9C, 0xF15FFB1DDC90D6FF,
+0x00018E306F0F63FD, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x798D6E30E03F0988, 0xA2B5506613DC9025, 0xF51D3651330EF098, 0x32BF08323A4022E8,
+0x81F766512C38A80C, 0x6DACA9D29B3EF3E0, 0x0000D7071F152FC4, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x3F2DCDF22C22542E, 0x906AD7D08D296F6B,
+0x7A6FD84C48AF6474, 0x1D1B4EB7FDDA1891, 0x29C3B702DB79615E, 0xB023AA67B5096849,
+0x00009394DFDC4A63, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x5BC9D84AB7670E7E, 0x4828083021C6B06B, 0xD3B77D6E1ED217C0, 0x9B708170752D35C9,
+0xAD9C8AC4E3114497, 0xF2D9D5CAD596864B, 0x00019970436E8F82, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xEB7014D3B1558099, 0x31B43C34E4043A4F,
+0xD605D0A353DF16BB, 0x29052CF0660858BA, 0xC051EF7D6A24062D, 0xF8AB241860E6667B,
+0x00019988B262D5F2, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xE71FF97A24EA26CB, 0x9BC9C7CCA26CBBE9, 0x89A9F6F6FF8D0CDE, 0xB81C81FC5683098D,
+0x081C9101A2BEA5E4, 0x57C02BD72A2F0796, 0x000215E895AC4066, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x2BCD811B0F367D84, 0x4EE5F5C993B7378F,
+0x090EC735B3393A7C, 0x4D7141D5EAED90F3, 0xB0A7D9604FA202F6, 0xB6F3E50F8F42430C,
+0x0002308EF15618E9, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x1B5AD5E5EC741A14, 0xC12898CAA7AD65F9, 0x4E8289E586864A6F, 0x1F6A9C53E6973A6F,
+0xD76D8EF6742DA063, 0x8854405E9F71099B, 0x0000B42928B810D8, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xB4C6D5B11E608CF0, 0xF95002D00BE73279,
+0xFC2C81CB77F6FB3C, 0x951A170F12ED0083, 0xC4BA916B6E9546B0, 0x05CB365C6C965032,
+0x00020840EDC83749, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xE1C9D7EF0FEBE892, 0x1DF07532A4A53D6F, 0x40F8A917A7229E13, 0xB1E6DF990923DA52,
+0x3C4F556D33F7B0A6, 0x1A204667FABB89E3, 0x0002074D41770A65, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xBD46615B77631B3D, 0xB82CBDEB9C0F1A5D,
+0x7D7D8B5710BAB3AD, 0xB18D9297994DF90A, 0x28FDE8CFE41010C6, 0xAB4DDBC50ED9F92F,
+0x000001E36A440EAD, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x4E47C7BDCC5DA6FC, 0x1A76F867936FFA8F, 0x7928D70BD2F39011, 0xA715A72F43A63F55,
+0x108C291EF381A36F, 0x083CE23677277146, 0x00014B7E58AC4200, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x11159DA74DA188A0, 0x9AF2BE3CEE5FAE60,
+0x4802493BF30EC121, 0x6109C36A194E9484, 0x3E8ACC334272EEF8, 0x876E8C054E45807B,
+0x0000ABBC428567C4, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xAE9F44BC4D12131C, 0xEF3929208F8E8B8F, 0x86798199BCD9E47D, 0x681A9EF197F964DB,
+0x31AA44428ADF126F, 0x24629B11266DA11F, 0x00021C2F2F0D311E, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xF41395A31AC41485, 0xFBDABD58D3947498,
+0x25B1A6737195A602, 0x529B6EB737DEFAFC, 0x9F2FE5DF6D801F95, 0xA746C9AD5C50A197,
+0x0001728E8D837AEE, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x106481C11DE4E9D3, 0x939D3E5816F41D5A, 0xD2025B7B67EB6C91, 0x592B37A6F232C48B,
+0xBEA0B50216E833A8, 0x405407621C1397D2, 0x000172FBCCD45EC2, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xC65E84EEB3A9E000, 0x3195C262881F4CB3,
+0xCA96C80FCA9FC25F, 0x32387B327A709DDC, 0xCFE1B6D6F6812CC7, 0x5B613D8F7759731E,
+0x000001D800C398FD, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xCC82D775B79F4E31, 0xDFD6D75A9C41339C, 0xEFEDFA1933D6E72E, 0x6DB8A8499CF6E8C9,
+0xFF8DF95403F8121B, 0x417C7FFC046FA8D6, 0x0000DA3B831B44A8, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x37C098F075211E91, 0x2EC7655CF1E0191D,
+0x768EDA577FAD9A11, 0x98A53CAADC9EA258, 0x6469555224B09DC3, 0x6631375B82C33148,
+0x00003B00B3110FC2, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x18C836E1F90BEA71, 0x98494481DFE7E44D, 0xCFB23608B7C9596B, 0x8EEAD1D664A7E87B,
+0x6AB074121D692DF1, 0xB34B4920AAE24360, 0x0001B6AA0055C773, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x96DD77838A892F1F, 0x12049DAC0EC75A63,
+0x1BFEBDB7DA52087A, 0x0D008A96D7BF8DC1, 0xC7A9B652DD5A79D5, 0x03A4185C3A6E10D3,
+0x00008F4940C23A3C, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x8611203CCCB39421, 0xB3650F9191FAE881, 0x6E4ED171721E3C27, 0x23901E86BED5F53A,
+0x9B1BD9B2BD1C273B, 0x61DB23E97808FB9B, 0x00016174938F5805, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0C877F3F2EF7BBD3, 0x8113BB64DE8E3081,
+0x262D263EDCFD5F45, 0x7FD12CDE8A38D5E2, 0x5167B4D534438E27, 0x779D9D46CA088DC2,
+0x0000A55332777311, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xD67EC8F75EBB498D, 0x2CFB6C49B767D813, 0x3B8DC960BC17129F, 0x60BAEFFDB70BE3F3,
+0x39AA09C811054A80, 0xA4A7F5ABC64487AC, 0x0001BF82B39943DD, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xFE6798777C06E4AF, 0x635E796DF6CBC121,
+0x37A30A893771907A, 0x4DE7CF830A8298B8, 0xEF6312861A171574, 0xCFBD8E65FB64233E,
+0x00005D562E3A2ED4, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x17B2FE54CF627F63, 0x28631D934CE44707, 0xB2F202597D8F01A5, 0x07033ED888FCEF45,
+0xD67E7BD2ECB67E40, 0x0510F2B3DDC64FEA, 0x0000774EDF3657D7, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x43F3E135B57C1C81, 0x66AE914F1024DEEA,
+0x45E31BC8C76E51EB, 0x66E6CEA58BB3AA2B, 0x74A417434D268AB6, 0x8DD399CCF21B3BC3,
+0x0000E7E9C66FB48F, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0A72139079500003, 0x10A744F288C0E528, 0xD77A1F03C000A55C, 0x4FE654FB908A33BF,
+0xF9A8A288F0F02C85, 0xAB42E32FAFB18A56, 0x00013125331996D6, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x1B96A29BBA9C11C3, 0x6FEC44D87CF63E12,
+0x98710EE3FD48502C, 0x0345A001CB01D034, 0xADF10A4182AA0386, 0x64CBD02089C4ED52,
+0x0001986C2D7B1DE2, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x4C52E483153AA012, 0x4D85FDB7D6C1D0FD, 0xD7ED43EF0D277F4E, 0x851773067B73303E,
+0xA6047E8873241EC9, 0x8C72D586E63C2C69, 0x00020399781A2D24, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xCA8001124F1CF8A7, 0xF5E1AE36A5A9F929,
+0x428E95B9ADF4181D, 0xDB6A2FC2292C0BFB, 0x40D79CC80E887D4D, 0xAE6E80CE25129DDD,
+0x0000ADFC6AAE1670, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x5E78CD087A74FB6A, 0x10B79E5B5852D68E, 0xBACB660C04490DBE, 0xEFFEFC6D71533105,
+0x510167ACF1015301, 0x4B475EF9AA391EA2, 0x0000418597D363B2, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x2E4ADE2AD80D0416, 0xF066B45E89F7043B,
+0xE12AEB54E3EB4BC8, 0x7A4FBE890AC24E4F, 0x10C56AB2FB28C309, 0x3108318E57760A44,
+0x0002265F5D96AFF2, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xE54BCD485E097E2F, 0xB5F2ED1EFB1252E5, 0x9EC561C80B035C6E, 0x8586529603A9EAFC,
+0x75BE64183FA43117, 0x543C36F11656618E, 0x0000C41F4AE0BD8F, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x11C1B8931E40D343, 0x64E3D47ECF5743AD,
+0x003F7A0A1A210859, 0xAD189411B125266A, 0xF3B355DF2BE06846, 0xAEE3FA7C57D9B2A8,
+0x00019A8CE111196B, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x67B69A62680C7E3E, 0x04EF0EDD60EFAC37, 0x3B56CEC346264274, 0xEE451876472FD329,
+0xCAC62D162B4D3415, 0xFC71519A8E7CDE03, 0x0000DB731C3CD3C1, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x568332C749178824, 0x310C3B06A1FA1580,
+0x53C5A1E3BD4553AA, 0xF6E497B1AC82E88B, 0xD0436D2DC04C50EF, 0x3E0C8D496CF7C603,
+0x0000C00118465310, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0A12B95389B87661, 0x172AB393CFFCE92A, 0x646C0A8B8F22BDE2, 0x32FA6A80A7698EBA,
+0x1D8C0D7CD05F18AD, 0x96569F84CCE4AC40, 0x00017623B26D31FC, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x3D6C936A87BDE36C, 0x739B38EDF0140373,
+0x3F5CF52285152080, 0x0ECB47980AC397C0, 0xDBD142BA4B84E995, 0xABAE06E7CD0F2E51,
+0x0001BDDF7C851F88, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x10024C52ACFDACAC, 0xEEFC9B6860CAF84D, 0xAA5E9A7F67353348, 0x79D13397D4BE568D,
+0x7A1770E79B910D7A, 0x8DBAFE65CAD36093, 0x000014BFFC14C7D1, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x6CE9DEEA73C40F09, 0x091923FB736C36F5,
+0x02F7599ECD4B05EF, 0xF727362873C885BE, 0x6B4EA7136F9EFDBE, 0xD91726CBE47A5A4E,
+0x0001BFD1F1A4FA1D, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x600B100FA381493A, 0x4FCB7AE6278EF752, 0x47DB40AE22F51B41, 0x4F067F53332A4C96,
+0x9ACF4475729AC21B, 0x0679A0537C17E591, 0x0002051D3F74F9AA, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x549D10672DED1D4D, 0xDC0CA92488DD6340,
+0x2C2E670D1EF766C7, 0xC592057DE17BE120, 0x2017615D6368E68B, 0xE905E7188A28CCBE,
+0x0000630AC4536783, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x06657FBB4F238780, 0xF61DFBA907116D38, 0x06F5212E281C0CA4, 0x42E17D46ADFB5902,
+0x8C9DB81CAE17917C, 0x875F1D01B82C7C33, 0x0001CDE5F8FA1E94, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x2DCFD4C28B7F5672, 0xF4207C3B76E983D2,
+0xF8042451E8A1230E, 0x104D5C8137A866F3, 0x9ABF6493F8722CA9, 0x34F41341A6186085,
+0x00014C5975E85C8E, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x7FC2D5C5571FD216, 0x441F02A8F9E9D995, 0x5C9CF2CCF1577C19, 0xCE27B00B240CA762,
+0x39DBC1899E4D7DB2, 0xB332D0F7273F2DD1, 0x00016B4A6285C179, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x7BA1835BB04E379B, 0x100BF59457AEBFAE,
+0x564873697CB18BFE, 0xDE04EC837F6D568E, 0xF31B4D0B49110085, 0x030857FC74D30E9D,
+0x000063A2FDFBBEB4, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xF3CF99850B1CC734, 0xCB765A99EE56ABD9, 0x1A3A0330245EBE88, 0xFF42851E6D021874,
+0x3ABCE75F013D7A91, 0x91496219F6ABF7BE, 0x0000DA7DADC580AD, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x761F5EAB3F1DBA51, 0x84AA65A50BF6DBF2,
+0xF96CE36C0C40B791, 0xFD1450A4952FF6E4, 0x0775BD4C461C0BC7, 0xCA0198E4B75C6C1A,
+0x0000416F5A0DE789, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x2B77231791DBADDD, 0xD0693B43E7D08942, 0x3A92882F3DEFC9B4, 0xBB706D1B81B5EBB5,
+0x0C4C68D15BDF78A1, 0xCA87D79CB012FB38, 0x000185132058B9D4, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xA6A9EC8DD00B64FB, 0xB623BB6F76BB508C,
+0x8C4B41E468A7C520, 0x7DECC9F4FBE21135, 0x276E4A98EE688400, 0xF63FC825AE86FCAF,
+0x0000F507195D1D41, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x2EB554CC73A53F98, 0x080CF0939ECAA7C3, 0x2580EFE4F697FA62, 0x8B3B41AC2E28A4F6,
+0x2FBE0AEBB608F821, 0x7FFAEE863392C2B3, 0x0001038E6ADDF8EE, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x614DC284F849F84B, 0xDE9C0A4E254EB272,
+0x68E308E9785B737A, 0xCE27D6923B66D9B0, 0x22C54DB4BA600400, 0xF362CA2F40FC7C01,
+0x000055F3F8A80F91, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xF3E5D5BF1EB7996B, 0xFE41C3D9E2260CEB, 0x8BE8C50F84521D4B, 0x1EFC5EA2568B7234,
+0x8905FB2D1C240E59, 0xE2972EC1F97B6BD2, 0x0000B97378E14AB8, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xFC2315A16CD478E2, 0xD327E15413FF9745,
+0xF00B70DA037F77F5, 0x5168F4D562D88D17, 0xB0ED7608A0935680, 0x9CBF45065A2C557D,
+0x0001C2D41B542FEA, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0432C3E60F166C73, 0x10374D78995DFD37, 0x70DEA8CA0DA1B4BE, 0x3E0434A4C26BA6B8,
+0xB3456ACFE550246D, 0xF3C74EEB6E30579D, 0x0000FC5227A7B28A, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xDC08BB216594F3F9, 0x5874073630779EF9,
+0x302D6E16BEDF5D32, 0x18F5BF51FE240186, 0x039B7FCA7CAF3D98, 0xCAB96812C7DA64CB,
+0x0000EEDDB250346F, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x8A22DC3961F7A3FE, 0xDFF420C305106175, 0xC77682A47F63A8AE, 0xF2DC017CC5CD38A2,
+0x98E11323ED9D3AB9, 0xE5828256AD45028D, 0x00006F03EE495289, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xDE3896B0F077BC37, 0x7C6263584C06EA1E,
+0x2189100ACE1DC9F3, 0xE70C30537E81E903, 0x6270A26ADCDEF487, 0xB12F9579F90AF5C6,
+0x00012DADA83AFA23, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0A97BDC303A74328, 0x79EAE5C92334E57C, 0xF23518C911A19B52, 0x4DB31D5AADA8C573,
+0x9032F60B6D6B51D1, 0x1D59BF621BBEF11A, 0x0002040C5D045A29, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xC1EDF4E318A6579C, 0x3CDD4ECC98CFE80A,
+0x184255585DBD382F, 0xCFA579F8379C9A90, 0xF672BC6D54B6A6E8, 0x1672046672026248,
+0x0001BD349CEE63C7, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xAB64D3352C97E4F6, 0x54007A5D3CEE0F2E, 0x325AB104EC89E461, 0xB45B4B903E88650B,
+0x5A56CC148066BDC7, 0x88C9A1BD3411D299, 0x0001FD90EC186904, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xEBAF9E1E624C974C, 0x56022DB9648643C3,
+0x46431850B5D0AB68, 0x2E9E4E0F09A9F93B, 0x28F9E97242284789, 0xA60924B72BF3E7F0,
+0x00017ADFA61541B9, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xF90023683FE6E333, 0xBCBBC8280B4CA69D, 0xABE599D1A316D6B1, 0x6D62D870D8A8063B,
+0xE87260BEC8CC041C, 0x5F77ECD848172D0A, 0x0001FA337ACBEA72, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x3CE8C1CB36C2A12A, 0xDC48C06D2E1D162F,
+0xE16F1E0D51AE384A, 0x2A229694A6F8F455, 0x7AFF07D8BE0CBD1A, 0x07E4DADD9D6014F5,
+0x000019AEB23008CF, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x4964F4E6FF845694, 0x63B8B3DE3A091D11, 0x0C5049D15DEF41F9, 0x0B2827C64D868DAC,
+0x7463282473A12942, 0xF5D154061F454356, 0x000145C6BAAEE46D, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x3A81F91F9ED4EDE2, 0x643B87ABB6AD034E,
+0x44C2130F379934B6, 0x991374793213C027, 0x60757BFEF8F0C7D6, 0x39E334F6DFEA0E82,
+0x000167DE0D902C1D, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x267716441430F7AC, 0x9598B23097BFC8BC, 0x0C983EDAD7BE31CE, 0xBF133B0116EF007A,
+0x98CF1EDE9317DD92, 0x5B60F72FA82E6FD7, 0x0001BBBA05765D36, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xD6A9622A6A1D28A3, 0x5F9473D36A8BC0BF,
+0xDBEEC4A2879D5CD8, 0x34947B609B5715CB, 0x110C4D64DC453C06, 0x072D0BFF30E11A5F,
+0x000142AB8F410528, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x2D712CC692640906, 0x3F18C9E19580F4ED, 0x7D076BFFAE167D3C, 0x46631D8AABAD772F,
+0x9627FAB1BB3B6A9C, 0x1A93BF25D45FD369, 0x00011E29211E44EE, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x08C3B92B3C2B7522, 0x4F0E72DCF480EFAF,
+0xBF309E81EAC88EBC, 0xB21FA35E39C94401, 0x276727A61F66B1E9, 0x2933C42F977F411E,
+0x0000EA790B4BBD2C, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x45C0DD6063E9A728, 0x1E58D912DFB67E2A, 0x2DF6C34DAD30FEBA, 0x19CA72A147AB85C2,
+0xFCF48EB858DFC78C, 0x30695D72B6DB0EC1, 0x00004524AAA9BD43, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xF9D0B69D4289B7CD, 0xEB3561C718EE394D,
+0xD50F55295CB07AF6, 0x8B3825BEDD9D5BF5, 0x3D8DA3CD52634399, 0x0F7C55D7F1FF5171,
+0x000175D2C788CE0B, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xB2F0FDA79656250E, 0x44EC1850F3FF5BA7, 0x1D7331D80FBDC8EF, 0xFAE494EAC8440ABC,
+0x092019FF24685A60, 0xA83A66A6DF4C7FF9, 0x000044BC038398D9, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x3A68C88873EE4D86, 0xB689EE333D173E37,
+0xAD34A38A455EF294, 0x0A92A48D8C12B22B, 0x66BA6CA121A731CF, 0x8EAEE734EAE3D43E,
+0x00014081D7F980B2, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xE241F530BB2D2504, 0xEC332DBE7377BCD6, 0x194830C8F51A4399, 0x200F3082E07E68D1,
+0x3F63446A20995589, 0x3F505A21CBB89F7B, 0x0001467FA0DA79DC, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x9CE415ECDEBAF6D1, 0xC0A15D2CE619065F,
+0x4A987B2F7273849F, 0x3105F16811B6CBA5, 0x465C51A50D0BE2E4, 0x1FB7BD03ACD61073,
+0x0000B536D3273EF9, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x98F9036E67F3DC76, 0x3DD840BA4E03ADAA, 0x699D75072D3AB031, 0x8E65604EAF8B84D8,
+0x2E3811A6F43FD60E, 0x9E9D89B76147AFEF, 0x0001C565AB2809A0, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xDD5E92B81C1C2C6C, 0xC1C040EBC2C43C26,
+0x9AA2D074225821A4, 0x0823FCCEB6F32F6F, 0x9E3F84DA1FD67CF1, 0x93C56EBCFFF18216,
+0x00007A244F2E04E0, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x7C9668C3E5EECED6, 0x1BFC13FCA0775216, 0x00B7967152FA9B82, 0x0865C4593AF64BF8,
+0x121B2EE93EBCCA7F, 0xA0928BD5439F5C4F, 0x00010F38C4442FDE, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xD383BB6C9847AB2B, 0x359E7CD63EADA5D8,
+0x086BFD1C49A33C59, 0x36B8DDB363599675, 0x236D5FDBDFEDE714, 0xF0E4F3C3E3372647,
+0x0000B1ECA8A30E4B, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xC56C65A773C45F63, 0x10F075C6BC553C7C, 0x81D90865853608BF, 0x84222135205F9C63,
+0xA5A309789236EDF8, 0x11323FE178EBC504, 0x0001A20D5CD8CBBB, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xE1687B62225484DC, 0xCB6F7251748AB1F3,
+0x499076A238AD5AB1, 0xE817A011658D6EB0, 0xE96E7CDDAADC7991, 0xC0940EC23D5BA3B8,
+0x0001A3E2E0201C6F, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x4C90408957BAD9A5, 0x882D0EFB301C7B8B, 0xFBEDCEADED8B8B03, 0xB0777476C96EBAEF,
+0xB9A6E80FD02E0F8B, 0xCADC9AEE22CA0854, 0x00016C6BDA922554, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xBE4E7FDEB999C023, 0x5843C6068B7BC859,
+0xCBDCFB2B2989F33B, 0x4A489CE35CF233F1, 0x60AF5C38AC154DB5, 0x204D927587EEBFF2,
+0x000158384D6E8C62, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xAEEB9F059B68AEA0, 0xFA085F572B63C0DE, 0x8D3A0D633DBA0DF5, 0x3546773903E63C0E,
+0x3EF35E327EE5DC05, 0xA38A945BC73C191B, 0x0000EF4CC792EA1B, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xDF8C73B312E8173E, 0xDB7A68B11E01B654,
+0x49BFB9DEFA32BE2D, 0xE1082D3E7265803F, 0x0063081C6EA3850C, 0x76BBABA59FFD0C3B,
+0x000084AFFD895FEF, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x3EABE060BFD715B8, 0x33CC0641CA66A1B5, 0x19514324ED3D6142, 0xCF52E732F7E1EBC5,
+0xC07FC7EA6A0E0366, 0xEB87994FE28B3D3C, 0x0000A5D778B6DC82, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x7B1901942E91B448, 0xE4598B9456881049,
+0xCB4704E6FD3A3FBB, 0x2B7A8EBE2F03A393, 0x6D4A9C29A0A448BA, 0x7DFAC5EA4FB1FEAB,
+0x00020977550FC089, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x501661E5457EDD1A, 0xEFC7C5096690CC3F, 0xE35B014094BF433C, 0x18B18D408F726383,
+0x7304CD2AD6BC493E, 0xFD2BE1170E83B5FF, 0x0001128BE1EA20AF, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xE37834A5E001558B, 0xD622A5C6394E35CC,
+0x9EFC7D02979204C1, 0x6E393DE81332CF2C, 0xE41B85FE56171C77, 0x24914A2770E935E9,
+0x0000E8D2AF1F5A0E, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x2B75C8E40BAFCBB4, 0xC583F47997F334B3, 0xEF0EEC8905D1C354, 0xF354B54270E747C9,
+0x8B93A37A397B5183, 0x6BA2E17993180185, 0x0000504CC39104C2, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x043DC6F5DAF4BD57, 0x980624108E33B044,
+0x9C4BC906491A98A9, 0xEBB738FA1B5DFEC7, 0xDA0C58F77827262D, 0xB10AE7A01813828C,
+0x0001CF5C42F57CA5, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x99031F0EA93F1037, 0xA123072340B36BFF, 0xD8AF444F5DF88CC6, 0x216809798160B618,
+0x571249D24F9E064B, 0x1CFA04E0F3899FAE, 0x000193D13578F598, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x95FCA2E25EB3034C, 0x8A9435BC96E88B71,
+0xC6C928691095CA4A, 0x0D0BA85B99357102, 0x4E0193CEBDB18FBC, 0x9F7D983552BD0535,
+0x000005CCD50BF2C3, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x14B048460F6BC82C, 0x542E46861D6A3B8C, 0x6A26A2F49D8B0734, 0xAFBE9C8F884FFFF6,
+0xBC00D262DBB3536C, 0xD1CF1F06F540930D, 0x0000D6C1473D6DF0, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x9AAB8E2D9551187B, 0xD748CFD48D0404D3,
+0x7B5726137D30655D, 0xBBAC5A8A78E083E5, 0xF70E6E0A4DDC24CC, 0x279168F32B9F25D4,
+0x000124F4B3649C36, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x502AC59B5A454D09, 0xA10FD4F1E4EF7FD3, 0x6A28ACF3AA3ED3E0, 0x472A2A9C6F77E661,
+0x705183573BFB20DF, 0x332F5DE5956C80BB, 0x00021DFBFD8C51C0, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x395DBF4F1217C427, 0xAFB2651464D8D2EF,
+0x39F08D59517EA96A, 0xF4987E52008090CD, 0x9EC8250B51A09BCA, 0x581CE28880720A61,
+0x0000CCA06B7B8F4A, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xAD725DF169BA920F, 0x206C8B5F7A433E0C, 0xCB637AF1FEF08BC1, 0x987932A9CE6E9138,
+0x0F086C9039832D30, 0xE142BBDB638D73E7, 0x000004E6DE2133D2, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xEC4D5C62E0733107, 0x701E452F7C9C9E71,
+0x48B2FBD369E4A683, 0xEEFBE24F2B6D5CFF, 0x85FCBB0DAED990C3, 0x8ADFCD4DA11F95B1,
+0x0001D42459BAB097, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x960F2CC16819CBA6, 0xF9AC1AA05AA76383, 0xE031D10DEC5FAB22, 0xD14C963D42060EDD,
+0xD0EB0FA4EB7F5B79, 0xEB3A23F1CBDA8244, 0x00007A37D8799D3B, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0F7E42B68243ED46, 0xF4F775802544E3B8,
+0x8F23F517C797D97D, 0xB36A4DA1502339A2, 0x9791FFA7E8A5C59E, 0x07CC3407C16AD1BC,
+0x00015470FCC199BC, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x5C076046F2B65671, 0xDCDDAA3F50E52FA3, 0xD1ABE2AB3D47246A, 0xB95974F674EF0A4F,
+0x96ADEB508A2F0C16, 0x26DDE2BFF52FEF71, 0x0001C818FAFB0161, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x47664F8C6CA8B779, 0x7EA490FDF7394024,
+0x30383BDEC04CF30F, 0xC64624171656C9F7, 0x183A0385C5D49BB3, 0x5FA0349177C007E3,
+0x0000F45D40FE909E, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x7B220F313DB9267F, 0xD3BB7A488C772DD7, 0xB7A652851939B274, 0x59DA78830D7C2E21,
+0xB394BA84A034E175, 0x058A212F9552063C, 0x0000EE25933A8E9F, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x12C210C02B4B032F, 0xFE25307301D92397,
+0xD5F7511ACE91A721, 0xB7CD5B191E162F17, 0x9818D4670B0AA4A5, 0x7022CE43C55D6080,
+0x0000849F999B443C, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xF44B49702259B77A, 0x43438446144179F0, 0xA8156AED33F9AF63, 0xD45BF25CD1952B8F,
+0x90BBEC30384C6C8D, 0x2C647D8417D748A0, 0x0001F9E5FFE4FE4B, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x04EE1F5C969AAAAB, 0x624EA264BA19995D,
+0x024E2A10C209D0B8, 0x4F1AD77A25FD8BFF, 0x7623FE60B45E7876, 0xC3FD434801A2245F,
+0x0000AE5E34918E41, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xE2D2AED0BDBEFE15, 0x2A9049C17582699F, 0x6EF10F929B422238, 0x9F6573AF54B083BB,
+0xABF23BE749E8C2ED, 0xB3BCFB0697ACFDBD, 0x00014544AB956CA8, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x7B76073A69B60AF4, 0xA152E835F8D15D47,
+0xE484D3B6FD8DCD60, 0xDA30596E43CC1EB2, 0x8ECEBB32EE38C1CC, 0xAA2C15FBDBEE9142,
+0x00015A66C3743D09, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x132374E7D5F24449, 0x0DB8A6B88249F1D2, 0x93EF80AA009B5D5F, 0x9822151968562E25,
+0x7ED8BF0AFCB231BB, 0x59471A86A8E40371, 0x0001FD72EEAD66DA, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xA95BB4B05170C702, 0x964E6052568FF15A,
+0xAD325D0DCCB11B64, 0xF87969815FF3605A, 0xEA97BBEF9C6FEEC7, 0xEB1A13055C3E99EF,
+0x00006BDF16FAE690, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x788558BCD601640D, 0xB166C56506FBFB02, 0x4B293C1D32971018, 0x4B8E9D393B144CF8,
+0x5646ABDD32558CA9, 0x85C410C6AF0BF02C, 0x0001A698CC1AD455, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x68AB08BE87C36D91, 0x1BBF879A41F3C7A5,
+0x518A58D435560D4B, 0x83E581B7D526CBEA, 0x436B56502CBD44F5, 0xBB2403FE1314F9CC,
+0x00020A686EAE655A, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xB2DB0D9873D8C6E4, 0x79978AE9C8FEB826, 0x02274C27D9CDC83B, 0x5D886658C5D1AC92,
+0xE000A9E8E462CE1E, 0x5E4043C31503B4EA, 0x0000EC115D7B93D3, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x3EE51FAD3C471B3B, 0x0AFF3724356078D4,
+0xC8A1D8DBCF122FB6, 0x9290498CEA016E47, 0xF582ADF8532F9953, 0x545504B9F3C6C877,
+0x0000370E82A4C26A, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x4931F462C7933217, 0x107B53C61214C726, 0x8B872C80AEED9D66, 0x696A827B402C9862,
+0x283CA181C3060EF1, 0x2DE66ECF9AD39DBE, 0x0000A65C44942851, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x4D8577A871912D70, 0x645BC0406ACDE54D,
+0xA93C3AFF95EB521E, 0xDACE102319F59DE5, 0xB211C18BE3BE7131, 0x4E79B80A3FE66901,
+0x0000CDEE7B88A342, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x2B3C36E7B6FD54B4, 0x7F4D7A0EF8E592C0, 0x6319005E3FEEED6F, 0xADAB5F56DEDDD0BA,
+0x386946DDC7E4E4BA, 0x2CF1A4BA92322F4F, 0x00016D00071126B0, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x71C9BFDC733B70EF, 0x5AA2906611908119,
+0x4CF93A4DF3E6DA20, 0x26E85172F0B271BC, 0x7236C45734D4A3EF, 0x2355CC762E3D9CE8,
+0x0000CEFF14CBB12C, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x1C26CE53567EEEEA, 0x784FE98EDFE934C5, 0x32E5E6239C34D040, 0xCF694DCD0D2B8DE3,
+0x931A3AA6D4285157, 0xEA4B118074C064EB, 0x000011593731AFFE, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x29B79204F2CDFD74, 0xAD1DF9636B669F0D,
+0x641E17D7144D90C9, 0x7F7ED3BE2B72F9D8, 0x69158F6E9CE371D5, 0x188F6655E6BEAF1C,
+0x00013D9550F6D690, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xCF78B39849E8D648, 0xEB82074B80104FBA, 0xD8381770429ACD49, 0x8170BDC5BD87E113,
+0x8A667CBE7FFE0067, 0x30387D0A621F19EB, 0x0002173D416DD2C5, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x245B59F4599F43EA, 0x34519687057C6852,
+0x81E3AD563B0DCC7A, 0x58DAE141A5CF3AF4, 0xE233C1967F59EC34, 0x9DCA44F00B19A558,
+0x0001D6069AE5AFD1, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x2F41E8913C727480, 0x82F2EF4E74153F4B, 0x9AF45A8BB183111F, 0x562FD5EEE53D9E0A,
+0x24262E29DACF4E6C, 0x27F25D9490C952D7, 0x0001828B6B4FDE68, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x32F44B51930A0F07, 0x055D3A8298DADCFA,
+0xF8E0DF11E077978E, 0xD8FD74F84F1B617B, 0xB5DB029C629A4132, 0x8B62CF52E5AAEB2A,
+0x0001998E9B7D1971, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xA5B9BAC2B600BE06, 0x001ECBA4E8F94A2D, 0x4C280DFFB1EDC8A0, 0x44408BE1BFAE46F0,
+0xFB051C5CEC38264F, 0x7BF605EDAB2755D4, 0x000168193DC23576, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x27FDE6E7BEB08A9A, 0x2FE6758852C20B98,
+0x8F7D9769171DCC19, 0xDBE9C7DCFB205E46, 0xE2C599A5441F1236, 0x24B67D4AAC2D502A,
+0x0001C8CB9AC97409, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xDDDC77D40875691E, 0xF673983AD4C7FD60, 0xBCFAFAD3A30055D6, 0x436EF7583A16B67B,
+0x67E35F15C191B4C5, 0x2190F9A7185B2A7C, 0x00012FD098640D8B, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x041CC2BA4CDA21B0, 0x5DCBD3E21199CD0E,
+0xD8A61221A3B30271, 0x05E2FDC521C8B233, 0x3E941C58734E6628, 0xBD44940092312B64,
+0x00004803C723FB39, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x2C1D5603AC3C6B78, 0x5D9ADA16A4CEA7C0, 0xD9D6DDD6A30A024A, 0x11D74BC1D18FE53E,
+0x9F9845E407ECFE98, 0xBBA6AB447D8B9C92, 0x00019E5E0DD3350B, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x3FEF9FDD9349AA7A, 0xB16681CB611A0188,
+0x63F1E02A115E3B38, 0x3636BC78FB31E7EE, 0x04CC1F9D005C994F, 0x58AC0BA2ACEF0168,
+0x0001416CA3B3008B, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x6CAA0873101405AF, 0xFA0E943634911E0B, 0xB16D8223DB5DC287, 0xB626A5671CC84C9D,
+0xAB8D871138F742DA, 0x0FEA6E26837AD8C6, 0x00021F06EE0B2CE3, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x98313A60749C2CF9, 0x5B3026DF21798A27,
+0x148912DBECBCFD6B, 0xE474252C13C0C002, 0x1AA5B864452CCC33, 0x5E494B38A7447596,
+0x0001B17374574A13, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x39968CED76FD4E86, 0x481F2B8C93C30812, 0xEFD9F1148105041B, 0xDAC268F0C9F558CA,
+0xED7340FF93E7DDB1, 0x9A65754CF9B85BFA, 0x0001E8018000E510, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x67827E91F4348981, 0x3EBAF678248AB050,
+0xE51A35C5AC3B6BEA, 0x4D9D0410B095E79D, 0x418AE9F267AF7029, 0xB4AE278B637B3191,
+0x00021CC606C0389E, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xA8ECCDCF0FDD35C1, 0xBA59F787CF9D3E8C, 0xDB32E7430482A851, 0x1AB481543EF7C099,
+0xD747479675165BB1, 0x3587F8EE569AB1FE, 0x00017459A7E2CB73, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xDD1F05E2F171C67D, 0x43996EF596A0C600,
+0xBC8A8D46DF86D6CC, 0xC237924BFE91A83A, 0xA3B71F8D7360A7A0, 0x58B7582D1B044017,
+0x0000DDEBA96431AC, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0AAB3A8B3B6C7EB0, 0x0134B873661B58A5, 0xE631BF295C28D853, 0x61EF83FBC622CF72,
+0xCFC30F18CCA58AD5, 0xC4DC64DBAD59425E, 0x00014D9D342D8BEE, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x5BC1C0C90F5674AB, 0x4646300B5F32B215,
+0x8BBFF4641A827C10, 0xEE9794DF4E3A961A, 0xF33DB69EE06A5075, 0x1B7FC1DB9642CF86,
+0x000067D4C0EA3C63, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x32E5FC66E9ADB479, 0xC1F3067F8E4AE752, 0x2BF3BE66C1AB699C, 0x42B02FC84866D01C,
+0x3532282AD9188324, 0x165E4746CB592D79, 0x000220E7A82BAE18, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x5A382564D1124346, 0x782DFA2E9B831C0B,
+0x045DA700C5DD8E3E, 0x1E17AA64C9F777FD, 0x15B38537C5B92E19, 0xC157A9F6680AAFF6,
+0x00011BCA5CF82917, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xCB1C9051594D7252, 0xB27F3B958BDB53BC, 0x1DBC1ACEEEA04F1A, 0x032B5046440549A1,
+0x1C5AD9021DA9D954, 0xCC2BEC021C0F5C20, 0x0000329458E27C5B, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x6A991873A92FC1CD, 0x4F89AB2293894073,
+0x653AE54AB155A30E, 0x4B4759AE9A1AB6B0, 0xDDC390FBDF9C30F4, 0x0F97D1DDE5F93112,
+0x00001BD9D93C1C68, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x648D80907F85F607, 0x915AA3491383D01F, 0x62B4C057711577A9, 0xF794EFB3A52E928E,
+0x71B274C582AD491C, 0xD3CA4692F00D6E19, 0x0000A7A1650D59E0, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x5050CF0FAE84AC35, 0xBDC050F3AC0BD0C7,
+0xA601C8A3EC132A83, 0xBF9EEFEB81D1751E, 0x33EFB43B0E1571D0, 0xBD27F094361FAAFF,
+0x0000A0960E1B2EC2, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x5D7629386C19D5DC, 0x3FFE90D27AD57269, 0x360E01636F4A51D6, 0x783FB3257B771A67,
+0x0519458FD7C3CADD, 0xB302D20E68D9F7BC, 0x0001274D49BC01FB, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x522D7ED9EE23F477, 0x63042659FDE3FF86,
+0x0A859F7141F0C57F, 0xA45955A6A7F1EC98, 0x2AC48357998ABA8E, 0x14E0706DE4D4F8F4,
+0x0000B6AA5904042D, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x52FD418079E90992, 0xA46614001A6913FF, 0x845E6E7C3D571D50, 0xAC381EBCA20CE8CD,
+0xF1F8C6047A6CD332, 0x136C84E5B8F8A502, 0x00018C9A2E68347B, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x2F6AE0C048593159, 0xBF76E64DD0FD7009,
+0x11D60C314AB36E3D, 0xFD875FF2CBE87967, 0xB0A7F25FA2007582, 0xE92891B38C05145A,
+0x000062CCE7D6EDC4, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xF5442ED6D40192A1, 0x662C74B08F229DA7, 0x66DAF3BC6CC4B699, 0x766F50F48C873574,
+0xA74580CA4337A820, 0x0E848EBC86264E01, 0x000154C25A24CA70, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xEAA93127B7ECB087, 0x77EC346DAB413396,
+0xC7C5729DBF6471A2, 0xF7668CD654FD8965, 0x29B0BB31D6D6B77C, 0xCD598CDB86AEAAEE,
+0x0001341122406DA7, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x8E29CB6AF6B8E528, 0xAB58CAFA93433794, 0x391CF665DC5D89CD, 0xC02042B35260EC47,
+0x67589E86022DB84A, 0xAE5E823922F05A04, 0x00011D5DD80AC79B, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x59ED69AAABA1645F, 0x3D1E4C7A6AC2477F,
+0x53C743367F1BD0DF, 0xB6F4270AC3282ED8, 0x010B7BEA041287CF, 0xB356B3076D334217,
+0x000146B3E00C0541, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0xCAC966DA96AA3B1A, 0xD07107E714DACEFC, 0x96F345633DE3134B, 0x63051A52F8B0C9C1,
+0x81ECC79ABDC40E94, 0xB45017BBCB7A72B1, 0x0000C08BA2D9EAF0, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0xCFC53E23EBB4BF05, 0xC49204D49CF85C94,
+0xE5F0630D397EE787, 0x4C5C894BD1C6F345, 0x15D374123AA63599, 0xD4A79F2382DE06C7,
+0x0000B8EF02D8B7B7, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0B457E9E7ACC7EE1, 0xED456B19CD7176F2, 0xB59D5062AAA72340, 0xB791CAE50677A8EE,
+0xA2F4F39BC173B388, 0x57DC146BCA40FD11, 0x00002B0058C023F4, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+0x0000000000000000, 0x0000000000000000 };
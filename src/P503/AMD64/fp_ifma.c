@@ -0,0 +1,47 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license 
+*
+* Abstract: 8-way modular arithmetic using AVX-512 IFMA for P503
+*********************************************************************************************/
+
+#include "../P503_internal.h"
+#include "../../internal.h"
+
+
+// Constants in radix 2^52
+// 2 * p503
+static const uint64_t px2_52[NLIMBS52_FIELD]           = { 0xFFFFFFFFFFFFE, 0xFFFFFFFFFFFFF, 0xFFFFFFFFFFFFF, 0xFFFFFFFFFFFFF,
+                                                           0x157FFFFFFFFFF, 0x10B7B44423CF4, 0xD90F6FCFB5E26, 0xB4EF49A03737E,
+                                                           0x23C3CC08B8D7B, 0x000080CDEA830 };
+// p503 + 1
+static const uint64_t pp1_52[NLIMBS52_FIELD]           = { 0x0000000000000, 0x0000000000000, 0x0000000000000, 0x0000000000000,
+                                                           0x0AC0000000000, 0x085BDA2211E7A, 0x6C87B7E7DAF13, 0xDA77A4D01B9BF,
+                                                           0x11E1E6045C6BD, 0x00004066F5418 };
+// (2^520)^2/2^512 mod p503, maps a*2^512 to a*2^520 in the Montgomery domain
+static const uint64_t Montgomery_to52[NLIMBS52_FIELD]  = { 0x0000003F99AF5, 0x0000000000000, 0x0000000000000, 0x0000000000000,
+                                                           0x3640000000000, 0x2D869D723B5FC, 0xE566BD3C9CADC, 0x339C65A25ED59,
+                                                           0x371D15B71B194, 0x00001CB3EFFCA };
+// 2^512 mod p503, maps a*2^520 back to a*2^512 in the Montgomery domain
+static const uint64_t Montgomery_from52[NLIMBS52_FIELD] = { 0x00000000003F9, 0x0000000000000, 0x0000000000000, 0x0000000000000,
+                                                           0x4B40000000000, 0xCB1A6EA6DED2B, 0xD8D667EB37D63, 0x1AB2414251689,
+                                                           0xF59538ACD77C7, 0x000026FBAEC60 };
+
+#define fpcopy                        fpcopy503
+#define fp_pack_x8                    fp_pack503_x8
+#define fp_unpack_x8                  fp_unpack503_x8
+#define fp2_pack_x8                   fp2_pack503_x8
+#define fp2_unpack_x8                 fp2_unpack503_x8
+#define fpadd_x8                      fpadd503_x8
+#define fpsub_x8                      fpsub503_x8
+#define fpmul_mont_x8                 fpmul503_mont_x8
+#define fpsqr_mont_x8                 fpsqr503_mont_x8
+#define fp2add_x8                     fp2add503_x8
+#define fp2sub_x8                     fp2sub503_x8
+#define fp2mul_mont_x8                fp2mul503_mont_x8
+#define fp2sqr_mont_x8                fp2sqr503_mont_x8
+
+#include "../../fpx_ifma.c"
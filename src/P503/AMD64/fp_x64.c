@@ -18,6 +18,34 @@ extern const uint64_t p503p1[NWORDS_FIELD];
 extern const uint64_t p503x2[NWORDS_FIELD];  
 extern const uint64_t p503x4[NWORDS_FIELD];
 
+#if defined(_DISPATCH_) && (OS_TARGET == OS_NIX)
+    // Portable kernels of generic/fp_generic.c, renamed so that they sit next to the assembly-based ones below
+    #define mp_sub503_p2        mp_sub503_p2_portable
+    #define mp_sub503_p4        mp_sub503_p4_portable
+    #define fpadd503            fpadd503_portable
+    #define fpsub503            fpsub503_portable
+    #define fpneg503            fpneg503_portable
+    #define fpdiv2_503          fpdiv2_503_portable
+    #define fpcorrection503     fpcorrection503_portable
+    #define digit_x_digit       digit_x_digit_portable
+    #define mp_mul              mp_mul_portable
+    #define mp_sqr              mp_sqr_portable
+    #define rdc_mont            rdc_mont_portable
+    #include "../generic/fp_generic.c"
+    #undef mp_sub503_p2
+    #undef mp_sub503_p4
+    #undef fpadd503
+    #undef fpsub503
+    #undef fpneg503
+    #undef fpdiv2_503
+    #undef fpcorrection503
+    #undef digit_x_digit
+    #undef mp_mul
+    #undef mp_sqr
+    #undef rdc_mont
+    #include "../../fpx_dispatch.c"
+#endif
+
 
 inline void mp_sub503_p2(const digit_t* a, const digit_t* b, digit_t* c)
 { // Multiprecision subtraction with correction with 2*p, c = a-b+2p.    
@@ -164,33 +192,75 @@ void fpcorrection503(digit_t* a)
 
 void fp2mul503_c0_mont(const digit_t* a, const digit_t* b, digit_t* c)
 {
+#if defined(_DISPATCH_)
+    if (!mulx_adx_supported) {
+        fp2mul_c0_portable(a, b, c);
+        return;
+    }
+#endif
     fp2mul503_c0_asm(a, b, c);
 }
 
 
 void fp2mul503_c1_mont(const digit_t* a, const digit_t* b, digit_t* c)
 {
+#if defined(_DISPATCH_)
+    if (!mulx_adx_supported) {
+        fp2mul_c1_portable(a, b, c);
+        return;
+    }
+#endif
     fp2mul503_c1_asm(a, b, c);
 }
 
 
 void fp2sqr503_c0_mont(const digit_t* a, digit_t* c)
 {
+#if defined(_DISPATCH_)
+    if (!mulx_adx_supported) {
+        fp2sqr_c0_portable(a, c);
+        return;
+    }
+#endif
     fp2sqr503_c0_asm(a, c);
 }
 
 
 void fp2sqr503_c1_mont(const digit_t* a, digit_t* c)
 {
+#if defined(_DISPATCH_)
+    if (!mulx_adx_supported) {
+        fp2sqr_c1_portable(a, c);
+        return;
+    }
+#endif
     fp2sqr503_c1_asm(a, c);
 }
 
 
 void fpmul503(const digit_t* a, const digit_t* b, digit_t* c)
 {
+#if defined(_DISPATCH_)
+    if (!mulx_adx_supported) {
+        fpmul_portable(a, b, c);
+        return;
+    }
+#endif
     fpmul503_asm(a, b, c);
 }
 
+
+void fpsqr503(const digit_t* a, digit_t* c)
+{
+#if defined(_DISPATCH_)
+    if (!mulx_adx_supported) {
+        fpsqr_portable(a, c);
+        return;
+    }
+#endif
+    fpsqr503_asm(a, c);
+}
+
 #else
 
 void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords)
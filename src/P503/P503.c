@@ -31,8 +31,8 @@ const uint64_t p503x2[NWORDS64_FIELD]            = { 0xFFFFFFFFFFFFFFFE, 0xFFFFF
                                                      0x2610B7B44423CF41, 0x3737ED90F6FCFB5E, 0xC08B8D7BB4EF49A0, 0x0080CDEA83023C3C }; 
 const uint64_t p503x4[NWORDS64_FIELD]            = { 0xFFFFFFFFFFFFFFFC, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xAFFFFFFFFFFFFFFF, 
                                                      0x4C216F6888479E82, 0x6E6FDB21EDF9F6BC, 0x81171AF769DE9340, 0x01019BD506047879 };
-const uint64_t p503x8[NWORDS64_FIELD]            = { 0xFFFFFFFFFFFFFFF8, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0x5FFFFFFFFFFFFFFF, 
-                                                     0x9842DED1108F3D05, 0xDCDFB643DBF3ED78, 0x022E35EED3BD2680, 0x020337AA0C08F0F3 };
+const uint64_t p503x8[NWORDS64_FIELD]            = { 0xFFFFFFFFFFFFFFF8, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0x5FFFFFFFFFFFFFFF, 
+                                                     0x9842DED1108F3D05, 0xDCDFB643DBF3ED78, 0x022E35EED3BD2680, 0x020337AA0C08F0F3 };
 const uint64_t p503p1[NWORDS64_FIELD]            = { 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0xAC00000000000000,
                                                      0x13085BDA2211E7A0, 0x1B9BF6C87B7E7DAF, 0x6045C6BDDA77A4D0, 0x004066F541811E1E };
 // Order of Alice's subgroup
@@ -74,6 +74,9 @@ const uint64_t Montgomery_one[NWORDS64_FIELD]    = { 0x00000000000003F9, 0x00000
 
 
 // Fixed parameters for isogeny tree computation
+#if defined(_TUNED_STRATEGIES_)
+    #include "P503_strategies.h"
+#else
 const unsigned int strat_Alice[MAX_Alice-1] = { 
 61, 32, 16, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 
 4, 2, 1, 1, 2, 1, 1, 16, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 
@@ -88,6 +91,49 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 1, 4, 2, 1, 1, 2, 1, 1, 33, 17, 9, 5, 3, 2, 1, 1, 1, 1, 2, 1, 1, 1, 4, 2, 1, 1, 1, 
 2, 1, 1, 8, 4, 2, 1, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 16, 8, 4, 2, 1, 1, 1, 2, 
 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1 };
+
+#if defined(_THREADS_)
+// Strategies for the parallel isogeny evaluation with 2, 4 and 8 threads, generated with tools/strategies.c
+// nthreads = 2, p = 4171, q = 2658, modeled cost = 2504002, 11 intermediate points
+const unsigned int strat_Alice_2[MAX_Alice-1] = { 
+40, 27, 18, 13, 9, 6, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 6, 4, 3, 2, 
+1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 9, 6, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 13, 9, 6, 4, 3, 2, 1, 
+1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+// nthreads = 2, p = 3567, q = 1950, modeled cost = 2676562, 14 intermediate points
+const unsigned int strat_Bob_2[MAX_Bob-1] = { 
+42, 32, 25, 18, 13, 9, 6, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 
+4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 7, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 9, 6, 4, 4, 3, 2, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 13, 9, 6, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 
+3, 2, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+// nthreads = 4, p = 4171, q = 2658, modeled cost = 1994739, 16 intermediate points
+const unsigned int strat_Alice_4[MAX_Alice-1] = { 
+27, 21, 17, 15, 11, 8, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 
+1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 4, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+// nthreads = 4, p = 3567, q = 1950, modeled cost = 2150304, 21 intermediate points
+const unsigned int strat_Bob_4[MAX_Bob-1] = { 
+29, 24, 22, 17, 13, 10, 8, 7, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 4, 3, 2, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 4, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 6, 5, 4, 3, 2, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+// nthreads = 8, p = 4171, q = 2658, modeled cost = 1652848, 29 intermediate points
+const unsigned int strat_Alice_8[MAX_Alice-1] = { 
+14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+// nthreads = 8, p = 3567, q = 1950, modeled cost = 1793362, 30 intermediate points
+const unsigned int strat_Bob_8[MAX_Bob-1] = { 
+17, 15, 14, 13, 12, 11, 10, 9, 8, 8, 7, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+#endif
+#endif
            
 // Setting up macro defines and including GF(p), GF(p^2), curve, isogeny and kex functions
 #define fpcopy                        fpcopy503
@@ -98,11 +144,13 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fpdiv2                        fpdiv2_503
 #define fpcorrection                  fpcorrection503
 #define fpmul                         fpmul503
+#define fpsqr                         fpsqr503
 #define fpmul_mont                    fpmul503_mont
 #define fpsqr_mont                    fpsqr503_mont
 #define fpinv_mont                    fpinv503_mont
 #define fpinv_chain_mont              fpinv503_chain_mont
 #define fpinv_mont_bingcd             fpinv503_mont_bingcd
+#define is_sqr_fp                     is_sqr_fp503
 #define fp2copy                       fp2copy503
 #define fp2zero                       fp2zero503
 #define fp2add                        fp2add503
@@ -115,12 +163,15 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fp2correction                 fp2correction503
 #define fp2mul_mont                   fp2mul503_mont
 #define fp2sqr_mont                   fp2sqr503_mont
+#define xDBLe_asm                     xDBLe503_asm
+#define xTPLe_asm                     xTPLe503_asm
 #define fp2mul_c0_mont                fp2mul503_c0_mont
 #define fp2mul_c1_mont                fp2mul503_c1_mont
 #define fp2sqr_c0_mont                fp2sqr503_c0_mont
 #define fp2sqr_c1_mont                fp2sqr503_c1_mont
 #define fp2inv_mont                   fp2inv503_mont
 #define fp2inv_mont_bingcd            fp2inv503_mont_bingcd
+#define is_sqr_fp2                    is_sqr_fp2_503
 #define fpequal_non_constant_time     fpequal503_non_constant_time
 #define mp_add_asm                    mp_add503_asm
 #define mp_subaddx2_asm               mp_subadd503x2_asm
@@ -128,6 +179,15 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp503
 #define crypto_kem_enc                crypto_kem_enc_SIKEp503
 #define crypto_kem_dec                crypto_kem_dec_SIKEp503
+#define crypto_kem_enc_batch          crypto_kem_enc_batch_SIKEp503
+#define crypto_kem_dec_batch          crypto_kem_dec_batch_SIKEp503
+#define crypto_kem_expand_pk          crypto_kem_expand_pk_SIKEp503
+#define crypto_kem_enc_expanded       crypto_kem_enc_expanded_SIKEp503
+#define crypto_kem_expand_sk          crypto_kem_expand_sk_SIKEp503
+#define crypto_kem_dec_expanded       crypto_kem_dec_expanded_SIKEp503
+#define crypto_kem_pool_start         crypto_kem_pool_start_SIKEp503
+#define crypto_kem_pool_stop          crypto_kem_pool_stop_SIKEp503
+#define crypto_kem_keypair_pooled     crypto_kem_keypair_pooled_SIKEp503
 #define random_mod_order_A            random_mod_order_A_SIDHp503
 #define random_mod_order_B            random_mod_order_B_SIDHp503
 #define EphemeralKeyGeneration_A      EphemeralKeyGeneration_A_SIDHp503
@@ -135,7 +195,22 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define EphemeralSecretAgreement_A    EphemeralSecretAgreement_A_SIDHp503
 #define EphemeralSecretAgreement_B    EphemeralSecretAgreement_B_SIDHp503
 
+#if defined(_IFMA_)
+#define fp2_pack_x8                   fp2_pack503_x8
+#define fp2_unpack_x8                 fp2_unpack503_x8
+#define fp2add_x8                     fp2add503_x8
+#define fp2sub_x8                     fp2sub503_x8
+#define fp2mul_mont_x8                fp2mul503_mont_x8
+#define fp2sqr_mont_x8                fp2sqr503_mont_x8
+#endif
+
 #include "../fpx.c"
 #include "../ec_isogeny.c"
+#if defined(_FIXED_BASE_)
+#include "P503_ladder_tables.c"
+#endif
 #include "../sidh.c"    
+#if defined(_IFMA_)
+#include "../sidh_x8.c"
+#endif
 #include "../sike.c"
\ No newline at end of file
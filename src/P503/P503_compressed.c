@@ -172,6 +172,7 @@ const unsigned int strat_Bob[MAX_Bob - 1] = {
 2, 1, 1, 8, 4, 2, 1, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 16, 8, 4, 2, 1, 1, 1, 2,
 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1 };
 
+#if !defined(_DLOG_TABLES_)
 // Fixed traversal strategies for Pohlig-Hellman discrete logs
 const unsigned int ph2_path[PLEN_2] = {
 #ifdef COMPRESSED_TABLES
@@ -192,6 +193,7 @@ const unsigned int ph3_path[PLEN_3] = {
     #endif   
 #endif
 };
+#endif
 
 
 // Entangled bases related static tables and parameters
@@ -201,7 +203,7 @@ const unsigned int ph3_path[PLEN_3] = {
 //      Two tables of 17 elements each for the values r in F_p such that v = 1/(1+ur^2) where r is already converted to Montgomery representation
 //      Also, 2 tables for the quadratic residues (qr) and quadratric non residues (qnr) v in F_{p^2} with 17 GF(p^2) elements each. 
 // For the 3^eB-torsion basis generation:
-//      A table of size 20 for values v = 1/(1+U*r^2) 
+//      A table of size 20 for values v = 1/(1+U*r^2), or of size TABLE_V3_LEN generated by "make elligator_tables"
 
 
 const uint64_t u_entang[2 * NWORDS64_FIELD] = {
@@ -324,6 +326,7 @@ const uint64_t table_v_qnr[TABLE_V_LEN][NWORDS64_FIELD] =
 {0x22BCBF7871766C3A,0x9395C19D8E87CC4C,0xB92EF7084D0FEBD8,0x8A60E143C87DB915,0x3FDCB6ED258F6167,0xFB9943E3BF11D380,0xE116C209F87D2108,0xE76DDE2391409},
 {0xC8A69E75B7B72831,0x300BCE8A5E86484D,0x34F0183CB8FBECCB,0x590030B5DC767075,0x2D8B65503007FE01,0x8F397E3E796F3B98,0xC77FB29679EAF434,0x13554730291BD2} };
 
+#if !defined(_ELLIGATOR_TABLES_)
 const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 { {0x9999999999999ACA,0x9999999999999999,0x9999999999999999,0xE199999999999999,0xF80F9506B04F6159,0x922628D05B98276C,0x536E7BDA3A893A25,0x38C6C682DEFCAE,0xCCCCCCCCCCCCCC67,0xCCCCCCCCCCCCCCCC,0xCCCCCCCCCCCCCCCC,0x98CCCCCCCCCCCCCC,0x5E52ECF125EB8217,0x2DD1EF52B54CC76B,0xAEF26E4BDFFA238E,0x28ABA3F8B607A},
 {0xB61A6449E59BB678,0xE59BB61A6449E59B,0x6449E59BB61A6449,0x161A6449E59BB61A,0xB0A7A696AD14F403,0x5908519429BF6752,0xF8F5C2FDB95D626B,0x3415A91EB9B01B,0x59BB61A6449E5991,0x449E59BB61A6449E,0x61A6449E59BB61A6,0xEDBB61A6449E59BB,0xDCBBFD66B1210ED0,0xD1759BAF69F0DE7F,0x151E605BC94FFF1C,0x1AF11E41BC9044},
@@ -345,6 +348,10 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 {0xAA3BFB6CB8587768,0x515E32FD38308C38,0x927E612E9CE18C76,0x13B2195A5D867C54,0x857274100A6ECFD0,0x10CAD97274DDC646,0x30BCDB9A79ECA27,0x7F0790BC050BA,0x67F4FD27FF7B7A3B,0x7528EF9DFC6790F9,0xD34442AA02F00A58,0x51935D736DE84027,0xFEA3DCBAF9002F2,0xB3D055C2572AD741,0x9F0EF6D70050CCC5,0x10611302FDA1B4},
 {0x8894D7E86C5358CF,0xE01ED56C2E374D80,0x1EB04AACFBB0B60D,0x1B0F1031360154CD,0x52257CF78935DF2,0xD1759C3E61E7823C,0xC5CBD367AD3EB0AB,0x377C52E4424CF4,0xED5FFE6B5FB024BD,0x65B8965C7A3F1BB,0x61A0E4FB6BAAF40F,0xD8ACB4A3CC9A6C24,0x38FAAD404A5D6211,0xF59F595458B10D72,0x13FDB0B2371936A0,0x1934F680EC8F88},
 {0xF6DC60A5C5734661,0x9CD9E9A6DA083A88,0xEDA465D0EAA7F9BB,0x87FEE132D788E4CA,0x94D57ED92F0D0A7B,0xA157AC0056BDBFE8,0x62DAF28EE0E30FC9,0x10E9FA4557999D,0x78942F9DE083A353,0x5FDAC52AEBA63CE5,0x905BC434EA6102CF,0x9CC2E0667372C509,0xE22094C33879AFDC,0x820B3999B77E5E28,0x7076A18C8D100A7D,0x1B55229ADA2623} };
+#else
+    #define ELLIGATOR_TABLES_DATA
+    #include "P503_elligator_tables.h"    // Larger table and the extension of the tables of the 2^eA-torsion
+#endif
 
 // Setting up macro defines and including GF(p), GF(p^2), curve, isogeny and kex functions
 #define fpcopy                        fpcopy503
@@ -355,11 +362,13 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 #define fpdiv2                        fpdiv2_503
 #define fpcorrection                  fpcorrection503
 #define fpmul                         fpmul503
+#define fpsqr                         fpsqr503
 #define fpmul_mont                    fpmul503_mont
 #define fpsqr_mont                    fpsqr503_mont
 #define fpinv_mont                    fpinv503_mont
 #define fpinv_chain_mont              fpinv503_chain_mont
 #define fpinv_mont_bingcd             fpinv503_mont_bingcd
+#define is_sqr_fp                     is_sqr_fp503
 #define fp2copy                       fp2copy503
 #define fp2zero                       fp2zero503
 #define fp2add                        fp2add503
@@ -372,18 +381,22 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 #define fp2correction                 fp2correction503
 #define fp2mul_mont                   fp2mul503_mont
 #define fp2sqr_mont                   fp2sqr503_mont
+#define xDBLe_asm                     xDBLe503_asm
+#define xTPLe_asm                     xTPLe503_asm
 #define fp2mul_c0_mont                fp2mul503_c0_mont
 #define fp2mul_c1_mont                fp2mul503_c1_mont
 #define fp2sqr_c0_mont                fp2sqr503_c0_mont
 #define fp2sqr_c1_mont                fp2sqr503_c1_mont
 #define fp2inv_mont                   fp2inv503_mont
 #define fp2inv_mont_bingcd            fp2inv503_mont_bingcd
+#define is_sqr_fp2                    is_sqr_fp2_503
 #define fpequal_non_constant_time     fpequal503_non_constant_time
 #define mp_add_asm                    mp_add503_asm
 #define mp_subaddx2_asm               mp_subadd503x2_asm
 #define mp_dblsubx2_asm               mp_dblsub503x2_asm
 #define random_mod_order_A            random_mod_order_A_SIDHp503
 #define random_mod_order_B            random_mod_order_B_SIDHp503
+#define tables_load                   tables_load_SIDHp503_compressed
 #define EphemeralKeyGeneration_A      EphemeralKeyGeneration_A_SIDHp503_Compressed
 #define EphemeralKeyGeneration_B      EphemeralKeyGeneration_B_SIDHp503_Compressed
 #define EphemeralSecretAgreement_A    EphemeralSecretAgreement_A_SIDHp503_Compressed
@@ -391,14 +404,30 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp503_compressed
 #define crypto_kem_enc                crypto_kem_enc_SIKEp503_compressed
 #define crypto_kem_dec                crypto_kem_dec_SIKEp503_compressed
+#define crypto_kem_enc_batch          crypto_kem_enc_batch_SIKEp503_compressed
+#define crypto_kem_dec_batch          crypto_kem_dec_batch_SIKEp503_compressed
+#define crypto_kem_pool_start         crypto_kem_pool_start_SIKEp503_compressed
+#define crypto_kem_pool_stop          crypto_kem_pool_stop_SIKEp503_compressed
+#define crypto_kem_keypair_pooled     crypto_kem_keypair_pooled_SIKEp503_compressed
 
 
 #include "../fpx.c"
 #include "../ec_isogeny.c"
 #include "../compression/torsion_basis.c"
-#include "P503_compressed_pair_tables.c"
+#define TABLES_BLOB_NAME              "SIDHp503_compressed"
+#define TABLES_BLOB_FILE              "src/P503/P503_compressed_tables.bin"     // Written by "make tables_blob"
+#if defined(_TABLE_BLOB_)
+    #include "../compression/tables_blob.c"
+#else
+    #include "P503_compressed_pair_tables.c"
+#endif
 #include "../compression/pairing.c"
-#include "P503_compressed_dlog_tables.c"
+#if defined(_DLOG_TABLES_)
+    #define DLOG_TABLES_DATA
+    #include "P503_dlog_tables.h"
+#elif !defined(_TABLE_BLOB_)
+    #include "P503_compressed_dlog_tables.c"
+#endif
 #include "../compression/dlog.c"
 #include "../compression/sidh_compressed.c"
 #include "../compression/sike_compressed.c"
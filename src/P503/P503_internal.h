@@ -48,6 +48,8 @@
 #define MAX_INT_POINTS_BOB      8      
 #define MAX_Alice               125
 #define MAX_Bob                 159
+#define MAX_INT_POINTS_ALICE_THREADS  29
+#define MAX_INT_POINTS_BOB_THREADS    30
 #define MSG_BYTES               24
 #define SECRETKEY_A_BYTES       ((OALICE_BITS + 7) / 8)
 #define SECRETKEY_B_BYTES       ((OBOB_BITS - 1 + 7) / 8)
@@ -64,35 +66,44 @@
     // Table sizes used by the Entangled basis generation
     #define TABLE_R_LEN 17
     #define TABLE_V_LEN 34
-    #define TABLE_V3_LEN 20
+    #if defined(_ELLIGATOR_TABLES_)
+        #include "P503_elligator_tables.h"   // Generated by "make elligator_tables"
+    #else
+        #define TABLE_V3_LEN 20
+        #define TABLE_R_EXT_LEN 0
+    #endif
     // Parameters for discrete log computations
-    // Binary Pohlig-Hellman reduced to smaller logs of order ell^W
-    #define W_2 5
-    #define W_3 3
-    // ell^w    
-    #define ELL2_W (1 << W_2)    
-    #define ELL3_W 27
-    // ell^(e mod w) 
-    #define ELL2_EMODW (1 << (OALICE_BITS % W_2))    
-    #define ELL3_EMODW 1
-    // # of digits in the discrete log    
-    #define DLEN_2 ((OALICE_BITS + W_2 - 1) / W_2) // ceil(eA/W_2)
-    #define DLEN_3 ((OBOB_EXPON + W_3 - 1) / W_3) // ceil(eB/W_3)
-    // Use compressed tables: FULL_SIGNED
-    #define COMPRESSED_TABLES
-    #define ELL2_TORUS
-    #define ELL3_FULL_SIGNED    // Uses signed digits to reduce table size by half
-    // Length of the optimal strategy path for Pohlig-Hellman
-    #ifdef COMPRESSED_TABLES
-        #if W_2 == 5
-            #define PLEN_2 51
-        #endif
-        #ifdef ELL2_TORUS
-            #define W_2_1 4
+    #if defined(_DLOG_TABLES_)
+        #include "P503_dlog_tables.h"        // Generated by "make dlog_tables"
+    #else
+        // Binary Pohlig-Hellman reduced to smaller logs of order ell^W
+        #define W_2 5
+        #define W_3 3
+        // ell^w    
+        #define ELL2_W (1 << W_2)    
+        #define ELL3_W 27
+        // ell^(e mod w) 
+        #define ELL2_EMODW (1 << (OALICE_BITS % W_2))    
+        #define ELL3_EMODW 1
+        // # of digits in the discrete log    
+        #define DLEN_2 ((OALICE_BITS + W_2 - 1) / W_2) // ceil(eA/W_2)
+        #define DLEN_3 ((OBOB_EXPON + W_3 - 1) / W_3) // ceil(eB/W_3)
+        // Use compressed tables: FULL_SIGNED
+        #define COMPRESSED_TABLES
+        #define ELL2_TORUS
+        #define ELL3_FULL_SIGNED    // Uses signed digits to reduce table size by half
+        // Length of the optimal strategy path for Pohlig-Hellman
+        #ifdef COMPRESSED_TABLES
+            #if W_2 == 5
+                #define PLEN_2 51
             #endif
-        #ifdef ELL3_FULL_SIGNED
-            #if W_3 == 3
-                #define PLEN_3 54
+            #ifdef ELL2_TORUS
+                #define W_2_1 4
+                #endif
+            #ifdef ELL3_FULL_SIGNED
+                #if W_3 == 3
+                    #define PLEN_3 54
+                #endif
             #endif
         #endif
     #endif
@@ -104,6 +115,7 @@
 typedef digit_t felm_t[NWORDS_FIELD];                                 // Datatype for representing 503-bit field elements (512-bit max.)
 typedef digit_t dfelm_t[2*NWORDS_FIELD];                              // Datatype for representing double-precision 2x503-bit field elements (2x512-bit max.) 
 typedef felm_t  f2elm_t[2];                                           // Datatype for representing quadratic extension field elements GF(p503^2)
+typedef dfelm_t df2elm_t[2];                                          // Datatype for representing double-precision quadratic extension field elements GF(p503^2)
         
 typedef struct { f2elm_t X; f2elm_t Z; } point_proj;                  // Point representation in projective XZ Montgomery coordinates.
 typedef point_proj point_proj_t[1]; 
@@ -178,6 +190,8 @@ void mul503_asm(const digit_t* a, const digit_t* b, digit_t* c);
    
 // Field squaring using Montgomery arithmetic, c = a*b*R^-1 mod p503, where R=2^512
 void fpsqr503_mont(const digit_t* ma, digit_t* mc);
+void fpsqr503(const digit_t* a, digit_t* c);
+void fpsqr503_asm(const digit_t* a, digit_t* c);
 
 // Field inversion, a = a^-1 in GF(p503)
 void fpinv503_mont(digit_t* a);
@@ -188,6 +202,9 @@ void fpinv503_mont_bingcd(digit_t* a);
 // Chain to compute (p503-3)/4 using Montgomery arithmetic
 void fpinv503_chain_mont(digit_t* a);
 
+// Test if a is a square in GF(p503), returns 1 if true (also for a = 0), 0 otherwise
+unsigned char is_sqr_fp503(const felm_t a);
+
 /************ GF(p^2) arithmetic functions *************/
     
 // Copy of a GF(p503^2) element, c = a
@@ -225,11 +242,52 @@ void fp2mul503_c0_asm(const digit_t* a, const digit_t* b, digit_t* c);
 void fp2mul503_c1_mont(const digit_t* a, const digit_t* b, digit_t* c);
 void fp2mul503_c1_asm(const digit_t* a, const digit_t* b, digit_t* c);
 
+// Repeated doubling Q = [2^e]P as xDBLe, and repeated tripling Q = [3^e]P as xTPLe, in GF(p503^2)
+void xDBLe503_asm(const digit_t* P, digit_t* Q, const digit_t* A24plus, const digit_t* C24, const int e);
+void xTPLe503_asm(const digit_t* P, digit_t* Q, const digit_t* A24minus, const digit_t* A24plus, const int e);
+
 // GF(p503^2) inversion using Montgomery arithmetic, a = (a0-i*a1)/(a0^2+a1^2)
 void fp2inv503_mont(f2elm_t a);
 
 // GF(p503^2) inversion, a = (a0-i*a1)/(a0^2+a1^2), GF(p503) inversion done using the binary GCD 
 void fp2inv503_mont_bingcd(f2elm_t a);
 
+// Test if a is a square in GF(p503^2), returns 1 if true, 0 otherwise
+unsigned char is_sqr_fp2_503(const f2elm_t a);
+
+#if defined(_IFMA_)
+/************ 8-way field arithmetic using AVX-512 IFMA *************/
+
+#define NLIMBS52_FIELD          10               // Number of 52-bit limbs of a 503-bit field element
+#define ZERO_LIMBS52_FIELD      4               // Number of "0" 52-bit limbs in the least significant part of p503 + 1
+
+typedef uint64_t felm_x8_t[NLIMBS52_FIELD][8];                          // Datatype for 8 field elements in radix 2^52, stored limb by limb across the 8 lanes
+typedef felm_x8_t f2elm_x8_t[2];                                       // Datatype for 8 GF(p503^2) elements
+
+// Loading of 8 field elements into the lanes of c, converting from R=2^512 to R'=2^520 Montgomery representation
+void fp_pack503_x8(const felm_t* a, felm_x8_t c);
+void fp2_pack503_x8(const f2elm_t* a, f2elm_x8_t c);
+
+// Extraction of the 8 lane elements of a, converting back to the R=2^512 Montgomery representation
+void fp_unpack503_x8(const felm_x8_t a, felm_t* c);
+void fp2_unpack503_x8(const f2elm_x8_t a, f2elm_t* c);
+
+// 8-way modular addition and subtraction, c = a+b mod p503 and c = a-b mod p503
+void fpadd503_x8(const felm_x8_t a, const felm_x8_t b, felm_x8_t c);
+void fpsub503_x8(const felm_x8_t a, const felm_x8_t b, felm_x8_t c);
+
+// 8-way field multiplication and squaring using Montgomery arithmetic, c = a*b*R'^-1 mod p503 and c = a^2*R'^-1 mod p503
+void fpmul503_mont_x8(const felm_x8_t a, const felm_x8_t b, felm_x8_t c);
+void fpsqr503_mont_x8(const felm_x8_t a, felm_x8_t c);
+
+// 8-way GF(p503^2) addition and subtraction
+void fp2add503_x8(const f2elm_x8_t a, const f2elm_x8_t b, f2elm_x8_t c);
+void fp2sub503_x8(const f2elm_x8_t a, const f2elm_x8_t b, f2elm_x8_t c);
+
+// 8-way GF(p503^2) multiplication and squaring using Montgomery arithmetic
+void fp2mul503_mont_x8(const f2elm_x8_t a, const f2elm_x8_t b, f2elm_x8_t c);
+void fp2sqr503_mont_x8(const f2elm_x8_t a, f2elm_x8_t c);
+#endif
+
 
 #endif
@@ -0,0 +1,47 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license 
+*
+* Abstract: 8-way modular arithmetic using AVX-512 IFMA for P610
+*********************************************************************************************/
+
+#include "../P610_internal.h"
+#include "../../internal.h"
+
+
+// Constants in radix 2^52
+// 2 * p610
+static const uint64_t px2_52[NLIMBS52_FIELD]           = { 0xFFFFFFFFFFFFE, 0xFFFFFFFFFFFFF, 0xFFFFFFFFFFFFF, 0xFFFFFFFFFFFFF,
+                                                           0xFFFFFFFFFFFFF, 0x03FFFFFFFFFFF, 0xBD154B5605CDC, 0x091FF35762F09,
+                                                           0x84A5535CF7E8A, 0x1964AB65F4218, 0x3202184A3CFB1, 0x0004F7ED4ED10 };
+// p610 + 1
+static const uint64_t pp1_52[NLIMBS52_FIELD]           = { 0x0000000000000, 0x0000000000000, 0x0000000000000, 0x0000000000000,
+                                                           0x0000000000000, 0x0200000000000, 0xDE8AA5AB02E6E, 0x048FF9ABB1784,
+                                                           0x4252A9AE7BF45, 0x8CB255B2FA10C, 0x19010C251E7D8, 0x00027BF6A7688 };
+// (2^624)^2/2^640 mod p610, maps a*2^640 to a*2^624 in the Montgomery domain
+static const uint64_t Montgomery_to52[NLIMBS52_FIELD]  = { 0x0000000000000, 0x0000000000000, 0x0000000000000, 0x0000000000000,
+                                                           0x0000000000000, 0x0000000000000, 0x0000000000000, 0x0000000000000,
+                                                           0x0000000000000, 0x0000000000000, 0x0000000000000, 0x0001000000000 };
+// 2^640 mod p610, maps a*2^624 back to a*2^640 in the Montgomery domain
+static const uint64_t Montgomery_from52[NLIMBS52_FIELD] = { 0x00000670CC8E6, 0x0000000000000, 0x0000000000000, 0x0000000000000,
+                                                           0x0000000000000, 0x3400000000000, 0x2BD28717A3F9A, 0xA323D41C4D99C,
+                                                           0xAD1E20A4A1839, 0x3DD2B62215D06, 0x369026E862CAF, 0x00010894E9641 };
+
+#define fpcopy                        fpcopy610
+#define fp_pack_x8                    fp_pack610_x8
+#define fp_unpack_x8                  fp_unpack610_x8
+#define fp2_pack_x8                   fp2_pack610_x8
+#define fp2_unpack_x8                 fp2_unpack610_x8
+#define fpadd_x8                      fpadd610_x8
+#define fpsub_x8                      fpsub610_x8
+#define fpmul_mont_x8                 fpmul610_mont_x8
+#define fpsqr_mont_x8                 fpsqr610_mont_x8
+#define fp2add_x8                     fp2add610_x8
+#define fp2sub_x8                     fp2sub610_x8
+#define fp2mul_mont_x8                fp2mul610_mont_x8
+#define fp2sqr_mont_x8                fp2sqr610_mont_x8
+
+#include "../../fpx_ifma.c"
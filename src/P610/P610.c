@@ -31,8 +31,8 @@ const uint64_t p610x2[NWORDS64_FIELD]            = { 0xFFFFFFFFFFFFFFFE, 0xFFFFF
                                                      0x62F09BD154B5605C, 0x35CF7E8A091FF357, 0x64AB65F421884A55, 0x03202184A3CFB119, 0x00000004F7ED4ED1 };
 const uint64_t p610x4[NWORDS64_FIELD]            = { 0xFFFFFFFFFFFFFFFC, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xB807FFFFFFFFFFFF, 
                                                      0xC5E137A2A96AC0B9, 0x6B9EFD14123FE6AE, 0xC956CBE8431094AA, 0x06404309479F6232, 0x00000009EFDA9DA2 };
-const uint64_t p610x8[NWORDS64_FIELD]            = { 0xFFFFFFFFFFFFFFF8, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0x700FFFFFFFFFFFFF, 
-                                                     0x8BC26F4552D58173, 0xD73DFA28247FCD5D, 0x92AD97D086212954, 0x0C8086128F3EC465, 0x00000013DFB53B44 };
+const uint64_t p610x8[NWORDS64_FIELD]            = { 0xFFFFFFFFFFFFFFF8, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0x700FFFFFFFFFFFFF, 
+                                                     0x8BC26F4552D58173, 0xD73DFA28247FCD5D, 0x92AD97D086212954, 0x0C8086128F3EC465, 0x00000013DFB53B44 };
 const uint64_t p610p1[NWORDS64_FIELD]            = { 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x6E02000000000000,
                                                      0xB1784DE8AA5AB02E, 0x9AE7BF45048FF9AB, 0xB255B2FA10C4252A, 0x819010C251E7D88C, 0x000000027BF6A768 };   
 // Order of Alice's subgroup
@@ -74,6 +74,9 @@ const uint64_t Montgomery_one[NWORDS64_FIELD]    = { 0x00000000670CC8E6, 0x00000
 
 
 // Fixed parameters for isogeny tree computation
+#if defined(_TUNED_STRATEGIES_)
+    #include "P610_strategies.h"
+#else
 const unsigned int strat_Alice[MAX_Alice-1] = { 
 67, 37, 21, 12, 7, 4, 2, 1, 1, 2, 1, 1, 3, 2, 1, 1, 1, 1, 5, 3, 2, 1, 1, 1, 1, 
 2, 1, 1, 1, 9, 5, 3, 2, 1, 1, 1, 1, 2, 1, 1, 1, 4, 2, 1, 1, 1, 2, 1, 1, 16, 9, 
@@ -92,6 +95,55 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 1, 1, 2, 1, 1, 1, 4, 2, 1, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 
 1, 1 };
 
+#if defined(_THREADS_)
+// Strategies for the parallel isogeny evaluation with 2, 4 and 8 threads, generated with tools/strategies.c
+// nthreads = 2, p = 7918, q = 6111, modeled cost = 6389343, 12 intermediate points
+const unsigned int strat_Alice_2[MAX_Alice-1] = { 
+52, 34, 22, 14, 9, 7, 5, 3, 2, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 2, 2, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 5, 3, 2, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 
+8, 5, 3, 2, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 12, 8, 5, 3, 2, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 4, 3, 2, 
+1, 1, 1, 1, 1, 1, 1, 1, 18, 12, 8, 5, 3, 2, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 6, 4, 3, 2, 
+1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1 };
+
+// nthreads = 2, p = 7082, q = 3010, modeled cost = 5800597, 16 intermediate points
+const unsigned int strat_Bob_2[MAX_Bob-1] = { 
+49, 37, 27, 20, 15, 11, 8, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 
+1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 7, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 10, 7, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 3, 2, 1, 1, 
+1, 1, 1, 1, 1, 12, 10, 7, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 1, 3, 2, 2, 1, 
+1, 1, 1, 1, 1, 1, 1 };
+
+// nthreads = 4, p = 7918, q = 6111, modeled cost = 4998408, 16 intermediate points
+const unsigned int strat_Alice_4[MAX_Alice-1] = { 
+37, 27, 20, 17, 14, 10, 7, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 4, 3, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 7, 5, 4, 
+3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 10, 7, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 
+1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 1 };
+
+// nthreads = 4, p = 7082, q = 3010, modeled cost = 4693438, 25 intermediate points
+const unsigned int strat_Bob_4[MAX_Bob-1] = { 
+31, 26, 24, 19, 15, 12, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 4, 
+3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1 };
+
+// nthreads = 8, p = 7918, q = 6111, modeled cost = 4094629, 22 intermediate points
+const unsigned int strat_Alice_8[MAX_Alice-1] = { 
+29, 23, 18, 14, 11, 9, 8, 7, 6, 5, 4, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+// nthreads = 8, p = 7082, q = 3010, modeled cost = 3896485, 37 intermediate points
+const unsigned int strat_Bob_8[MAX_Bob-1] = { 
+18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1 };
+#endif
+#endif
+
 // Setting up macro defines and including GF(p), GF(p^2), curve, isogeny and kex functions
 #define fpcopy                        fpcopy610
 #define fpzero                        fpzero610
@@ -101,11 +153,13 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fpdiv2                        fpdiv2_610
 #define fpcorrection                  fpcorrection610
 #define fpmul                         fpmul610
+#define fpsqr                         fpsqr610
 #define fpmul_mont                    fpmul610_mont
 #define fpsqr_mont                    fpsqr610_mont
 #define fpinv_mont                    fpinv610_mont
 #define fpinv_chain_mont              fpinv610_chain_mont
 #define fpinv_mont_bingcd             fpinv610_mont_bingcd
+#define is_sqr_fp                     is_sqr_fp610
 #define fp2copy                       fp2copy610
 #define fp2zero                       fp2zero610
 #define fp2add                        fp2add610
@@ -118,12 +172,16 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fp2correction                 fp2correction610
 #define fp2mul_mont                   fp2mul610_mont
 #define fp2sqr_mont                   fp2sqr610_mont
+#define ladder3pt_step_asm            ladder3pt_step610_asm
+#define xDBLe_asm                     xDBLe610_asm
+#define xTPLe_asm                     xTPLe610_asm
 #define fp2mul_c0_mont                fp2mul610_c0_mont
 #define fp2mul_c1_mont                fp2mul610_c1_mont
 #define fp2sqr_c0_mont                fp2sqr610_c0_mont
 #define fp2sqr_c1_mont                fp2sqr610_c1_mont
 #define fp2inv_mont                   fp2inv610_mont
 #define fp2inv_mont_bingcd            fp2inv610_mont_bingcd
+#define is_sqr_fp2                    is_sqr_fp2_610
 #define fpequal_non_constant_time     fpequal610_non_constant_time
 #define mp_add_asm                    mp_add610_asm
 #define mp_subaddx2_asm               mp_subadd610x2_asm
@@ -131,6 +189,15 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp610
 #define crypto_kem_enc                crypto_kem_enc_SIKEp610
 #define crypto_kem_dec                crypto_kem_dec_SIKEp610
+#define crypto_kem_enc_batch          crypto_kem_enc_batch_SIKEp610
+#define crypto_kem_dec_batch          crypto_kem_dec_batch_SIKEp610
+#define crypto_kem_expand_pk          crypto_kem_expand_pk_SIKEp610
+#define crypto_kem_enc_expanded       crypto_kem_enc_expanded_SIKEp610
+#define crypto_kem_expand_sk          crypto_kem_expand_sk_SIKEp610
+#define crypto_kem_dec_expanded       crypto_kem_dec_expanded_SIKEp610
+#define crypto_kem_pool_start         crypto_kem_pool_start_SIKEp610
+#define crypto_kem_pool_stop          crypto_kem_pool_stop_SIKEp610
+#define crypto_kem_keypair_pooled     crypto_kem_keypair_pooled_SIKEp610
 #define random_mod_order_A            random_mod_order_A_SIDHp610
 #define random_mod_order_B            random_mod_order_B_SIDHp610
 #define EphemeralKeyGeneration_A      EphemeralKeyGeneration_A_SIDHp610
@@ -138,7 +205,22 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define EphemeralSecretAgreement_A    EphemeralSecretAgreement_A_SIDHp610
 #define EphemeralSecretAgreement_B    EphemeralSecretAgreement_B_SIDHp610
 
+#if defined(_IFMA_)
+#define fp2_pack_x8                   fp2_pack610_x8
+#define fp2_unpack_x8                 fp2_unpack610_x8
+#define fp2add_x8                     fp2add610_x8
+#define fp2sub_x8                     fp2sub610_x8
+#define fp2mul_mont_x8                fp2mul610_mont_x8
+#define fp2sqr_mont_x8                fp2sqr610_mont_x8
+#endif
+
 #include "../fpx.c"
 #include "../ec_isogeny.c"
+#if defined(_FIXED_BASE_)
+#include "P610_ladder_tables.c"
+#endif
 #include "../sidh.c"
+#if defined(_IFMA_)
+#include "../sidh_x8.c"
+#endif
 #include "../sike.c"
\ No newline at end of file
@@ -163,6 +163,7 @@ const unsigned int strat_Bob[MAX_Bob-1] = { 86, 48, 27, 15, 8, 4, 2, 1, 1, 2, 1,
 
 
 
+#if !defined(_DLOG_TABLES_)
 // Fixed traversal strategies for Pohlig-Hellman discrete logs
 const unsigned int ph2_path[PLEN_2] = {
 #ifdef COMPRESSED_TABLES
@@ -183,6 +184,7 @@ const unsigned int ph3_path[PLEN_3] = {
     #endif
 #endif
 };
+#endif
 
 
 // Entangled bases related static tables and parameters
@@ -192,7 +194,7 @@ const unsigned int ph3_path[PLEN_3] = {
 //      Two tables of 17 elements each for the values r in F_p such that v = 1/(1+ur^2) where r is already converted to Montgomery representation
 //      Also, 2 tables for the quadratic residues (qr) and quadratric non residues (qnr) v in F_{p^2} with 17 GF(p^2) elements each. 
 // For the 3^eB-torsion basis generation:
-//      A table of size 20 for values v = 1/(1+U*r^2) where U = 4+i
+//      A table of size 20 for values v = 1/(1+U*r^2) where U = 4+i, or of size TABLE_V3_LEN generated by "make elligator_tables"
 
 const uint64_t u_entang[2*NWORDS64_FIELD] = {
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0xCE1991CC,0x0,0x0,0x0,0x3468000000000000,0x9B33857A50E2F47F,0x149430734647A838,0xA56C442BA0D5A3C4,0x26D204DD0C595E7B,0x21129D2C8};
@@ -313,6 +315,7 @@ const uint64_t table_v_qnr[TABLE_V_LEN][NWORDS64_FIELD] =
 {0xB04ACFA73EA0C46C,0xCF933F68BB9B3F4A,0x15AE5CE2F27DB04C,0x1695B1823A1F6D59,0xD753A316CA51CB6,0x7445E2D99B0BA50B,0xB6F9A9A580E786,0x51545996DACD4F17,0x112B452323F4F0A3,0xAFBF4B5F},
 {0xA8982A5E43B37B3,0x4D1DFB947C1F2BC7,0x7A938628C766F64A,0x545AB97381CCDA04,0xD8ACCB93F83D4C5B,0xCA5959634A186221,0x9E72DEA20E161486,0x3FB2EF9969B4F6C,0xA62EC7356550C78,0x1C0F7BD25}};
 
+#if !defined(_ELLIGATOR_TABLES_)
 const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] = 
 {{0x6EB3E454124AAF4,0xEB3E45306EB3E453,0x3E45306EB3E45306,0x45306EB3E45306EB,0x286B3E45306EB3E,0x375E62F5BC7C82AF,0x650BCBF202B9AE38,0x3FDD465F450DFCFD,0xC63A99445C986900,0x250ED785C,0x2983759F1FCF38D7,0x83759F22983759F2,0x759F22983759F229,0x9F22983759F22983,0x4EEA3759F2298375,0x87430979EEB424F2,0x4D75F319566660DA,0x30CD05437A146239,0xA2641600BDE8C04,0x712AA3BE},
 {0xCF43C7FB897F2FE2,0x3C7FB84C2F0E011E,0xFB84C2F0E011ECF4,0x4C2F0E011ECF43C7,0x751C11ECF43C7FB8,0x1D007C113B5D095,0x4235B0D5E66773CE,0x9E42B6C94350F39E,0xB98F10656ABF493B,0xA2738C79,0xC023D9E87818892A,0x3D9E878FF70985E1,0xE878FF70985E1C02,0x8FF70985E1C023D9,0x52445E1C023D9E87,0xC4A56A1DB3037852,0xBE1F9B0F8C463146,0xD7DB04211C8A255B,0x87C4C4B67CF93C1C,0x96C2BFBD},
@@ -334,6 +337,10 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 {0xBDF8A208F713F4A9,0x18481280856177D9,0x10BD738108662F2C,0x1EF37C1AB5531600,0x98D3C52040B3E9DB,0x8E988D26C011FF69,0x18AE98AA255688B,0x8E60CDC1B136648B,0x7E91BFE825833F56,0x13DB93F4A,0xC90DED2C7313B98,0x82F6CE5855C8D3AC,0xD22BF07E7380D124,0xE912C49BBF549FD8,0xBD34790D9C351C45,0x4A1A372896AB66BF,0x44E6AD3D3CB7D968,0x473B9962DF10B605,0x2DC4E87221525887,0xD61465},
 {0x3E77A9B726C4E35A,0x72508865383E24E9,0x703A850A1795B24B,0xB744F39B78F82E6,0xBCA3D4CB44C8DE88,0x98BB9A1523EDC1A1,0x1055B9EF0ED241A1,0xDF619C4A7A3305B,0xD3CAD19AFBE71CE8,0x8A810A03,0x78553A5AD2AFD1FC,0x87C486E5D053F7C5,0xD49A2C8D3988259,0xD059B9BB567D1CB1,0x5D10F35FBB64BF63,0xB6A58DE0F78BF9DD,0xCD0DEBAFEA4B0478,0xDAF46A0964D3FD0A,0x8E33C74FE2F70AFC,0x21CAAD2F8},
 {0x3BABE989C4B7C8C6,0x2BF8F447EF3BDD7D,0x20EAAD8C5457CF18,0x8C176F27BA3E5B6D,0x6994DF1010BAB10B,0xC508E30E46C0CA1E,0xA48AA3C16405257B,0xFDA00D371BEC4681,0x9D86B52EDF6EC9F8,0x1C34BB8B6,0xADB4F379816C780A,0xC25F504173CEACF5,0x1DA0375FEB0BBE8C,0xB87264B37860585,0xE0E1B8080C0215AB,0xA4E2CD906374B7FC,0x5326260B7A3021ED,0x168C806A9FD020B4,0xDD2E356F2066C037,0x110BD582B}};
+#else
+    #define ELLIGATOR_TABLES_DATA
+    #include "P610_elligator_tables.h"    // Larger table and the extension of the tables of the 2^eA-torsion
+#endif
 
 // Setting up macro defines and including GF(p), GF(p^2), curve, isogeny and kex functions
 #define fpcopy                        fpcopy610
@@ -344,11 +351,13 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 #define fpdiv2                        fpdiv2_610
 #define fpcorrection                  fpcorrection610
 #define fpmul                         fpmul610
+#define fpsqr                         fpsqr610
 #define fpmul_mont                    fpmul610_mont
 #define fpsqr_mont                    fpsqr610_mont
 #define fpinv_mont                    fpinv610_mont
 #define fpinv_chain_mont              fpinv610_chain_mont
 #define fpinv_mont_bingcd             fpinv610_mont_bingcd
+#define is_sqr_fp                     is_sqr_fp610
 #define fp2copy                       fp2copy610
 #define fp2zero                       fp2zero610
 #define fp2add                        fp2add610
@@ -361,18 +370,23 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 #define fp2correction                 fp2correction610
 #define fp2mul_mont                   fp2mul610_mont
 #define fp2sqr_mont                   fp2sqr610_mont
+#define ladder3pt_step_asm            ladder3pt_step610_asm
+#define xDBLe_asm                     xDBLe610_asm
+#define xTPLe_asm                     xTPLe610_asm
 #define fp2mul_c0_mont                fp2mul610_c0_mont
 #define fp2mul_c1_mont                fp2mul610_c1_mont
 #define fp2sqr_c0_mont                fp2sqr610_c0_mont
 #define fp2sqr_c1_mont                fp2sqr610_c1_mont
 #define fp2inv_mont                   fp2inv610_mont
 #define fp2inv_mont_bingcd            fp2inv610_mont_bingcd
+#define is_sqr_fp2                    is_sqr_fp2_610
 #define fpequal_non_constant_time     fpequal610_non_constant_time
 #define mp_add_asm                    mp_add610_asm
 #define mp_subaddx2_asm               mp_subadd610x2_asm
 #define mp_dblsubx2_asm               mp_dblsub610x2_asm
 #define random_mod_order_A            random_mod_order_A_SIDHp610
 #define random_mod_order_B            random_mod_order_B_SIDHp610
+#define tables_load                   tables_load_SIDHp610_compressed
 #define EphemeralKeyGeneration_A      EphemeralKeyGeneration_A_SIDHp610_Compressed
 #define EphemeralKeyGeneration_B      EphemeralKeyGeneration_B_SIDHp610_Compressed
 #define EphemeralSecretAgreement_A    EphemeralSecretAgreement_A_SIDHp610_Compressed
@@ -380,14 +394,30 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp610_compressed
 #define crypto_kem_enc                crypto_kem_enc_SIKEp610_compressed
 #define crypto_kem_dec                crypto_kem_dec_SIKEp610_compressed
+#define crypto_kem_enc_batch          crypto_kem_enc_batch_SIKEp610_compressed
+#define crypto_kem_dec_batch          crypto_kem_dec_batch_SIKEp610_compressed
+#define crypto_kem_pool_start         crypto_kem_pool_start_SIKEp610_compressed
+#define crypto_kem_pool_stop          crypto_kem_pool_stop_SIKEp610_compressed
+#define crypto_kem_keypair_pooled     crypto_kem_keypair_pooled_SIKEp610_compressed
 
 
 #include "../fpx.c"
 #include "../ec_isogeny.c"
 #include "../compression/torsion_basis.c"
-#include "P610_compressed_pair_tables.c"
+#define TABLES_BLOB_NAME              "SIDHp610_compressed"
+#define TABLES_BLOB_FILE              "src/P610/P610_compressed_tables.bin"     // Written by "make tables_blob"
+#if defined(_TABLE_BLOB_)
+    #include "../compression/tables_blob.c"
+#else
+    #include "P610_compressed_pair_tables.c"
+#endif
 #include "../compression/pairing.c"
-#include "P610_compressed_dlog_tables.c"
+#if defined(_DLOG_TABLES_)
+    #define DLOG_TABLES_DATA
+    #include "P610_dlog_tables.h"
+#elif !defined(_TABLE_BLOB_)
+    #include "P610_compressed_dlog_tables.c"
+#endif
 #include "../compression/dlog.c"
 #include "../compression/sidh_compressed.c"
 #include "../compression/sike_compressed.c"
@@ -40,6 +40,49 @@ int crypto_kem_enc_SIKEp610_compressed(unsigned char *ct, unsigned char *ss, con
 // Outputs: shared secret ss      (CRYPTO_BYTES = 24 bytes)
 int crypto_kem_dec_SIKEp610_compressed(unsigned char *ss, const unsigned char *ct, const unsigned char *sk);
 
+// SIKE's batched encapsulation
+// Encapsulates under count public keys, sharing field inversions across the batch.
+// Input:   count public keys pk          (count*CRYPTO_PUBLICKEYBYTES = count*274 bytes, contiguous)
+// Outputs: count shared secrets ss       (count*CRYPTO_BYTES = count*24 bytes, contiguous)
+//          count ciphertext messages ct  (count*CRYPTO_CIPHERTEXTBYTES = count*336 bytes, contiguous)
+int crypto_kem_enc_batch_SIKEp610_compressed(unsigned char *ct, unsigned char *ss, const unsigned char *pk, unsigned int count);
+
+// SIKE's batched decapsulation
+// Decapsulates count ciphertexts, the i-th one with the i-th secret key, sharing field inversions across the batch.
+// Input:   count secret keys sk          (count*CRYPTO_SECRETKEYBYTES = count*491 bytes, contiguous)
+//          count ciphertext messages ct  (count*CRYPTO_CIPHERTEXTBYTES = count*336 bytes, contiguous) 
+// Outputs: count shared secrets ss       (count*CRYPTO_BYTES = count*24 bytes, contiguous)
+int crypto_kem_dec_batch_SIKEp610_compressed(unsigned char *ss, const unsigned char *ct, const unsigned char *sk, unsigned int count);
+
+// SIKE's keypair pool, only available when compiling with USE_THREADS=TRUE
+// Starts nthreads background threads that generate keypairs until high of them are ready, and resume when only low are left (low < high <= 4096).
+// Returns 0 on success. It must not be called concurrently with crypto_kem_pool_stop_SIKEp610_compressed.
+int crypto_kem_pool_start_SIKEp610_compressed(unsigned int nthreads, unsigned int low, unsigned int high);
+
+// Stops the background threads and wipes the keypairs left in the pool.
+// It must not be called concurrently with the other pool functions.
+void crypto_kem_pool_stop_SIKEp610_compressed(void);
+
+// SIKE's key generation from the keypair pool
+// Pops a ready keypair, or generates one with crypto_kem_keypair_SIKEp610_compressed if the pool is empty or not running.
+// Outputs: secret key sk (CRYPTO_SECRETKEYBYTES = 491 bytes)
+//          public key pk (CRYPTO_PUBLICKEYBYTES = 274 bytes)
+int crypto_kem_keypair_pooled_SIKEp610_compressed(unsigned char *pk, unsigned char *sk);
+
+// Number of threads used for the parallel isogeny evaluations, only available when compiling with USE_THREADS=TRUE
+// Sets nthreads, including the calling thread. nthreads = 1 (default) disables parallelism.
+// Returns 0 on success. It must not be called concurrently with other library functions.
+int threadpool_set_num_threads(unsigned int nthreads);
+
+// Returns the number of threads used for the parallel isogeny evaluations, including the calling thread.
+unsigned int threadpool_get_num_threads(void);
+
+// Precomputed tables of key compression, only available when compiling with USE_TABLE_BLOB=TRUE or USE_TABLE_BLOB=INCBIN
+// Maps the blob written by "make tables_blob" from path (ignored with USE_TABLE_BLOB=INCBIN, where the blob is embedded) and
+// validates its version, parameters and checksum. It must be called, not concurrently, before the other functions of
+// SIKEp610_compressed and SIDHp610_Compressed. Returns 0 on success.
+int tables_load_SIDHp610_compressed(const char* path);
+
 
 // Encoding of keys for KEM-based isogeny system "SIKEp610" (wire format):
 // ----------------------------------------------------------------------
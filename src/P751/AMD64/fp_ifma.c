@@ -0,0 +1,51 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license 
+*
+* Abstract: 8-way modular arithmetic using AVX-512 IFMA for P751
+*********************************************************************************************/
+
+#include "../P751_internal.h"
+#include "../../internal.h"
+
+
+// Constants in radix 2^52
+// 2 * p751
+static const uint64_t px2_52[NLIMBS52_FIELD]           = { 0xFFFFFFFFFFFFE, 0xFFFFFFFFFFFFF, 0xFFFFFFFFFFFFF, 0xFFFFFFFFFFFFF,
+                                                           0xFFFFFFFFFFFFF, 0xFFFFFFFFFFFFF, 0xFFFFFFFFFFFFF, 0x93F0F151DD5FF,
+                                                           0xF98EDC7D92D0A, 0xEDB52B363427E, 0x09D30CFADD7D0, 0x6A08B964AE901,
+                                                           0xF2F75B8CD0AC5, 0x83EE381C25213, 0x0000000DFCBAA };
+// p751 + 1
+static const uint64_t pp1_52[NLIMBS52_FIELD]           = { 0x0000000000000, 0x0000000000000, 0x0000000000000, 0x0000000000000,
+                                                           0x0000000000000, 0x0000000000000, 0x0000000000000, 0x49F878A8EEB00,
+                                                           0x7CC76E3EC9685, 0x76DA959B1A13F, 0x84E9867D6EBE8, 0xB5045CB257480,
+                                                           0xF97BADC668562, 0x41F71C0E12909, 0x00000006FE5D5 };
+// (2^780)^2/2^768 mod p751, maps a*2^768 to a*2^780 in the Montgomery domain
+static const uint64_t Montgomery_to52[NLIMBS52_FIELD]  = { 0x00249AD67C3FF, 0x0000000000000, 0x0000000000000, 0x0000000000000,
+                                                           0x0000000000000, 0x0000000000000, 0x0000000000000, 0xE822291A2EB00,
+                                                           0xC397715452356, 0x82A796EA41E7E, 0xC83FB3EDF886E, 0x19B40AAC77043,
+                                                           0xDC309584457DC, 0xD7CA701397670, 0x000000067FAC9 };
+// 2^768 mod p751, maps a*2^780 back to a*2^768 in the Montgomery domain
+static const uint64_t Montgomery_from52[NLIMBS52_FIELD] = { 0x00000000249AD, 0x0000000000000, 0x0000000000000, 0x0000000000000,
+                                                           0x0000000000000, 0x0000000000000, 0x0000000000000, 0x375C6C6683100,
+                                                           0xF24D05527B1E4, 0x2E697797BF3F4, 0x89DB7B2AC5C4E, 0xB439D2076956C,
+                                                           0xC7512C7E94CA4, 0xBCE5E210F7926, 0x00000002D5B24 };
+
+#define fpcopy                        fpcopy751
+#define fp_pack_x8                    fp_pack751_x8
+#define fp_unpack_x8                  fp_unpack751_x8
+#define fp2_pack_x8                   fp2_pack751_x8
+#define fp2_unpack_x8                 fp2_unpack751_x8
+#define fpadd_x8                      fpadd751_x8
+#define fpsub_x8                      fpsub751_x8
+#define fpmul_mont_x8                 fpmul751_mont_x8
+#define fpsqr_mont_x8                 fpsqr751_mont_x8
+#define fp2add_x8                     fp2add751_x8
+#define fp2sub_x8                     fp2sub751_x8
+#define fp2mul_mont_x8                fp2mul751_mont_x8
+#define fp2sqr_mont_x8                fp2sqr751_mont_x8
+
+#include "../../fpx_ifma.c"
@@ -18,6 +18,34 @@ extern const uint64_t p751p1[NWORDS_FIELD];
 extern const uint64_t p751x2[NWORDS_FIELD];   
 extern const uint64_t p751x4[NWORDS_FIELD];
 
+#if defined(_DISPATCH_) && (OS_TARGET == OS_NIX)
+    // Portable kernels of generic/fp_generic.c, renamed so that they sit next to the assembly-based ones below
+    #define mp_sub751_p2        mp_sub751_p2_portable
+    #define mp_sub751_p4        mp_sub751_p4_portable
+    #define fpadd751            fpadd751_portable
+    #define fpsub751            fpsub751_portable
+    #define fpneg751            fpneg751_portable
+    #define fpdiv2_751          fpdiv2_751_portable
+    #define fpcorrection751     fpcorrection751_portable
+    #define digit_x_digit       digit_x_digit_portable
+    #define mp_mul              mp_mul_portable
+    #define mp_sqr              mp_sqr_portable
+    #define rdc_mont            rdc_mont_portable
+    #include "../generic/fp_generic.c"
+    #undef mp_sub751_p2
+    #undef mp_sub751_p4
+    #undef fpadd751
+    #undef fpsub751
+    #undef fpneg751
+    #undef fpdiv2_751
+    #undef fpcorrection751
+    #undef digit_x_digit
+    #undef mp_mul
+    #undef mp_sqr
+    #undef rdc_mont
+    #include "../../fpx_dispatch.c"
+#endif
+
 
 inline void mp_sub751_p2(const digit_t* a, const digit_t* b, digit_t* c)
 { // Multiprecision subtraction with correction with 2*p, c = a-b+2p.    
@@ -576,13 +604,36 @@ void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int n
     c[23] = uv[1];
 
 #elif (OS_TARGET == OS_NIX)
-    
+
+#if defined(_DISPATCH_)
+    if (!mulx_adx_supported) {
+        mp_mul_portable(a, b, c, nwords);
+        return;
+    }
+#endif
     mul751_asm(a, b, c);
 
 #endif
 }
 
 
+void mp_sqr(const digit_t* a, digit_t* c, const unsigned int nwords)
+{ // Multiprecision squaring, c = a^2, where lng(a) = nwords.
+
+#if (OS_TARGET == OS_WIN)
+    mp_mul(a, a, c, nwords);
+
+#elif (OS_TARGET == OS_NIX)
+
+    UNREFERENCED_PARAMETER(nwords);
+
+    // sqr751_asm only uses MUL, so it needs no MULX/ADX dispatch
+    sqr751_asm(a, c);
+
+#endif
+}
+
+
 void rdc_mont(digit_t* ma, digit_t* mc)
 { // Montgomery reduction exploiting special form of the prime.
   // mc = ma*R^-1 mod p751x2, where R = 2^768.
@@ -904,7 +955,13 @@ void rdc_mont(digit_t* ma, digit_t* mc)
     ADDC(0, uv[1], ma[23], carry, mc[11]); 
     
 #elif (OS_TARGET == OS_NIX)                 
-    
+
+#if defined(_DISPATCH_)
+    if (!mulx_adx_supported) {
+        rdc_mont_portable(ma, mc);
+        return;
+    }
+#endif
     rdc751_asm(ma, mc);    
 
 #endif
@@ -72,6 +72,9 @@ const uint64_t Montgomery_one[NWORDS64_FIELD]    = { 0x00000000000249ad, 0x00000
 
 
 // Fixed parameters for isogeny tree computation
+#if defined(_TUNED_STRATEGIES_)
+    #include "P751_strategies.h"
+#else
 const unsigned int strat_Alice[MAX_Alice-1] = { 
 80, 48, 27, 15, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 7, 4, 2, 1, 1, 2, 1, 
 1, 3, 2, 1, 1, 1, 1, 12, 7, 4, 2, 1, 1, 2, 1, 1, 3, 2, 1, 1, 1, 1, 5, 3, 2, 1, 1, 
@@ -92,6 +95,61 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 1, 1, 1, 21, 12, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 5, 3, 2, 1, 1, 1, 1, 
 2, 1, 1, 1, 9, 5, 3, 2, 1, 1, 1, 1, 2, 1, 1, 1, 4, 2, 1, 1, 1, 2, 1, 1 };
 
+#if defined(_THREADS_)
+// Strategies for the parallel isogeny evaluation with 2, 4 and 8 threads, generated with tools/strategies.c
+// nthreads = 2, p = 9154, q = 6461, modeled cost = 8933008, 12 intermediate points
+const unsigned int strat_Alice_2[MAX_Alice-1] = { 
+63, 41, 27, 18, 12, 8, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 6, 4, 3, 2, 1, 1, 
+1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 9, 6, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 14, 9, 6, 4, 3, 2, 1, 1, 1, 
+1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 5, 3, 2, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 22, 14, 9, 6, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 
+2, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 5, 3, 2, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 8, 5, 3, 2, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 3, 2, 1, 1, 1, 1, 
+1 };
+
+// nthreads = 2, p = 8437, q = 4204, modeled cost = 9450788, 15 intermediate points
+const unsigned int strat_Bob_2[MAX_Bob-1] = { 
+68, 49, 35, 25, 18, 13, 9, 6, 4, 3, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 7, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 10, 7, 5, 
+4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 1, 14, 10, 7, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 19, 14, 10, 7, 5, 4, 3, 2, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1 };
+
+// nthreads = 4, p = 9154, q = 6461, modeled cost = 6982752, 18 intermediate points
+const unsigned int strat_Alice_4[MAX_Alice-1] = { 
+42, 33, 26, 20, 15, 11, 8, 6, 5, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 3, 2, 
+1, 1, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 6, 5, 4, 3, 2, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 7, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 9, 7, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 
+1 };
+
+// nthreads = 4, p = 8437, q = 4204, modeled cost = 7553022, 23 intermediate points
+const unsigned int strat_Bob_4[MAX_Bob-1] = { 
+44, 36, 29, 24, 22, 17, 13, 10, 8, 7, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 4, 3, 2, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 4, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 6, 5, 4, 3, 2, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 7, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 8, 7, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1 };
+
+// nthreads = 8, p = 9154, q = 6461, modeled cost = 5750498, 26 intermediate points
+const unsigned int strat_Alice_8[MAX_Alice-1] = { 
+31, 25, 20, 16, 13, 11, 10, 9, 8, 7, 6, 5, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 4, 3, 2, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1 };
+
+// nthreads = 8, p = 8437, q = 4204, modeled cost = 6282572, 37 intermediate points
+const unsigned int strat_Bob_8[MAX_Bob-1] = { 
+23, 20, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 8, 7, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1 };
+#endif
+#endif
+
 // Setting up macro defines and including GF(p), GF(p^2), curve, isogeny and kex functions
 #define fpcopy                        fpcopy751
 #define fpzero                        fpzero751
@@ -105,6 +163,7 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fpinv_mont                    fpinv751_mont
 #define fpinv_chain_mont              fpinv751_chain_mont
 #define fpinv_mont_bingcd             fpinv751_mont_bingcd
+#define is_sqr_fp                     is_sqr_fp751
 #define fp2copy                       fp2copy751
 #define fp2zero                       fp2zero751
 #define fp2add                        fp2add751
@@ -117,12 +176,15 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fp2correction                 fp2correction751
 #define fp2mul_mont                   fp2mul751_mont
 #define fp2sqr_mont                   fp2sqr751_mont
+#define xDBLe_asm                     xDBLe751_asm
+#define xTPLe_asm                     xTPLe751_asm
 #define fp2mul_c0_mont                fp2mul751_c0_mont
 #define fp2mul_c1_mont                fp2mul751_c1_mont
 #define fp2sqr_c0_mont                fp2sqr751_c0_mont
 #define fp2sqr_c1_mont                fp2sqr751_c1_mont
 #define fp2inv_mont                   fp2inv751_mont
 #define fp2inv_mont_bingcd            fp2inv751_mont_bingcd
+#define is_sqr_fp2                    is_sqr_fp2_751
 #define fpequal_non_constant_time     fpequal751_non_constant_time
 #define mp_add_asm                    mp_add751_asm
 #define mp_subaddx2_asm               mp_subadd751x2_asm
@@ -130,6 +192,15 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp751
 #define crypto_kem_enc                crypto_kem_enc_SIKEp751
 #define crypto_kem_dec                crypto_kem_dec_SIKEp751
+#define crypto_kem_enc_batch          crypto_kem_enc_batch_SIKEp751
+#define crypto_kem_dec_batch          crypto_kem_dec_batch_SIKEp751
+#define crypto_kem_expand_pk          crypto_kem_expand_pk_SIKEp751
+#define crypto_kem_enc_expanded       crypto_kem_enc_expanded_SIKEp751
+#define crypto_kem_expand_sk          crypto_kem_expand_sk_SIKEp751
+#define crypto_kem_dec_expanded       crypto_kem_dec_expanded_SIKEp751
+#define crypto_kem_pool_start         crypto_kem_pool_start_SIKEp751
+#define crypto_kem_pool_stop          crypto_kem_pool_stop_SIKEp751
+#define crypto_kem_keypair_pooled     crypto_kem_keypair_pooled_SIKEp751
 #define random_mod_order_A            random_mod_order_A_SIDHp751
 #define random_mod_order_B            random_mod_order_B_SIDHp751
 #define EphemeralKeyGeneration_A      EphemeralKeyGeneration_A_SIDHp751
@@ -137,7 +208,22 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define EphemeralSecretAgreement_A    EphemeralSecretAgreement_A_SIDHp751
 #define EphemeralSecretAgreement_B    EphemeralSecretAgreement_B_SIDHp751
 
+#if defined(_IFMA_)
+#define fp2_pack_x8                   fp2_pack751_x8
+#define fp2_unpack_x8                 fp2_unpack751_x8
+#define fp2add_x8                     fp2add751_x8
+#define fp2sub_x8                     fp2sub751_x8
+#define fp2mul_mont_x8                fp2mul751_mont_x8
+#define fp2sqr_mont_x8                fp2sqr751_mont_x8
+#endif
+
 #include "../fpx.c"
 #include "../ec_isogeny.c"
+#if defined(_FIXED_BASE_)
+#include "P751_ladder_tables.c"
+#endif
 #include "../sidh.c"
+#if defined(_IFMA_)
+#include "../sidh_x8.c"
+#endif
 #include "../sike.c"
\ No newline at end of file
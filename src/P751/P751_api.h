@@ -18,6 +18,8 @@
 #define CRYPTO_PUBLICKEYBYTES     564
 #define CRYPTO_BYTES               32
 #define CRYPTO_CIPHERTEXTBYTES    596    // CRYPTO_PUBLICKEYBYTES + MSG_BYTES bytes
+#define CRYPTO_EXPANDEDSECRETKEYBYTES 648    // Expanded secret key for crypto_kem_dec_expanded
+#define CRYPTO_EXPANDEDPUBLICKEYBYTES 72760  // Expanded public key for crypto_kem_enc_expanded
 
 // Algorithm name
 #define CRYPTO_ALGNAME "SIKEp751"  
@@ -40,6 +42,69 @@ int crypto_kem_enc_SIKEp751(unsigned char *ct, unsigned char *ss, const unsigned
 // Outputs: shared secret ss      (CRYPTO_BYTES = 32 bytes)
 int crypto_kem_dec_SIKEp751(unsigned char *ss, const unsigned char *ct, const unsigned char *sk);
 
+// SIKE's batched encapsulation
+// Encapsulates under count public keys, sharing field inversions across the batch.
+// Input:   count public keys pk          (count*CRYPTO_PUBLICKEYBYTES = count*564 bytes, contiguous)
+// Outputs: count shared secrets ss       (count*CRYPTO_BYTES = count*32 bytes, contiguous)
+//          count ciphertext messages ct  (count*CRYPTO_CIPHERTEXTBYTES = count*596 bytes, contiguous)
+int crypto_kem_enc_batch_SIKEp751(unsigned char *ct, unsigned char *ss, const unsigned char *pk, unsigned int count);
+
+// SIKE's batched decapsulation
+// Decapsulates count ciphertexts, the i-th one with the i-th secret key, sharing field inversions across the batch.
+// Input:   count secret keys sk          (count*CRYPTO_SECRETKEYBYTES = count*644 bytes, contiguous)
+//          count ciphertext messages ct  (count*CRYPTO_CIPHERTEXTBYTES = count*596 bytes, contiguous) 
+// Outputs: count shared secrets ss       (count*CRYPTO_BYTES = count*32 bytes, contiguous)
+int crypto_kem_dec_batch_SIKEp751(unsigned char *ss, const unsigned char *ct, const unsigned char *sk, unsigned int count);
+
+// SIKE's public key expansion
+// Precomputes a context for pk with the decoded public key and a ladder table, for repeated encapsulation to the same key.
+// The expanded public key contains only public data. The buffer epk must be aligned to 8 bytes.
+// Input:   public key pk          (CRYPTO_PUBLICKEYBYTES = 564 bytes)
+// Outputs: expanded public key epk (CRYPTO_EXPANDEDPUBLICKEYBYTES = 72760 bytes)
+int crypto_kem_expand_pk_SIKEp751(unsigned char *epk, const unsigned char *pk);
+
+// SIKE's encapsulation using an expanded public key
+// Input:   expanded public key epk (CRYPTO_EXPANDEDPUBLICKEYBYTES = 72760 bytes)
+// Outputs: shared secret ss        (CRYPTO_BYTES = 32 bytes)
+//          ciphertext message ct   (CRYPTO_CIPHERTEXTBYTES = 596 bytes)
+int crypto_kem_enc_expanded_SIKEp751(unsigned char *ct, unsigned char *ss, const unsigned char *epk);
+
+// SIKE's secret key expansion
+// Decodes sk once into the format used by crypto_kem_dec_expanded, for repeated decapsulation with the same key.
+// The expanded secret key must be protected like sk. The buffer esk must be aligned to 8 bytes.
+// Input:   secret key sk          (CRYPTO_SECRETKEYBYTES = 644 bytes)
+// Outputs: expanded secret key esk (CRYPTO_EXPANDEDSECRETKEYBYTES = 648 bytes)
+int crypto_kem_expand_sk_SIKEp751(unsigned char *esk, const unsigned char *sk);
+
+// SIKE's decapsulation using an expanded secret key
+// Input:   expanded secret key esk (CRYPTO_EXPANDEDSECRETKEYBYTES = 648 bytes)
+//          ciphertext message ct   (CRYPTO_CIPHERTEXTBYTES = 596 bytes) 
+// Outputs: shared secret ss        (CRYPTO_BYTES = 32 bytes)
+int crypto_kem_dec_expanded_SIKEp751(unsigned char *ss, const unsigned char *ct, const unsigned char *esk);
+
+// SIKE's keypair pool, only available when compiling with USE_THREADS=TRUE
+// Starts nthreads background threads that generate keypairs until high of them are ready, and resume when only low are left (low < high <= 4096).
+// Returns 0 on success. It must not be called concurrently with crypto_kem_pool_stop_SIKEp751.
+int crypto_kem_pool_start_SIKEp751(unsigned int nthreads, unsigned int low, unsigned int high);
+
+// Stops the background threads and wipes the keypairs left in the pool.
+// It must not be called concurrently with the other pool functions.
+void crypto_kem_pool_stop_SIKEp751(void);
+
+// SIKE's key generation from the keypair pool
+// Pops a ready keypair, or generates one with crypto_kem_keypair_SIKEp751 if the pool is empty or not running.
+// Outputs: secret key sk (CRYPTO_SECRETKEYBYTES = 644 bytes)
+//          public key pk (CRYPTO_PUBLICKEYBYTES = 564 bytes)
+int crypto_kem_keypair_pooled_SIKEp751(unsigned char *pk, unsigned char *sk);
+
+// Number of threads used for the parallel isogeny evaluations, only available when compiling with USE_THREADS=TRUE
+// Sets nthreads, including the calling thread. nthreads = 1 (default) disables parallelism.
+// Returns 0 on success. It must not be called concurrently with other library functions.
+int threadpool_set_num_threads(unsigned int nthreads);
+
+// Returns the number of threads used for the parallel isogeny evaluations, including the calling thread.
+unsigned int threadpool_get_num_threads(void);
+
 
 // Encoding of keys for KEM-based isogeny system "SIKEp751" (wire format):
 // ----------------------------------------------------------------------
@@ -174,6 +174,7 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 1, 1, 1, 21, 12, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 5, 3, 2, 1, 1, 1, 1, 
 2, 1, 1, 1, 9, 5, 3, 2, 1, 1, 1, 1, 2, 1, 1, 1, 4, 2, 1, 1, 1, 2, 1, 1 };
 
+#if !defined(_DLOG_TABLES_)
 // Fixed traversal strategies for Pohlig-Hellman discrete logs
 const unsigned int ph2_path[PLEN_2] = {
   #ifdef COMPRESSED_TABLES
@@ -194,6 +195,7 @@ const unsigned int ph3_path[PLEN_3] = {
     #endif 
   #endif
 };
+#endif
 
 
 // Entangled bases related static tables and parameters
@@ -203,7 +205,7 @@ const unsigned int ph3_path[PLEN_3] = {
 //      Two tables of 17 elements each for the values r in F_p such that v = 1/(1+ur^2) where r is already converted to Montgomery representation
 //      Also, 2 tables for the quadratic residues (qr) and quadratric non residues (qnr) v in F_{p^2} with 17 GF(p^2) elements each. 
 // For the 3^eB-torsion basis generation:
-//      A table of size 20 for values v = 1/(1+U*r^2) where U = 4+i
+//      A table of size 20 for values v = 1/(1+U*r^2) where U = 4+i, or of size TABLE_V3_LEN generated by "make elligator_tables"
 
 const uint64_t u_entang[2*NWORDS64_FIELD] = {
 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 
@@ -329,6 +331,7 @@ const uint64_t table_v_qnr[TABLE_V_LEN][NWORDS64_FIELD] =
 {0xD681EED8B087DAC7,0x90726086FB0A1D9F,0x643AD6038FE15FF2,0xF6524CCDFEB45CE0,0x511BD3AA0B479432,0xFDAA3B25B585A917,0x16C0CA87EB477009,0x5DCAD9871ABB0038,0x5BA46393DEEC08B5,0x9AC8A0B793849197,0xA8F7FEDA5FA4EA5A,0x3A742CC9DEB9}};
 
 
+#if !defined(_ELLIGATOR_TABLES_)
 const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] = 
 {{0xD89D89D89D8A493E,0x9D89D89D89D89D89,0x89D89D89D89D89D8,0xD89D89D89D89D89D,0x9D89D89D89D89D89,0x8B389D89D89D89D8,0xB4C6B9529F01D8C3,0x1399AE2626262260,0xDE85321D9D8185DF,0x8451DC3FDF91784A,0xFAEFD5E487381389,0x6319EE6373CB,0x3B13B13B13B1248D,0x13B13B13B13B13B1,0xB13B13B13B13B13B,0x3B13B13B13B13B13,0x13B13B13B13B13B1,0x7A4B13B13B13B13B,0xA30792A3BBCAECC7,0x8E3262972F905537,0x6EC1E1420B7BAD51,0x3369C4F4190692FF,0x9D6D588BD01A282C,0x28F2E2C80A9},
 {0x673D45AA630B09FB,0x5673D45AA630AE95,0x95673D45AA630AE9,0xE95673D45AA630AE,0xAE95673D45AA630A,0xD4595673D45AA630,0x6D7B45385F91ACC,0x7FDE0F3B044702EF,0xF1BFC4766FC2E18A,0xD67138B8790E3167,0x9EF75C6F0552A406,0x2C5A25459904,0xF6C4681424EE5801,0xAF6C4681424EE5FA,0xFAF6C4681424EE5F,0x5FAF6C4681424EE5,0xE5FAF6C4681424EE,0x7FAFAF6C4681424E,0x71E7F021FC96E1CF,0xBD317223E4665091,0x4D1B06EED834E4E,0xF423F47B02EEF4B8,0xA418B4D55C23C88,0x94F95559E31},
@@ -350,6 +353,10 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 {0xB24323DEA264A910,0xFBB77EB1969BA34D,0x6DFE6BD2DF0E62D,0x4BA1D9212AAC1737,0x6604456CC168CE0D,0x1F045C2902E70B1A,0xC30F3CF005747BBB,0xD0808A1E60231D09,0x616E5202B8B68AB9,0x91279DE1E1F59C61,0x17039A54DE74E351,0x483F7B722965,0xCA63AE6778B0F84E,0x3920204D38EBDF19,0xFB1FE6BAD523F1EC,0x8B34EDE136AC2733,0x7409325BA76B71BB,0x987FACF98158EF9B,0x3EBAB81D7CC6988B,0x518A2D688F371575,0xC77B4766A9D72BCA,0xAF7343FE6E77A7C4,0x54516072DE9FE449,0x52E493B8BEDC},
 {0x95B9273E98BEE101,0x6CF2C2CC7C2F0D29,0xEFE3B76E594AA11B,0x3DDEDCDD1FE42241,0xF7E15F986E39CC89,0x3CF9E152B6FD333B,0xE7F2CF0844AD69DD,0xB792DFF3C762D02E,0x3888F4A332FD9030,0x8A4CC0E4C437575A,0x833E2BA7BAF41403,0x135FE5EBD4BB,0x657D9769E52DAD91,0x84951CC10B514173,0x7678CDEC0CC5511B,0xD4E7DB99FC763848,0xC6ADD473DF8087CE,0x842DE2D06829FA76,0xD086DB2A4651BE48,0xD0399255E5DAD344,0x6B2EAEB21B8BB524,0xF6DE9148F0694AEF,0x5A85093194755805,0x2570D86C9FCF},
 {0xD665CD614A703CBD,0x7251A4FFE04E2B30,0x8AD6A13EAA0B07BC,0x2AB5112D91260BE2,0xF31D78441E75FDE5,0x981D1D465A8768E6,0x7AD08CCEE352CCDD,0x31C6C60ACD409AC7,0xDFC10AD642C330AA,0x16DA3C495AE40C44,0x89AB4B294D700C6D,0x13081265A555,0xB649623190FAD2EC,0x9E0A9F4A626C11FD,0xEF8A6A8092D66371,0xEB9370EA38CC1EED,0x74BF8D8667FFF12C,0xF931EE21E90FE5CA,0x5E180EC10EC59AE0,0xBA6729A7EF221E52,0xAEAB0D0AC6ED85F9,0x2401EAF62859B015,0xD309B49CD60C1B34,0x2CBA9B452CC8}};
+#else
+    #define ELLIGATOR_TABLES_DATA
+    #include "P751_elligator_tables.h"    // Larger table and the extension of the tables of the 2^eA-torsion
+#endif
 
 // Setting up macro defines and including GF(p), GF(p^2), curve, isogeny and kex functions
 #define fpcopy                        fpcopy751
@@ -364,6 +371,7 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 #define fpinv_mont                    fpinv751_mont
 #define fpinv_chain_mont              fpinv751_chain_mont
 #define fpinv_mont_bingcd             fpinv751_mont_bingcd
+#define is_sqr_fp                     is_sqr_fp751
 #define fp2copy                       fp2copy751
 #define fp2zero                       fp2zero751
 #define fp2add                        fp2add751
@@ -376,18 +384,22 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 #define fp2correction                 fp2correction751
 #define fp2mul_mont                   fp2mul751_mont
 #define fp2sqr_mont                   fp2sqr751_mont
+#define xDBLe_asm                     xDBLe751_asm
+#define xTPLe_asm                     xTPLe751_asm
 #define fp2mul_c0_mont                fp2mul751_c0_mont
 #define fp2mul_c1_mont                fp2mul751_c1_mont
 #define fp2sqr_c0_mont                fp2sqr751_c0_mont
 #define fp2sqr_c1_mont                fp2sqr751_c1_mont
 #define fp2inv_mont                   fp2inv751_mont
 #define fp2inv_mont_bingcd            fp2inv751_mont_bingcd
+#define is_sqr_fp2                    is_sqr_fp2_751
 #define fpequal_non_constant_time     fpequal751_non_constant_time
 #define mp_add_asm                    mp_add751_asm
 #define mp_subaddx2_asm               mp_subadd751x2_asm
 #define mp_dblsubx2_asm               mp_dblsub751x2_asm
 #define random_mod_order_A            random_mod_order_A_SIDHp751
 #define random_mod_order_B            random_mod_order_B_SIDHp751
+#define tables_load                   tables_load_SIDHp751_compressed
 #define EphemeralKeyGeneration_A      EphemeralKeyGeneration_A_SIDHp751_Compressed
 #define EphemeralKeyGeneration_B      EphemeralKeyGeneration_B_SIDHp751_Compressed
 #define EphemeralSecretAgreement_A    EphemeralSecretAgreement_A_SIDHp751_Compressed
@@ -395,14 +407,30 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp751_compressed
 #define crypto_kem_enc                crypto_kem_enc_SIKEp751_compressed
 #define crypto_kem_dec                crypto_kem_dec_SIKEp751_compressed
+#define crypto_kem_enc_batch          crypto_kem_enc_batch_SIKEp751_compressed
+#define crypto_kem_dec_batch          crypto_kem_dec_batch_SIKEp751_compressed
+#define crypto_kem_pool_start         crypto_kem_pool_start_SIKEp751_compressed
+#define crypto_kem_pool_stop          crypto_kem_pool_stop_SIKEp751_compressed
+#define crypto_kem_keypair_pooled     crypto_kem_keypair_pooled_SIKEp751_compressed
 
 
 #include "../fpx.c"
 #include "../ec_isogeny.c"
 #include "../compression/torsion_basis.c"
-#include "P751_compressed_pair_tables.c"
+#define TABLES_BLOB_NAME              "SIDHp751_compressed"
+#define TABLES_BLOB_FILE              "src/P751/P751_compressed_tables.bin"     // Written by "make tables_blob"
+#if defined(_TABLE_BLOB_)
+    #include "../compression/tables_blob.c"
+#else
+    #include "P751_compressed_pair_tables.c"
+#endif
 #include "../compression/pairing.c"
-#include "P751_compressed_dlog_tables.c"
+#if defined(_DLOG_TABLES_)
+    #define DLOG_TABLES_DATA
+    #include "P751_dlog_tables.h"
+#elif !defined(_TABLE_BLOB_)
+    #include "P751_compressed_dlog_tables.c"
+#endif
 #include "../compression/dlog.c"
 #include "../compression/sidh_compressed.c"
 #include "../compression/sike_compressed.c"
\ No newline at end of file
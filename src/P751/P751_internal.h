@@ -48,6 +48,8 @@
 #define MAX_INT_POINTS_BOB      10 
 #define MAX_Alice               186
 #define MAX_Bob                 239
+#define MAX_INT_POINTS_ALICE_THREADS  26
+#define MAX_INT_POINTS_BOB_THREADS    37
 #define MSG_BYTES               32
 #define SECRETKEY_A_BYTES       ((OALICE_BITS + 7) / 8)
 #define SECRETKEY_B_BYTES       ((OBOB_BITS - 1 + 7) / 8)
@@ -64,36 +66,45 @@
     // Table sizes used by the Entangled basis generation
     #define TABLE_R_LEN 17
     #define TABLE_V_LEN 34
-    #define TABLE_V3_LEN 20
+    #if defined(_ELLIGATOR_TABLES_)
+        #include "P751_elligator_tables.h"   // Generated by "make elligator_tables"
+    #else
+        #define TABLE_V3_LEN 20
+        #define TABLE_R_EXT_LEN 0
+    #endif
     // Parameters for discrete log computations
-    // Binary Pohlig-Hellman reduced to smaller logs of order ell^W
-    #define W_2 4    
-    #define W_3 3
-    // ell^w    
-    #define ELL2_W (1 << W_2)    
-    #define ELL3_W 27
-    // ell^(e mod w) 
-    #define ELL2_EMODW (1 << (OALICE_BITS % W_2))    
-    #define ELL3_EMODW 9
-    // # of digits in the discrete log    
-    #define DLEN_2 ((OALICE_BITS + W_2 - 1) / W_2) // ceil(eA/W_2)
-    #define DLEN_3 ((OBOB_EXPON + W_3 - 1) / W_3) // ceil(eB/W_3)
-    // Use compressed tables: FULL_SIGNED
-    #define COMPRESSED_TABLES
-    #define ELL2_TORUS
-    #define ELL3_FULL_SIGNED    // Uses signed digits to reduce table size by half
-    // Length of the optimal strategy path for Pohlig-Hellman
-    #ifdef COMPRESSED_TABLES
-        #if W_2 == 4
-            #define PLEN_2 94
-        #endif
-        #ifdef ELL2_TORUS
-            #define W_2_1 3
-        #endif
+    #if defined(_DLOG_TABLES_)
+        #include "P751_dlog_tables.h"        // Generated by "make dlog_tables"
+    #else
+        // Binary Pohlig-Hellman reduced to smaller logs of order ell^W
+        #define W_2 4    
+        #define W_3 3
+        // ell^w    
+        #define ELL2_W (1 << W_2)    
+        #define ELL3_W 27
+        // ell^(e mod w) 
+        #define ELL2_EMODW (1 << (OALICE_BITS % W_2))    
+        #define ELL3_EMODW 9
+        // # of digits in the discrete log    
+        #define DLEN_2 ((OALICE_BITS + W_2 - 1) / W_2) // ceil(eA/W_2)
+        #define DLEN_3 ((OBOB_EXPON + W_3 - 1) / W_3) // ceil(eB/W_3)
+        // Use compressed tables: FULL_SIGNED
+        #define COMPRESSED_TABLES
+        #define ELL2_TORUS
+        #define ELL3_FULL_SIGNED    // Uses signed digits to reduce table size by half
+        // Length of the optimal strategy path for Pohlig-Hellman
+        #ifdef COMPRESSED_TABLES
+            #if W_2 == 4
+                #define PLEN_2 94
+            #endif
+            #ifdef ELL2_TORUS
+                #define W_2_1 3
+            #endif
 
-        #ifdef ELL3_FULL_SIGNED
-            #if W_3 == 3
-                #define PLEN_3 81
+            #ifdef ELL3_FULL_SIGNED
+                #if W_3 == 3
+                    #define PLEN_3 81
+                #endif
             #endif
         #endif
     #endif
@@ -105,6 +116,7 @@
 typedef digit_t felm_t[NWORDS_FIELD];                                 // Datatype for representing 751-bit field elements (768-bit max.)
 typedef digit_t dfelm_t[2*NWORDS_FIELD];                              // Datatype for representing double-precision 2x751-bit field elements (2x768-bit max.) 
 typedef felm_t  f2elm_t[2];                                           // Datatype for representing quadratic extension field elements GF(p751^2)
+typedef dfelm_t df2elm_t[2];                                          // Datatype for representing double-precision quadratic extension field elements GF(p751^2)
         
 typedef struct { f2elm_t X; f2elm_t Z; } point_proj;                  // Point representation in projective XZ Montgomery coordinates.
 typedef point_proj point_proj_t[1]; 
@@ -177,6 +189,7 @@ void mul751_asm(const digit_t* a, const digit_t* b, digit_t* c);
    
 // Field squaring using Montgomery arithmetic, c = a*b*R^-1 mod p751, where R=2^768
 void fpsqr751_mont(const digit_t* ma, digit_t* mc);
+void sqr751_asm(const digit_t* a, digit_t* c);
 
 // Field inversion, a = a^-1 in GF(p751)
 void fpinv751_mont(digit_t* a);
@@ -187,6 +200,9 @@ void fpinv751_mont_bingcd(digit_t* a);
 // Chain to compute (p751-3)/4 using Montgomery arithmetic
 void fpinv751_chain_mont(digit_t* a);
 
+// Test if a is a square in GF(p751), returns 1 if true (also for a = 0), 0 otherwise
+unsigned char is_sqr_fp751(const felm_t a);
+
 /************ GF(p^2) arithmetic functions *************/
     
 // Copy of a GF(p751^2) element, c = a
@@ -224,11 +240,52 @@ void fp2mul751_c0_asm(const digit_t* a, const digit_t* b, digit_t* c);
 void fp2mul751_c1_mont(const digit_t* a, const digit_t* b, digit_t* c);
 void fp2mul751_c1_asm(const digit_t* a, const digit_t* b, digit_t* c);
 
+// Repeated doubling Q = [2^e]P as xDBLe, and repeated tripling Q = [3^e]P as xTPLe, in GF(p751^2)
+void xDBLe751_asm(const digit_t* P, digit_t* Q, const digit_t* A24plus, const digit_t* C24, const int e);
+void xTPLe751_asm(const digit_t* P, digit_t* Q, const digit_t* A24minus, const digit_t* A24plus, const int e);
+
 // GF(p751^2) inversion using Montgomery arithmetic, a = (a0-i*a1)/(a0^2+a1^2)
 void fp2inv751_mont(f2elm_t a);
 
 // GF(p751^2) inversion, a = (a0-i*a1)/(a0^2+a1^2), GF(p751) inversion done using the binary GCD 
 void fp2inv751_mont_bingcd(f2elm_t a);
 
+// Test if a is a square in GF(p751^2), returns 1 if true, 0 otherwise
+unsigned char is_sqr_fp2_751(const f2elm_t a);
+
+#if defined(_IFMA_)
+/************ 8-way field arithmetic using AVX-512 IFMA *************/
+
+#define NLIMBS52_FIELD          15               // Number of 52-bit limbs of a 751-bit field element
+#define ZERO_LIMBS52_FIELD      7               // Number of "0" 52-bit limbs in the least significant part of p751 + 1
+
+typedef uint64_t felm_x8_t[NLIMBS52_FIELD][8];                          // Datatype for 8 field elements in radix 2^52, stored limb by limb across the 8 lanes
+typedef felm_x8_t f2elm_x8_t[2];                                       // Datatype for 8 GF(p751^2) elements
+
+// Loading of 8 field elements into the lanes of c, converting from R=2^768 to R'=2^780 Montgomery representation
+void fp_pack751_x8(const felm_t* a, felm_x8_t c);
+void fp2_pack751_x8(const f2elm_t* a, f2elm_x8_t c);
+
+// Extraction of the 8 lane elements of a, converting back to the R=2^768 Montgomery representation
+void fp_unpack751_x8(const felm_x8_t a, felm_t* c);
+void fp2_unpack751_x8(const f2elm_x8_t a, f2elm_t* c);
+
+// 8-way modular addition and subtraction, c = a+b mod p751 and c = a-b mod p751
+void fpadd751_x8(const felm_x8_t a, const felm_x8_t b, felm_x8_t c);
+void fpsub751_x8(const felm_x8_t a, const felm_x8_t b, felm_x8_t c);
+
+// 8-way field multiplication and squaring using Montgomery arithmetic, c = a*b*R'^-1 mod p751 and c = a^2*R'^-1 mod p751
+void fpmul751_mont_x8(const felm_x8_t a, const felm_x8_t b, felm_x8_t c);
+void fpsqr751_mont_x8(const felm_x8_t a, felm_x8_t c);
+
+// 8-way GF(p751^2) addition and subtraction
+void fp2add751_x8(const f2elm_x8_t a, const f2elm_x8_t b, f2elm_x8_t c);
+void fp2sub751_x8(const f2elm_x8_t a, const f2elm_x8_t b, f2elm_x8_t c);
+
+// 8-way GF(p751^2) multiplication and squaring using Montgomery arithmetic
+void fp2mul751_mont_x8(const f2elm_x8_t a, const f2elm_x8_t b, f2elm_x8_t c);
+void fp2sqr751_mont_x8(const f2elm_x8_t a, f2elm_x8_t c);
+#endif
+
 
 #endif
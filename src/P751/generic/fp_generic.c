@@ -205,6 +205,38 @@ void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int n
 }
 
 
+void mp_sqr(const digit_t* a, digit_t* c, const unsigned int nwords)
+{ // Multiprecision comba squaring, c = a^2, where lng(a) = nwords.
+  // Each cross product a[j]*a[i-j], j < i-j, is computed once and doubled.
+    unsigned int i, j, carry = 0;
+    digit_t t = 0, u = 0, v = 0, UV[2];
+
+    for (i = 0; i < 2*nwords-1; i++) {
+        for (j = (i < nwords) ? 0 : i-nwords+1; j < i-j; j++) {
+            MUL(a[j], a[i-j], UV+1, UV[0]);
+            t += UV[1] >> (RADIX-1);
+            UV[1] = (UV[1] << 1) | (UV[0] >> (RADIX-1));
+            UV[0] = UV[0] << 1;
+            ADDC(0, UV[0], v, carry, v); 
+            ADDC(carry, UV[1], u, carry, u); 
+            t += carry;
+        }
+        if ((i & 1) == 0) {
+            MUL(a[i/2], a[i/2], UV+1, UV[0]); 
+            ADDC(0, UV[0], v, carry, v); 
+            ADDC(carry, UV[1], u, carry, u); 
+            t += carry;
+        }
+        c[i] = v;
+        v = u; 
+        u = t;
+        t = 0;
+    }
+    c[2*nwords-1] = v; 
+}
+
+
+
 void rdc_mont(digit_t* ma, digit_t* mc)
 { // Efficient Montgomery reduction using comba and exploiting the special form of the prime p751.
   // mc = ma*R^-1 mod p751x2, where R = 2^768.
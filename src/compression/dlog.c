@@ -247,7 +247,7 @@ void Traverse_w_div_e_torus(const felm_t *r, int j, int k, int z, const unsigned
         fpcorrection((digit_t*)&r[0]);
         fpcorrection((digit_t*)&r[1]);
 
-        D[k] = ord2w_dloghyb(r, (const int *)&ph2_Log, (const felm_t *)&ph2_Texp, (const felm_t *)&ph2_G);           
+        D[k] = ord2w_dloghyb(r, (const int *)ph2_Log, (const felm_t *)ph2_Texp, (const felm_t *)ph2_G);           
     }
 }
 
@@ -414,14 +414,14 @@ void solve_dlog(const f2elm_t r, int *D, digit_t* d, int ell)
     if (ell == 2) {
         felm_t rproj[2];
         toproj(r, rproj);  
-        Traverse_w_div_e_torus(rproj, 0, 0, PLEN_2 - 1, ph2_path, (const felm_t *)&ph2_CT, D, DLEN_2, ELL2_W, W_2);
+        Traverse_w_div_e_torus(rproj, 0, 0, PLEN_2 - 1, ph2_path, (const felm_t *)ph2_CT, D, DLEN_2, ELL2_W, W_2);
 
         from_base(D, d, DLEN_2, ELL2_W);
     } else if (ell == 3) {
         #if (OBOB_EXPON % W_3 == 0)
-            Traverse_w_div_e_fullsigned(r, 0, 0, PLEN_3 - 1, ph3_path, (const felm_t *)&ph3_T, D, DLEN_3, ELL3_W, W_3);
+            Traverse_w_div_e_fullsigned(r, 0, 0, PLEN_3 - 1, ph3_path, (const felm_t *)ph3_T, D, DLEN_3, ELL3_W, W_3);
         #else          
-            Traverse_w_notdiv_e_fullsigned(r, 0, 0, PLEN_3 - 1, ph3_path, (const felm_t *)&ph3_T1, (const felm_t *)&ph3_T2, D, DLEN_3, ell, ELL3_W, ELL3_EMODW, W_3, OBOB_EXPON);                    
+            Traverse_w_notdiv_e_fullsigned(r, 0, 0, PLEN_3 - 1, ph3_path, (const felm_t *)ph3_T1, (const felm_t *)ph3_T2, D, DLEN_3, ell, ELL3_W, ELL3_EMODW, W_3, OBOB_EXPON);                    
         #endif     
         from_base(D, d, DLEN_3, ELL3_W);
     }    
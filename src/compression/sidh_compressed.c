@@ -130,12 +130,27 @@ static void FullIsogeny_A_dual(unsigned char* PrivateKeyA, f2elm_t As[][5], f2el
 }
 
 
-static void Dlogs3_dual(const f2elm_t *f, int *D, digit_t *d0, digit_t *c0, digit_t *d1, digit_t *c1)
-{
-    solve_dlog(f[0], D, d0, 3);    
-    solve_dlog(f[2], D, c0, 3);
-    solve_dlog(f[1], D, d1, 3);     
-    solve_dlog(f[3], D, c1, 3);    
+typedef struct {
+    const f2elm_t* f;
+    digit_t* d[4];                                          // Discrete logarithms of f[0], f[1], f[2] and f[3]
+    int D[4][(DLEN_2 > DLEN_3) ? DLEN_2 : DLEN_3];         // Digits of each discrete logarithm
+    int ell;
+} dlogs_t;
+
+
+static void dlogs_task(void* arg, unsigned int i)
+{ // Discrete logarithm of f[i]
+    dlogs_t* dlogs = (dlogs_t*)arg;
+
+    solve_dlog(dlogs->f[i], dlogs->D[i], dlogs->d[i], dlogs->ell);
+}
+
+
+static void Dlogs3_dual(const f2elm_t *f, digit_t *d0, digit_t *c0, digit_t *d1, digit_t *c1)
+{ // The four discrete logarithms are independent and are distributed across the thread pool if enabled
+    dlogs_t dlogs = {f, {d0, d1, c0, c1}, {{0}}, 3};
+
+    compression_run(dlogs_task, &dlogs, 4);
     mp_sub((digit_t*)Bob_order, c0, c0, NWORDS_ORDER);    
     mp_sub((digit_t*)Bob_order, c1, c1, NWORDS_ORDER);  
 }
@@ -257,7 +272,6 @@ static int EphemeralKeyGeneration_A_extended(unsigned char* PrivateKeyA, unsigne
 { // Alice's ephemeral public key generation using compression -- SIKE protocol
   // Output: PrivateKeyA[MSG_BYTES + SECRETKEY_A_BYTES] <- x(K_A) where K_A = PA + sk_A*Q_A 
     unsigned int rs[3];
-    int D[DLEN_3];
     f2elm_t a24, As[MAX_Alice+1][5], f[4];
     digit_t c0[NWORDS_ORDER] = {0}, d0[NWORDS_ORDER] = {0}, c1[NWORDS_ORDER] = {0}, d1[NWORDS_ORDER] = {0}; 
     point_full_proj_t Rs[2];
@@ -265,7 +279,7 @@ static int EphemeralKeyGeneration_A_extended(unsigned char* PrivateKeyA, unsigne
     FullIsogeny_A_dual(PrivateKeyA, As, a24, 1);
     BuildOrdinary3nBasis_dual(a24, As, Rs, rs, &rs[2]);
     Tate3_pairings(Rs, f);
-    Dlogs3_dual(f, D, d0, c0, d1, c1);
+    Dlogs3_dual(f, d0, c0, d1, c1);
     Compress_PKA_dual(d0, c0, d1, c1, a24, rs, CompressedPKA);
     return 0;
 }
@@ -275,7 +289,6 @@ int EphemeralKeyGeneration_A(const unsigned char* PrivateKeyA, unsigned char* Co
 { // Alice's ephemeral public key generation using compression -- SIDH protocol
   // Output: PrivateKeyA[MSG_BYTES + SECRETKEY_A_BYTES] <- x(K_A) where K_A = PA + sk_A*Q_A 
     unsigned int rs[3];
-    int D[DLEN_3];
     f2elm_t a24, As[MAX_Alice+1][5], f[4];
     digit_t c0[NWORDS_ORDER] = {0}, d0[NWORDS_ORDER] = {0}, c1[NWORDS_ORDER] = {0}, d1[NWORDS_ORDER] = {0}; 
     point_full_proj_t Rs[2];
@@ -283,22 +296,21 @@ int EphemeralKeyGeneration_A(const unsigned char* PrivateKeyA, unsigned char* Co
     FullIsogeny_A_dual((unsigned char*)PrivateKeyA, As, a24, 0);
     BuildOrdinary3nBasis_dual(a24, As, Rs, rs, &rs[2]);
     Tate3_pairings(Rs, f);
-    Dlogs3_dual(f, D, d0, c0, d1, c1);
+    Dlogs3_dual(f, d0, c0, d1, c1);
     Compress_PKA_dual(d0, c0, d1, c1, a24, rs, CompressedPKA);
     return 0;
 }
 
 
-int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned char* PKA, unsigned char* SharedSecretB)
-{ // Bob's ephemeral shared secret computation using compression
-  // It produces a shared secret key SharedSecretB using his secret key PrivateKeyB and Alice's decompressed data point_R and param_A
+static void EphemeralSecretAgreement_B_proj(const unsigned char* PrivateKeyB, const unsigned char* PKA, f2elm_t A, f2elm_t C)
+{ // Bob's ephemeral shared secret computation using compression, without the final j-invariant computation
   // Inputs: Bob's PrivateKeyB is an integer in the range [1, oB-1], where oB = 3^OBOB_EXP. 
-  //         Alice's decompressed data consists of point_R in (X:Z) coordinates and the curve parameter param_A in GF(p^2).
-  // Output: a shared secret SharedSecretB that consists of one element in GF(p^2). 
+  //         Alice's compressed public key PKA.
+  // Output: the projective constants (A:C) of the shared curve. 
     unsigned int i, ii = 0, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0;
     f2elm_t A24plus = {0}, A24minus = {0};
     point_proj_t R, pts[MAX_INT_POINTS_BOB];
-    f2elm_t jinv, A, coeff[3];
+    f2elm_t coeff[3];
     f2elm_t param_A = {0};
 
     PKADecompression_dual(PrivateKeyB, PKA, R, param_A);
@@ -334,8 +346,20 @@ int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned
     get_3_isog(R, A24minus, A24plus, coeff);
     fp2add(A24plus, A24minus, A);
     fp2add(A, A, A);
-    fp2sub(A24plus, A24minus, A24plus);
-    j_inv(A, A24plus, jinv);    
+    fp2sub(A24plus, A24minus, C);
+}
+
+
+int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned char* PKA, unsigned char* SharedSecretB)
+{ // Bob's ephemeral shared secret computation using compression
+  // It produces a shared secret key SharedSecretB using his secret key PrivateKeyB and Alice's decompressed data point_R and param_A
+  // Inputs: Bob's PrivateKeyB is an integer in the range [1, oB-1], where oB = 3^OBOB_EXP. 
+  //         Alice's decompressed data consists of point_R in (X:Z) coordinates and the curve parameter param_A in GF(p^2).
+  // Output: a shared secret SharedSecretB that consists of one element in GF(p^2). 
+    f2elm_t A, C, jinv;
+
+    EphemeralSecretAgreement_B_proj(PrivateKeyB, PKA, A, C);
+    j_inv(A, C, jinv);    
     fp2_encode(jinv, SharedSecretB);    // Format shared secret
       
     return 0;
@@ -405,12 +429,11 @@ static void FullIsogeny_B_dual(const unsigned char* PrivateKeyB, f2elm_t Ds[][2]
 }
 
 
-static void Dlogs2_dual(const f2elm_t *f, int *D, digit_t *d0, digit_t *c0, digit_t *d1, digit_t *c1)
-{
-    solve_dlog(f[0], D, d0, 2);
-    solve_dlog(f[2], D, c0, 2);
-    solve_dlog(f[1], D, d1, 2);
-    solve_dlog(f[3], D, c1, 2);
+static void Dlogs2_dual(const f2elm_t *f, digit_t *d0, digit_t *c0, digit_t *d1, digit_t *c1)
+{ // The four discrete logarithms are independent and are distributed across the thread pool if enabled
+    dlogs_t dlogs = {f, {d0, d1, c0, c1}, {{0}}, 2};
+
+    compression_run(dlogs_task, &dlogs, 4);
     mp_sub((digit_t*)Alice_order, c0, c0, NWORDS_ORDER);
     mp_sub((digit_t*)Alice_order, c1, c1, NWORDS_ORDER);
 }
@@ -624,7 +647,6 @@ static void Compress_PKB_dual(digit_t *d0, digit_t *c0, digit_t *d1, digit_t *c1
 static int EphemeralKeyGeneration_B_extended(const unsigned char* PrivateKeyB, unsigned char* CompressedPKB, unsigned int sike)
 { // Bob's ephemeral public key generation using compression -- SIKE protocol
     unsigned char qnr, ind;
-    int D[DLEN_2] = {0};
     digit_t c0[NWORDS_ORDER] = {0}, d0[NWORDS_ORDER] = {0}, c1[NWORDS_ORDER] = {0}, d1[NWORDS_ORDER] = {0}; 
     f2elm_t Ds[MAX_Bob][2] = {0}, f[4] = {0}, A = {0};
     point_full_proj_t Rs[2] = {0};
@@ -653,7 +675,7 @@ static int EphemeralKeyGeneration_B_extended(const unsigned char* PrivateKeyB, u
     fp2correction(f[2]);
     fp2correction(f[3]);
 
-    Dlogs2_dual(f, D, d0, c0, d1, c1);
+    Dlogs2_dual(f, d0, c0, d1, c1);
     if (sike == 1)
         Compress_PKB_dual_extended(d0, c0, d1, c1, A, qnr, ind, CompressedPKB);  
     else
@@ -670,20 +692,21 @@ int EphemeralKeyGeneration_B(const unsigned char* PrivateKeyB, unsigned char* Co
 }
 
 
-static int EphemeralSecretAgreement_A_extended(const unsigned char* PrivateKeyA, const unsigned char* PKB, unsigned char* SharedSecretA, unsigned int sike)
-{ // Alice's ephemeral shared secret computation using compression -- SIKE protocol
+static void EphemeralSecretAgreement_A_extended_proj(const unsigned char* PrivateKeyA, const unsigned char* PKB, f2elm_t A24plus, f2elm_t C24, unsigned char* tphiBKA_t, unsigned int sike)
+{ // Alice's ephemeral shared secret computation using compression, without the final j-invariant computation
+  // Output: the projective constants (A24plus:C24) = (A:C) of the shared curve. If sike = 1, tphiBKA_t is filled in for ciphertext validation 
     unsigned int i, ii = 0, row, m, index = 0, pts_index[MAX_INT_POINTS_ALICE], npts = 0;
-    f2elm_t A24plus = {0}, C24 = {0};
     point_proj_t R, pts[MAX_INT_POINTS_ALICE];
-    f2elm_t jinv, coeff[5], A;
+    f2elm_t coeff[5], A;
     f2elm_t param_A = {0};
 
     if (sike == 1)
-        PKBDecompression_extended(PrivateKeyA, PKB, R, param_A, SharedSecretA+FP2_ENCODED_BYTES);
+        PKBDecompression_extended(PrivateKeyA, PKB, R, param_A, tphiBKA_t);
     else
         PKBDecompression(PrivateKeyA, PKB, R, param_A);
     
     fp2copy(param_A, A);    
+    fp2zero(C24);
     fpadd((digit_t*)&Montgomery_one, (digit_t*)&Montgomery_one, C24[0]);
     fp2add(A, C24, A24plus);
     fpadd(C24[0], C24[0], C24[0]);    
@@ -723,7 +746,15 @@ static int EphemeralSecretAgreement_A_extended(const unsigned char* PrivateKeyA,
     fp2add(A24plus, A24plus, A24plus);
     fp2sub(A24plus, C24, A24plus);
     fp2add(A24plus, A24plus, A24plus);
-    j_inv(A24plus, C24, jinv);    
+}
+
+
+static int EphemeralSecretAgreement_A_extended(const unsigned char* PrivateKeyA, const unsigned char* PKB, unsigned char* SharedSecretA, unsigned int sike)
+{ // Alice's ephemeral shared secret computation using compression -- SIKE protocol
+    f2elm_t A, C, jinv;
+
+    EphemeralSecretAgreement_A_extended_proj(PrivateKeyA, PKB, A, C, SharedSecretA+FP2_ENCODED_BYTES, sike);
+    j_inv(A, C, jinv);    
     fp2_encode(jinv, SharedSecretA);    // Format shared secret
     
     return 0;
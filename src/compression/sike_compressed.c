@@ -10,6 +10,9 @@
 
 #include <string.h>
 #include "../sha3/fips202.h"
+#include "../sha3/fips202x4.h"
+
+#define KEM_BATCH_CHUNK    16      // Number of operations that share field inversions in the batched API
 
 
 int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
@@ -39,12 +42,16 @@ int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk
     unsigned char ephemeralsk[SECRETKEY_B_BYTES] = {0};
     unsigned char jinvariant[FP2_ENCODED_BYTES] = {0};
     unsigned char h[MSG_BYTES];
-    unsigned char temp[CRYPTO_CIPHERTEXTBYTES + MSG_BYTES] = {0};
+    unsigned char temp[MSG_BYTES] = {0};
+    shake256incctx state;
 
     // Generate ephemeralsk <- G(m||pk) mod oB 
     randombytes(temp, MSG_BYTES);    
-    memcpy(&temp[MSG_BYTES], pk, CRYPTO_PUBLICKEYBYTES);        
-    shake256(ephemeralsk, SECRETKEY_B_BYTES, temp, MSG_BYTES + CRYPTO_PUBLICKEYBYTES);
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, temp, MSG_BYTES);
+    shake256_inc_absorb(&state, pk, CRYPTO_PUBLICKEYBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(ephemeralsk, SECRETKEY_B_BYTES, &state);
     FormatPrivKey_B(ephemeralsk);
     
     // Encrypt
@@ -56,8 +63,11 @@ int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk
     }
 
     // Generate shared secret ss <- H(m||ct)
-    memcpy(&temp[MSG_BYTES], ct, CRYPTO_CIPHERTEXTBYTES);      
-    shake256(ss, CRYPTO_BYTES, temp, CRYPTO_CIPHERTEXTBYTES + MSG_BYTES);
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, temp, MSG_BYTES);
+    shake256_inc_absorb(&state, ct, CRYPTO_CIPHERTEXTBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(ss, CRYPTO_BYTES, &state);
 
     return 0;
 }
@@ -70,7 +80,8 @@ int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned ch
   // Outputs: shared secret ss                      (CRYPTO_BYTES bytes)
     unsigned char ephemeralsk_[SECRETKEY_B_BYTES] = {0};
     unsigned char jinvariant_[FP2_ENCODED_BYTES + 2*FP2_ENCODED_BYTES + SECRETKEY_A_BYTES] = {0}, h_[MSG_BYTES];
-    unsigned char temp[CRYPTO_CIPHERTEXTBYTES + MSG_BYTES] = {0};   
+    unsigned char temp[MSG_BYTES] = {0};   
+    shake256incctx state;
     unsigned char* tphiBKA_t = &jinvariant_[FP2_ENCODED_BYTES];
     
     // Decrypt 
@@ -82,8 +93,11 @@ int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned ch
     }     
     
     // Generate ephemeralsk_ <- G(m||pk) mod oB
-    memcpy(&temp[MSG_BYTES], &sk[MSG_BYTES + SECRETKEY_A_BYTES], CRYPTO_PUBLICKEYBYTES);            
-    shake256(ephemeralsk_, SECRETKEY_B_BYTES, temp, MSG_BYTES + CRYPTO_PUBLICKEYBYTES);
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, temp, MSG_BYTES);
+    shake256_inc_absorb(&state, &sk[MSG_BYTES + SECRETKEY_A_BYTES], CRYPTO_PUBLICKEYBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(ephemeralsk_, SECRETKEY_B_BYTES, &state);
     FormatPrivKey_B(ephemeralsk_);
     
     // Generate shared secret ss <- H(m||ct), or output ss <- H(s||ct) in case of ct verification failure
@@ -91,9 +105,135 @@ int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned ch
     int8_t selector = validate_ciphertext(ephemeralsk_, ct, &sk[MSG_BYTES + SECRETKEY_A_BYTES + CRYPTO_PUBLICKEYBYTES], tphiBKA_t);
     // If ct validation passes (selector = 0) then do ss = H(m||ct), otherwise (selector = -1) load s to do ss = H(s||ct)
     ct_cmov(temp, sk, MSG_BYTES, selector);
-    memcpy(&temp[MSG_BYTES], ct, CRYPTO_CIPHERTEXTBYTES);  
-    shake256(ss, CRYPTO_BYTES, temp, CRYPTO_CIPHERTEXTBYTES + MSG_BYTES);
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, temp, MSG_BYTES);
+    shake256_inc_absorb(&state, ct, CRYPTO_CIPHERTEXTBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(ss, CRYPTO_BYTES, &state);
+
+    return 0;
+}
+
+
+int crypto_kem_enc_batch(unsigned char *ct, unsigned char *ss, const unsigned char *pk, unsigned int count)
+{ // SIKE's batched encapsulation using compression
+  // Input:   count public keys pk              (count*CRYPTO_PUBLICKEYBYTES bytes)
+  // Outputs: count shared secrets ss           (count*CRYPTO_BYTES bytes)
+  //          count ciphertext messages ct      (count*CRYPTO_CIPHERTEXTBYTES bytes)
+  // The i-th ciphertext and shared secret are computed under the i-th public key, as in crypto_kem_enc. Operations are processed 
+  // in chunks of KEM_BATCH_CHUNK that share the sampling of m and a single inversion for the j-invariants. 
+  // The SHAKE256 evaluations of a chunk are computed four at a time.
+    f2elm_t jinv[KEM_BATCH_CHUNK], A, C, den[KEM_BATCH_CHUNK], inv[KEM_BATCH_CHUNK];
+    unsigned char ephemeralsk[KEM_BATCH_CHUNK*SECRETKEY_B_BYTES] = {0};
+    unsigned char jinvariant[KEM_BATCH_CHUNK*FP2_ENCODED_BYTES] = {0};
+    unsigned char h[KEM_BATCH_CHUNK*MSG_BYTES];
+    unsigned char m[KEM_BATCH_CHUNK*MSG_BYTES];
+    unsigned int i, j, k, n;
+
+    for (i = 0; i < count; i += n) {
+        n = count - i;
+        if (n > KEM_BATCH_CHUNK) n = KEM_BATCH_CHUNK;
+
+        randombytes(m, n*MSG_BYTES);
+        // Generate ephemeralsk <- G(m||pk) mod oB 
+        shake256_batch_concat(ephemeralsk, SECRETKEY_B_BYTES, m, MSG_BYTES, pk + i*CRYPTO_PUBLICKEYBYTES, CRYPTO_PUBLICKEYBYTES, CRYPTO_PUBLICKEYBYTES, n);
+
+        for (j = 0; j < n; j++) {
+            unsigned char *ephemeralskj = &ephemeralsk[j*SECRETKEY_B_BYTES];
+
+            FormatPrivKey_B(ephemeralskj);
+
+            // Encrypt, leaving the j-invariant in projective form
+            EphemeralKeyGeneration_B_extended(ephemeralskj, ct + (i+j)*CRYPTO_CIPHERTEXTBYTES, 1); 
+            EphemeralSecretAgreement_B_proj(ephemeralskj, pk + (i+j)*CRYPTO_PUBLICKEYBYTES, A, C);
+            j_inv_proj(A, C, jinv[j], den[j]);
+        }
+
+        mont_n_way_inv_ct(den, n, inv);
+
+        for (j = 0; j < n; j++) {
+            fp2mul_mont(jinv[j], inv[j], jinv[j]);
+            fp2_encode(jinv[j], &jinvariant[j*FP2_ENCODED_BYTES]);
+        }
+        shake256_batch(h, MSG_BYTES, jinvariant, FP2_ENCODED_BYTES, n);          
+
+        for (j = 0; j < n; j++) {
+            unsigned char *ctj = ct + (i+j)*CRYPTO_CIPHERTEXTBYTES;
+
+            for (k = 0; k < MSG_BYTES; k++) {
+                ctj[k + PARTIALLY_COMPRESSED_CHUNK_CT] = m[j*MSG_BYTES + k] ^ h[j*MSG_BYTES + k];
+            }
+        }
+
+        // Generate shared secrets ss <- H(m||ct)
+        shake256_batch_concat(ss + i*CRYPTO_BYTES, CRYPTO_BYTES, m, MSG_BYTES, ct + i*CRYPTO_CIPHERTEXTBYTES, CRYPTO_CIPHERTEXTBYTES, CRYPTO_CIPHERTEXTBYTES, n);
+    }
 
     return 0;
 }
 
+
+int crypto_kem_dec_batch(unsigned char *ss, const unsigned char *ct, const unsigned char *sk, unsigned int count)
+{ // SIKE's batched decapsulation using compression 
+  // Input:   count secret keys sk                  (count*CRYPTO_SECRETKEYBYTES bytes)
+  //          count compressed ciphertexts ct       (count*CRYPTO_CIPHERTEXTBYTES bytes) 
+  // Outputs: count shared secrets ss               (count*CRYPTO_BYTES bytes)
+  // The i-th ciphertext is decapsulated with the i-th secret key, as in crypto_kem_dec. Operations are processed in chunks of 
+  // KEM_BATCH_CHUNK that share a single inversion for the j-invariants. A malformed ciphertext only affects its own shared secret.
+  // The SHAKE256 evaluations of a chunk are computed four at a time.
+    f2elm_t jinv[KEM_BATCH_CHUNK], A, C, den[KEM_BATCH_CHUNK], inv[KEM_BATCH_CHUNK];
+    unsigned char ephemeralsk_[KEM_BATCH_CHUNK*SECRETKEY_B_BYTES] = {0};
+    unsigned char jinvariant_[KEM_BATCH_CHUNK*FP2_ENCODED_BYTES] = {0}, h_[KEM_BATCH_CHUNK*MSG_BYTES];
+    unsigned char m_[KEM_BATCH_CHUNK*MSG_BYTES];
+    unsigned char tphiBKA_t[KEM_BATCH_CHUNK][2*FP2_ENCODED_BYTES + SECRETKEY_A_BYTES] = {0};
+    unsigned int i, j, k, n;
+
+    for (i = 0; i < count; i += n) {
+        n = count - i;
+        if (n > KEM_BATCH_CHUNK) n = KEM_BATCH_CHUNK;
+
+        // Decrypt, leaving the j-invariants in projective form
+        for (j = 0; j < n; j++) {
+            EphemeralSecretAgreement_A_extended_proj(sk + (i+j)*CRYPTO_SECRETKEYBYTES + MSG_BYTES, ct + (i+j)*CRYPTO_CIPHERTEXTBYTES, A, C, tphiBKA_t[j], 1);
+            j_inv_proj(A, C, jinv[j], den[j]);
+        }
+
+        mont_n_way_inv_ct(den, n, inv);
+
+        for (j = 0; j < n; j++) {
+            fp2mul_mont(jinv[j], inv[j], jinv[j]);
+            fp2_encode(jinv[j], &jinvariant_[j*FP2_ENCODED_BYTES]);
+        }
+        shake256_batch(h_, MSG_BYTES, jinvariant_, FP2_ENCODED_BYTES, n);   
+
+        // Generate ephemeralsk_ <- G(m||pk) mod oB
+        for (j = 0; j < n; j++) {
+            const unsigned char *ctj = ct + (i+j)*CRYPTO_CIPHERTEXTBYTES;
+
+            for (k = 0; k < MSG_BYTES; k++) {
+                m_[j*MSG_BYTES + k] = ctj[k + PARTIALLY_COMPRESSED_CHUNK_CT] ^ h_[j*MSG_BYTES + k];                         
+            }     
+        }
+        shake256_batch_concat(ephemeralsk_, SECRETKEY_B_BYTES, m_, MSG_BYTES, sk + i*CRYPTO_SECRETKEYBYTES + MSG_BYTES + SECRETKEY_A_BYTES, CRYPTO_PUBLICKEYBYTES, CRYPTO_SECRETKEYBYTES, n);
+
+        for (j = 0; j < n; j++) {
+            const unsigned char *ctj = ct + (i+j)*CRYPTO_CIPHERTEXTBYTES;
+            const unsigned char *skj = sk + (i+j)*CRYPTO_SECRETKEYBYTES;
+            unsigned char *ephemeralskj_ = &ephemeralsk_[j*SECRETKEY_B_BYTES];
+
+            FormatPrivKey_B(ephemeralskj_);
+
+            // Generate shared secret ss <- H(m||ct), or output ss <- H(s||ct) in case of ct verification failure
+            int8_t selector = validate_ciphertext(ephemeralskj_, ctj, &skj[MSG_BYTES + SECRETKEY_A_BYTES + CRYPTO_PUBLICKEYBYTES], tphiBKA_t[j]);
+            ct_cmov(&m_[j*MSG_BYTES], skj, MSG_BYTES, selector);
+        }
+        shake256_batch_concat(ss + i*CRYPTO_BYTES, CRYPTO_BYTES, m_, MSG_BYTES, ct + i*CRYPTO_CIPHERTEXTBYTES, CRYPTO_CIPHERTEXTBYTES, CRYPTO_CIPHERTEXTBYTES, n);
+    }
+
+    return 0;
+}
+
+
+#if defined(_THREADS_)
+    #include "../keypair_pool.c"
+#endif
@@ -0,0 +1,183 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: precomputed tables of key compression stored out of line in a binary blob
+*           The blob holds the pairing tables and the Pohlig-Hellman tables after a header with a version, the parameter
+*           set, the window sizes and a SHAKE256 checksum. It is written by tools/tables_blob.c ("make tables_blob").
+*           When compiling with USE_TABLE_BLOB=TRUE, the tables are not compiled in and tables_load() maps the blob from
+*           a file, so that it is shared between processes through the page cache. With USE_TABLE_BLOB=INCBIN, the blob is
+*           embedded in the library with .incbin instead. In both cases tables_load() validates the blob once.
+*********************************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "../sha3/fips202.h"
+
+#define TABLES_BLOB_MAGIC          "SIDHTABL"
+#define TABLES_BLOB_VERSION        1
+#define TABLES_BLOB_BYTE_ORDER     0x0102030405060708ULL       // Tables are stored in the byte order of the host that wrote them
+#define TABLES_BLOB_ALIGN          64
+#define TABLES_BLOB_NTABLES        12
+#define TABLES_BLOB_CHECKSUM_BYTES 32
+
+// Tables in the order in which they are stored. Unused Pohlig-Hellman tables have 0 bytes.
+enum { TABLE_TATE3, TABLE_TATE2_FIRSTSTEP_P, TABLE_TATE2_P, TABLE_TATE2_FIRSTSTEP_Q, TABLE_TATE2_Q,
+       TABLE_PH2_TEXP, TABLE_PH2_LOG, TABLE_PH2_G, TABLE_PH2_CT, TABLE_PH3_T, TABLE_PH3_T1, TABLE_PH3_T2 };
+
+typedef struct {
+    unsigned char magic[8];
+    unsigned char checksum[TABLES_BLOB_CHECKSUM_BYTES];     // SHAKE256 of the rest of the blob, starting at byte_order
+    uint64_t byte_order;
+    uint32_t version;
+    uint32_t ntables;
+    char name[24];                                          // Parameter set, e.g., "SIDHp434_compressed"
+    uint32_t w2, w3;                                        // Window sizes of the Pohlig-Hellman tables
+    uint64_t size;                                          // Size of the blob in bytes
+    struct { uint64_t offset, bytes; } tables[TABLES_BLOB_NTABLES];
+} tables_blob_header_t;
+
+static const uint64_t tables_blob_bytes[TABLES_BLOB_NTABLES] = {
+    (6*(OBOB_EXPON - 1) + 4)*NWORDS64_FIELD*8,              // T_tate3
+    4*NWORDS64_FIELD*8,                                     // T_tate2_firststep_P
+    3*(OALICE_BITS - 2)*NWORDS64_FIELD*8,                   // T_tate2_P
+    4*NWORDS64_FIELD*8,                                     // T_tate2_firststep_Q
+    3*(OALICE_BITS - 2)*NWORDS64_FIELD*8,                   // T_tate2_Q
+    ((1 << (W_2_1 - 2)) - 1)*NWORDS64_FIELD*8,              // ph2_Texp
+    ((1 << W_2_1) - 1)*sizeof(int),                         // ph2_Log
+    (1 << (W_2 - 2))*NWORDS64_FIELD*8,                      // ph2_G
+    DLEN_2*(ELL2_W >> 1)*NWORDS64_FIELD*8,                  // ph2_CT
+#if (OBOB_EXPON % W_3 == 0)
+    DLEN_3*(ELL3_W >> 1)*2*NWORDS64_FIELD*8, 0, 0           // ph3_T
+#else
+    0, DLEN_3*(ELL3_W >> 1)*2*NWORDS64_FIELD*8,             // ph3_T1
+    DLEN_3*(ELL3_W >> 1)*2*NWORDS64_FIELD*8                 // ph3_T2
+#endif
+};
+
+
+static int tables_blob_validate(const unsigned char* blob, const uint64_t size)
+{ // Checks the header of the blob against the compiled-in parameters and window sizes, and its checksum. Returns 0 if valid.
+    const tables_blob_header_t* header = (const tables_blob_header_t*)blob;
+    unsigned char checksum[TABLES_BLOB_CHECKSUM_BYTES];
+    unsigned int i;
+
+    if (size < sizeof(tables_blob_header_t) || ((uintptr_t)blob % TABLES_BLOB_ALIGN) != 0) {
+        return 1;
+    }
+    if (memcmp(header->magic, TABLES_BLOB_MAGIC, sizeof(header->magic)) != 0 || header->byte_order != TABLES_BLOB_BYTE_ORDER ||
+        header->version != TABLES_BLOB_VERSION || header->ntables != TABLES_BLOB_NTABLES || header->size != size ||
+        strncmp(header->name, TABLES_BLOB_NAME, sizeof(header->name)) != 0 || header->w2 != W_2 || header->w3 != W_3) {
+        return 1;
+    }
+    for (i = 0; i < TABLES_BLOB_NTABLES; i++) {
+        if (header->tables[i].bytes != tables_blob_bytes[i] || (header->tables[i].offset % TABLES_BLOB_ALIGN) != 0 ||
+            header->tables[i].offset > size || header->tables[i].bytes > size - header->tables[i].offset) {
+            return 1;
+        }
+    }
+    shake256(checksum, TABLES_BLOB_CHECKSUM_BYTES, blob + offsetof(tables_blob_header_t, byte_order), size - offsetof(tables_blob_header_t, byte_order));
+
+    return (memcmp(checksum, header->checksum, TABLES_BLOB_CHECKSUM_BYTES) != 0);
+}
+
+
+#if defined(_TABLE_BLOB_)
+
+#if !defined(_TABLE_BLOB_INCBIN_)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+// Set by tables_load()
+const uint64_t *T_tate3, *T_tate2_firststep_P, *T_tate2_P, *T_tate2_firststep_Q, *T_tate2_Q;
+const uint64_t *ph2_Texp, *ph2_G, *ph2_CT, *ph3_T, *ph3_T1, *ph3_T2;
+const int *ph2_Log;
+
+#if defined(_TABLE_BLOB_INCBIN_)
+    #define TABLES_BLOB_STR(x)       #x
+    #define TABLES_BLOB_XSTR(x)      TABLES_BLOB_STR(x)
+    #define TABLES_BLOB_SYMBOL       tables_blob_data
+    #define TABLES_BLOB_END_SYMBOL   tables_blob_data_end
+
+// The symbols are local to the object file, so the blobs of different parameter sets do not clash
+__asm__(".section .rodata\n"
+        ".balign " TABLES_BLOB_XSTR(TABLES_BLOB_ALIGN) "\n"
+        TABLES_BLOB_XSTR(TABLES_BLOB_SYMBOL) ":\n"
+        ".incbin \"" TABLES_BLOB_FILE "\"\n"
+        TABLES_BLOB_XSTR(TABLES_BLOB_END_SYMBOL) ":\n"
+        ".previous\n");
+
+extern const unsigned char TABLES_BLOB_SYMBOL[], TABLES_BLOB_END_SYMBOL[];
+#endif
+
+static const unsigned char* tables_blob = NULL;
+
+
+int tables_load(const char* path)
+{ // Validates the blob with the precomputed tables and sets the table pointers. With USE_TABLE_BLOB=TRUE, the blob is mapped
+  // from the file path, otherwise the embedded blob is used and path is ignored. Returns 0 on success.
+    const tables_blob_header_t* header;
+    const unsigned char* blob;
+    uint64_t size;
+#if !defined(_TABLE_BLOB_INCBIN_)
+    struct stat st;
+    void* map;
+    int fd;
+#endif
+
+    if (tables_blob != NULL) {
+        return 0;
+    }
+#if defined(_TABLE_BLOB_INCBIN_)
+    (void)path;
+    blob = TABLES_BLOB_SYMBOL;
+    size = (uint64_t)(TABLES_BLOB_END_SYMBOL - TABLES_BLOB_SYMBOL);
+    if (tables_blob_validate(blob, size) != 0) {
+        return 1;
+    }
+#else
+    if (path == NULL || (fd = open(path, O_RDONLY | O_CLOEXEC)) == -1) {
+        return 1;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(tables_blob_header_t)) {
+        close(fd);
+        return 1;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return 1;
+    }
+    blob = (const unsigned char*)map;
+    size = (uint64_t)st.st_size;
+    if (tables_blob_validate(blob, size) != 0) {
+        munmap(map, (size_t)size);
+        return 1;
+    }
+#endif
+
+    header = (const tables_blob_header_t*)blob;
+    T_tate3             = (const uint64_t*)(blob + header->tables[TABLE_TATE3].offset);
+    T_tate2_firststep_P = (const uint64_t*)(blob + header->tables[TABLE_TATE2_FIRSTSTEP_P].offset);
+    T_tate2_P           = (const uint64_t*)(blob + header->tables[TABLE_TATE2_P].offset);
+    T_tate2_firststep_Q = (const uint64_t*)(blob + header->tables[TABLE_TATE2_FIRSTSTEP_Q].offset);
+    T_tate2_Q           = (const uint64_t*)(blob + header->tables[TABLE_TATE2_Q].offset);
+    ph2_Texp            = (const uint64_t*)(blob + header->tables[TABLE_PH2_TEXP].offset);
+    ph2_Log             = (const int*)(blob + header->tables[TABLE_PH2_LOG].offset);
+    ph2_G               = (const uint64_t*)(blob + header->tables[TABLE_PH2_G].offset);
+    ph2_CT              = (const uint64_t*)(blob + header->tables[TABLE_PH2_CT].offset);
+    ph3_T               = (const uint64_t*)(blob + header->tables[TABLE_PH3_T].offset);
+    ph3_T1              = (const uint64_t*)(blob + header->tables[TABLE_PH3_T1].offset);
+    ph3_T2              = (const uint64_t*)(blob + header->tables[TABLE_PH3_T2].offset);
+    tables_blob = blob;
+
+    return 0;
+}
+
+#endif
@@ -13,13 +13,48 @@
 #define DECOMPRESSION 1
 
 
-static void Elligator2(const f2elm_t a24, const unsigned int r, f2elm_t x, unsigned char *bit, const unsigned char COMPorDEC)
-{ // Generate an x-coordinate of a point on curve with (affine) coefficient a24 
+#define ELLIGATOR_BATCH 4    // Number of Elligator values computed together beyond the precomputed tables
+
+
+typedef struct {
+    f2elm_t v[ELLIGATOR_BATCH];
+    unsigned int r, n;       // Counter of v[0] and number of values
+} elligator_batch_t;
+
+
+static void Elligator2_v(const unsigned int r, const unsigned int n, f2elm_t *v)
+{ // Compute the Elligator values v[i] = 1/(1 + U*(r+i)^2) for the counters r, ..., r+n-1
   // Use a precomputed Elligator table of size TABLE_V3_LEN and switch to online computations if table runs out of elements.
-  // Use the counter r
-    int i;
-    felm_t one_fp, a2, b2, N, temp0, temp1, rmonty = {0}, *U;
-    f2elm_t A, y2, *t_ptr, v;
+  // The online values are inverted together, using a single inversion.
+    unsigned int i, m = 0;
+    felm_t rmonty, *U = (felm_t *)U3;
+    f2elm_t den[ELLIGATOR_BATCH];
+
+    for (i = 0; i < n; i++) {
+        if (r + i < TABLE_V3_LEN) {
+            fp2copy((felm_t*)&v_3_torsion[r + i], v[i]);
+        } else { // Compute 1+U*r^2
+            fpzero(rmonty);
+            rmonty[0] = r + i;
+            to_mont(rmonty, rmonty);
+            fpsqr_mont(rmonty, rmonty);
+            fpmul_mont(U[0], rmonty, den[m][0]);
+            fpmul_mont(U[1], rmonty, den[m][1]);
+            fpadd(den[m][0], (digit_t*)&Montgomery_one, den[m][0]);
+            m++;
+        }
+    }
+    if (m > 0) {
+        mont_n_way_inv(den, m, &v[n - m]);    // Online values come last
+    }
+}
+
+
+static void Elligator2(const f2elm_t a24, const f2elm_t v, f2elm_t x, unsigned char *bit, const unsigned char COMPorDEC)
+{ // Generate an x-coordinate of a point on curve with (affine) coefficient a24 
+  // Use the Elligator value v = 1/(1 + U*r^2) for the counter r
+    felm_t one_fp, a2, b2, N;
+    f2elm_t A, y2;
 
     fpcopy((digit_t*)&Montgomery_one, one_fp);
     fp2add(a24, a24, A);
@@ -27,20 +62,7 @@ static void Elligator2(const f2elm_t a24, const unsigned int r, f2elm_t x, unsig
     fp2add(A, A, A);                          // A = 4*a24-2 
 
     // Elligator computation    
-    if (r < TABLE_V3_LEN) {
-        t_ptr = (f2elm_t *)&v_3_torsion[r];    
-        fp2copy((felm_t*)t_ptr, v);
-    } else { // Compute v = 1/(1+U*r^2)
-        U = (felm_t *)U3;
-        rmonty[0] = r;
-        to_mont(rmonty, rmonty);
-        fpsqr_mont(rmonty, rmonty);
-        fpmul_mont(U[0], rmonty, v[0]);
-        fpmul_mont(U[1], rmonty, v[1]);
-        fpadd(v[0], (digit_t*)&Montgomery_one, v[0]);
-        fp2inv_mont_bingcd(v);
-    }
-    fp2mul_mont(A, v, x);     // x = A*v; v := 1/(1 + U*r^2) table lookup
+    fp2mul_mont(A, v, x);     // x = A*v; v := 1/(1 + U*r^2)
     fp2neg(x);                // x = -A*v;
     
     if (COMPorDEC == COMPRESSION) {
@@ -52,18 +74,7 @@ static void Elligator2(const f2elm_t a24, const unsigned int r, f2elm_t x, unsig
         fpsqr_mont(y2[1], b2);
         fpadd(a2, b2, N);                      // N := norm(y2);
 
-        fpcopy(N, temp0);
-        for (i = 0; i < OALICE_BITS - 2; i++) {    
-            fpsqr_mont(temp0,  temp0);
-        }
-        for (i = 0; i < OBOB_EXPON; i++) {
-            fpsqr_mont(temp0,  temp1);
-            fpmul_mont(temp0,  temp1,  temp0);
-        }
-        fpsqr_mont(temp0, temp1);              // z = N^((p + 1) div 4);
-        fpcorrection(temp1);
-        fpcorrection(N);
-        if (memcmp(temp1, N, NBITS_TO_NBYTES(NBITS_FIELD)) != 0) {
+        if (!is_sqr_fp(N)) {                   // y2 is a square iff N is a square
             fp2neg(x);
             fp2sub(x, A, x);                   // x = -x - A;
             if (COMPorDEC == COMPRESSION)
@@ -78,6 +89,18 @@ static void Elligator2(const f2elm_t a24, const unsigned int r, f2elm_t x, unsig
 }
 
 
+static void Elligator2_next(const f2elm_t a24, elligator_batch_t *batch, const unsigned int r, f2elm_t x, unsigned char *bit)
+{ // Generate the x-coordinate for the counter r during compression, taking the Elligator value from the batch
+  // The batch is refilled with the values for r, ..., r+ELLIGATOR_BATCH-1 if it does not contain r
+    if (r < batch->r || r >= batch->r + batch->n) {
+        Elligator2_v(r, ELLIGATOR_BATCH, batch->v);
+        batch->r = r;
+        batch->n = ELLIGATOR_BATCH;
+    }
+    Elligator2(a24, batch->v[r - batch->r], x, bit, COMPRESSION);
+}
+
+
 static void TripleAndParabola_proj(const point_full_proj_t R, f2elm_t l1x, f2elm_t l1z)
 {
     fp2sqr_mont(R->X, l1z);
@@ -241,7 +264,7 @@ static bool SecondPoint_dual(const point_proj_t P, point_full_proj_t R, unsigned
 }
 
 
-static void FirstPoint3n(const f2elm_t a24, const f2elm_t As[][5], f2elm_t x, point_full_proj_t R, unsigned int *r, unsigned char *ind, unsigned char *bitEll)
+static void FirstPoint3n(const f2elm_t a24, const f2elm_t As[][5], elligator_batch_t *batch, f2elm_t x, point_full_proj_t R, unsigned int *r, unsigned char *ind, unsigned char *bitEll)
 {
     bool b = false;
     point_proj_t P;
@@ -250,7 +273,7 @@ static void FirstPoint3n(const f2elm_t a24, const f2elm_t As[][5], f2elm_t x, po
 
     while (!b) {        
         *bitEll = 0;
-        Elligator2(a24, *r, x, bitEll, COMPRESSION);    // Get x-coordinate on curve a24
+        Elligator2_next(a24, batch, *r, x, bitEll);    // Get x-coordinate on curve a24
 
         fp2copy(x, P->X);
         fpcopy((digit_t*)&Montgomery_one, (P->Z)[0]);
@@ -263,7 +286,7 @@ static void FirstPoint3n(const f2elm_t a24, const f2elm_t As[][5], f2elm_t x, po
 }
 
 
-static void SecondPoint3n(const f2elm_t a24, const f2elm_t As[][5], f2elm_t x, point_full_proj_t R, unsigned int *r, unsigned char ind, unsigned char *bitEll)
+static void SecondPoint3n(const f2elm_t a24, const f2elm_t As[][5], elligator_batch_t *batch, f2elm_t x, point_full_proj_t R, unsigned int *r, unsigned char ind, unsigned char *bitEll)
 {
     bool b = false;
     point_proj_t P;
@@ -271,7 +294,7 @@ static void SecondPoint3n(const f2elm_t a24, const f2elm_t As[][5], f2elm_t x, p
 
     while (!b) {
         *bitEll = 0;
-        Elligator2(a24, *r, x, bitEll, COMPRESSION);
+        Elligator2_next(a24, batch, *r, x, bitEll);
 
         fp2copy(x, P->X);
         fpcopy((digit_t*)&Montgomery_one, (P->Z)[0]);
@@ -351,11 +374,12 @@ static void BuildOrdinary3nBasis_dual(const f2elm_t a24, const f2elm_t As[][5],
     point_proj_t D;
     f2elm_t xs[2];
     unsigned char ind, bit;
+    elligator_batch_t batch = {0};    // Shared by both points, since the second point continues with the counter of the first
 
-    FirstPoint3n(a24, As, xs[0], R[0], r, &ind, &bit);
+    FirstPoint3n(a24, As, &batch, xs[0], R[0], r, &ind, &bit);
     *bitsEll = (unsigned int)bit;
     *(r+1) = *r;
-    SecondPoint3n(a24, As, xs[1], R[1], r+1, ind, &bit);
+    SecondPoint3n(a24, As, &batch, xs[1], R[1], r+1, ind, &bit);
     *bitsEll |= ((unsigned int)bit << 1);
 
     // Get x-coordinate of difference
@@ -368,13 +392,16 @@ static void BuildOrdinary3nBasis_dual(const f2elm_t a24, const f2elm_t As[][5],
 static void BuildOrdinary3nBasis_Decomp_dual(const f2elm_t A24, point_proj_t *Rs, unsigned char *r, const unsigned char bitsEll)
 {
     unsigned char bitEll[2];
+    f2elm_t v[2];
     
     bitEll[0] = bitsEll & 0x1;
     bitEll[1] = (bitsEll >> 1) & 0x1;    
     
     // Elligator2 both x-coordinates
-    Elligator2(A24, (unsigned int)r[0]-1, Rs[0]->X, &bitEll[0], DECOMPRESSION);
-    Elligator2(A24, (unsigned int)r[1]-1, Rs[1]->X, &bitEll[1], DECOMPRESSION);
+    Elligator2_v((unsigned int)r[0]-1, 1, &v[0]);
+    Elligator2_v((unsigned int)r[1]-1, 1, &v[1]);
+    Elligator2(A24, v[0], Rs[0]->X, &bitEll[0], DECOMPRESSION);
+    Elligator2(A24, v[1], Rs[1]->X, &bitEll[1], DECOMPRESSION);
     // Get x-coordinate of difference
     BiQuad_affine(A24, Rs[0]->X, Rs[1]->X, Rs[2]);
 }
@@ -382,12 +409,21 @@ static void BuildOrdinary3nBasis_Decomp_dual(const f2elm_t A24, point_proj_t *Rs
 
 static void get2mPointonEA(const f2elm_t A, f2elm_t x, felm_t r, f2elm_t t, unsigned char *vqnr, unsigned char *ind) 
 {// Given a Montgomery curve EA, find a point of order 2^m using precomputed tables of size TABLE_R_LEN and switch to online computations if table runs out of elements.
-    f2elm_t *tv_ptr, v, tmp;
-    felm_t *tr_ptr, *u;
+ // The tables are followed by TABLE_R_EXT_LEN candidates generated by "make elligator_tables", if any, whose index counts the steps after the tables as for the online values.
+ // The online values are computed ELLIGATOR_BATCH at a time, using a single inversion.
+    f2elm_t *tv_ptr, v, tmp, den[ELLIGATOR_BATCH], vs[ELLIGATOR_BATCH];
+    felm_t *tr_ptr, *u, rs[ELLIGATOR_BATCH];
+    unsigned int i, nv = 0;
+#if (TABLE_R_EXT_LEN > 0)
+    f2elm_t *tv_ext;
+    felm_t *tr_ext;
+    const unsigned char *ts_ext;
+    unsigned int j = 0;
+#endif
 
     u = (felm_t *)u_entang;
     // Select the correct tables, i.e., if A is a QR then v must be QNR, and vice-versa
-    if (is_sqr_fp2(A,  tmp[0])) {
+    if (is_sqr_fp2(A)) {
         tv_ptr = (f2elm_t *)table_v_qnr; 
         tr_ptr = (felm_t *)table_r_qnr; 
         *vqnr = 1;
@@ -396,23 +432,42 @@ static void get2mPointonEA(const f2elm_t A, f2elm_t x, felm_t r, f2elm_t t, unsi
         tr_ptr = (felm_t *)table_r_qr; 
         *vqnr = 0;
     }
+#if (TABLE_R_EXT_LEN > 0)
+    tv_ext = (f2elm_t *)((*vqnr == 1) ? table_v_qnr_ext : table_v_qr_ext);
+    tr_ext = (felm_t *)((*vqnr == 1) ? table_r_qnr_ext : table_r_qr_ext);
+    ts_ext = (*vqnr == 1) ? table_s_qnr_ext : table_s_qr_ext;
+#endif
 
     *ind = 0;
     do {
         if (*ind <= TABLE_R_LEN-1) {
             fp2copy((felm_t *)*tv_ptr++, v);
             fpcopy(tr_ptr[*ind], r);
+#if (TABLE_R_EXT_LEN > 0)
+        } else if (j < TABLE_R_EXT_LEN) {
+            fp2copy(tv_ext[j], v);
+            fpcopy(tr_ext[j], r);
+            *ind = TABLE_R_LEN + ts_ext[j];    // The online values continue from here
+            j++;
+#endif
         } else {
             do {
-                fpadd(r, (digit_t*)Montgomery_one, r);
-                fpmul_mont(r, r, tmp[1]);
-                fpmul_mont(u[0], tmp[1], tmp[0]);
-                fpmul_mont(u[1], tmp[1], tmp[1]);
-                fpadd(tmp[0], (digit_t*)Montgomery_one, tmp[0]);
-                fp2inv_mont_bingcd(tmp);
-                fp2copy(tmp, v);     // v = 1/(1 + u*r^2)
+                if (nv == 0) {    // Next ELLIGATOR_BATCH counters after r
+                    for (i = 0; i < ELLIGATOR_BATCH; i++) {
+                        fpadd((i == 0) ? r : rs[i-1], (digit_t*)Montgomery_one, rs[i]);
+                        fpmul_mont(rs[i], rs[i], tmp[1]);
+                        fpmul_mont(u[0], tmp[1], den[i][0]);
+                        fpmul_mont(u[1], tmp[1], den[i][1]);
+                        fpadd(den[i][0], (digit_t*)Montgomery_one, den[i][0]);
+                    }
+                    mont_n_way_inv(den, ELLIGATOR_BATCH, vs);
+                    nv = ELLIGATOR_BATCH;
+                }
+                fpcopy(rs[ELLIGATOR_BATCH - nv], r);
+                fp2copy(vs[ELLIGATOR_BATCH - nv], v);    // v = 1/(1 + u*r^2)
+                nv--;
                 *ind += 1; // store the number of attempts for r so that we skip them during decompression
-            } while (is_sqr_fp2(v, tmp[0]) == *vqnr);
+            } while (is_sqr_fp2(v) == *vqnr);
         }
         fp2mul_mont(A, v, x);   
         fp2neg(x);                   // x = -A*v
@@ -422,7 +477,7 @@ static void get2mPointonEA(const f2elm_t A, f2elm_t x, felm_t r, f2elm_t t, unsi
         fp2mul_mont(x, tmp, t);      // t = x^3 + A*x^2 + x
         if (*ind < TABLE_R_LEN)
             *ind += 1;
-    } while (!is_sqr_fp2(t, tmp[0]));
+    } while (!is_sqr_fp2(t));
     *ind -= 1;
 }
 
@@ -32,6 +32,9 @@ void xDBLe(const point_proj_t P, point_proj_t Q, const f2elm_t A24plus, const f2
 { // Computes [2^e](X:Z) on Montgomery curve with projective constant via e repeated doublings.
   // Input: projective Montgomery x-coordinates P = (XP:ZP), such that xP=XP/ZP and Montgomery curve constants A+2C and 4C.
   // Output: projective Montgomery x-coordinates Q <- (2^e)*P.
+#if defined(_CHAIN_ASM_)
+    xDBLe_asm((const digit_t*)P, (digit_t*)Q, (const digit_t*)A24plus, (const digit_t*)C24, e);
+#else
     int i;
     
     copy_words((digit_t*)P, (digit_t*)Q, 2*2*NWORDS_FIELD);
@@ -39,6 +42,7 @@ void xDBLe(const point_proj_t P, point_proj_t Q, const f2elm_t A24plus, const f2
     for (i = 0; i < e; i++) {
         xDBL(Q, Q, A24plus, C24);
     }
+#endif
 }
 
 #if (OALICE_BITS % 2 == 1)
@@ -132,10 +136,8 @@ void xTPL(const point_proj_t P, point_proj_t Q, const f2elm_t A24minus, const f2
     mp2_sub_p2(t1, t3, t1);                         // t1 = 4*X^2 - (X+Z)^2 
     mp2_sub_p2(t1, t2, t1);                         // t1 = 4*X^2 - (X+Z)^2 - (X-Z)^2
     fp2mul_mont(A24plus, t3, t5);                   // t5 = A24plus*(X+Z)^2 
-    fp2mul_mont(t3, t5, t3);                        // t3 = A24plus*(X+Z)^4
     fp2mul_mont(A24minus, t2, t6);                  // t6 = A24minus*(X-Z)^2
-    fp2mul_mont(t2, t6, t2);                        // t2 = A24minus*(X-Z)^4
-    mp2_sub_p2(t2, t3, t3);                         // t3 = A24minus*(X-Z)^4 - A24plus*(X+Z)^4
+    fp2mulsub_mont(t2, t6, t3, t5, t3);             // t3 = A24minus*(X-Z)^4 - A24plus*(X+Z)^4
     mp2_sub_p2(t5, t6, t2);                         // t2 = A24plus*(X+Z)^2 - A24minus*(X-Z)^2
     fp2mul_mont(t1, t2, t1);                        // t1 = [4*X^2 - (X+Z)^2 - (X-Z)^2]*[A24plus*(X+Z)^2 - A24minus*(X-Z)^2]
     fp2add(t3, t1, t2);                             // t2 = [4*X^2 - (X+Z)^2 - (X-Z)^2]*[A24plus*(X+Z)^2 - A24minus*(X-Z)^2] + A24minus*(X-Z)^4 - A24plus*(X+Z)^4
@@ -151,6 +153,9 @@ void xTPLe(const point_proj_t P, point_proj_t Q, const f2elm_t A24minus, const f
 { // Computes [3^e](X:Z) on Montgomery curve with projective constant via e repeated triplings.
   // Input: projective Montgomery x-coordinates P = (XP:ZP), such that xP=XP/ZP and Montgomery curve constants A24plus = A+2C and A24minus = A-2C.
   // Output: projective Montgomery x-coordinates Q <- (3^e)*P.
+#if defined(_CHAIN_ASM_)
+    xTPLe_asm((const digit_t*)P, (digit_t*)Q, (const digit_t*)A24minus, (const digit_t*)A24plus, e);
+#else
     int i;
         
     copy_words((digit_t*)P, (digit_t*)Q, 2*2*NWORDS_FIELD);
@@ -158,6 +163,7 @@ void xTPLe(const point_proj_t P, point_proj_t Q, const f2elm_t A24minus, const f
     for (i = 0; i < e; i++) {
         xTPL(Q, Q, A24minus, A24plus);
     }
+#endif
 }
 
 
@@ -246,26 +252,36 @@ void get_A(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xR, f2elm_t A)
 }
 
 
+void j_inv_proj(const f2elm_t A, const f2elm_t C, f2elm_t jnum, f2elm_t jden)
+{ // Computes the j-invariant of a Montgomery curve with projective constant, as a fraction.
+  // Input: A,C in GF(p^2).
+  // Output: jnum=256*(A^2-3*C^2)^3 and jden=C^4*(A^2-4*C^2), such that j=jnum/jden is the j-invariant of the Montgomery curve B*y^2=x^3+(A/C)*x^2+x.
+    f2elm_t t1;
+    
+    fp2sqr_mont(A, jden);                           // jden = A^2        
+    fp2sqr_mont(C, t1);                             // t1 = C^2
+    fp2add(t1, t1, jnum);                           // jnum = t1+t1
+    fp2sub(jden, jnum, jnum);                       // jnum = jden-jnum
+    fp2sub(jnum, t1, jnum);                         // jnum = jnum-t1
+    fp2sub(jnum, t1, jden);                         // jden = jnum-t1
+    fp2sqr_mont(t1, t1);                            // t1 = t1^2
+    fp2mul_mont(jden, t1, jden);                    // jden = jden*t1
+    fp2add(jnum, jnum, jnum);                       // jnum = jnum+jnum
+    fp2add(jnum, jnum, jnum);                       // jnum = jnum+jnum
+    fp2sqr_mont(jnum, t1);                          // t1 = jnum^2
+    fp2mul_mont(jnum, t1, jnum);                    // jnum = jnum*t1
+    fp2add(jnum, jnum, jnum);                       // jnum = jnum+jnum
+    fp2add(jnum, jnum, jnum);                       // jnum = jnum+jnum
+}
+
+
 void j_inv(const f2elm_t A, const f2elm_t C, f2elm_t jinv)
 { // Computes the j-invariant of a Montgomery curve with projective constant.
   // Input: A,C in GF(p^2).
   // Output: j=256*(A^2-3*C^2)^3/(C^4*(A^2-4*C^2)), which is the j-invariant of the Montgomery curve B*y^2=x^3+(A/C)*x^2+x or (equivalently) j-invariant of B'*y^2=C*x^3+A*x^2+C*x.
-    f2elm_t t0, t1;
+    f2elm_t t0;
     
-    fp2sqr_mont(A, jinv);                           // jinv = A^2        
-    fp2sqr_mont(C, t1);                             // t1 = C^2
-    fp2add(t1, t1, t0);                             // t0 = t1+t1
-    fp2sub(jinv, t0, t0);                           // t0 = jinv-t0
-    fp2sub(t0, t1, t0);                             // t0 = t0-t1
-    fp2sub(t0, t1, jinv);                           // jinv = t0-t1
-    fp2sqr_mont(t1, t1);                            // t1 = t1^2
-    fp2mul_mont(jinv, t1, jinv);                    // jinv = jinv*t1
-    fp2add(t0, t0, t0);                             // t0 = t0+t0
-    fp2add(t0, t0, t0);                             // t0 = t0+t0
-    fp2sqr_mont(t0, t1);                            // t1 = t0^2
-    fp2mul_mont(t0, t1, t0);                        // t0 = t0*t1
-    fp2add(t0, t0, t0);                             // t0 = t0+t0
-    fp2add(t0, t0, t0);                             // t0 = t0+t0
+    j_inv_proj(A, C, t0, jinv);                     // j = t0/jinv
     fp2inv_mont(jinv);                              // jinv = 1/jinv 
     fp2mul_mont(jinv, t0, jinv);                    // jinv = t0*jinv
 }
@@ -358,14 +374,83 @@ static void LADDER3PT(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, con
         prevbit = bit;
         mask = 0 - (digit_t)swap;
 
+#if defined(_LADDER_ASM_)
+        ladder3pt_step_asm((digit_t*)R0, (digit_t*)R2, (digit_t*)R, (const digit_t*)A24, mask);
+#else
         swap_points(R, R2, mask);
         xDBLADD(R0, R2, R->X, R->Z, A24);
+#endif
+    }
+    swap = 0 ^ prevbit;
+    mask = 0 - (digit_t)swap;
+    swap_points(R, R2, mask);
+}
+
+#if !defined(COMPRESS)
+
+
+static void xADD_affine(const f2elm_t xP, point_proj_t Q, const point_proj_t PQ)
+{ // Differential addition with an affine point.
+  // Input: affine x-coordinate xP of a point P, projective Montgomery points Q=(XQ:ZQ) and P-Q=(XPQ:ZPQ).
+  // Output: projective Montgomery point Q <- P+Q = (XQP:ZQP) such that x(Q+P)=XQP/ZQP.
+    f2elm_t t0, t1, t2;
+
+    mp2_add(Q->X, Q->Z, t0);                        // t0 = XQ+ZQ
+    mp2_sub_p2(Q->X, Q->Z, t1);                     // t1 = XQ-ZQ
+    fpsub(xP[0], (digit_t*)&Montgomery_one, t2[0]);
+    fpcopy(xP[1], t2[1]);                           // t2 = xP-1
+    fp2mul_mont(t0, t2, t0);                        // t0 = (xP-1)*(XQ+ZQ)
+    fpadd(xP[0], (digit_t*)&Montgomery_one, t2[0]); // t2 = xP+1
+    fp2mul_mont(t1, t2, t1);                        // t1 = (xP+1)*(XQ-ZQ)
+    mp2_sub_p2(t0, t1, t2);                         // t2 = (xP-1)*(XQ+ZQ)-(xP+1)*(XQ-ZQ)
+    mp2_add(t0, t1, t0);                            // t0 = (xP-1)*(XQ+ZQ)+(xP+1)*(XQ-ZQ)
+    fp2sqr_mont(t2, t2);                            // t2 = [(xP-1)*(XQ+ZQ)-(xP+1)*(XQ-ZQ)]^2
+    fp2sqr_mont(t0, t0);                            // t0 = [(xP-1)*(XQ+ZQ)+(xP+1)*(XQ-ZQ)]^2
+    fp2mul_mont(PQ->Z, t0, Q->X);                   // XQ = ZPQ*[(xP-1)*(XQ+ZQ)+(xP+1)*(XQ-ZQ)]^2
+    fp2mul_mont(PQ->X, t2, Q->Z);                   // ZQ = XPQ*[(xP-1)*(XQ+ZQ)-(xP+1)*(XQ-ZQ)]^2
+}
+
+
+static void LADDER3PT_fixed_base(const f2elm_t xP, const f2elm_t xPQ, const digit_t* table, const digit_t* m, const unsigned int AliceOrBob, point_proj_t R)
+{ // Right-to-left three-point ladder for a fixed point Q, R = P+[m]Q. Q is a basis point of the starting curve or of a cached public key.
+  // The doublings of Q are replaced by lookups of the affine x-coordinates of [2^i]Q in table, so that each step is a single differential addition.
+    point_proj_t R2 = {0};
+    f2elm_t xQ;
+    digit_t mask;
+    int i, nbits, bit, swap, prevbit = 0;
+
+    if (AliceOrBob == ALICE) {
+        nbits = OALICE_BITS;
+    } else {
+        nbits = OBOB_BITS - 1;
+    }
+
+    // Initializing points
+    fp2copy(xPQ, R2->X);
+    fpcopy((digit_t*)&Montgomery_one, (digit_t*)R2->Z);
+    fp2copy(xP, R->X);
+    fpcopy((digit_t*)&Montgomery_one, (digit_t*)R->Z);
+    fpzero((digit_t*)(R->Z)[1]);
+
+    // Main loop
+    for (i = 0; i < nbits; i++) {
+        bit = (m[i >> LOG2RADIX] >> (i & (RADIX-1))) & 1;
+        swap = bit ^ prevbit;
+        prevbit = bit;
+        mask = 0 - (digit_t)swap;
+
+        fpcopy(table + 2*i*NWORDS_FIELD, xQ[0]);
+        fpcopy(table + (2*i+1)*NWORDS_FIELD, xQ[1]);
+        swap_points(R, R2, mask);
+        xADD_affine(xQ, R2, R);
     }
     swap = 0 ^ prevbit;
     mask = 0 - (digit_t)swap;
     swap_points(R, R2, mask);
 }
 
+#endif
+
 #ifdef COMPRESS
 
 
@@ -430,7 +515,7 @@ static void CompletePoint(const point_proj_t P, point_full_proj_t R)
 
 void CompleteMPoint(const f2elm_t A, const f2elm_t PX, const f2elm_t PZ, point_full_proj_t R)
 { // Given an xz-only representation on a montgomery curve, compute its affine representation
-    f2elm_t zero = {0}, one = {0}, xz, yz, s2, r2, invz, temp0, temp1;
+    f2elm_t zero = {0}, one = {0}, xz, yz, r2, invz, temp0, temp1;
 
     fpcopy((digit_t*)&Montgomery_one, one[0]);    
     if (memcmp(PZ[0], zero, NBITS_TO_NBYTES(NBITS_FIELD)) != 0 || memcmp(PZ[1], zero, NBITS_TO_NBYTES(NBITS_FIELD)) != 0) {
@@ -439,10 +524,8 @@ void CompleteMPoint(const f2elm_t A, const f2elm_t PX, const f2elm_t PZ, point_f
         fpadd(PX[1], PZ[0], temp0[1]);
         fpadd(PX[0], PZ[1], temp1[0]);
         fpsub(PX[1], PZ[0], temp1[1]);        
-        fp2mul_mont(temp0, temp1, s2);     // s2 = (x + i*z)*(x - i*z);
-        fp2mul_mont(A, xz, temp0);
-        fp2add(temp0, s2, temp1);
-        fp2mul_mont(xz, temp1, r2);        // r2 = xz*(A*xz + s2);
+        fp2muladd_mont(A, xz, temp0, temp1, temp1);    // temp1 = A*xz + (x + i*z)*(x - i*z);
+        fp2mul_mont(xz, temp1, r2);        // r2 = xz*(A*xz + (x + i*z)*(x - i*z));
         sqrt_Fp2(r2, yz);
         fp2copy(PZ, invz);
         fp2inv_mont_bingcd(invz);        
@@ -571,9 +654,7 @@ static void eval_dual_4_isog(const f2elm_t A24, const f2elm_t C24, const f2elm_t
     fp2sub(t2, t3, t2);
     fp2mul_mont(t2, t0, P->X);
     fp2mul_mont(t3, t1, P->Z);
-    fp2mul_mont(coeff[0], P->X, P->X);
-    fp2mul_mont(coeff[1], P->Z, t0);
-    fp2add(P->X, t0, P->X);
+    fp2muladd_mont(coeff[0], P->X, coeff[1], P->Z, P->X);
     fp2mul_mont(coeff[2], P->Z, P->Z);
 }
 
@@ -711,8 +792,12 @@ static void Ladder3pt_dual(const point_proj_t *Rs, const digit_t* m, const unsig
         prevbit = bit;
         mask = 0 - (digit_t)swap;
 
+#if defined(_LADDER_ASM_)
+        ladder3pt_step_asm((digit_t*)R0, (digit_t*)R2, (digit_t*)R, (const digit_t*)A24, mask);
+#else
         swap_points(R, R2, mask);
         xDBLADD(R0, R2, R->X, R->Z, A24);
+#endif
     }
     swap = 0 ^ prevbit;
     mask = 0 - (digit_t)swap;
@@ -154,25 +154,171 @@ void fpmul_mont(const digit_t* ma, const digit_t* mb, digit_t* mc)
 void fpsqr_mont(const digit_t* ma, digit_t* mc)
 { // Multiprecision squaring, c = a^2 mod p.
 #if defined(_MULX_) && defined(_ADX_) && (OS_TARGET == OS_NIX) && (NBITS_FIELD != 751)
-    fpmul(ma, ma, mc);
+    fpsqr(ma, mc);
 #else
     dfelm_t temp = {0};
 
+#if (((TARGET == TARGET_AMD64) && (OS_TARGET == OS_WIN) && (NBITS_FIELD != 751)) || (TARGET == TARGET_ARM64)) && !defined(GENERIC_IMPLEMENTATION)
     mp_mul(ma, ma, temp, NWORDS_FIELD);
+#else
+    mp_sqr(ma, temp, NWORDS_FIELD);
+#endif
     rdc_mont(temp, mc);
 #endif
 }
 
 
+// Constant-time field inversion via the safegcd algorithm by Bernstein and Yang (https://eprint.iacr.org/2019/266).
+// Divsteps are applied in batches of SAFEGCD_BATCH steps on the low words of f and g. The resulting transition matrix,
+// scaled by 2^SAFEGCD_BATCH, is then applied to the full-length values. Signed values are stored in two's complement.
+#define SAFEGCD_NWORDS       (NWORDS_FIELD+1)                                            // Number of words of the signed values f, g, d and e
+#define SAFEGCD_BATCH        (RADIX-2)                                                   // Number of divsteps per batch
+#define SAFEGCD_ITERATIONS   ((49*NBITS_FIELD+80)/17)                                    // Divstep bound for NBITS_FIELD-bit inputs (Theorem 11.2)
+#define SAFEGCD_NBATCHES     ((SAFEGCD_ITERATIONS+SAFEGCD_BATCH-1)/SAFEGCD_BATCH)
+
+
+static inline void safegcd_divsteps(digit_t* delta, digit_t f, digit_t g, digit_t* t)
+{ // Computes SAFEGCD_BATCH divsteps on the low words f and g. Returns the transition matrix t = {u, v, q, r} scaled by 2^SAFEGCD_BATCH,
+  // such that the updated values are f' = (u*f + v*g)/2^SAFEGCD_BATCH and g' = (q*f + r*g)/2^SAFEGCD_BATCH.
+    digit_t u = 1, v = 0, q = 0, r = 1, c1, c2, x;
+    unsigned int i;
+
+    for (i = 0; i < SAFEGCD_BATCH; i++) {
+        c2 = 0 - (g & 1);                                                 // c2 = -1 if g is odd
+        c1 = c2 & (0 - ((0 - *delta) >> (RADIX-1)));                      // c1 = -1 if delta > 0 and g is odd
+        x = (f ^ g) & c1; f ^= x; g ^= x; g = (g ^ c1) - c1;              // If c1 = -1 then (f, g) = (g, -f)
+        x = (u ^ q) & c1; u ^= x; q ^= x; q = (q ^ c1) - c1;
+        x = (v ^ r) & c1; v ^= x; r ^= x; r = (r ^ c1) - c1;
+        *delta = (*delta ^ c1) - c1;                                      // If c1 = -1 then delta = -delta
+        g += f & c2; q += u & c2; r += v & c2;                            // If g is odd then g = g + f
+        g >>= 1; u <<= 1; v <<= 1;
+        *delta += 1;
+    }
+    t[0] = u; t[1] = v; t[2] = q; t[3] = r;
+}
+
+
+static inline void safegcd_mul_digit(const digit_t* a, const digit_t s, digit_t* c)
+{ // Signed multiplication by a digit, c = a*s, where lng(a) = SAFEGCD_NWORDS and lng(c) = SAFEGCD_NWORDS+1.
+    digit_t mask_s = 0 - (s >> (RADIX-1)), mask_a = 0 - (a[SAFEGCD_NWORDS-1] >> (RADIX-1));
+    digit_t abs_s = (s ^ mask_s) - mask_s, UV[2], hi = 0;
+    unsigned int i, carry;
+
+    for (i = 0; i < SAFEGCD_NWORDS; i++) {
+        MUL(a[i], abs_s, UV+1, UV[0]);
+        ADDC(0, UV[0], hi, carry, c[i]);
+        hi = UV[1] + carry;
+    }
+    c[SAFEGCD_NWORDS] = hi - (abs_s & mask_a);                            // Correction for a < 0
+    carry = (unsigned int)(mask_s & 1);
+    for (i = 0; i < SAFEGCD_NWORDS+1; i++) {                              // If s < 0 then c = -c
+        ADDC(carry, c[i] ^ mask_s, 0, carry, c[i]);
+    }
+}
+
+
+static inline void safegcd_lincomb(const digit_t* a, const digit_t* b, const digit_t sa, const digit_t sb, digit_t* c)
+{ // Signed linear combination c = a*sa + b*sb, where lng(a) = lng(b) = SAFEGCD_NWORDS and lng(c) = SAFEGCD_NWORDS+1.
+    digit_t t[SAFEGCD_NWORDS+1];
+    unsigned int i, carry = 0;
+
+    safegcd_mul_digit(a, sa, c);
+    safegcd_mul_digit(b, sb, t);
+    for (i = 0; i < SAFEGCD_NWORDS+1; i++) {
+        ADDC(carry, c[i], t[i], carry, c[i]);
+    }
+}
+
+
+static inline void safegcd_shiftr(const digit_t* a, digit_t* c)
+{ // Arithmetic right shift by SAFEGCD_BATCH bits, c = a/2^SAFEGCD_BATCH, where lng(a) = SAFEGCD_NWORDS+1 and lng(c) = SAFEGCD_NWORDS.
+  // The division is exact for all the values passed to this function.
+    unsigned int i;
+
+    for (i = 0; i < SAFEGCD_NWORDS; i++) {
+        c[i] = (a[i] >> SAFEGCD_BATCH) | (a[i+1] << (RADIX-SAFEGCD_BATCH));
+    }
+}
+
+
+static inline void safegcd_update_fg(digit_t* f, digit_t* g, const digit_t* t)
+{ // Update of f and g using the transition matrix t = {u, v, q, r}, (f, g) = ((u*f + v*g)/2^SAFEGCD_BATCH, (q*f + r*g)/2^SAFEGCD_BATCH).
+    digit_t tf[SAFEGCD_NWORDS+1], tg[SAFEGCD_NWORDS+1];
+
+    safegcd_lincomb(f, g, t[0], t[1], tf);
+    safegcd_lincomb(f, g, t[2], t[3], tg);
+    safegcd_shiftr(tf, f);
+    safegcd_shiftr(tg, g);
+}
+
+
+static inline void safegcd_update_de_reduce(digit_t* d, const digit_t* p)
+{ // Division of d by 2^SAFEGCD_BATCH modulo p, where lng(d) = SAFEGCD_NWORDS+1 and |d| < 2^SAFEGCD_BATCH*p. Output in the range (-p, p).
+  // Since p = -1 mod 2^SAFEGCD_BATCH, adding m*p with m = d mod 2^SAFEGCD_BATCH clears the low SAFEGCD_BATCH bits of d.
+    digit_t m = d[0] & (((digit_t)1 << SAFEGCD_BATCH) - 1), mask;
+    digit_t t[SAFEGCD_NWORDS+1], r[SAFEGCD_NWORDS];
+    unsigned int i, carry = 0, borrow = 0;
+
+    safegcd_mul_digit(p, m, t);
+    for (i = 0; i < SAFEGCD_NWORDS+1; i++) {
+        ADDC(carry, d[i], t[i], carry, d[i]);
+    }
+    safegcd_shiftr(d, d);                                                 // d in (-p, 2p)
+    for (i = 0; i < SAFEGCD_NWORDS; i++) {
+        SUBC(borrow, d[i], p[i], borrow, r[i]);
+    }
+    mask = (r[SAFEGCD_NWORDS-1] >> (RADIX-1)) - 1;                        // mask = -1 if d-p >= 0
+    for (i = 0; i < SAFEGCD_NWORDS; i++) {
+        d[i] = (mask & (r[i] ^ d[i])) ^ d[i];
+    }
+}
+
+
+static inline void safegcd_update_de(digit_t* d, digit_t* e, const digit_t* t, const digit_t* p)
+{ // Update of d and e using the transition matrix t = {u, v, q, r}, (d, e) = ((u*d + v*e)/2^SAFEGCD_BATCH, (q*d + r*e)/2^SAFEGCD_BATCH) mod p.
+    digit_t td[SAFEGCD_NWORDS+1], te[SAFEGCD_NWORDS+1];
+
+    safegcd_lincomb(d, e, t[0], t[1], td);
+    safegcd_lincomb(d, e, t[2], t[3], te);
+    safegcd_update_de_reduce(td, p);
+    safegcd_update_de_reduce(te, p);
+    copy_words(td, d, SAFEGCD_NWORDS);
+    copy_words(te, e, SAFEGCD_NWORDS);
+}
+
+
 void fpinv_mont(digit_t* a)
-{ // Field inversion using Montgomery arithmetic, a = a^(-1)*R mod p.
-    felm_t tt;
+{ // Constant-time field inversion using Montgomery arithmetic, a = a^(-1)*R mod p.
+  // It computes d such that d*a = f mod p, where f = gcd(p, a) = +-1 after SAFEGCD_NBATCHES batches of divsteps.
+    digit_t f[SAFEGCD_NWORDS] = {0}, g[SAFEGCD_NWORDS] = {0}, d[SAFEGCD_NWORDS] = {0}, e[SAFEGCD_NWORDS] = {0}, p[SAFEGCD_NWORDS] = {0};
+    digit_t t[4], delta = 1, mask;
+    unsigned int i, carry;
+
+    copy_words((digit_t*)PRIME, p, NWORDS_FIELD);
+    copy_words(p, f, NWORDS_FIELD);
+    fpcopy(a, g);
+    fpcorrection(g);                                                      // g = a in [0, p-1]
+    e[0] = 1;
+
+    for (i = 0; i < SAFEGCD_NBATCHES; i++) {
+        safegcd_divsteps(&delta, f[0], g[0], t);
+        safegcd_update_fg(f, g, t);
+        safegcd_update_de(d, e, t, p);
+    }
 
-    fpcopy(a, tt);
-    fpinv_chain_mont(tt);
-    fpsqr_mont(tt, tt);
-    fpsqr_mont(tt, tt);
-    fpmul_mont(a, tt, a);
+    mask = 0 - (f[SAFEGCD_NWORDS-1] >> (RADIX-1));                        // If f = -1 then d = -d
+    carry = (unsigned int)(mask & 1);
+    for (i = 0; i < SAFEGCD_NWORDS; i++) {
+        ADDC(carry, d[i] ^ mask, 0, carry, d[i]);
+    }
+    mask = 0 - (d[SAFEGCD_NWORDS-1] >> (RADIX-1));                        // If d < 0 then d = d + p
+    carry = 0;
+    for (i = 0; i < SAFEGCD_NWORDS; i++) {
+        ADDC(carry, d[i], p[i] & mask, carry, d[i]);
+    }
+
+    fpmul_mont(d, (digit_t*)&Montgomery_R2, d);                           // For a = x*R, d*R^2 = x^(-1)*R
+    fpmul_mont(d, (digit_t*)&Montgomery_R2, a);
 }
 
 
@@ -331,6 +477,70 @@ inline static void mp_dblsubfast(const digit_t* a, const digit_t* b, digit_t* c)
 }
 
 
+#if !(defined(_MULX_) && defined(_ADX_) && (OS_TARGET == OS_NIX) && (NBITS_FIELD != 751))
+// GF(p^2) products are computed with mp_mul and rdc_mont, so that sums of products can be accumulated in double precision 
+// and reduced once. The MULX/ADX builds of p434, p503 and p610 have neither mp_mul nor rdc_mont, only the fused kernels, 
+// and keep computing the sums of products with two fp2mul_mont calls.
+#define FP2_LAZY_REDUCTION
+
+inline static void mp2_mul(const f2elm_t a, const f2elm_t b, df2elm_t c)
+{ // GF(p^2) multiplication without reduction, c = a*b in GF(p^2) with double-precision coefficients.
+  // Inputs: a = a0+a1*i and b = b0+b1*i, where a0, a1, b0, b1 are in [0, 4*p-1] 
+  // Output: c = c0+c1*i, where c0, c1 are in [0, p*2^MAXBITS_FIELD-1] 
+    felm_t t1, t2;
+    dfelm_t tt1;
+    
+    mp_addfast(a[0], a[1], t1);                      // t1 = a0+a1
+    mp_addfast(b[0], b[1], t2);                      // t2 = b0+b1
+    mp_mul(a[0], b[0], c[0], NWORDS_FIELD);          // c0 = a0*b0
+    mp_mul(a[1], b[1], tt1, NWORDS_FIELD);           // tt1 = a1*b1
+    mp_mul(t1, t2, c[1], NWORDS_FIELD);              // c1 = (a0+a1)*(b0+b1)
+    mp_dblsubfast(c[0], tt1, c[1]);                  // c1 = (a0+a1)*(b0+b1) - a0*b0 - a1*b1
+    mp_subaddfast(c[0], tt1, c[0]);                  // c0 = a0*b0 - a1*b1 + p*2^MAXBITS_FIELD if a0*b0 - a1*b1 < 0, else c0 = a0*b0 - a1*b1
+}
+
+
+inline static void mp_dbladdfast(const digit_t* a, const digit_t* b, digit_t* c)
+{ // Multiprecision addition followed by subtraction of p*2^MAXBITS_FIELD, c = a+b-(p*2^MAXBITS_FIELD) if a+b >= p*2^MAXBITS_FIELD, otherwise c=a+b.
+  // Inputs: a, b in [0, p*2^MAXBITS_FIELD-1], where lng(a) = lng(b) = 2*NWORDS_FIELD.
+    felm_t t1;
+    digit_t mask;
+    unsigned int i;
+
+    mp_add(a, b, c, 2*NWORDS_FIELD);
+    mask = 0 - (digit_t)mp_sub(&c[NWORDS_FIELD], (digit_t*)PRIME, &c[NWORDS_FIELD], NWORDS_FIELD);
+    for (i = 0; i < NWORDS_FIELD; i++)
+        t1[i] = ((digit_t*)PRIME)[i] & mask;
+    mp_add(&c[NWORDS_FIELD], t1, &c[NWORDS_FIELD], NWORDS_FIELD);
+}
+
+
+inline static void mp2_dbladd(const df2elm_t a, const df2elm_t b, df2elm_t c)
+{ // GF(p^2) addition of double-precision elements, c = a+b in GF(p^2). 
+  // Inputs and output with coefficients in [0, p*2^MAXBITS_FIELD-1].
+    mp_dbladdfast(a[0], b[0], c[0]);
+    mp_dbladdfast(a[1], b[1], c[1]);
+}
+
+
+inline static void mp2_dblsub(const df2elm_t a, const df2elm_t b, df2elm_t c)
+{ // GF(p^2) subtraction of double-precision elements, c = a-b in GF(p^2). 
+  // Inputs and output with coefficients in [0, p*2^MAXBITS_FIELD-1].
+    mp_subaddfast(a[0], b[0], c[0]);
+    mp_subaddfast(a[1], b[1], c[1]);
+}
+
+
+inline static void rdc2_mont(df2elm_t a, f2elm_t c)
+{ // GF(p^2) Montgomery reduction, c = a*2^(-MAXBITS_FIELD) in GF(p^2).
+  // Input: a = a0+a1*i, where a0, a1 are in [0, p*2^MAXBITS_FIELD-1] 
+  // Output: c = c0+c1*i, where c0, c1 are in [0, 2*p-1] 
+    rdc_mont(a[0], c[0]);
+    rdc_mont(a[1], c[1]);
+}
+
+#endif
+
 void fp2mul_mont(const f2elm_t a, const f2elm_t b, f2elm_t c)
 { // GF(p^2) multiplication using Montgomery arithmetic, c = a*b in GF(p^2).
   // Inputs: a = a0+a1*i and b = b0+b1*i, where a0, a1, b0, b1 are in [0, 2*p-1] 
@@ -342,18 +552,54 @@ void fp2mul_mont(const f2elm_t a, const f2elm_t b, f2elm_t c)
     fp2mul_c1_mont(a[0], b[0], c[1]);                // c1 = a0*b1 + a1*b0 
     fpcopy(t1, c[0]);
 #else
-    felm_t t1, t2;
-    dfelm_t tt1, tt2, tt3; 
+    df2elm_t tt1; 
     
-    mp_addfast(a[0], a[1], t1);                      // t1 = a0+a1
-    mp_addfast(b[0], b[1], t2);                      // t2 = b0+b1
-    mp_mul(a[0], b[0], tt1, NWORDS_FIELD);           // tt1 = a0*b0
-    mp_mul(a[1], b[1], tt2, NWORDS_FIELD);           // tt2 = a1*b1
-    mp_mul(t1, t2, tt3, NWORDS_FIELD);               // tt3 = (a0+a1)*(b0+b1)
-    mp_dblsubfast(tt1, tt2, tt3);                    // tt3 = (a0+a1)*(b0+b1) - a0*b0 - a1*b1
-    mp_subaddfast(tt1, tt2, tt1);                    // tt1 = a0*b0 - a1*b1 + p*2^MAXBITS_FIELD if a0*b0 - a1*b1 < 0, else tt1 = a0*b0 - a1*b1
-    rdc_mont(tt3, c[1]);                             // c1 = (a0+a1)*(b0+b1) - a0*b0 - a1*b1 
-    rdc_mont(tt1, c[0]);                             // c0 = a0*b0 - a1*b1
+    mp2_mul(a, b, tt1);                              // tt1 = a*b
+    rdc2_mont(tt1, c);                               // c = a*b mod p
+#endif
+}
+
+
+inline static void fp2muladd_mont(const f2elm_t a, const f2elm_t b, const f2elm_t c, const f2elm_t d, f2elm_t e)
+{ // GF(p^2) sum of products using Montgomery arithmetic, e = a*b + c*d in GF(p^2).
+  // With FP2_LAZY_REDUCTION, the products are accumulated in double precision and reduced once.
+  // Inputs: a, b, c, d with coefficients in [0, 2*p-1] 
+  // Output: e = e0+e1*i, where e0, e1 are in [0, 2*p-1] 
+#if defined(FP2_LAZY_REDUCTION)
+    df2elm_t tt1, tt2;
+
+    mp2_mul(a, b, tt1);                              // tt1 = a*b
+    mp2_mul(c, d, tt2);                              // tt2 = c*d
+    mp2_dbladd(tt1, tt2, tt1);                       // tt1 = a*b + c*d
+    rdc2_mont(tt1, e);                               // e = a*b + c*d mod p
+#else
+    f2elm_t t1, t2;
+
+    fp2mul_mont(a, b, t1);                           // t1 = a*b
+    fp2mul_mont(c, d, t2);                           // t2 = c*d
+    fp2add(t1, t2, e);                               // e = a*b + c*d
+#endif
+}
+
+
+inline static void fp2mulsub_mont(const f2elm_t a, const f2elm_t b, const f2elm_t c, const f2elm_t d, f2elm_t e)
+{ // GF(p^2) difference of products using Montgomery arithmetic, e = a*b - c*d in GF(p^2).
+  // With FP2_LAZY_REDUCTION, the products are accumulated in double precision and reduced once.
+  // Inputs: a, b, c, d with coefficients in [0, 2*p-1] 
+  // Output: e = e0+e1*i, where e0, e1 are in [0, 2*p-1] with FP2_LAZY_REDUCTION, and in [0, 4*p-1] otherwise
+#if defined(FP2_LAZY_REDUCTION)
+    df2elm_t tt1, tt2;
+
+    mp2_mul(a, b, tt1);                              // tt1 = a*b
+    mp2_mul(c, d, tt2);                              // tt2 = c*d
+    mp2_dblsub(tt1, tt2, tt1);                       // tt1 = a*b - c*d
+    rdc2_mont(tt1, e);                               // e = a*b - c*d mod p
+#else
+    f2elm_t t1, t2;
+
+    fp2mul_mont(a, b, t1);                           // t1 = a*b
+    fp2mul_mont(c, d, t2);                           // t2 = c*d
+    mp2_sub_p2(t1, t2, e);                           // e = a*b - c*d
 #endif
 }
 
@@ -791,6 +1037,60 @@ void fp2inv_mont(f2elm_t a)
 }
 
 
+static digit_t fp2_zero_to_one(const f2elm_t a, f2elm_t c)
+{ // Constant-time replacement of zero, c = 1 if a = 0, otherwise c = a.
+  // Returns a mask equal to 0 if a != 0, or to all-ones if a = 0.
+    unsigned int i;
+    digit_t mask = 0;
+
+    fp2copy(a, c);
+    fp2correction(c);
+    for (i = 0; i < NWORDS_FIELD; i++) {
+        mask |= c[0][i] | c[1][i];
+    }
+    mask = (digit_t)is_digit_zero_ct(mask);
+    mask = 0 - mask;
+    for (i = 0; i < NWORDS_FIELD; i++) {
+        c[0][i] |= ((digit_t*)&Montgomery_one)[i] & mask;
+    }
+    return mask;
+}
+
+
+void mont_n_way_inv_ct(const f2elm_t* vec, const unsigned int n, f2elm_t* out)
+{ // n-way simultaneous inversion using Montgomery's trick, out[i] = 1/vec[i] in GF(p^2), with out[i] = 0 if vec[i] = 0.
+  // Zero inputs are replaced by one while accumulating, so they do not spoil the rest of the outputs.
+  // This function runs in constant time. Also, vec and out CANNOT be the same variable!
+    f2elm_t t1, t2;
+    digit_t mask;
+    unsigned int i, j;
+
+    fp2_zero_to_one(vec[0], out[0]);              // out[0] = vec[0]
+    for (i = 1; i < n; i++) {
+        fp2_zero_to_one(vec[i], t2);
+        fp2mul_mont(out[i-1], t2, out[i]);        // out[i] = out[i-1]*vec[i]
+    }
+
+    fp2copy(out[n-1], t1);                        // t1 = 1/out[n-1]
+    fp2inv_mont(t1);
+
+    for (i = n-1; i >= 1; i--) {
+        mask = fp2_zero_to_one(vec[i], t2);
+        fp2mul_mont(out[i-1], t1, out[i]);        // out[i] = t1*out[i-1]
+        fp2mul_mont(t1, t2, t1);                  // t1 = t1*vec[i]
+        for (j = 0; j < NWORDS_FIELD; j++) {
+            out[i][0][j] &= ~mask;
+            out[i][1][j] &= ~mask;
+        }
+    }
+    mask = fp2_zero_to_one(vec[0], t2);
+    for (j = 0; j < NWORDS_FIELD; j++) {          // out[0] = t1
+        out[0][0][j] = t1[0][j] & ~mask;
+        out[0][1][j] = t1[1][j] & ~mask;
+    }
+}
+
+
 void to_fp2mont(const f2elm_t a, f2elm_t mc)
 { // Conversion of a GF(p^2) element to Montgomery representation,
   // mc_i = a_i*R^2*R^(-1) = a_i*R in GF(p^2). 
@@ -849,6 +1149,146 @@ void mp_shiftl1(digit_t* x, const unsigned int nwords)
     x[0] <<= 1;
 }
 
+// Constant-time Legendre symbol via the binary GCD with approximations by Pornin (https://eprint.iacr.org/2020/972).
+// Each batch runs LEGENDRE_BATCH iterations on 64-bit approximations of a and b that keep their 31 low bits and the 33 top bits
+// of max(a, b). The symbol is updated with the low bits of a and b, which stay exact for the whole batch since LEGENDRE_BATCH
+// leaves 3 of the 31 low bits. The update factors, scaled by 2^LEGENDRE_BATCH, are then applied to the full-length values with
+// the safegcd routines. The approximations may turn one of a and b negative, but never both, so the usual rules apply.
+#define LEGENDRE_BATCH       29                                                          // Number of iterations per batch
+#define LEGENDRE_NBATCHES    ((2*NBITS_FIELD-1+LEGENDRE_BATCH-1)/LEGENDRE_BATCH)         // 2*NBITS_FIELD-1 iterations suffice
+#define LEGENDRE_NWORDS64    ((SAFEGCD_NWORDS*RADIX+63)/64)
+#define LEGENDRE_LOW_MASK    (((uint64_t)1 << 31) - 1)
+
+
+static inline uint64_t legendre_word64(const digit_t* a, const unsigned int i)
+{ // Returns the i-th 64-bit word of a, where lng(a) = SAFEGCD_NWORDS.
+#if RADIX == 64
+    return (uint64_t)a[i];
+#else
+    return (uint64_t)a[2*i] | ((2*i+1 < SAFEGCD_NWORDS) ? ((uint64_t)a[2*i+1] << 32) : 0);
+#endif
+}
+
+
+static inline unsigned int legendre_clz(uint64_t x)
+{ // Constant-time count of leading zeros, 64 if x = 0.
+    unsigned int r = 0, s, m;
+
+    for (s = 32; s > 0; s >>= 1) {
+        m = (unsigned int)(((x >> (64-s)) - 1) >> 63);                    // m = 1 if the top s bits of x are zero
+        r += m*s;
+        x <<= m*s;
+    }
+    return r + (unsigned int)(1 - (x >> 63));
+}
+
+
+static inline void legendre_approx(const digit_t* a, const digit_t* b, uint64_t* xa, uint64_t* xb)
+{ // Approximations xa and xb of a and b, where a, b >= 0. They are exact if a, b < 2^64.
+    uint64_t ah = legendre_word64(a, 0), al = 0, bh = legendre_word64(b, 0), bl = 0, wa, wb, nz, found = 0;
+    unsigned int i, s;
+
+    for (i = 1; i < LEGENDRE_NWORDS64; i++) {                             // (ah, al) and (bh, bl) = highest nonzero word of a|b and the word below
+        wa = legendre_word64(a, i);
+        wb = legendre_word64(b, i);
+        nz = 0 - (((wa | wb) | (0 - (wa | wb))) >> 63);
+        al ^= nz & (al ^ legendre_word64(a, i-1)); ah ^= nz & (ah ^ wa);
+        bl ^= nz & (bl ^ legendre_word64(b, i-1)); bh ^= nz & (bh ^ wb);
+        found |= nz;
+    }
+    s = legendre_clz(ah | bh) & (unsigned int)found;
+    ah = (ah << s) | ((al >> 1) >> (63 - s));
+    bh = (bh << s) | ((bl >> 1) >> (63 - s));
+    *xa = (legendre_word64(a, 0) & LEGENDRE_LOW_MASK) | (ah & ~LEGENDRE_LOW_MASK);
+    *xb = (legendre_word64(b, 0) & LEGENDRE_LOW_MASK) | (bh & ~LEGENDRE_LOW_MASK);
+}
+
+
+static inline digit_t legendre_steps(uint64_t xa, uint64_t xb, digit_t* t)
+{ // Computes LEGENDRE_BATCH iterations on the approximations xa and xb. Returns the update factors t = {f0, g0, f1, g1} scaled by 2^LEGENDRE_BATCH,
+  // such that the updated values are a' = (f0*a + g0*b)/2^LEGENDRE_BATCH and b' = (f1*a + g1*b)/2^LEGENDRE_BATCH. The low bit of the
+  // output is 1 if the Legendre symbol changes sign.
+    uint64_t f0 = 1, g0 = 0, f1 = 0, g1 = 1, c1, c2, x, ls = 0;
+    unsigned int i;
+
+    for (i = 0; i < LEGENDRE_BATCH; i++) {
+        c2 = 0 - (xa & 1);                                                // c2 = -1 if a is odd
+        c1 = c2 & (0 - ((xa ^ ((xa ^ xb) | ((xa - xb) ^ xb))) >> 63));   // c1 = -1 if a is odd and a < b
+        ls ^= c1 & ((xa & xb) >> 1);                                      // Swap: flip if a = b = 3 mod 4
+        x = (xa ^ xb) & c1; xa ^= x; xb ^= x;                             // If c1 = -1 then (a, b) = (b, a)
+        x = (f0 ^ f1) & c1; f0 ^= x; f1 ^= x;
+        x = (g0 ^ g1) & c1; g0 ^= x; g1 ^= x;
+        xa -= xb & c2; f0 -= f1 & c2; g0 -= g1 & c2;                      // If a is odd then a = a - b
+        xa >>= 1; f1 <<= 1; g1 <<= 1;                                     // a = a/2
+        ls ^= (xb >> 1) ^ (xb >> 2);                                      // Halving: flip if b = 3, 5 mod 8
+    }
+    t[0] = (digit_t)f0; t[1] = (digit_t)g0; t[2] = (digit_t)f1; t[3] = (digit_t)g1;
+    return (digit_t)(ls & 1);
+}
+
+
+static inline digit_t legendre_update(digit_t* a, digit_t* b, const digit_t* t)
+{ // Update of a and b using the update factors t = {f0, g0, f1, g1}, followed by the negation of negative results.
+  // Returns 1 if the Legendre symbol changes sign.
+    digit_t ta[SAFEGCD_NWORDS+1], tb[SAFEGCD_NWORDS+1], mask_a, mask_b;
+    unsigned int i, carry_a, carry_b;
+
+    safegcd_lincomb(a, b, t[0], t[1], ta);
+    safegcd_lincomb(a, b, t[2], t[3], tb);
+    for (i = 0; i < SAFEGCD_NWORDS; i++) {
+        a[i] = (ta[i] >> LEGENDRE_BATCH) | (ta[i+1] << (RADIX-LEGENDRE_BATCH));
+        b[i] = (tb[i] >> LEGENDRE_BATCH) | (tb[i+1] << (RADIX-LEGENDRE_BATCH));
+    }
+    mask_a = 0 - (a[SAFEGCD_NWORDS-1] >> (RADIX-1));                      // If a < 0 then a = -a, and b > 0
+    mask_b = 0 - (b[SAFEGCD_NWORDS-1] >> (RADIX-1));                      // If b < 0 then b = -b, and a >= 0
+    carry_a = (unsigned int)(mask_a & 1);
+    carry_b = (unsigned int)(mask_b & 1);
+    for (i = 0; i < SAFEGCD_NWORDS; i++) {
+        ADDC(carry_a, a[i] ^ mask_a, 0, carry_a, a[i]);
+        ADDC(carry_b, b[i] ^ mask_b, 0, carry_b, b[i]);
+    }
+
+    return mask_a & (b[0] >> 1) & 1;                                      // Negation of a: flip if b = 3 mod 4
+}
+
+
+unsigned char is_sqr_fp(const felm_t a)
+{ // Test if a is a square in GF(p) and return 1 if true (also for a = 0), 0 otherwise. It runs in constant time.
+  // a is in Montgomery representation, i.e., a = x*R with R a power of 2. Since p = 7 mod 8, 2 is a square and a is a square iff x is.
+    digit_t f[SAFEGCD_NWORDS] = {0}, g[SAFEGCD_NWORDS] = {0}, t[4], ls = 0, nz = 0;
+    uint64_t xa, xb;
+    unsigned int i;
+
+    fpcopy(a, f);
+    fpcorrection(f);                                                      // (a, b) = (f, g) = (a, p)
+    copy_words((digit_t*)PRIME, g, NWORDS_FIELD);
+    for (i = 0; i < NWORDS_FIELD; i++) {
+        nz |= f[i];
+    }
+
+    for (i = 0; i < LEGENDRE_NBATCHES; i++) {
+        legendre_approx(f, g, &xa, &xb);
+        ls ^= legendre_steps(xa, xb, t);
+        ls ^= legendre_update(f, g, t);
+    }
+
+    return (unsigned char)(1 ^ (ls & is_digit_nonzero_ct(nz)));          // Now f = 0 and g = 1 if a != 0
+}
+
+
+unsigned char is_sqr_fp2(const f2elm_t a) 
+{ // Test if a is a square in GF(p^2) and return 1 if true, 0 otherwise
+  // a is a square in GF(p^2) iff its norm a0^2 + a1^2 is a square in GF(p)
+    felm_t a0, a1, z;
+    
+    fpsqr_mont(a[0], a0);
+    fpsqr_mont(a[1], a1);
+    fpadd(a0, a1, z);
+    
+    return is_sqr_fp(z);
+}
+
+
 #ifdef COMPRESS
 
 static inline unsigned int is_felm_zero(const felm_t x)
@@ -968,34 +1408,6 @@ static bool is_zero(digit_t* a, unsigned int nwords)
 }
 
 
-unsigned char is_sqr_fp2(const f2elm_t a, felm_t s) 
-{ // Test if a is a square in GF(p^2) and return 1 if true, 0 otherwise
-  // If a is a quadratic residue, s will be assigned with a partially computed square root of a
-    int i;
-    felm_t a0,a1,z,temp;
-    
-    fpsqr_mont(a[0],a0);
-    fpsqr_mont(a[1],a1);
-    fpadd(a0,a1,z);
-    
-    fpcopy(z,s);
-    for (i = 0; i < OALICE_BITS - 2; i++) {             
-        fpsqr_mont(s, s);
-    }
-    for (i = 0; i < OBOB_EXPON; i++) {
-        fpsqr_mont(s, temp);
-        fpmul_mont(s, temp, s);
-    }  
-    fpsqr_mont(s,temp);          // s = z^((p+1)/4)
-    fpcorrection(temp);
-    fpcorrection(z);
-    if (memcmp(temp, z, NBITS_TO_NBYTES(NBITS_FIELD)) != 0)  // s^2 !=? z
-        return 0;
-    
-    return 1;
-}
-
-
 void sqrt_Fp2(const f2elm_t u, f2elm_t y)
 { // Computes square roots of elements in (Fp2)^2 using Hamburg's trick. 
     felm_t t0, t1, t2, t3;
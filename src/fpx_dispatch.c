@@ -0,0 +1,107 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: runtime CPU feature dispatch for the x64 field arithmetic
+*           The MULX/ADX assembly kernels are used only if CPUID reports support for BMI2 and ADX when the library
+*           is loaded. Otherwise, the portable comba multiplication and Montgomery reduction of generic/fp_generic.c,
+*           included by fp_x64.c under the names mp_mul_portable, mp_sqr_portable and rdc_mont_portable, are used instead.
+*           Setting the environment variable SIDH_DISABLE_MULX_ADX forces the portable kernels.
+*********************************************************************************************/
+
+#include <cpuid.h>
+#include <stdlib.h>
+
+
+static unsigned int mulx_adx_supported = 0;
+
+
+__attribute__((constructor)) static void fp_dispatch_init(void)
+{ // Detection of MULX (BMI2, CPUID.7.0:EBX[8]) and ADX (CPUID.7.0:EBX[19]) support
+    unsigned int eax, ebx, ecx, edx;
+
+    if (getenv("SIDH_DISABLE_MULX_ADX") != NULL) {
+        return;
+    }
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        mulx_adx_supported = ((ebx >> 8) & 1) & ((ebx >> 19) & 1);
+    }
+}
+
+
+static inline void mp_subadd_portable(const digit_t* a, const digit_t* b, digit_t* c)
+{ // Multiprecision subtraction followed by addition with p*2^MAXBITS_FIELD, c = a-b+(p*2^MAXBITS_FIELD) if a-b < 0, otherwise c=a-b.
+    felm_t t;
+    unsigned int i;
+    digit_t mask = 0 - (digit_t)mp_sub(a, b, c, 2*NWORDS_FIELD);
+
+    for (i = 0; i < NWORDS_FIELD; i++) {
+        t[i] = ((digit_t*)PRIME)[i] & mask;
+    }
+    mp_add(&c[NWORDS_FIELD], t, &c[NWORDS_FIELD], NWORDS_FIELD);
+}
+
+
+static inline void fpmul_portable(const digit_t* a, const digit_t* b, digit_t* c)
+{ // Field multiplication using Montgomery arithmetic, c = a*b*R^-1 mod 2p
+    dfelm_t tt;
+
+    mp_mul_portable(a, b, tt, NWORDS_FIELD);
+    rdc_mont_portable(tt, c);
+}
+
+
+static inline void fpsqr_portable(const digit_t* a, digit_t* c)
+{ // Field squaring using Montgomery arithmetic, c = a^2*R^-1 mod 2p
+    dfelm_t tt;
+
+    mp_sqr_portable(a, tt, NWORDS_FIELD);
+    rdc_mont_portable(tt, c);
+}
+
+
+static inline void fp2mul_c0_portable(const digit_t* a, const digit_t* b, digit_t* c)
+{ // Real part of a GF(p^2) multiplication, c = a0*b0 - a1*b1 mod 2p, where a = {a0, a1} and b = {b0, b1}
+    dfelm_t tt1, tt2;
+
+    mp_mul_portable(a, b, tt1, NWORDS_FIELD);                                   // tt1 = a0*b0
+    mp_mul_portable(&a[NWORDS_FIELD], &b[NWORDS_FIELD], tt2, NWORDS_FIELD);     // tt2 = a1*b1
+    mp_subadd_portable(tt1, tt2, tt1);                                          // tt1 = a0*b0 - a1*b1 (+ p*2^MAXBITS_FIELD)
+    rdc_mont_portable(tt1, c);
+}
+
+
+static inline void fp2mul_c1_portable(const digit_t* a, const digit_t* b, digit_t* c)
+{ // Imaginary part of a GF(p^2) multiplication, c = a0*b1 + a1*b0 mod 2p, where a = {a0, a1} and b = {b0, b1}
+    dfelm_t tt1, tt2;
+
+    mp_mul_portable(a, &b[NWORDS_FIELD], tt1, NWORDS_FIELD);                    // tt1 = a0*b1
+    mp_mul_portable(&a[NWORDS_FIELD], b, tt2, NWORDS_FIELD);                    // tt2 = a1*b0
+    mp_add(tt1, tt2, tt1, 2*NWORDS_FIELD);                                      // tt1 = a0*b1 + a1*b0
+    rdc_mont_portable(tt1, c);
+}
+
+
+static inline void fp2sqr_c0_portable(const digit_t* a, digit_t* c)
+{ // Real part of a GF(p^2) squaring, c = a0^2 - a1^2 mod 2p, where a = {a0, a1}
+    dfelm_t tt1, tt2;
+
+    mp_sqr_portable(a, tt1, NWORDS_FIELD);                                      // tt1 = a0^2
+    mp_sqr_portable(&a[NWORDS_FIELD], tt2, NWORDS_FIELD);                       // tt2 = a1^2
+    mp_subadd_portable(tt1, tt2, tt1);                                          // tt1 = a0^2 - a1^2 (+ p*2^MAXBITS_FIELD)
+    rdc_mont_portable(tt1, c);
+}
+
+
+static inline void fp2sqr_c1_portable(const digit_t* a, digit_t* c)
+{ // Imaginary part of a GF(p^2) squaring, c = 2*a0*a1 mod 2p, where a = {a0, a1}
+    felm_t t;
+    dfelm_t tt;
+
+    mp_add(a, a, t, NWORDS_FIELD);                                              // t = 2*a0
+    mp_mul_portable(t, &a[NWORDS_FIELD], tt, NWORDS_FIELD);                     // tt = 2*a0*a1
+    rdc_mont_portable(tt, c);
+}
@@ -0,0 +1,369 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: 8-way field arithmetic using AVX-512 IFMA
+*           Eight independent field elements are processed at once, one per 64-bit lane. Each element is represented
+*           with NLIMBS52_FIELD limbs in radix 2^52, and Montgomery arithmetic uses R' = 2^(52*NLIMBS52_FIELD).
+*           Lane values are kept in the range [0, 2p-1], as in the scalar implementation.
+*********************************************************************************************/
+
+#include <immintrin.h>
+
+#define MASK52    0xFFFFFFFFFFFFFULL
+
+
+static inline void load_x8(const felm_x8_t a, __m512i* r)
+{ // Load the limbs of 8 lane elements
+    for (unsigned int i = 0; i < NLIMBS52_FIELD; i++) {
+        r[i] = _mm512_loadu_si512((const void*)a[i]);
+    }
+}
+
+
+static inline void store_x8(const __m512i* a, felm_x8_t r)
+{ // Store the limbs of 8 lane elements
+    for (unsigned int i = 0; i < NLIMBS52_FIELD; i++) {
+        _mm512_storeu_si512((void*)r[i], a[i]);
+    }
+}
+
+
+static inline void carry_x8(__m512i* a)
+{ // Carry propagation, leaving limbs 0..NLIMBS52_FIELD-2 in [0, 2^52-1]. All limbs but the top one must be non-negative
+    const __m512i mask = _mm512_set1_epi64(MASK52);
+
+    for (unsigned int i = 0; i < NLIMBS52_FIELD-1; i++) {
+        a[i+1] = _mm512_add_epi64(a[i+1], _mm512_srli_epi64(a[i], 52));
+        a[i] = _mm512_and_si512(a[i], mask);
+    }
+}
+
+
+static inline void carry_signed_x8(__m512i* a)
+{ // Signed carry propagation, leaving limbs 0..NLIMBS52_FIELD-2 in [0, 2^52-1]. The sign ends up in the top limb
+    const __m512i mask = _mm512_set1_epi64(MASK52);
+
+    for (unsigned int i = 0; i < NLIMBS52_FIELD-1; i++) {
+        a[i+1] = _mm512_add_epi64(a[i+1], _mm512_srai_epi64(a[i], 52));
+        a[i] = _mm512_and_si512(a[i], mask);
+    }
+}
+
+
+static inline void fpadd_x8_r(const __m512i* a, const __m512i* b, __m512i* c)
+{ // Lane-wise modular addition, c = a+b mod 2p
+    __m512i t[NLIMBS52_FIELD];
+    __mmask8 neg;
+    unsigned int i;
+
+    for (i = 0; i < NLIMBS52_FIELD; i++) {
+        c[i] = _mm512_add_epi64(a[i], b[i]);
+    }
+    carry_x8(c);
+    for (i = 0; i < NLIMBS52_FIELD; i++) {
+        t[i] = _mm512_sub_epi64(c[i], _mm512_set1_epi64((long long)px2_52[i]));
+    }
+    carry_signed_x8(t);
+    neg = _mm512_cmplt_epi64_mask(t[NLIMBS52_FIELD-1], _mm512_setzero_si512());
+    for (i = 0; i < NLIMBS52_FIELD; i++) {
+        c[i] = _mm512_mask_blend_epi64(neg, t[i], c[i]);   // Keep a+b if a+b-2p < 0
+    }
+}
+
+
+static inline void fpsub_x8_r(const __m512i* a, const __m512i* b, __m512i* c)
+{ // Lane-wise modular subtraction, c = a-b mod 2p
+    __mmask8 neg;
+    unsigned int i;
+
+    for (i = 0; i < NLIMBS52_FIELD; i++) {
+        c[i] = _mm512_sub_epi64(a[i], b[i]);
+    }
+    carry_signed_x8(c);
+    neg = _mm512_cmplt_epi64_mask(c[NLIMBS52_FIELD-1], _mm512_setzero_si512());
+    for (i = 0; i < NLIMBS52_FIELD; i++) {
+        c[i] = _mm512_mask_add_epi64(c[i], neg, c[i], _mm512_set1_epi64((long long)px2_52[i]));   // Add 2p if a-b < 0
+    }
+    carry_x8(c);
+}
+
+
+static inline void mp_mul_x8(const __m512i* a, const __m512i* b, __m512i* c)
+{ // Lane-wise schoolbook multiplication, c = a*b, with 2*NLIMBS52_FIELD unnormalized output columns
+    unsigned int i, j;
+
+    for (i = 0; i < 2*NLIMBS52_FIELD; i++) {
+        c[i] = _mm512_setzero_si512();
+    }
+    for (i = 0; i < NLIMBS52_FIELD; i++) {
+        for (j = 0; j < NLIMBS52_FIELD; j++) {
+            c[i+j] = _mm512_madd52lo_epu64(c[i+j], a[i], b[j]);
+            c[i+j+1] = _mm512_madd52hi_epu64(c[i+j+1], a[i], b[j]);
+        }
+    }
+}
+
+
+static inline void mp_sqr_x8(const __m512i* a, __m512i* c)
+{ // Lane-wise squaring, c = a^2, with 2*NLIMBS52_FIELD unnormalized output columns
+    unsigned int i, j;
+
+    for (i = 0; i < 2*NLIMBS52_FIELD; i++) {
+        c[i] = _mm512_setzero_si512();
+    }
+    for (i = 0; i < NLIMBS52_FIELD; i++) {
+        for (j = i+1; j < NLIMBS52_FIELD; j++) {
+            c[i+j] = _mm512_madd52lo_epu64(c[i+j], a[i], a[j]);
+            c[i+j+1] = _mm512_madd52hi_epu64(c[i+j+1], a[i], a[j]);
+        }
+    }
+    for (i = 0; i < 2*NLIMBS52_FIELD; i++) {
+        c[i] = _mm512_add_epi64(c[i], c[i]);
+    }
+    for (i = 0; i < NLIMBS52_FIELD; i++) {
+        c[2*i] = _mm512_madd52lo_epu64(c[2*i], a[i], a[i]);
+        c[2*i+1] = _mm512_madd52hi_epu64(c[2*i+1], a[i], a[i]);
+    }
+}
+
+
+static inline void rdc_mont_x8(__m512i* ma, __m512i* mc)
+{ // Lane-wise Montgomery reduction, mc = ma*R'^-1 mod 2p, where ma < 2p*R' is given as unnormalized columns.
+  // Since p = -1 mod 2^52, the Montgomery quotient digit is the current low limb, and the products with p+1
+  // skip its ZERO_LIMBS52_FIELD least significant limbs, which are all zero.
+    const __m512i mask = _mm512_set1_epi64(MASK52);
+    __m512i q;
+    unsigned int i, j;
+
+    for (i = 0; i < NLIMBS52_FIELD; i++) {
+        q = _mm512_and_si512(ma[i], mask);
+        ma[i+1] = _mm512_add_epi64(ma[i+1], _mm512_srli_epi64(ma[i], 52));
+        for (j = ZERO_LIMBS52_FIELD; j < NLIMBS52_FIELD; j++) {
+            const __m512i pj = _mm512_set1_epi64((long long)pp1_52[j]);
+            ma[i+j] = _mm512_madd52lo_epu64(ma[i+j], q, pj);
+            ma[i+j+1] = _mm512_madd52hi_epu64(ma[i+j+1], q, pj);
+        }
+    }
+    for (i = 0; i < NLIMBS52_FIELD; i++) {
+        mc[i] = ma[NLIMBS52_FIELD+i];
+    }
+    carry_x8(mc);
+}
+
+
+static inline void fpmul_mont_x8_r(const __m512i* a, const __m512i* b, __m512i* c)
+{ // Lane-wise Montgomery multiplication, c = a*b*R'^-1 mod 2p
+    __m512i t[2*NLIMBS52_FIELD];
+
+    mp_mul_x8(a, b, t);
+    rdc_mont_x8(t, c);
+}
+
+
+static inline void fpsqr_mont_x8_r(const __m512i* a, __m512i* c)
+{ // Lane-wise Montgomery squaring, c = a^2*R'^-1 mod 2p
+    __m512i t[2*NLIMBS52_FIELD];
+
+    mp_sqr_x8(a, t);
+    rdc_mont_x8(t, c);
+}
+
+
+static inline void const_x8(const uint64_t* a, __m512i* r)
+{ // Broadcast of a radix-2^52 constant to all lanes
+    for (unsigned int i = 0; i < NLIMBS52_FIELD; i++) {
+        r[i] = _mm512_set1_epi64((long long)a[i]);
+    }
+}
+
+
+static inline void words_to_limbs52(const digit_t* a, uint64_t* r, const unsigned int stride)
+{ // Conversion of a field element from 64-bit words to 52-bit limbs, r[i*stride] = limb i
+    unsigned int i, w, s;
+
+    for (i = 0; i < NLIMBS52_FIELD; i++) {
+        w = (52*i) / 64;
+        s = (52*i) % 64;
+        r[i*stride] = a[w] >> s;
+        if (s > 12 && w+1 < NWORDS_FIELD) {
+            r[i*stride] |= a[w+1] << (64-s);
+        }
+        r[i*stride] &= MASK52;
+    }
+}
+
+
+static inline void limbs52_to_words(const uint64_t* a, digit_t* r, const unsigned int stride)
+{ // Conversion of a field element from 52-bit limbs to 64-bit words, limb i = a[i*stride]
+    unsigned int i, w, s;
+
+    for (i = 0; i < NWORDS_FIELD; i++) {
+        r[i] = 0;
+    }
+    for (i = 0; i < NLIMBS52_FIELD; i++) {
+        w = (52*i) / 64;
+        s = (52*i) % 64;
+        r[w] |= a[i*stride] << s;
+        if (s > 12 && w+1 < NWORDS_FIELD) {
+            r[w+1] |= a[i*stride] >> (64-s);
+        }
+    }
+}
+
+
+void fp_pack_x8(const felm_t* a, felm_x8_t c)
+{ // Loading of 8 field elements a[0..7] in Montgomery representation into the lanes of c, converting them to the radix-2^52 Montgomery representation
+    __m512i t[NLIMBS52_FIELD], r[NLIMBS52_FIELD];
+
+    for (unsigned int k = 0; k < 8; k++) {
+        words_to_limbs52(a[k], &c[0][k], 8);
+    }
+    load_x8(c, t);
+    const_x8(Montgomery_to52, r);
+    fpmul_mont_x8_r(t, r, t);                 // a*R * R'^2/R * R'^-1 = a*R'
+    store_x8(t, c);
+}
+
+
+void fp_unpack_x8(const felm_x8_t a, felm_t* c)
+{ // Extraction of the 8 lane elements of a into c[0..7], converting them back to the scalar Montgomery representation
+    __m512i t[NLIMBS52_FIELD], r[NLIMBS52_FIELD];
+    felm_x8_t u;
+
+    load_x8(a, t);
+    const_x8(Montgomery_from52, r);
+    fpmul_mont_x8_r(t, r, t);                 // a*R' * R * R'^-1 = a*R
+    store_x8(t, u);
+    for (unsigned int k = 0; k < 8; k++) {
+        limbs52_to_words(&u[0][k], c[k], 8);
+    }
+}
+
+
+void fp2_pack_x8(const f2elm_t* a, f2elm_x8_t c)
+{ // Loading of 8 GF(p^2) elements a[0..7] into the lanes of c
+    felm_t t[8];
+    unsigned int i, k;
+
+    for (i = 0; i < 2; i++) {
+        for (k = 0; k < 8; k++) {
+            fpcopy(a[k][i], t[k]);
+        }
+        fp_pack_x8((const felm_t*)t, c[i]);
+    }
+}
+
+
+void fp2_unpack_x8(const f2elm_x8_t a, f2elm_t* c)
+{ // Extraction of the 8 GF(p^2) lane elements of a into c[0..7]
+    felm_t t[8];
+    unsigned int i, k;
+
+    for (i = 0; i < 2; i++) {
+        fp_unpack_x8(a[i], t);
+        for (k = 0; k < 8; k++) {
+            fpcopy(t[k], c[k][i]);
+        }
+    }
+}
+
+
+void fpadd_x8(const felm_x8_t a, const felm_x8_t b, felm_x8_t c)
+{ // 8-way modular addition, c = a+b mod p
+    __m512i ta[NLIMBS52_FIELD], tb[NLIMBS52_FIELD];
+
+    load_x8(a, ta);
+    load_x8(b, tb);
+    fpadd_x8_r(ta, tb, ta);
+    store_x8(ta, c);
+}
+
+
+void fpsub_x8(const felm_x8_t a, const felm_x8_t b, felm_x8_t c)
+{ // 8-way modular subtraction, c = a-b mod p
+    __m512i ta[NLIMBS52_FIELD], tb[NLIMBS52_FIELD];
+
+    load_x8(a, ta);
+    load_x8(b, tb);
+    fpsub_x8_r(ta, tb, ta);
+    store_x8(ta, c);
+}
+
+
+void fpmul_mont_x8(const felm_x8_t a, const felm_x8_t b, felm_x8_t c)
+{ // 8-way field multiplication using Montgomery arithmetic, c = a*b*R'^-1 mod p
+    __m512i ta[NLIMBS52_FIELD], tb[NLIMBS52_FIELD];
+
+    load_x8(a, ta);
+    load_x8(b, tb);
+    fpmul_mont_x8_r(ta, tb, ta);
+    store_x8(ta, c);
+}
+
+
+void fpsqr_mont_x8(const felm_x8_t a, felm_x8_t c)
+{ // 8-way field squaring using Montgomery arithmetic, c = a^2*R'^-1 mod p
+    __m512i ta[NLIMBS52_FIELD];
+
+    load_x8(a, ta);
+    fpsqr_mont_x8_r(ta, ta);
+    store_x8(ta, c);
+}
+
+
+void fp2add_x8(const f2elm_x8_t a, const f2elm_x8_t b, f2elm_x8_t c)
+{ // 8-way GF(p^2) addition, c = a+b in GF(p^2)
+    fpadd_x8(a[0], b[0], c[0]);
+    fpadd_x8(a[1], b[1], c[1]);
+}
+
+
+void fp2sub_x8(const f2elm_x8_t a, const f2elm_x8_t b, f2elm_x8_t c)
+{ // 8-way GF(p^2) subtraction, c = a-b in GF(p^2)
+    fpsub_x8(a[0], b[0], c[0]);
+    fpsub_x8(a[1], b[1], c[1]);
+}
+
+
+void fp2mul_mont_x8(const f2elm_x8_t a, const f2elm_x8_t b, f2elm_x8_t c)
+{ // 8-way GF(p^2) multiplication using Montgomery arithmetic, c = a*b in GF(p^2)
+  // Inputs: a = a0+a1*i and b = b0+b1*i, Output: c = (a0*b0-a1*b1) + (a0*b1+a1*b0)*i
+    __m512i a0[NLIMBS52_FIELD], a1[NLIMBS52_FIELD], b0[NLIMBS52_FIELD], b1[NLIMBS52_FIELD];
+    __m512i t0[NLIMBS52_FIELD], t1[NLIMBS52_FIELD];
+
+    load_x8(a[0], a0);
+    load_x8(a[1], a1);
+    load_x8(b[0], b0);
+    load_x8(b[1], b1);
+    fpadd_x8_r(a0, a1, t0);                   // t0 = a0+a1
+    fpadd_x8_r(b0, b1, t1);                   // t1 = b0+b1
+    fpmul_mont_x8_r(t0, t1, t0);              // t0 = (a0+a1)*(b0+b1)
+    fpmul_mont_x8_r(a0, b0, t1);              // t1 = a0*b0
+    fpmul_mont_x8_r(a1, b1, a0);              // a0 = a1*b1
+    fpsub_x8_r(t0, t1, t0);                   // t0 = (a0+a1)*(b0+b1)-a0*b0
+    fpsub_x8_r(t0, a0, t0);                   // t0 = a0*b1+a1*b0
+    fpsub_x8_r(t1, a0, t1);                   // t1 = a0*b0-a1*b1
+    store_x8(t1, c[0]);
+    store_x8(t0, c[1]);
+}
+
+
+void fp2sqr_mont_x8(const f2elm_x8_t a, f2elm_x8_t c)
+{ // 8-way GF(p^2) squaring using Montgomery arithmetic, c = a^2 in GF(p^2)
+  // Input: a = a0+a1*i, Output: c = (a0+a1)*(a0-a1) + 2*a0*a1*i
+    __m512i a0[NLIMBS52_FIELD], a1[NLIMBS52_FIELD], t0[NLIMBS52_FIELD], t1[NLIMBS52_FIELD];
+
+    load_x8(a[0], a0);
+    load_x8(a[1], a1);
+    fpadd_x8_r(a0, a1, t0);                   // t0 = a0+a1
+    fpsub_x8_r(a0, a1, t1);                   // t1 = a0-a1
+    fpadd_x8_r(a0, a0, a0);                   // a0 = 2*a0
+    fpmul_mont_x8_r(t0, t1, t0);              // t0 = (a0+a1)*(a0-a1)
+    fpmul_mont_x8_r(a0, a1, t1);              // t1 = 2*a0*a1
+    store_x8(t0, c[0]);
+    store_x8(t1, c[1]);
+}
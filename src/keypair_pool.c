@@ -0,0 +1,200 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: pool of SIKE keypairs generated in the background
+*           Background threads fill a bounded lock-free ring buffer (with per-slot sequence numbers, so that any number
+*           of threads can push and pop concurrently) up to the high water mark, and go to sleep until the number of
+*           ready keypairs drops to the low water mark. Included by sike.c and sike_compressed.c when compiling with
+*           USE_THREADS=TRUE, so that each variant has its own pool.
+*********************************************************************************************/
+
+#include <stdlib.h>
+#include <pthread.h>
+
+#define KEM_POOL_MAX_KEYPAIRS   4096     // Largest high water mark
+#define KEM_POOL_MAX_THREADS    64       // Largest number of background threads
+#define KEM_POOL_KEYPAIR_WORDS  ((CRYPTO_PUBLICKEYBYTES + CRYPTO_SECRETKEYBYTES + sizeof(digit_t) - 1)/sizeof(digit_t))
+
+typedef struct {
+    unsigned long long sequence;         // Equal to the position for pushing into an empty slot, and to the position + 1 for popping from a full slot
+    digit_t keypair[KEM_POOL_KEYPAIR_WORDS];    // pk||sk
+} kem_pool_slot_t;
+
+static struct {
+    pthread_mutex_t lock;                // Protects the background threads waiting on refill
+    pthread_cond_t refill;               // Signaled when the number of ready keypairs drops to the low water mark or on shutdown
+    pthread_t threads[KEM_POOL_MAX_THREADS];
+    unsigned int nthreads;
+    unsigned int nwaiting;               // Number of background threads waiting on refill
+    unsigned int shutdown;
+    unsigned int low, high;
+    kem_pool_slot_t* slots;              // NULL if the pool is not running
+    unsigned long long mask;             // Number of slots minus 1, a power of 2 minus 1
+    unsigned long long push_pos;
+    unsigned long long pop_pos;
+} kem_pool = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER };
+
+
+static unsigned long long kem_pool_level(void)
+{ // Number of keypairs ready or being pushed into the ring
+    unsigned long long pop = __atomic_load_n(&kem_pool.pop_pos, __ATOMIC_SEQ_CST);
+    unsigned long long push = __atomic_load_n(&kem_pool.push_pos, __ATOMIC_SEQ_CST);
+
+    return (push > pop) ? push - pop : 0;
+}
+
+
+static int kem_pool_push(const digit_t* keypair)
+{ // Push a keypair into the ring. Returns 1 if the ring is full.
+    kem_pool_slot_t* slot;
+    unsigned long long pos = __atomic_load_n(&kem_pool.push_pos, __ATOMIC_RELAXED), seq;
+
+    while (1) {
+        slot = &kem_pool.slots[pos & kem_pool.mask];
+        seq = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        if (seq == pos) {
+            if (__atomic_compare_exchange_n(&kem_pool.push_pos, &pos, pos + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (seq < pos) {
+            return 1;
+        } else {
+            pos = __atomic_load_n(&kem_pool.push_pos, __ATOMIC_RELAXED);
+        }
+    }
+    memcpy(slot->keypair, keypair, KEM_POOL_KEYPAIR_WORDS*sizeof(digit_t));
+    __atomic_store_n(&slot->sequence, pos + 1, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+
+static int kem_pool_pop(unsigned char *pk, unsigned char *sk)
+{ // Pop a keypair from the ring and wipe its slot. Returns 1 if the ring is empty.
+    kem_pool_slot_t* slot;
+    unsigned long long pos = __atomic_load_n(&kem_pool.pop_pos, __ATOMIC_RELAXED), seq;
+
+    while (1) {
+        slot = &kem_pool.slots[pos & kem_pool.mask];
+        seq = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        if (seq == pos + 1) {
+            if (__atomic_compare_exchange_n(&kem_pool.pop_pos, &pos, pos + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (seq < pos + 1) {
+            return 1;
+        } else {
+            pos = __atomic_load_n(&kem_pool.pop_pos, __ATOMIC_RELAXED);
+        }
+    }
+    memcpy(pk, slot->keypair, CRYPTO_PUBLICKEYBYTES);
+    memcpy(sk, (unsigned char*)slot->keypair + CRYPTO_PUBLICKEYBYTES, CRYPTO_SECRETKEYBYTES);
+    clear_words((void*)slot->keypair, KEM_POOL_KEYPAIR_WORDS);
+    __atomic_store_n(&slot->sequence, pos + kem_pool.mask + 1, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+
+static void* kem_pool_thread(void* unused)
+{ // Background thread main loop: generate keypairs until the high water mark is reached, then wait for the low water mark
+    digit_t keypair[KEM_POOL_KEYPAIR_WORDS];
+    unsigned char* pk = (unsigned char*)keypair;
+    (void)unused;
+
+    while (__atomic_load_n(&kem_pool.shutdown, __ATOMIC_ACQUIRE) == 0) {
+        if (kem_pool_level() >= kem_pool.high) {
+            pthread_mutex_lock(&kem_pool.lock);
+            __atomic_add_fetch(&kem_pool.nwaiting, 1, __ATOMIC_SEQ_CST);
+            while (kem_pool.shutdown == 0 && kem_pool_level() > kem_pool.low) {
+                pthread_cond_wait(&kem_pool.refill, &kem_pool.lock);
+            }
+            __atomic_sub_fetch(&kem_pool.nwaiting, 1, __ATOMIC_SEQ_CST);
+            pthread_mutex_unlock(&kem_pool.lock);
+            continue;
+        }
+        crypto_kem_keypair(pk, pk + CRYPTO_PUBLICKEYBYTES);
+        kem_pool_push(keypair);     // Another thread may have filled the ring in the meantime, the keypair is then discarded
+    }
+    clear_words((void*)keypair, KEM_POOL_KEYPAIR_WORDS);
+
+    return NULL;
+}
+
+
+void crypto_kem_pool_stop(void)
+{ // Stop the background threads and wipe the keypairs left in the pool
+    unsigned int i;
+
+    if (kem_pool.slots == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&kem_pool.lock);
+    __atomic_store_n(&kem_pool.shutdown, 1, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&kem_pool.refill);
+    pthread_mutex_unlock(&kem_pool.lock);
+
+    for (i = 0; i < kem_pool.nthreads; i++) {
+        pthread_join(kem_pool.threads[i], NULL);
+    }
+    clear_words((void*)kem_pool.slots, (kem_pool.mask + 1)*sizeof(kem_pool_slot_t)/sizeof(digit_t));
+    free(kem_pool.slots);
+    __atomic_store_n(&kem_pool.slots, NULL, __ATOMIC_RELEASE);
+    kem_pool.nthreads = 0;
+    kem_pool.shutdown = 0;
+}
+
+
+int crypto_kem_pool_start(unsigned int nthreads, unsigned int low, unsigned int high)
+{ // Start nthreads background threads that keep between low and high keypairs ready for crypto_kem_keypair_pooled
+    unsigned long long i, nslots = 1;
+    kem_pool_slot_t* slots;
+
+    if (kem_pool.slots != NULL || nthreads < 1 || nthreads > KEM_POOL_MAX_THREADS || low >= high || high > KEM_POOL_MAX_KEYPAIRS) {
+        return 1;
+    }
+    while (nslots < high) {
+        nslots <<= 1;
+    }
+    slots = calloc(nslots, sizeof(kem_pool_slot_t));
+    if (slots == NULL) {
+        return 1;
+    }
+    for (i = 0; i < nslots; i++) {
+        slots[i].sequence = i;
+    }
+    kem_pool.mask = nslots - 1;
+    kem_pool.push_pos = 0;
+    kem_pool.pop_pos = 0;
+    kem_pool.low = low;
+    kem_pool.high = high;
+    __atomic_store_n(&kem_pool.slots, slots, __ATOMIC_RELEASE);
+
+    for (kem_pool.nthreads = 0; kem_pool.nthreads < nthreads; kem_pool.nthreads++) {
+        if (pthread_create(&kem_pool.threads[kem_pool.nthreads], NULL, kem_pool_thread, NULL) != 0) {
+            crypto_kem_pool_stop();
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+
+int crypto_kem_keypair_pooled(unsigned char *pk, unsigned char *sk)
+{ // SIKE's key generation from the pool, falling back to crypto_kem_keypair if the pool is empty or not running
+    if (__atomic_load_n(&kem_pool.slots, __ATOMIC_ACQUIRE) == NULL || kem_pool_pop(pk, sk) != 0) {
+        return crypto_kem_keypair(pk, sk);
+    }
+    if (kem_pool_level() <= kem_pool.low && __atomic_load_n(&kem_pool.nwaiting, __ATOMIC_SEQ_CST) != 0) {
+        pthread_mutex_lock(&kem_pool.lock);
+        pthread_cond_broadcast(&kem_pool.refill);
+        pthread_mutex_unlock(&kem_pool.lock);
+    }
+
+    return 0;
+}
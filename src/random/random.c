@@ -1,8 +1,12 @@
 /********************************************************************************************
 * Hardware-based random number generation function
 *
-* It uses /dev/urandom in Linux and CNG's BCryptGenRandom function in Windows
-*********************************************************************************************/ 
+* It uses CNG's BCryptGenRandom function in Windows. In Linux and other Unix-like systems, each thread keeps a
+* buffered generator based on SHAKE256 that is seeded with getrandom() (or /dev/urandom if the system call is not
+* available), so that most requests are served without a system call and without synchronization between threads.
+* The generator key is replaced after every refill of the buffer (fast key erasure), and the generator is reseeded
+* every RANDOM_RESEED_BYTES bytes of output and in the child process after a fork.
+*********************************************************************************************/
 
 #include "random.h"
 #include <stdlib.h>
@@ -10,52 +14,152 @@
     #include <windows.h>
     #include <bcrypt.h>
 #elif defined(__NIX__)
+    #include <string.h>
+    #include <errno.h>
     #include <unistd.h>
     #include <fcntl.h>
-    static int lock = -1;
+    #include <pthread.h>
+    #include <sys/syscall.h>
+    #include "../sha3/fips202.h"
 #endif
 
-#define passed 0 
+#define passed 0
 #define failed 1
 
 
-static inline void delay(unsigned int count)
+#if defined(__NIX__)
+
+#define RANDOM_KEY_BYTES      32
+#define RANDOM_BUFFER_BYTES   (4*SHAKE256_RATE)      // One refill: the next key followed by the output bytes
+#define RANDOM_RESEED_BYTES   (1 << 20)              // Output bytes between two reseeds from the operating system
+#define RANDOM_RETRY_USECS    1000
+
+#if !defined(RANDOM_COUNT_SYSCALL)                   // Hook for tools/bench_random.c
+    #define RANDOM_COUNT_SYSCALL()
+#endif
+
+typedef struct {
+    unsigned char buffer[RANDOM_BUFFER_BYTES];       // buffer[0..RANDOM_KEY_BYTES-1] is the key, unused output starts at buffer[pos]
+    unsigned int pos;
+    unsigned long long output;                       // Output bytes since the last reseed
+    unsigned int generation;                         // Value of random_forks when the generator was seeded
+    int seeded;
+} random_state_t;
+
+static __thread random_state_t random_state;
+static volatile unsigned int random_forks = 0;
+
+
+static void random_atfork_child(void)
+{ // Forces all generators in the child process to be reseeded. Only the thread that called fork() survives in the child.
+    random_forks++;
+}
+
+
+__attribute__((constructor)) static void random_init(void)
 {
-    while (count>0) { count--; }
+    pthread_atfork(NULL, NULL, random_atfork_child);
+}
+
+
+static int random_os_read(unsigned char* random_array, unsigned long long nbytes)
+{ // Read nbytes from the operating system, using getrandom() if available and /dev/urandom otherwise
+    long r;
+    int fd;
+
+#if defined(SYS_getrandom)
+    while (nbytes > 0) {
+        RANDOM_COUNT_SYSCALL();
+        r = syscall(SYS_getrandom, random_array, (size_t)nbytes, 0);
+        if (r > 0) {
+            random_array += r;
+            nbytes -= r;
+        } else if (errno != EINTR) {
+            break;
+        }
+    }
+    if (nbytes == 0) {
+        return passed;
+    }
+#endif
+
+    RANDOM_COUNT_SYSCALL();
+    fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return failed;
+    }
+    while (nbytes > 0) {
+        RANDOM_COUNT_SYSCALL();
+        r = read(fd, random_array, (size_t)nbytes);
+        if (r > 0) {
+            random_array += r;
+            nbytes -= r;
+        } else if (r == 0 || errno != EINTR) {
+            break;
+        }
+    }
+    RANDOM_COUNT_SYSCALL();
+    close(fd);
+
+    return (nbytes == 0) ? passed : failed;
 }
 
 
+static void random_refill(random_state_t* state)
+{ // Refill the buffer with SHAKE256(key || seed), where the seed is read from the operating system if a reseed is due
+    unsigned char input[2*RANDOM_KEY_BYTES];
+    unsigned int inlen = RANDOM_KEY_BYTES;
+
+    memcpy(input, state->buffer, RANDOM_KEY_BYTES);
+    if (!state->seeded || state->generation != random_forks || state->output >= RANDOM_RESEED_BYTES) {
+        while (random_os_read(input + RANDOM_KEY_BYTES, RANDOM_KEY_BYTES) != passed) {
+            usleep(RANDOM_RETRY_USECS);
+        }
+        inlen += RANDOM_KEY_BYTES;
+        state->generation = random_forks;
+        state->output = 0;
+        state->seeded = 1;
+    }
+    shake256(state->buffer, RANDOM_BUFFER_BYTES, input, inlen);
+    memset(input, 0, sizeof(input));
+    state->pos = RANDOM_KEY_BYTES;
+}
+
+#endif
+
+
 int randombytes(unsigned char* random_array, unsigned long long nbytes)
 { // Generation of "nbytes" of random values
-    
-#if defined(__WINDOWS__)   
+
+#if defined(__WINDOWS__)
     if (!BCRYPT_SUCCESS(BCryptGenRandom(NULL, random_array, (unsigned long)nbytes, BCRYPT_USE_SYSTEM_PREFERRED_RNG))) {
         return failed;
     }
 
 #elif defined(__NIX__)
-    int r, n = (int)nbytes, count = 0;
-    
-    if (lock == -1) {
-        do {
-            lock = open("/dev/urandom", O_RDONLY);
-            if (lock == -1) {
-                delay(0xFFFFF);
-            }
-        } while (lock == -1);
-    }
-
-    while (n > 0) {
-        do {
-            r = read(lock, random_array+count, n);
-            if (r == -1) {
-                delay(0xFFFF);
-            }
-        } while (r == -1);
-        count += r;
-        n -= r;
+    random_state_t* state = &random_state;
+    unsigned int n;
+
+    if (!state->seeded || state->generation != random_forks) {
+        random_refill(state);
+    }
+    while (nbytes > 0) {
+        if (state->pos == RANDOM_BUFFER_BYTES) {
+            random_refill(state);
+        }
+        n = RANDOM_BUFFER_BYTES - state->pos;
+        if (nbytes < n) {
+            n = (unsigned int)nbytes;
+        }
+        // Output bytes are erased from the buffer as soon as they are used
+        memcpy(random_array, state->buffer + state->pos, n);
+        memset(state->buffer + state->pos, 0, n);
+        state->pos += n;
+        state->output += n;
+        random_array += n;
+        nbytes -= n;
     }
 #endif
 
     return passed;
-}
\ No newline at end of file
+}
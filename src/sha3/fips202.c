@@ -453,4 +453,89 @@ void shake256(unsigned char *output, unsigned long long outlen, const unsigned c
     for (i = 0; i < outlen; i++)
       output[i] = t[i];
   }
-}
\ No newline at end of file
+}
+
+
+/********** Incremental SHAKE256 ***********/
+
+static void keccak_inc_absorb(uint64_t *s, unsigned int *pos, unsigned int r, const unsigned char *m, unsigned long long int mlen)
+{
+  unsigned int i;
+
+  /* Complete a partially absorbed block */
+  while (*pos != 0 && mlen > 0)
+  {
+    s[*pos >> 3] ^= (uint64_t)(*m) << (8 * (*pos & 7));
+    m++;
+    mlen--;
+    if (++(*pos) == r)
+    {
+      KeccakF1600_StatePermute(s);
+      *pos = 0;
+    }
+  }
+
+  /* Full blocks */
+  while (mlen >= r)
+  {
+    for (i = 0; i < r / 8; ++i)
+      s[i] ^= load64(m + 8 * i);
+    KeccakF1600_StatePermute(s);
+    mlen -= r;
+    m += r;
+  }
+
+  /* Remaining bytes */
+  for (i = 0; i < mlen; i++)
+    s[(*pos + i) >> 3] ^= (uint64_t)m[i] << (8 * ((*pos + i) & 7));
+  *pos += (unsigned int)mlen;
+}
+
+
+static void keccak_inc_finalize(uint64_t *s, unsigned int *pos, unsigned int r, unsigned char p)
+{
+  s[*pos >> 3] ^= (uint64_t)p << (8 * (*pos & 7));
+  s[(r - 1) >> 3] ^= (uint64_t)128 << (8 * ((r - 1) & 7));
+  *pos = r;
+}
+
+
+static void keccak_inc_squeeze(unsigned char *h, unsigned long long int outlen, uint64_t *s, unsigned int *pos, unsigned int r)
+{
+  while (outlen > 0)
+  {
+    if (*pos == r)
+    {
+      KeccakF1600_StatePermute(s);
+      *pos = 0;
+    }
+    *h++ = (unsigned char)(s[*pos >> 3] >> (8 * (*pos & 7)));
+    (*pos)++;
+    outlen--;
+  }
+}
+
+
+void shake256_inc_init(shake256incctx *state)
+{
+  memset(state->s, 0, sizeof(state->s));
+  state->pos = 0;
+}
+
+
+void shake256_inc_absorb(shake256incctx *state, const unsigned char *input, unsigned long long inlen)
+{
+  keccak_inc_absorb(state->s, &state->pos, SHAKE256_RATE, input, inlen);
+}
+
+
+void shake256_inc_finalize(shake256incctx *state)
+{
+  keccak_inc_finalize(state->s, &state->pos, SHAKE256_RATE, 0x1F);
+}
+
+
+void shake256_inc_squeeze(unsigned char *output, unsigned long long outlen, shake256incctx *state)
+{
+  keccak_inc_squeeze(output, outlen, state->s, &state->pos, SHAKE256_RATE);
+}
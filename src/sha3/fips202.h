@@ -15,5 +15,17 @@ void shake256_absorb(uint64_t *s, const unsigned char *input, unsigned int input
 void shake256_squeezeblocks(unsigned char *output, unsigned long long nblocks, uint64_t *s);
 void shake256(unsigned char *output, unsigned long long outlen, const unsigned char *input,  unsigned long long inlen);
 
+// Incremental SHAKE256: shake256_inc_absorb can be called any number of times before shake256_inc_finalize,
+// and shake256_inc_squeeze any number of times after it
+typedef struct {
+  uint64_t s[25];
+  unsigned int pos;      // Position in bytes within the current block of the rate
+} shake256incctx;
+
+void shake256_inc_init(shake256incctx *state);
+void shake256_inc_absorb(shake256incctx *state, const unsigned char *input, unsigned long long inlen);
+void shake256_inc_finalize(shake256incctx *state);
+void shake256_inc_squeeze(unsigned char *output, unsigned long long outlen, shake256incctx *state);
+
 
 #endif
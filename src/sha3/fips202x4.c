@@ -0,0 +1,280 @@
+/********************************************************************************************
+* SHA3-derived function SHAKE, four independent instances at once
+*
+* The four Keccak states are interleaved lane by lane, so that the AVX2 permutation processes the
+* same lane of all the states with a single 256-bit operation. Without AVX2 support, each state is
+* permuted with the scalar KeccakF1600_StatePermute.
+*
+* See NIST Special Publication 800-185 for more information:
+* http://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-185.pdf
+*
+*********************************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "fips202x4.h"
+#include "../config.h"
+#if defined(_SHAKE_AVX2_)
+  #include <immintrin.h>
+#endif
+
+#define NROUNDS 24
+
+void KeccakF1600_StatePermute(uint64_t * state);
+
+
+static uint64_t load64(const unsigned char *x)
+{
+  return LETOH_64(*((uint64_t*)x));
+}
+
+
+static void store64(uint8_t *x, uint64_t u)
+{
+  *(uint64_t*)x = HTOLE_64(u);
+}
+
+
+#if defined(_SHAKE_AVX2_)
+
+static const uint64_t KeccakF_RoundConstants[NROUNDS] =
+{
+    (uint64_t)0x0000000000000001ULL,
+    (uint64_t)0x0000000000008082ULL,
+    (uint64_t)0x800000000000808aULL,
+    (uint64_t)0x8000000080008000ULL,
+    (uint64_t)0x000000000000808bULL,
+    (uint64_t)0x0000000080000001ULL,
+    (uint64_t)0x8000000080008081ULL,
+    (uint64_t)0x8000000000008009ULL,
+    (uint64_t)0x000000000000008aULL,
+    (uint64_t)0x0000000000000088ULL,
+    (uint64_t)0x0000000080008009ULL,
+    (uint64_t)0x000000008000000aULL,
+    (uint64_t)0x000000008000808bULL,
+    (uint64_t)0x800000000000008bULL,
+    (uint64_t)0x8000000000008089ULL,
+    (uint64_t)0x8000000000008003ULL,
+    (uint64_t)0x8000000000008002ULL,
+    (uint64_t)0x8000000000000080ULL,
+    (uint64_t)0x000000000000800aULL,
+    (uint64_t)0x800000008000000aULL,
+    (uint64_t)0x8000000080008081ULL,
+    (uint64_t)0x8000000000008080ULL,
+    (uint64_t)0x0000000080000001ULL,
+    (uint64_t)0x8000000080008008ULL
+};
+
+// Rotation offsets of rho, for the lane at position x+5*y
+static const unsigned int KeccakF_RhoOffsets[25] =
+{
+     0,  1, 62, 28, 27,
+    36, 44,  6, 55, 20,
+     3, 10, 43, 25, 39,
+    41, 45, 15, 21,  8,
+    18,  2, 61, 56, 14
+};
+
+#define ROL4X(a, offset) _mm256_or_si256(_mm256_slli_epi64(a, offset), _mm256_srli_epi64(a, 64-(offset)))
+
+
+void KeccakF1600_StatePermute4x(uint64_t *s)
+{
+  __m256i A[25], B[25], C[5], D[5];
+  unsigned int round, x, y;
+
+  for (x = 0; x < 25; x++)
+    A[x] = _mm256_loadu_si256((__m256i*)(s + 4*x));
+
+  for (round = 0; round < NROUNDS; round++)
+  {
+    // Theta
+    for (x = 0; x < 5; x++)
+      C[x] = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(A[x], A[x+5]), _mm256_xor_si256(A[x+10], A[x+15])), A[x+20]);
+    for (x = 0; x < 5; x++)
+      D[x] = _mm256_xor_si256(C[(x+4)%5], ROL4X(C[(x+1)%5], 1));
+    for (x = 0; x < 25; x++)
+      A[x] = _mm256_xor_si256(A[x], D[x%5]);
+
+    // Rho and pi
+    for (y = 0; y < 5; y++)
+      for (x = 0; x < 5; x++)
+        B[y + 5*((2*x + 3*y)%5)] = (KeccakF_RhoOffsets[x+5*y] == 0) ? A[x+5*y] : ROL4X(A[x+5*y], KeccakF_RhoOffsets[x+5*y]);
+
+    // Chi
+    for (y = 0; y < 25; y += 5)
+      for (x = 0; x < 5; x++)
+        A[y+x] = _mm256_xor_si256(B[y+x], _mm256_andnot_si256(B[y+(x+1)%5], B[y+(x+2)%5]));
+
+    // Iota
+    A[0] = _mm256_xor_si256(A[0], _mm256_set1_epi64x((long long)KeccakF_RoundConstants[round]));
+  }
+
+  for (x = 0; x < 25; x++)
+    _mm256_storeu_si256((__m256i*)(s + 4*x), A[x]);
+}
+
+#else
+
+void KeccakF1600_StatePermute4x(uint64_t *s)
+{
+  uint64_t t[25];
+  unsigned int i, j;
+
+  for (j = 0; j < 4; j++)
+  {
+    for (i = 0; i < 25; i++)
+      t[i] = s[4*i + j];
+    KeccakF1600_StatePermute(t);
+    for (i = 0; i < 25; i++)
+      s[4*i + j] = t[i];
+  }
+}
+
+#endif
+
+
+static void keccak_absorb4x(uint64_t *s, unsigned int r, const unsigned char **m, unsigned long long int mlen,
+                            const unsigned char **m2, unsigned long long int m2len, unsigned char p)
+{ // Absorbs the concatenations m[j] || m2[j] into the four states. Only the block in which m[j] ends is copied
+  unsigned long long i, k, pos = 0, len = mlen + m2len;
+  unsigned int j;
+  unsigned char t[4][200];
+  const unsigned char *b;
+
+  while (len >= r)
+  {
+    for (j = 0; j < 4; j++)
+    {
+      if (pos + r <= mlen)
+        b = m[j] + pos;
+      else if (pos >= mlen)
+        b = m2[j] + (pos - mlen);
+      else
+      {
+        k = mlen - pos;
+        memcpy(t[j], m[j] + pos, k);
+        memcpy(t[j] + k, m2[j], r - k);
+        b = t[j];
+      }
+      for (i = 0; i < r / 8; ++i)
+        s[4*i + j] ^= load64(b + 8 * i);
+    }
+
+    KeccakF1600_StatePermute4x(s);
+    len -= r;
+    pos += r;
+  }
+
+  for (j = 0; j < 4; j++)
+  {
+    memset(t[j], 0, r);
+    if (pos < mlen)
+    {
+      memcpy(t[j], m[j] + pos, mlen - pos);
+      memcpy(t[j] + mlen - pos, m2[j], m2len);
+    }
+    else
+      memcpy(t[j], m2[j] + (pos - mlen), len);
+    t[j][len] = p;
+    t[j][r - 1] |= 128;
+    for (i = 0; i < r / 8; ++i)
+      s[4*i + j] ^= load64(t[j] + 8 * i);
+  }
+}
+
+
+static void keccak_squeezeblocks4x(unsigned char **h, unsigned long long int nblocks, uint64_t *s, unsigned int r)
+{
+  unsigned long long pos = 0;
+  unsigned int i, j;
+
+  while(nblocks > 0)
+  {
+    KeccakF1600_StatePermute4x(s);
+    for (j = 0; j < 4; j++)
+      for (i = 0; i < (r>>3); i++)
+        store64(h[j] + pos + 8*i, s[4*i + j]);
+    pos += r;
+    nblocks--;
+  }
+}
+
+
+/********** SHAKE256 ***********/
+
+static void shake256x4_squeeze(unsigned char **out, unsigned long long outlen, uint64_t *s)
+{ // Squeezes outlen bytes from each of the four absorbed states
+  unsigned char t[4][SHAKE256_RATE];
+  unsigned char *tail[4] = {t[0], t[1], t[2], t[3]};
+  unsigned long long nblocks = outlen/SHAKE256_RATE;
+  unsigned int j;
+
+  keccak_squeezeblocks4x(out, nblocks, s, SHAKE256_RATE);
+
+  outlen -= nblocks*SHAKE256_RATE;
+
+  if (outlen)
+  {
+    keccak_squeezeblocks4x(tail, 1, s, SHAKE256_RATE);
+    for (j = 0; j < 4; j++)
+      memcpy(out[j] + nblocks*SHAKE256_RATE, t[j], outlen);
+  }
+}
+
+
+void shake256x4(unsigned char *out0, unsigned char *out1, unsigned char *out2, unsigned char *out3, unsigned long long outlen,
+                const unsigned char *in0, const unsigned char *in1, const unsigned char *in2, const unsigned char *in3, unsigned long long inlen)
+{ // Four SHAKE256 evaluations on inputs of the same length, out_j = SHAKE256(in_j, outlen)
+  uint64_t s[4*25] = {0};
+  unsigned char *out[4] = {out0, out1, out2, out3};
+  const unsigned char *in[4] = {in0, in1, in2, in3};
+
+  keccak_absorb4x(s, SHAKE256_RATE, in, inlen, in, 0, 0x1F);
+  shake256x4_squeeze(out, outlen, s);
+}
+
+
+void shake256_batch(unsigned char *output, unsigned long long outlen, const unsigned char *input, unsigned long long inlen, unsigned int count)
+{ // count SHAKE256 evaluations on contiguous inputs and outputs, output_j = SHAKE256(input_j, outlen), four at a time
+  unsigned int j;
+
+  for (j = 0; j + 4 <= count; j += 4)
+    shake256x4(output + j*outlen, output + (j+1)*outlen, output + (j+2)*outlen, output + (j+3)*outlen, outlen,
+               input + j*inlen, input + (j+1)*inlen, input + (j+2)*inlen, input + (j+3)*inlen, inlen);
+  for (; j < count; j++)
+    shake256(output + j*outlen, outlen, input + j*inlen, inlen);
+}
+
+
+void shake256_batch_concat(unsigned char *output, unsigned long long outlen, const unsigned char *prefix, unsigned long long prefixlen,
+                           const unsigned char *input, unsigned long long inlen, unsigned long long instride, unsigned int count)
+{ // count SHAKE256 evaluations on the concatenations of contiguous prefixes with inputs placed every instride bytes,
+  // output_j = SHAKE256(prefix_j || input_j, outlen), four at a time. The inputs are absorbed in place
+  uint64_t s[4*25];
+  unsigned char *out[4];
+  const unsigned char *pre[4], *in[4];
+  shake256incctx state;
+  unsigned int j, k;
+
+  for (j = 0; j + 4 <= count; j += 4)
+  {
+    for (k = 0; k < 4; k++)
+    {
+      out[k] = output + (j+k)*outlen;
+      pre[k] = prefix + (j+k)*prefixlen;
+      in[k] = input + (j+k)*instride;
+    }
+    memset(s, 0, sizeof(s));
+    keccak_absorb4x(s, SHAKE256_RATE, pre, prefixlen, in, inlen, 0x1F);
+    shake256x4_squeeze(out, outlen, s);
+  }
+  for (; j < count; j++)
+  {
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, prefix + j*prefixlen, prefixlen);
+    shake256_inc_absorb(&state, input + j*instride, inlen);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(output + j*outlen, outlen, &state);
+  }
+}
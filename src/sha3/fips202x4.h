@@ -0,0 +1,18 @@
+#ifndef FIPS202X4_H
+#define FIPS202X4_H
+
+#include <stdint.h>
+#include "fips202.h"
+
+
+// Four interleaved Keccak states, lane i of state j is stored in s[4*i + j]
+void KeccakF1600_StatePermute4x(uint64_t *s);
+
+void shake256x4(unsigned char *out0, unsigned char *out1, unsigned char *out2, unsigned char *out3, unsigned long long outlen,
+                const unsigned char *in0, const unsigned char *in1, const unsigned char *in2, const unsigned char *in3, unsigned long long inlen);
+void shake256_batch(unsigned char *output, unsigned long long outlen, const unsigned char *input, unsigned long long inlen, unsigned int count);
+void shake256_batch_concat(unsigned char *output, unsigned long long outlen, const unsigned char *prefix, unsigned long long prefixlen,
+                           const unsigned char *input, unsigned long long inlen, unsigned long long instride, unsigned int count);
+
+
+#endif
@@ -9,6 +9,9 @@
 *********************************************************************************************/ 
 
 #include "random/random.h"
+#if defined(_THREADS_)
+    #include "threadpool/threadpool.h"
+#endif
 
 
 static void init_basis(digit_t *gen, f2elm_t XP, f2elm_t XQ, f2elm_t XR)
@@ -41,18 +44,157 @@ void random_mod_order_B(unsigned char* random_digits)
 }
 
 
-int EphemeralKeyGeneration_A(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA)
-{ // Alice's ephemeral public key generation
+#if defined(_THREADS_)
+    #define MAX_INT_POINTS    ((MAX_INT_POINTS_ALICE_THREADS > MAX_INT_POINTS_BOB_THREADS) ? MAX_INT_POINTS_ALICE_THREADS : MAX_INT_POINTS_BOB_THREADS)
+#else
+    #define MAX_INT_POINTS    ((MAX_INT_POINTS_ALICE > MAX_INT_POINTS_BOB) ? MAX_INT_POINTS_ALICE : MAX_INT_POINTS_BOB)
+#endif
+
+typedef struct {
+    unsigned int AliceOrBob;
+    const unsigned int* strat;                // Strategy for the tree traversal
+    point_proj* R;                            // Kernel point of the next isogeny
+    point_proj_t pts[MAX_INT_POINTS];         // Intermediate multiples of the kernel point
+    unsigned int pts_index[MAX_INT_POINTS];
+    unsigned int npts, index, row, ii;
+    unsigned int neval;                       // Number of intermediate points evaluated at the current level
+    point_proj** phis;                        // Points pushed through all the isogenies
+    unsigned int nphis;
+    f2elm_t coeff[3];
+    felm_t* A24;                              // A24plus for Alice, A24minus for Bob
+    felm_t* C24;                              // C24 for Alice, A24plus for Bob
+} isogeny_tree_t;
+
+
+static void isogeny_tree_push(isogeny_tree_t* tree)
+{ // Computes the multiples of the kernel point required by the current row of the strategy, keeping the intermediate points
+    unsigned int m, max = (tree->AliceOrBob == ALICE) ? MAX_Alice : MAX_Bob;
+
+    while (tree->index < max - tree->row) {
+        fp2copy(tree->R->X, tree->pts[tree->npts]->X);
+        fp2copy(tree->R->Z, tree->pts[tree->npts]->Z);
+        tree->pts_index[tree->npts++] = tree->index;
+        m = tree->strat[tree->ii++];
+        if (tree->AliceOrBob == ALICE) {
+            xDBLe(tree->R, tree->R, tree->A24, tree->C24, (int)(2*m));
+        } else {
+            xTPLe(tree->R, tree->R, tree->A24, tree->C24, (int)m);
+        }
+        tree->index += m;
+    }
+}
+
+
+static void isogeny_tree_eval(isogeny_tree_t* tree, point_proj_t P)
+{ // Evaluates the isogeny of the current level at the point P
+    if (tree->AliceOrBob == ALICE) {
+        eval_4_isog(P, tree->coeff);
+    } else {
+        eval_3_isog(P, tree->coeff);
+    }
+}
+
+
+static void isogeny_tree_task(void* arg, unsigned int i)
+{ // Task i of the current level of the tree. Task 0 evaluates the last intermediate point, which becomes the next kernel point, and
+  // then computes the multiples for the next row. The other tasks evaluate the remaining intermediate points and the points in phis.
+    isogeny_tree_t* tree = (isogeny_tree_t*)arg;
+
+    if (i == 0 && tree->neval > 0) {
+        isogeny_tree_eval(tree, tree->pts[tree->neval-1]);
+        fp2copy(tree->pts[tree->neval-1]->X, tree->R->X);
+        fp2copy(tree->pts[tree->neval-1]->Z, tree->R->Z);
+        tree->index = tree->pts_index[tree->neval-1];
+        tree->npts = tree->neval-1;
+        tree->row++;
+        isogeny_tree_push(tree);
+    } else if (i < tree->neval) {
+        isogeny_tree_eval(tree, tree->pts[tree->neval-1-i]);
+    } else {
+        isogeny_tree_eval(tree, tree->phis[i-tree->neval]);
+    }
+}
+
+
+static void isogeny_tree_run(isogeny_tree_t* tree, const unsigned int ntasks)
+{ // Runs the tasks of the current level of the tree. The tasks are independent and are distributed across the thread pool if enabled.
+#if defined(_THREADS_)
+    threadpool_run(isogeny_tree_task, tree, ntasks);
+#else
+    unsigned int i;
+
+    for (i = 0; i < ntasks; i++) {
+        isogeny_tree_task(tree, i);
+    }
+#endif
+}
+
+
+static const unsigned int* isogeny_tree_strategy(const unsigned int AliceOrBob)
+{ // Selects the optimal strategy for the number of threads evaluating the isogenies
+#if defined(_THREADS_)
+    unsigned int nthreads = threadpool_get_num_threads();
+
+    if (nthreads >= 8) {
+        return (AliceOrBob == ALICE) ? strat_Alice_8 : strat_Bob_8;
+    } else if (nthreads >= 4) {
+        return (AliceOrBob == ALICE) ? strat_Alice_4 : strat_Bob_4;
+    } else if (nthreads >= 2) {
+        return (AliceOrBob == ALICE) ? strat_Alice_2 : strat_Bob_2;
+    }
+#endif
+    return (AliceOrBob == ALICE) ? strat_Alice : strat_Bob;
+}
+
+
+static void isogeny_tree_traverse(isogeny_tree_t* tree)
+{ // Traverses the isogeny tree following the optimal strategy, computing the isogeny with kernel generated by R and its images of the points in phis.
+  // Alice computes a chain of 4-isogenies on the curve (A24plus:C24), Bob computes a chain of 3-isogenies on the curve (A24minus:A24plus).
+    unsigned int max = (tree->AliceOrBob == ALICE) ? MAX_Alice : MAX_Bob;
+
+    tree->strat = isogeny_tree_strategy(tree->AliceOrBob);
+    tree->npts = 0;
+    tree->index = 0;
+    tree->row = 1;
+    tree->ii = 0;
+    isogeny_tree_push(tree);
+
+    while (tree->row < max) {
+        if (tree->AliceOrBob == ALICE) {
+            get_4_isog(tree->R, tree->A24, tree->C24, tree->coeff);
+        } else {
+            get_3_isog(tree->R, tree->A24, tree->C24, tree->coeff);
+        }
+        tree->neval = tree->npts;
+        isogeny_tree_run(tree, tree->neval + tree->nphis);
+    }
+
+    if (tree->AliceOrBob == ALICE) {
+        get_4_isog(tree->R, tree->A24, tree->C24, tree->coeff);
+    } else {
+        get_3_isog(tree->R, tree->A24, tree->C24, tree->coeff);
+    }
+    tree->neval = 0;
+    isogeny_tree_run(tree, tree->nphis);
+}
+
+
+static void EphemeralKeyGeneration_A_proj(const unsigned char* PrivateKeyA, point_proj_t phiP, point_proj_t phiQ, point_proj_t phiR)
+{ // Alice's ephemeral public key generation, without the final normalization
   // Input:  a private key PrivateKeyA in the range [0, 2^eA - 1]. 
-  // Output: the public key PublicKeyA consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
-    point_proj_t R, phiP = {0}, phiQ = {0}, phiR = {0}, pts[MAX_INT_POINTS_ALICE];
-    f2elm_t XPA, XQA, XRA, coeff[3], A24plus = {0}, C24 = {0}, A = {0};
-    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_ALICE], npts = 0, ii = 0;
+  // Output: the images phiP, phiQ and phiR of Bob's basis in projective (X:Z) coordinates.
+    point_proj_t R;
+    point_proj* phis[3] = {phiP, phiQ, phiR};
+    f2elm_t XPA, XQA, XRA, A24plus = {0}, C24 = {0}, A = {0};
     digit_t SecretKeyA[NWORDS_ORDER] = {0};
+    isogeny_tree_t tree = {0};
 
     // Initialize basis points
     init_basis((digit_t*)A_gen, XPA, XQA, XRA);
     init_basis((digit_t*)B_gen, phiP->X, phiQ->X, phiR->X);
+    fp2zero(phiP->Z);
+    fp2zero(phiQ->Z);
+    fp2zero(phiR->Z);
     fpcopy((digit_t*)&Montgomery_one, (phiP->Z)[0]);
     fpcopy((digit_t*)&Montgomery_one, (phiQ->Z)[0]);
     fpcopy((digit_t*)&Montgomery_one, (phiR->Z)[0]);
@@ -66,7 +208,11 @@ int EphemeralKeyGeneration_A(const unsigned char* PrivateKeyA, unsigned char* Pu
 
     // Retrieve kernel point
     decode_to_digits(PrivateKeyA, SecretKeyA, SECRETKEY_A_BYTES, NWORDS_ORDER);
-    LADDER3PT(XPA, XQA, XRA, SecretKeyA, ALICE, R, A);       
+#if defined(_FIXED_BASE_)
+    LADDER3PT_fixed_base(XPA, XRA, (digit_t*)A_gen_ladder, SecretKeyA, ALICE, R);
+#else
+    LADDER3PT(XPA, XQA, XRA, SecretKeyA, ALICE, R, A);
+#endif
 
 #if (OALICE_BITS % 2 == 1)
     point_proj_t S;
@@ -80,35 +226,23 @@ int EphemeralKeyGeneration_A(const unsigned char* PrivateKeyA, unsigned char* Pu
 #endif
 
     // Traverse tree
-    index = 0;        
-    for (row = 1; row < MAX_Alice; row++) {
-        while (index < MAX_Alice-row) {
-            fp2copy(R->X, pts[npts]->X);
-            fp2copy(R->Z, pts[npts]->Z);
-            pts_index[npts++] = index;
-            m = strat_Alice[ii++];
-            xDBLe(R, R, A24plus, C24, (int)(2*m));
-            index += m;
-        }
-        get_4_isog(R, A24plus, C24, coeff);        
+    tree.AliceOrBob = ALICE;
+    tree.R = R;
+    tree.phis = phis;
+    tree.nphis = 3;
+    tree.A24 = A24plus;
+    tree.C24 = C24;
+    isogeny_tree_traverse(&tree);
+}
 
-        for (i = 0; i < npts; i++) {
-            eval_4_isog(pts[i], coeff);
-        }
-        eval_4_isog(phiP, coeff);
-        eval_4_isog(phiQ, coeff);
-        eval_4_isog(phiR, coeff);
-
-        fp2copy(pts[npts-1]->X, R->X); 
-        fp2copy(pts[npts-1]->Z, R->Z);
-        index = pts_index[npts-1];
-        npts -= 1;
-    }
 
-    get_4_isog(R, A24plus, C24, coeff); 
-    eval_4_isog(phiP, coeff);
-    eval_4_isog(phiQ, coeff);
-    eval_4_isog(phiR, coeff);
+int EphemeralKeyGeneration_A(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA)
+{ // Alice's ephemeral public key generation
+  // Input:  a private key PrivateKeyA in the range [0, 2^eA - 1]. 
+  // Output: the public key PublicKeyA consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
+    point_proj_t phiP, phiQ, phiR;
+
+    EphemeralKeyGeneration_A_proj(PrivateKeyA, phiP, phiQ, phiR);
 
     inv_3_way(phiP->Z, phiQ->Z, phiR->Z);
     fp2mul_mont(phiP->X, phiP->Z, phiP->X);
@@ -128,10 +262,11 @@ int EphemeralKeyGeneration_B(const unsigned char* PrivateKeyB, unsigned char* Pu
 { // Bob's ephemeral public key generation
   // Input:  a private key PrivateKeyB in the range [0, 2^Floor(Log(2,oB)) - 1]. 
   // Output: the public key PublicKeyB consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
-    point_proj_t R, phiP = {0}, phiQ = {0}, phiR = {0}, pts[MAX_INT_POINTS_BOB];
-    f2elm_t XPB, XQB, XRB, coeff[3], A24plus = {0}, A24minus = {0}, A = {0};
-    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0, ii = 0;
+    point_proj_t R, phiP = {0}, phiQ = {0}, phiR = {0};
+    point_proj* phis[3] = {phiP, phiQ, phiR};
+    f2elm_t XPB, XQB, XRB, A24plus = {0}, A24minus = {0}, A = {0};
     digit_t SecretKeyB[NWORDS_ORDER] = {0};
+    isogeny_tree_t tree = {0};
 
     // Initialize basis points
     init_basis((digit_t*)B_gen, XPB, XQB, XRB);
@@ -149,38 +284,20 @@ int EphemeralKeyGeneration_B(const unsigned char* PrivateKeyB, unsigned char* Pu
 
     // Retrieve kernel point
     decode_to_digits(PrivateKeyB, SecretKeyB, SECRETKEY_B_BYTES, NWORDS_ORDER);
+#if defined(_FIXED_BASE_)
+    LADDER3PT_fixed_base(XPB, XRB, (digit_t*)B_gen_ladder, SecretKeyB, BOB, R);
+#else
     LADDER3PT(XPB, XQB, XRB, SecretKeyB, BOB, R, A);
+#endif
     
     // Traverse tree
-    index = 0;  
-    for (row = 1; row < MAX_Bob; row++) {
-        while (index < MAX_Bob-row) {
-            fp2copy(R->X, pts[npts]->X);
-            fp2copy(R->Z, pts[npts]->Z);
-            pts_index[npts++] = index;
-            m = strat_Bob[ii++];
-            xTPLe(R, R, A24minus, A24plus, (int)m);
-            index += m;
-        } 
-        get_3_isog(R, A24minus, A24plus, coeff);
-
-        for (i = 0; i < npts; i++) {
-            eval_3_isog(pts[i], coeff);
-        }     
-        eval_3_isog(phiP, coeff);
-        eval_3_isog(phiQ, coeff);
-        eval_3_isog(phiR, coeff);
-
-        fp2copy(pts[npts-1]->X, R->X); 
-        fp2copy(pts[npts-1]->Z, R->Z);
-        index = pts_index[npts-1];
-        npts -= 1;
-    }
-    
-    get_3_isog(R, A24minus, A24plus, coeff);
-    eval_3_isog(phiP, coeff);
-    eval_3_isog(phiQ, coeff);
-    eval_3_isog(phiR, coeff);
+    tree.AliceOrBob = BOB;
+    tree.R = R;
+    tree.phis = phis;
+    tree.nphis = 3;
+    tree.A24 = A24minus;
+    tree.C24 = A24plus;
+    isogeny_tree_traverse(&tree);
 
     inv_3_way(phiP->Z, phiQ->Z, phiR->Z);
     fp2mul_mont(phiP->X, phiP->Z, phiP->X);
@@ -196,86 +313,147 @@ int EphemeralKeyGeneration_B(const unsigned char* PrivateKeyB, unsigned char* Pu
 }
 
 
-int EphemeralSecretAgreement_A(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyB, unsigned char* SharedSecretA)
-{ // Alice's ephemeral shared secret computation
-  // It produces a shared secret key SharedSecretA using her secret key PrivateKeyA and Bob's public key PublicKeyB
+typedef struct {
+    f2elm_t PKB[3];                           // Decoded images of Alice's basis under Bob's isogeny, x(P), x(Q) and x(Q-P)
+    f2elm_t A;                                // Montgomery coefficient of Bob's curve
+    f2elm_t xQ[OALICE_BITS];                  // Affine x-coordinates of [2^i]Q for the three-point ladder
+} public_key_B_context_t;
+
+#define CONTEXT_INV_CHUNK    64               // Number of points normalized with a single inversion in the context initialization
+
+
+static void PublicKeyB_context_init(const unsigned char* PublicKeyB, public_key_B_context_t* ctx)
+{ // Initialization of a context for repeated shared secret computations with Bob's PublicKeyB
+  // Input:  Bob's PublicKeyB consists of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
+  // Output: the decoded public key, the curve coefficient and the doublings of Q used by LADDER3PT_fixed_base. All of them are public.
+    point_proj_t Q;
+    f2elm_t A24plus = {0}, C24 = {0}, Z[CONTEXT_INV_CHUNK], invZ[CONTEXT_INV_CHUNK];
+    unsigned int i, j, n;
+
+    fp2_decode(PublicKeyB, ctx->PKB[0]);
+    fp2_decode(PublicKeyB + FP2_ENCODED_BYTES, ctx->PKB[1]);
+    fp2_decode(PublicKeyB + 2*FP2_ENCODED_BYTES, ctx->PKB[2]);
+    get_A(ctx->PKB[0], ctx->PKB[1], ctx->PKB[2], ctx->A);
+
+    // A24plus = A+2C, C24 = 4C, where C=1
+    mp_add((digit_t*)&Montgomery_one, (digit_t*)&Montgomery_one, C24[0], NWORDS_FIELD);
+    mp2_add(ctx->A, C24, A24plus);
+    mp_add(C24[0], C24[0], C24[0], NWORDS_FIELD);
+
+    // xQ[i] = x([2^i]Q), normalized in chunks that share one inversion
+    fp2copy(ctx->PKB[1], Q->X);
+    fp2zero(Q->Z);
+    fpcopy((digit_t*)&Montgomery_one, Q->Z[0]);
+    for (i = 0; i < OALICE_BITS; i += n) {
+        n = OALICE_BITS - i;
+        if (n > CONTEXT_INV_CHUNK) n = CONTEXT_INV_CHUNK;
+        for (j = 0; j < n; j++) {
+            fp2copy(Q->X, ctx->xQ[i+j]);
+            fp2copy(Q->Z, Z[j]);
+            xDBL(Q, Q, A24plus, C24);
+        }
+        mont_n_way_inv_ct(Z, n, invZ);
+        for (j = 0; j < n; j++) {
+            fp2mul_mont(ctx->xQ[i+j], invZ[j], ctx->xQ[i+j]);
+        }
+    }
+}
+
+
+static void EphemeralSecretAgreement_A_kernel_proj(point_proj_t R, const f2elm_t A, f2elm_t A24plus, f2elm_t C24)
+{ // Alice's isogeny computation from the kernel point R on Bob's curve with Montgomery coefficient A
+  // Output: the projective constants (A24plus:C24) = (A:C) of the shared curve.  
+    isogeny_tree_t tree = {0};
+
+    // Initialize constants: A24plus = A+2C, C24 = 4C, where C=1
+    fp2zero(C24);
+    mp_add((digit_t*)&Montgomery_one, (digit_t*)&Montgomery_one, C24[0], NWORDS_FIELD);
+    mp2_add(A, C24, A24plus);
+    mp_add(C24[0], C24[0], C24[0], NWORDS_FIELD);
+
+#if (OALICE_BITS % 2 == 1)
+    point_proj_t S;
+
+    xDBLe(R, S, A24plus, C24, (int)(OALICE_BITS-1));
+    get_2_isog(S, A24plus, C24);
+    eval_2_isog(R, S);
+#endif
+
+    // Traverse tree
+    tree.AliceOrBob = ALICE;
+    tree.R = R;
+    tree.A24 = A24plus;
+    tree.C24 = C24;
+    isogeny_tree_traverse(&tree);
+    mp2_add(A24plus, A24plus, A24plus);                                                
+    fp2sub(A24plus, C24, A24plus); 
+    fp2add(A24plus, A24plus, A24plus);
+}
+
+
+static void EphemeralSecretAgreement_A_proj(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyB, f2elm_t A24plus, f2elm_t C24)
+{ // Alice's ephemeral shared secret computation, without the final j-invariant computation
   // Inputs: Alice's PrivateKeyA is an integer in the range [0, oA-1]. 
   //         Bob's PublicKeyB consists of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
-  // Output: a shared secret SharedSecretA that consists of one element in GF(p^2) encoded by removing leading 0 bytes.  
-    point_proj_t R, pts[MAX_INT_POINTS_ALICE];
-    f2elm_t coeff[3], PKB[3], jinv;
-    f2elm_t A24plus = {0}, C24 = {0}, A = {0};
-    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_ALICE], npts = 0, ii = 0;
+  // Output: the projective constants (A24plus:C24) = (A:C) of the shared curve.  
+    point_proj_t R;
+    f2elm_t PKB[3], A = {0};
     digit_t SecretKeyA[NWORDS_ORDER] = {0};
       
     // Initialize images of Bob's basis
     fp2_decode(PublicKeyB, PKB[0]);
     fp2_decode(PublicKeyB + FP2_ENCODED_BYTES, PKB[1]);
     fp2_decode(PublicKeyB + 2*FP2_ENCODED_BYTES, PKB[2]);
-
-    // Initialize constants: A24plus = A+2C, C24 = 4C, where C=1
     get_A(PKB[0], PKB[1], PKB[2], A);
-    mp_add((digit_t*)&Montgomery_one, (digit_t*)&Montgomery_one, C24[0], NWORDS_FIELD);
-    mp2_add(A, C24, A24plus);
-    mp_add(C24[0], C24[0], C24[0], NWORDS_FIELD);
 
     // Retrieve kernel point
     decode_to_digits(PrivateKeyA, SecretKeyA, SECRETKEY_A_BYTES, NWORDS_ORDER);
     LADDER3PT(PKB[0], PKB[1], PKB[2], SecretKeyA, ALICE, R, A);    
 
-#if (OALICE_BITS % 2 == 1)
-    point_proj_t S;
+    EphemeralSecretAgreement_A_kernel_proj(R, A, A24plus, C24);
+}
 
-    xDBLe(R, S, A24plus, C24, (int)(OALICE_BITS-1));
-    get_2_isog(S, A24plus, C24);
-    eval_2_isog(R, S);
-#endif
 
-    // Traverse tree
-    index = 0;        
-    for (row = 1; row < MAX_Alice; row++) {
-        while (index < MAX_Alice-row) {
-            fp2copy(R->X, pts[npts]->X);
-            fp2copy(R->Z, pts[npts]->Z);
-            pts_index[npts++] = index;
-            m = strat_Alice[ii++];
-            xDBLe(R, R, A24plus, C24, (int)(2*m));
-            index += m;
-        }
-        get_4_isog(R, A24plus, C24, coeff);        
+static void EphemeralSecretAgreement_A_context_proj(const unsigned char* PrivateKeyA, const public_key_B_context_t* ctx, f2elm_t A24plus, f2elm_t C24)
+{ // Alice's ephemeral shared secret computation with a context initialized by PublicKeyB_context_init, without the final j-invariant computation
+  // Inputs: Alice's PrivateKeyA is an integer in the range [0, oA-1]. 
+  // Output: the projective constants (A24plus:C24) = (A:C) of the shared curve.  
+    point_proj_t R;
+    digit_t SecretKeyA[NWORDS_ORDER] = {0};
 
-        for (i = 0; i < npts; i++) {
-            eval_4_isog(pts[i], coeff);
-        }
+    // Retrieve kernel point
+    decode_to_digits(PrivateKeyA, SecretKeyA, SECRETKEY_A_BYTES, NWORDS_ORDER);
+    LADDER3PT_fixed_base(ctx->PKB[0], ctx->PKB[2], (const digit_t*)ctx->xQ, SecretKeyA, ALICE, R);
 
-        fp2copy(pts[npts-1]->X, R->X); 
-        fp2copy(pts[npts-1]->Z, R->Z);
-        index = pts_index[npts-1];
-        npts -= 1;
-    }
+    EphemeralSecretAgreement_A_kernel_proj(R, ctx->A, A24plus, C24);
+}
 
-    get_4_isog(R, A24plus, C24, coeff); 
-    mp2_add(A24plus, A24plus, A24plus);                                                
-    fp2sub(A24plus, C24, A24plus); 
-    fp2add(A24plus, A24plus, A24plus);                    
-    j_inv(A24plus, C24, jinv);
+
+int EphemeralSecretAgreement_A(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyB, unsigned char* SharedSecretA)
+{ // Alice's ephemeral shared secret computation
+  // It produces a shared secret key SharedSecretA using her secret key PrivateKeyA and Bob's public key PublicKeyB
+  // Inputs: Alice's PrivateKeyA is an integer in the range [0, oA-1]. 
+  //         Bob's PublicKeyB consists of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
+  // Output: a shared secret SharedSecretA that consists of one element in GF(p^2) encoded by removing leading 0 bytes.  
+    f2elm_t A, C, jinv;
+
+    EphemeralSecretAgreement_A_proj(PrivateKeyA, PublicKeyB, A, C);
+    j_inv(A, C, jinv);
     fp2_encode(jinv, SharedSecretA);    // Format shared secret
 
     return 0;
 }
 
 
-int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedSecretB)
-{ // Bob's ephemeral shared secret computation
-  // It produces a shared secret key SharedSecretB using his secret key PrivateKeyB and Alice's public key PublicKeyA
-  // Inputs: Bob's PrivateKeyB is an integer in the range [0, 2^Floor(Log(2,oB)) - 1]. 
+static void EphemeralSecretAgreement_B_digits_proj(const digit_t* SecretKeyB, const unsigned char* PublicKeyA, f2elm_t A, f2elm_t C)
+{ // Bob's ephemeral shared secret computation, without the final j-invariant computation
+  // Inputs: Bob's secret key SecretKeyB in the range [0, 2^Floor(Log(2,oB)) - 1], decoded to NWORDS_ORDER digits. 
   //         Alice's PublicKeyA consists of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
-  // Output: a shared secret SharedSecretB that consists of one element in GF(p^2) encoded by removing leading 0 bytes.  
-    point_proj_t R, pts[MAX_INT_POINTS_BOB];
-    f2elm_t coeff[3], PKB[3], jinv;
-    f2elm_t A24plus = {0}, A24minus = {0}, A = {0};
-    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0, ii = 0;
-    digit_t SecretKeyB[NWORDS_ORDER] = {0};
+  // Output: the projective constants (A:C) of the shared curve.  
+    point_proj_t R;
+    f2elm_t PKB[3];
+    f2elm_t A24plus = {0}, A24minus = {0};
+    isogeny_tree_t tree = {0};
       
     // Initialize images of Alice's basis
     fp2_decode(PublicKeyA, PKB[0]);
@@ -289,37 +467,42 @@ int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned
     mp2_sub_p2(A, A24minus, A24minus);
 
     // Retrieve kernel point
-    decode_to_digits(PrivateKeyB, SecretKeyB, SECRETKEY_B_BYTES, NWORDS_ORDER);
     LADDER3PT(PKB[0], PKB[1], PKB[2], SecretKeyB, BOB, R, A);
     
     // Traverse tree
-    index = 0;  
-    for (row = 1; row < MAX_Bob; row++) {
-        while (index < MAX_Bob-row) {
-            fp2copy(R->X, pts[npts]->X);
-            fp2copy(R->Z, pts[npts]->Z);
-            pts_index[npts++] = index;
-            m = strat_Bob[ii++];
-            xTPLe(R, R, A24minus, A24plus, (int)m);
-            index += m;
-        }
-        get_3_isog(R, A24minus, A24plus, coeff);
-
-        for (i = 0; i < npts; i++) {
-            eval_3_isog(pts[i], coeff);
-        } 
-
-        fp2copy(pts[npts-1]->X, R->X); 
-        fp2copy(pts[npts-1]->Z, R->Z);
-        index = pts_index[npts-1];
-        npts -= 1;
-    }
-     
-    get_3_isog(R, A24minus, A24plus, coeff);    
+    tree.AliceOrBob = BOB;
+    tree.R = R;
+    tree.A24 = A24minus;
+    tree.C24 = A24plus;
+    isogeny_tree_traverse(&tree);
     fp2add(A24plus, A24minus, A);                 
     fp2add(A, A, A);
-    fp2sub(A24plus, A24minus, A24plus);                   
-    j_inv(A, A24plus, jinv);
+    fp2sub(A24plus, A24minus, C);
+}
+
+
+static void EphemeralSecretAgreement_B_proj(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, f2elm_t A, f2elm_t C)
+{ // Bob's ephemeral shared secret computation, without the final j-invariant computation
+  // Inputs: Bob's PrivateKeyB is an integer in the range [0, 2^Floor(Log(2,oB)) - 1]. 
+  //         Alice's PublicKeyA consists of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
+  // Output: the projective constants (A:C) of the shared curve.  
+    digit_t SecretKeyB[NWORDS_ORDER] = {0};
+
+    decode_to_digits(PrivateKeyB, SecretKeyB, SECRETKEY_B_BYTES, NWORDS_ORDER);
+    EphemeralSecretAgreement_B_digits_proj(SecretKeyB, PublicKeyA, A, C);
+}
+
+
+int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedSecretB)
+{ // Bob's ephemeral shared secret computation
+  // It produces a shared secret key SharedSecretB using his secret key PrivateKeyB and Alice's public key PublicKeyA
+  // Inputs: Bob's PrivateKeyB is an integer in the range [0, 2^Floor(Log(2,oB)) - 1]. 
+  //         Alice's PublicKeyA consists of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
+  // Output: a shared secret SharedSecretB that consists of one element in GF(p^2) encoded by removing leading 0 bytes.  
+    f2elm_t A, C, jinv;
+
+    EphemeralSecretAgreement_B_proj(PrivateKeyB, PublicKeyA, A, C);
+    j_inv(A, C, jinv);
     fp2_encode(jinv, SharedSecretB);    // Format shared secret
 
     return 0;
@@ -0,0 +1,568 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: 8-way isogeny computations using the AVX-512 IFMA field arithmetic
+*           Eight independent key generations or shared secret computations run in lockstep, one per lane of the 8-way
+*           GF(p^2) arithmetic. The control flow does not depend on the secret keys, whose bits only select the lanes
+*           that are swapped in the Montgomery ladder. Used by the batched KEM API.
+*           The 8-way computations are only used if CPUID reports support for AVX512F and AVX512IFMA, and the OS saves
+*           the AVX-512 state, when the library is loaded. Otherwise, the batched KEM API falls back to the scalar code.
+*           Setting the environment variable SIDH_DISABLE_IFMA forces the fallback, e.g., for testing.
+*********************************************************************************************/
+
+#include <cpuid.h>
+#include <stdlib.h>
+
+
+static unsigned int ifma_supported = 0;
+
+
+__attribute__((constructor)) static void ifma_dispatch_init(void)
+{ // Detection of AVX512F (CPUID.7.0:EBX[16]) and AVX512IFMA (CPUID.7.0:EBX[21]) support, and of the OS saving the SSE, AVX
+  // and AVX-512 states (XCR0[7:5] and XCR0[2:1], checked with XGETBV once CPUID.1:ECX[27] reports OSXSAVE)
+    unsigned int eax, ebx, ecx, edx, xcr0_lo, xcr0_hi;
+
+    if (getenv("SIDH_DISABLE_IFMA") != NULL) {
+        return;
+    }
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !((ecx >> 27) & 1)) {
+        return;
+    }
+    __asm__ __volatile__ ("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    if ((xcr0_lo & 0xE6) != 0xE6) {
+        return;
+    }
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        ifma_supported = ((ebx >> 16) & 1) & ((ebx >> 21) & 1);
+    }
+}
+
+
+#define MAX_INT_POINTS_X8    ((MAX_INT_POINTS_ALICE > MAX_INT_POINTS_BOB) ? MAX_INT_POINTS_ALICE : MAX_INT_POINTS_BOB)
+
+typedef struct { f2elm_x8_t X; f2elm_x8_t Z; } point_proj_x8;       // 8 points in projective XZ Montgomery coordinates, one per lane
+typedef point_proj_x8 point_proj_x8_t[1];
+
+
+static void fp2copy_x8(const f2elm_x8_t a, f2elm_x8_t c)
+{ // Copy of 8 GF(p^2) elements, c = a
+    copy_words((const digit_t*)a, (digit_t*)c, 2*NLIMBS52_FIELD*8);
+}
+
+
+static void fp2_broadcast_x8(const f2elm_t a, f2elm_x8_t c)
+{ // Loading of the GF(p^2) element a into the 8 lanes of c
+    f2elm_t t[8];
+    unsigned int k;
+
+    for (k = 0; k < 8; k++) {
+        fp2copy(a, t[k]);
+    }
+    fp2_pack_x8((const f2elm_t*)t, c);
+}
+
+
+static void swap_points_x8(point_proj_x8_t P, point_proj_x8_t Q, const digit_t* option)
+{ // Lane-wise swap of points.
+  // If option[k] = 0 then lane k of P and Q is left unchanged, else if option[k] = 0xFF...FF then it is swapped
+    uint64_t *p = (uint64_t*)P, *q = (uint64_t*)Q, temp;
+    unsigned int i, k;
+
+    for (i = 0; i < 2*2*NLIMBS52_FIELD; i++) {
+        for (k = 0; k < 8; k++) {
+            temp = option[k] & (p[8*i+k] ^ q[8*i+k]);
+            p[8*i+k] = temp ^ p[8*i+k];
+            q[8*i+k] = temp ^ q[8*i+k];
+        }
+    }
+}
+
+
+static void xDBL_x8(const point_proj_x8_t P, point_proj_x8_t Q, const f2elm_x8_t A24plus, const f2elm_x8_t C24)
+{ // 8-way doubling of Montgomery points in projective coordinates (X:Z), Q = 2*P. See xDBL().
+    f2elm_x8_t t0, t1;
+
+    fp2sub_x8(P->X, P->Z, t0);                      // t0 = X1-Z1
+    fp2add_x8(P->X, P->Z, t1);                      // t1 = X1+Z1
+    fp2sqr_mont_x8(t0, t0);                         // t0 = (X1-Z1)^2
+    fp2sqr_mont_x8(t1, t1);                         // t1 = (X1+Z1)^2
+    fp2mul_mont_x8(C24, t0, Q->Z);                  // Z2 = C24*(X1-Z1)^2
+    fp2mul_mont_x8(t1, Q->Z, Q->X);                 // X2 = C24*(X1-Z1)^2*(X1+Z1)^2
+    fp2sub_x8(t1, t0, t1);                          // t1 = (X1+Z1)^2-(X1-Z1)^2
+    fp2mul_mont_x8(A24plus, t1, t0);                // t0 = A24plus*[(X1+Z1)^2-(X1-Z1)^2]
+    fp2add_x8(Q->Z, t0, Q->Z);                      // Z2 = A24plus*[(X1+Z1)^2-(X1-Z1)^2] + C24*(X1-Z1)^2
+    fp2mul_mont_x8(Q->Z, t1, Q->Z);                 // Z2 = [A24plus*[(X1+Z1)^2-(X1-Z1)^2] + C24*(X1-Z1)^2]*[(X1+Z1)^2-(X1-Z1)^2]
+}
+
+
+static void xDBLe_x8(const point_proj_x8_t P, point_proj_x8_t Q, const f2elm_x8_t A24plus, const f2elm_x8_t C24, const int e)
+{ // 8-way computation of [2^e](X:Z) via e repeated doublings
+    int i;
+
+    fp2copy_x8(P->X, Q->X);
+    fp2copy_x8(P->Z, Q->Z);
+    for (i = 0; i < e; i++) {
+        xDBL_x8(Q, Q, A24plus, C24);
+    }
+}
+
+
+static void get_4_isog_x8(const point_proj_x8_t P, f2elm_x8_t A24plus, f2elm_x8_t C24, f2elm_x8_t* coeff)
+{ // 8-way computation of the 4-isogenies with kernels generated by the points P of order 4. See get_4_isog().
+
+    fp2sub_x8(P->X, P->Z, coeff[1]);                // coeff[1] = X4-Z4
+    fp2add_x8(P->X, P->Z, coeff[2]);                // coeff[2] = X4+Z4
+    fp2sqr_mont_x8(P->Z, coeff[0]);                 // coeff[0] = Z4^2
+    fp2add_x8(coeff[0], coeff[0], coeff[0]);        // coeff[0] = 2*Z4^2
+    fp2sqr_mont_x8(coeff[0], C24);                  // C24 = 4*Z4^4
+    fp2add_x8(coeff[0], coeff[0], coeff[0]);        // coeff[0] = 4*Z4^2
+    fp2sqr_mont_x8(P->X, A24plus);                  // A24plus = X4^2
+    fp2add_x8(A24plus, A24plus, A24plus);           // A24plus = 2*X4^2
+    fp2sqr_mont_x8(A24plus, A24plus);               // A24plus = 4*X4^4
+}
+
+
+static void eval_4_isog_x8(point_proj_x8_t P, f2elm_x8_t* coeff)
+{ // 8-way evaluation of the 4-isogenies given by coeff at the points P. See eval_4_isog().
+    f2elm_x8_t t0, t1;
+
+    fp2add_x8(P->X, P->Z, t0);                      // t0 = X+Z
+    fp2sub_x8(P->X, P->Z, t1);                      // t1 = X-Z
+    fp2mul_mont_x8(t0, coeff[1], P->X);             // X = (X+Z)*coeff[1]
+    fp2mul_mont_x8(t1, coeff[2], P->Z);             // Z = (X-Z)*coeff[2]
+    fp2mul_mont_x8(t0, t1, t0);                     // t0 = (X+Z)*(X-Z)
+    fp2mul_mont_x8(coeff[0], t0, t0);               // t0 = coeff[0]*(X+Z)*(X-Z)
+    fp2add_x8(P->X, P->Z, t1);                      // t1 = (X-Z)*coeff[2] + (X+Z)*coeff[1]
+    fp2sub_x8(P->X, P->Z, P->Z);                    // Z = (X-Z)*coeff[2] - (X+Z)*coeff[1]
+    fp2sqr_mont_x8(t1, t1);                         // t1 = [(X-Z)*coeff[2] + (X+Z)*coeff[1]]^2
+    fp2sqr_mont_x8(P->Z, P->Z);                     // Z = [(X-Z)*coeff[2] - (X+Z)*coeff[1]]^2
+    fp2add_x8(t1, t0, P->X);                        // X = coeff[0]*(X+Z)*(X-Z) + [(X-Z)*coeff[2] + (X+Z)*coeff[1]]^2
+    fp2sub_x8(P->Z, t0, t0);                        // t0 = [(X-Z)*coeff[2] - (X+Z)*coeff[1]]^2 - coeff[0]*(X+Z)*(X-Z)
+    fp2mul_mont_x8(P->X, t1, P->X);                 // Xfinal
+    fp2mul_mont_x8(P->Z, t0, P->Z);                 // Zfinal
+}
+
+#if (OALICE_BITS % 2 == 1)
+
+static void get_2_isog_x8(const point_proj_x8_t P, f2elm_x8_t A, f2elm_x8_t C)
+{ // 8-way computation of the 2-isogenies with kernels generated by the points P of order 2. See get_2_isog().
+
+    fp2sqr_mont_x8(P->X, A);                        // A = X2^2
+    fp2sqr_mont_x8(P->Z, C);                        // C = Z2^2
+    fp2sub_x8(C, A, A);                             // A = Z2^2 - X2^2
+}
+
+
+static void eval_2_isog_x8(point_proj_x8_t P, const point_proj_x8_t Q)
+{ // 8-way evaluation of the 2-isogenies with kernels generated by Q at the points P. See eval_2_isog().
+    f2elm_x8_t t0, t1, t2, t3;
+
+    fp2add_x8(Q->X, Q->Z, t0);                      // t0 = X2+Z2
+    fp2sub_x8(Q->X, Q->Z, t1);                      // t1 = X2-Z2
+    fp2add_x8(P->X, P->Z, t2);                      // t2 = X+Z
+    fp2sub_x8(P->X, P->Z, t3);                      // t3 = X-Z
+    fp2mul_mont_x8(t0, t3, t0);                     // t0 = (X2+Z2)*(X-Z)
+    fp2mul_mont_x8(t1, t2, t1);                     // t1 = (X2-Z2)*(X+Z)
+    fp2add_x8(t0, t1, t2);                          // t2 = (X2+Z2)*(X-Z) + (X2-Z2)*(X+Z)
+    fp2sub_x8(t0, t1, t3);                          // t3 = (X2+Z2)*(X-Z) - (X2-Z2)*(X+Z)
+    fp2mul_mont_x8(P->X, t2, P->X);                 // Xfinal
+    fp2mul_mont_x8(P->Z, t3, P->Z);                 // Zfinal
+}
+
+#endif
+
+static void xTPL_x8(const point_proj_x8_t P, point_proj_x8_t Q, const f2elm_x8_t A24minus, const f2elm_x8_t A24plus)
+{ // 8-way tripling of Montgomery points in projective coordinates (X:Z), Q = 3*P. See xTPL().
+    f2elm_x8_t t0, t1, t2, t3, t4, t5, t6;
+
+    fp2sub_x8(P->X, P->Z, t0);                      // t0 = X-Z
+    fp2sqr_mont_x8(t0, t2);                         // t2 = (X-Z)^2
+    fp2add_x8(P->X, P->Z, t1);                      // t1 = X+Z
+    fp2sqr_mont_x8(t1, t3);                         // t3 = (X+Z)^2
+    fp2add_x8(P->X, P->X, t4);                      // t4 = 2*X
+    fp2add_x8(P->Z, P->Z, t0);                      // t0 = 2*Z
+    fp2sqr_mont_x8(t4, t1);                         // t1 = 4*X^2
+    fp2sub_x8(t1, t3, t1);                          // t1 = 4*X^2 - (X+Z)^2
+    fp2sub_x8(t1, t2, t1);                          // t1 = 4*X^2 - (X+Z)^2 - (X-Z)^2
+    fp2mul_mont_x8(A24plus, t3, t5);                // t5 = A24plus*(X+Z)^2
+    fp2mul_mont_x8(t3, t5, t3);                     // t3 = A24plus*(X+Z)^4
+    fp2mul_mont_x8(A24minus, t2, t6);               // t6 = A24minus*(X-Z)^2
+    fp2mul_mont_x8(t2, t6, t2);                     // t2 = A24minus*(X-Z)^4
+    fp2sub_x8(t2, t3, t3);                          // t3 = A24minus*(X-Z)^4 - A24plus*(X+Z)^4
+    fp2sub_x8(t5, t6, t2);                          // t2 = A24plus*(X+Z)^2 - A24minus*(X-Z)^2
+    fp2mul_mont_x8(t1, t2, t1);                     // t1 = [4*X^2 - (X+Z)^2 - (X-Z)^2]*[A24plus*(X+Z)^2 - A24minus*(X-Z)^2]
+    fp2add_x8(t3, t1, t2);                          // t2 = [4*X^2 - (X+Z)^2 - (X-Z)^2]*[A24plus*(X+Z)^2 - A24minus*(X-Z)^2] + A24minus*(X-Z)^4 - A24plus*(X+Z)^4
+    fp2sqr_mont_x8(t2, t2);                         // t2 = t2^2
+    fp2mul_mont_x8(t4, t2, Q->X);                   // X3 = 2*X*t2
+    fp2sub_x8(t3, t1, t1);                          // t1 = A24minus*(X-Z)^4 - A24plus*(X+Z)^4 - [4*X^2 - (X+Z)^2 - (X-Z)^2]*[A24plus*(X+Z)^2 - A24minus*(X-Z)^2]
+    fp2sqr_mont_x8(t1, t1);                         // t1 = t1^2
+    fp2mul_mont_x8(t0, t1, Q->Z);                   // Z3 = 2*Z*t1
+}
+
+
+static void xTPLe_x8(const point_proj_x8_t P, point_proj_x8_t Q, const f2elm_x8_t A24minus, const f2elm_x8_t A24plus, const int e)
+{ // 8-way computation of [3^e](X:Z) via e repeated triplings
+    int i;
+
+    fp2copy_x8(P->X, Q->X);
+    fp2copy_x8(P->Z, Q->Z);
+    for (i = 0; i < e; i++) {
+        xTPL_x8(Q, Q, A24minus, A24plus);
+    }
+}
+
+
+static void get_3_isog_x8(const point_proj_x8_t P, f2elm_x8_t A24minus, f2elm_x8_t A24plus, f2elm_x8_t* coeff)
+{ // 8-way computation of the 3-isogenies with kernels generated by the points P of order 3. See get_3_isog().
+    f2elm_x8_t t0, t1, t2, t3, t4;
+
+    fp2sub_x8(P->X, P->Z, coeff[0]);                // coeff0 = X-Z
+    fp2sqr_mont_x8(coeff[0], t0);                   // t0 = (X-Z)^2
+    fp2add_x8(P->X, P->Z, coeff[1]);                // coeff1 = X+Z
+    fp2sqr_mont_x8(coeff[1], t1);                   // t1 = (X+Z)^2
+    fp2add_x8(P->X, P->X, t3);                      // t3 = 2*X
+    fp2sqr_mont_x8(t3, t3);                         // t3 = 4*X^2
+    fp2sub_x8(t3, t0, t2);                          // t2 = 4*X^2 - (X-Z)^2
+    fp2sub_x8(t3, t1, t3);                          // t3 = 4*X^2 - (X+Z)^2
+    fp2add_x8(t0, t3, t4);                          // t4 = 4*X^2 - (X+Z)^2 + (X-Z)^2
+    fp2add_x8(t4, t4, t4);                          // t4 = 2(4*X^2 - (X+Z)^2 + (X-Z)^2)
+    fp2add_x8(t1, t4, t4);                          // t4 = 8*X^2 - (X+Z)^2 + 2*(X-Z)^2
+    fp2mul_mont_x8(t2, t4, A24minus);               // A24minus = [4*X^2 - (X-Z)^2]*[8*X^2 - (X+Z)^2 + 2*(X-Z)^2]
+    fp2add_x8(t1, t2, t4);                          // t4 = 4*X^2 + (X+Z)^2 - (X-Z)^2
+    fp2add_x8(t4, t4, t4);                          // t4 = 2(4*X^2 + (X+Z)^2 - (X-Z)^2)
+    fp2add_x8(t0, t4, t4);                          // t4 = 8*X^2 + 2*(X+Z)^2 - (X-Z)^2
+    fp2mul_mont_x8(t3, t4, A24plus);                // A24plus = [4*X^2 - (X+Z)^2]*[8*X^2 + 2*(X+Z)^2 - (X-Z)^2]
+}
+
+
+static void eval_3_isog_x8(point_proj_x8_t Q, f2elm_x8_t* coeff)
+{ // 8-way evaluation of the 3-isogenies given by coeff at the points Q. See eval_3_isog().
+    f2elm_x8_t t0, t1, t2;
+
+    fp2add_x8(Q->X, Q->Z, t0);                      // t0 = X+Z
+    fp2sub_x8(Q->X, Q->Z, t1);                      // t1 = X-Z
+    fp2mul_mont_x8(coeff[0], t0, t0);               // t0 = coeff0*(X+Z)
+    fp2mul_mont_x8(coeff[1], t1, t1);               // t1 = coeff1*(X-Z)
+    fp2add_x8(t0, t1, t2);                          // t2 = coeff0*(X+Z) + coeff1*(X-Z)
+    fp2sub_x8(t1, t0, t0);                          // t0 = coeff1*(X-Z) - coeff0*(X+Z)
+    fp2sqr_mont_x8(t2, t2);                         // t2 = [coeff0*(X+Z) + coeff1*(X-Z)]^2
+    fp2sqr_mont_x8(t0, t0);                         // t0 = [coeff1*(X-Z) - coeff0*(X+Z)]^2
+    fp2mul_mont_x8(Q->X, t2, Q->X);                 // X3final = X*[coeff0*(X+Z) + coeff1*(X-Z)]^2
+    fp2mul_mont_x8(Q->Z, t0, Q->Z);                 // Z3final = Z*[coeff1*(X-Z) - coeff0*(X+Z)]^2
+}
+
+
+static void xDBLADD_x8(point_proj_x8_t P, point_proj_x8_t Q, const f2elm_x8_t XPQ, const f2elm_x8_t ZPQ, const f2elm_x8_t A24)
+{ // 8-way simultaneous doubling and differential addition, P <- 2*P and Q <- P+Q. See xDBLADD().
+    f2elm_x8_t t0, t1, t2;
+
+    fp2add_x8(P->X, P->Z, t0);                      // t0 = XP+ZP
+    fp2sub_x8(P->X, P->Z, t1);                      // t1 = XP-ZP
+    fp2sqr_mont_x8(t0, P->X);                       // XP = (XP+ZP)^2
+    fp2sub_x8(Q->X, Q->Z, t2);                      // t2 = XQ-ZQ
+    fp2add_x8(Q->X, Q->Z, Q->X);                    // XQ = XQ+ZQ
+    fp2mul_mont_x8(t0, t2, t0);                     // t0 = (XP+ZP)*(XQ-ZQ)
+    fp2sqr_mont_x8(t1, P->Z);                       // ZP = (XP-ZP)^2
+    fp2mul_mont_x8(t1, Q->X, t1);                   // t1 = (XP-ZP)*(XQ+ZQ)
+    fp2sub_x8(P->X, P->Z, t2);                      // t2 = (XP+ZP)^2-(XP-ZP)^2
+    fp2mul_mont_x8(P->X, P->Z, P->X);               // XP = (XP+ZP)^2*(XP-ZP)^2
+    fp2mul_mont_x8(A24, t2, Q->X);                  // XQ = A24*[(XP+ZP)^2-(XP-ZP)^2]
+    fp2sub_x8(t0, t1, Q->Z);                        // ZQ = (XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)
+    fp2add_x8(Q->X, P->Z, P->Z);                    // ZP = A24*[(XP+ZP)^2-(XP-ZP)^2]+(XP-ZP)^2
+    fp2add_x8(t0, t1, Q->X);                        // XQ = (XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)
+    fp2mul_mont_x8(P->Z, t2, P->Z);                 // ZP = [A24*[(XP+ZP)^2-(XP-ZP)^2]+(XP-ZP)^2]*[(XP+ZP)^2-(XP-ZP)^2]
+    fp2sqr_mont_x8(Q->Z, Q->Z);                     // ZQ = [(XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)]^2
+    fp2sqr_mont_x8(Q->X, Q->X);                     // XQ = [(XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)]^2
+    fp2mul_mont_x8(Q->Z, XPQ, Q->Z);                // ZQ = xPQ*[(XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)]^2
+    fp2mul_mont_x8(Q->X, ZPQ, Q->X);                // XQ = ZPQ*[(XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)]^2
+}
+
+
+static void ladder_A24(const f2elm_t A, f2elm_t A24)
+{ // Ladder constant A24 = (A+2)/4, as in LADDER3PT()
+
+    fp2zero(A24);
+    fpcopy((digit_t*)&Montgomery_one, A24[0]);
+    mp2_add(A24, A24, A24);
+    mp2_add(A, A24, A24);
+    fp2div2(A24, A24);
+    fp2div2(A24, A24);
+}
+
+
+static void LADDER3PT_x8(const f2elm_x8_t xP, const f2elm_x8_t xQ, const f2elm_x8_t xPQ, const digit_t (*m)[NWORDS_ORDER], const unsigned int AliceOrBob, point_proj_x8_t R, const f2elm_x8_t A24)
+{ // 8-way three-point Montgomery ladder R = P + [m]Q, where lane k uses the scalar m[k] and the ladder constant A24 = (A+2)/4. See LADDER3PT().
+    point_proj_x8_t R0, R2;
+    f2elm_t one = {0};
+    f2elm_x8_t one_x8;
+    digit_t mask[8], prevbit[8] = {0}, bit;
+    int i, nbits;
+    unsigned int k;
+
+    if (AliceOrBob == ALICE) {
+        nbits = OALICE_BITS;
+    } else {
+        nbits = OBOB_BITS - 1;
+    }
+
+    // Initializing points
+    fpcopy((digit_t*)&Montgomery_one, one[0]);
+    fp2_broadcast_x8(one, one_x8);
+    fp2copy_x8(xQ, R0->X);
+    fp2copy_x8(one_x8, R0->Z);
+    fp2copy_x8(xPQ, R2->X);
+    fp2copy_x8(one_x8, R2->Z);
+    fp2copy_x8(xP, R->X);
+    fp2copy_x8(one_x8, R->Z);
+
+    // Main loop
+    for (i = 0; i < nbits; i++) {
+        for (k = 0; k < 8; k++) {
+            bit = (m[k][i >> LOG2RADIX] >> (i & (RADIX-1))) & 1;
+            mask[k] = 0 - (bit ^ prevbit[k]);
+            prevbit[k] = bit;
+        }
+        swap_points_x8(R, R2, mask);
+        xDBLADD_x8(R0, R2, R->X, R->Z, A24);
+    }
+    for (k = 0; k < 8; k++) {
+        mask[k] = 0 - prevbit[k];
+    }
+    swap_points_x8(R, R2, mask);
+}
+
+
+static void isogeny_traverse_x8(point_proj_x8_t R, f2elm_x8_t A24, f2elm_x8_t C24, point_proj_x8* phis, const unsigned int nphis, const unsigned int AliceOrBob)
+{ // 8-way traversal of the isogeny tree following the single-threaded optimal strategy, computing the isogenies with kernels generated by R
+  // and their images of the points in phis. Alice computes chains of 4-isogenies on the curves (A24plus:C24), Bob chains of 3-isogenies
+  // on the curves (A24minus:A24plus).
+    point_proj_x8_t pts[MAX_INT_POINTS_X8];
+    f2elm_x8_t coeff[3];
+    const unsigned int *strat = (AliceOrBob == ALICE) ? strat_Alice : strat_Bob;
+    unsigned int max = (AliceOrBob == ALICE) ? MAX_Alice : MAX_Bob;
+    unsigned int pts_index[MAX_INT_POINTS_X8], i, row, m, index = 0, npts = 0, ii = 0;
+
+    for (row = 1; row < max; row++) {
+        while (index < max - row) {
+            fp2copy_x8(R->X, pts[npts]->X);
+            fp2copy_x8(R->Z, pts[npts]->Z);
+            pts_index[npts++] = index;
+            m = strat[ii++];
+            if (AliceOrBob == ALICE) {
+                xDBLe_x8(R, R, A24, C24, (int)(2*m));
+            } else {
+                xTPLe_x8(R, R, A24, C24, (int)m);
+            }
+            index += m;
+        }
+
+        if (AliceOrBob == ALICE) {
+            get_4_isog_x8(R, A24, C24, coeff);
+            for (i = 0; i < npts; i++) {
+                eval_4_isog_x8(pts[i], coeff);
+            }
+            for (i = 0; i < nphis; i++) {
+                eval_4_isog_x8(&phis[i], coeff);
+            }
+        } else {
+            get_3_isog_x8(R, A24, C24, coeff);
+            for (i = 0; i < npts; i++) {
+                eval_3_isog_x8(pts[i], coeff);
+            }
+            for (i = 0; i < nphis; i++) {
+                eval_3_isog_x8(&phis[i], coeff);
+            }
+        }
+
+        fp2copy_x8(pts[npts-1]->X, R->X);
+        fp2copy_x8(pts[npts-1]->Z, R->Z);
+        index = pts_index[npts-1];
+        npts -= 1;
+    }
+
+    if (AliceOrBob == ALICE) {
+        get_4_isog_x8(R, A24, C24, coeff);
+        for (i = 0; i < nphis; i++) {
+            eval_4_isog_x8(&phis[i], coeff);
+        }
+    } else {
+        get_3_isog_x8(R, A24, C24, coeff);
+        for (i = 0; i < nphis; i++) {
+            eval_3_isog_x8(&phis[i], coeff);
+        }
+    }
+}
+
+
+static void EphemeralKeyGeneration_A_proj_x8(const unsigned char* PrivateKeyA, point_proj_t* phi)
+{ // 8-way Alice's ephemeral public key generation, without the final normalization
+  // Input:  8 private keys PrivateKeyA + k*SECRETKEY_A_BYTES in the range [0, 2^eA - 1], for k = 0, ..., 7.
+  // Output: the images phi[3*k], phi[3*k+1] and phi[3*k+2] of Bob's basis under the k-th key, in projective (X:Z) coordinates.
+    point_proj_x8_t R, phis[3];
+    f2elm_t XPA, XQA, XRA, XPB, XQB, XRB, one = {0}, A24plus = {0}, C24 = {0}, A = {0}, A24, t[8];
+    f2elm_x8_t XPA_x8, XQA_x8, XRA_x8, A24plus_x8, C24_x8, A24_x8;
+    digit_t SecretKeyA[8][NWORDS_ORDER] = {{0}};
+    unsigned int j, k;
+
+    // Initialize basis points
+    init_basis((digit_t*)A_gen, XPA, XQA, XRA);
+    init_basis((digit_t*)B_gen, XPB, XQB, XRB);
+    fp2_broadcast_x8(XPA, XPA_x8);
+    fp2_broadcast_x8(XQA, XQA_x8);
+    fp2_broadcast_x8(XRA, XRA_x8);
+    fp2_broadcast_x8(XPB, phis[0]->X);
+    fp2_broadcast_x8(XQB, phis[1]->X);
+    fp2_broadcast_x8(XRB, phis[2]->X);
+    fpcopy((digit_t*)&Montgomery_one, one[0]);
+    fp2_broadcast_x8(one, phis[0]->Z);
+    fp2copy_x8(phis[0]->Z, phis[1]->Z);
+    fp2copy_x8(phis[0]->Z, phis[2]->Z);
+
+    // Initialize constants: A24plus = A+2C, C24 = 4C, where A=6, C=1, and the ladder constant (A+2)/4
+    fpcopy((digit_t*)&Montgomery_one, A24plus[0]);
+    mp2_add(A24plus, A24plus, A24plus);
+    mp2_add(A24plus, A24plus, C24);
+    mp2_add(A24plus, C24, A);
+    mp2_add(C24, C24, A24plus);
+    ladder_A24(A, A24);
+    fp2_broadcast_x8(A24plus, A24plus_x8);
+    fp2_broadcast_x8(C24, C24_x8);
+    fp2_broadcast_x8(A24, A24_x8);
+
+    // Retrieve kernel points
+    for (k = 0; k < 8; k++) {
+        decode_to_digits(PrivateKeyA + k*SECRETKEY_A_BYTES, SecretKeyA[k], SECRETKEY_A_BYTES, NWORDS_ORDER);
+    }
+    LADDER3PT_x8(XPA_x8, XQA_x8, XRA_x8, (const digit_t (*)[NWORDS_ORDER])SecretKeyA, ALICE, R, A24_x8);
+
+#if (OALICE_BITS % 2 == 1)
+    point_proj_x8_t S;
+
+    xDBLe_x8(R, S, A24plus_x8, C24_x8, (int)(OALICE_BITS-1));
+    get_2_isog_x8(S, A24plus_x8, C24_x8);
+    for (j = 0; j < 3; j++) {
+        eval_2_isog_x8(phis[j], S);
+    }
+    eval_2_isog_x8(R, S);
+#endif
+
+    // Traverse tree
+    isogeny_traverse_x8(R, A24plus_x8, C24_x8, (point_proj_x8*)phis, 3, ALICE);
+
+    for (j = 0; j < 3; j++) {
+        fp2_unpack_x8(phis[j]->X, t);
+        for (k = 0; k < 8; k++) {
+            fp2copy(t[k], phi[3*k+j]->X);
+        }
+        fp2_unpack_x8(phis[j]->Z, t);
+        for (k = 0; k < 8; k++) {
+            fp2copy(t[k], phi[3*k+j]->Z);
+        }
+    }
+}
+
+
+static void EphemeralSecretAgreement_A_proj_x8(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyB, const unsigned int pkstride, f2elm_t* A24plus, f2elm_t* C24)
+{ // 8-way Alice's ephemeral shared secret computation, without the final j-invariant computation
+  // Inputs: 8 private keys PrivateKeyA + k*SECRETKEY_A_BYTES in the range [0, oA-1], for k = 0, ..., 7.
+  //         8 Bob's public keys PublicKeyB + k*pkstride, each consisting of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
+  // Output: the projective constants (A24plus[k]:C24[k]) = (A:C) of the k-th shared curve.
+    point_proj_x8_t R;
+    f2elm_t PKB[3][8], A, A24[8];
+    f2elm_x8_t PKB_x8[3], A24plus_x8, C24_x8, A24_x8;
+    digit_t SecretKeyA[8][NWORDS_ORDER] = {{0}};
+    unsigned int j, k;
+
+    // Initialize images of Bob's basis and constants: A24plus = A+2C, C24 = 4C, where C=1, and the ladder constant (A+2)/4
+    for (k = 0; k < 8; k++) {
+        for (j = 0; j < 3; j++) {
+            fp2_decode(PublicKeyB + k*pkstride + j*FP2_ENCODED_BYTES, PKB[j][k]);
+        }
+        get_A(PKB[0][k], PKB[1][k], PKB[2][k], A);
+        ladder_A24(A, A24[k]);
+        fp2zero(C24[k]);
+        mp_add((digit_t*)&Montgomery_one, (digit_t*)&Montgomery_one, C24[k][0], NWORDS_FIELD);
+        mp2_add(A, C24[k], A24plus[k]);
+        mp_add(C24[k][0], C24[k][0], C24[k][0], NWORDS_FIELD);
+        decode_to_digits(PrivateKeyA + k*SECRETKEY_A_BYTES, SecretKeyA[k], SECRETKEY_A_BYTES, NWORDS_ORDER);
+    }
+    for (j = 0; j < 3; j++) {
+        fp2_pack_x8((const f2elm_t*)PKB[j], PKB_x8[j]);
+    }
+    fp2_pack_x8((const f2elm_t*)A24, A24_x8);
+    fp2_pack_x8((const f2elm_t*)A24plus, A24plus_x8);
+    fp2_pack_x8((const f2elm_t*)C24, C24_x8);
+
+    // Retrieve kernel points
+    LADDER3PT_x8(PKB_x8[0], PKB_x8[1], PKB_x8[2], (const digit_t (*)[NWORDS_ORDER])SecretKeyA, ALICE, R, A24_x8);
+
+#if (OALICE_BITS % 2 == 1)
+    point_proj_x8_t S;
+
+    xDBLe_x8(R, S, A24plus_x8, C24_x8, (int)(OALICE_BITS-1));
+    get_2_isog_x8(S, A24plus_x8, C24_x8);
+    eval_2_isog_x8(R, S);
+#endif
+
+    // Traverse tree
+    isogeny_traverse_x8(R, A24plus_x8, C24_x8, NULL, 0, ALICE);
+
+    fp2_unpack_x8(A24plus_x8, A24plus);
+    fp2_unpack_x8(C24_x8, C24);
+    for (k = 0; k < 8; k++) {
+        mp2_add(A24plus[k], A24plus[k], A24plus[k]);
+        fp2sub(A24plus[k], C24[k], A24plus[k]);
+        fp2add(A24plus[k], A24plus[k], A24plus[k]);
+    }
+}
+
+
+static void EphemeralSecretAgreement_B_proj_x8(const unsigned char* PrivateKeyB, const unsigned int skstride, const unsigned char* PublicKeyA, const unsigned int pkstride, f2elm_t* A, f2elm_t* C)
+{ // 8-way Bob's ephemeral shared secret computation, without the final j-invariant computation
+  // Inputs: 8 private keys PrivateKeyB + k*skstride in the range [0, 2^Floor(Log(2,oB)) - 1], for k = 0, ..., 7.
+  //         8 Alice's public keys PublicKeyA + k*pkstride, each consisting of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
+  // Output: the projective constants (A[k]:C[k]) of the k-th shared curve.
+    point_proj_x8_t R;
+    f2elm_t PKA[3][8], A24plus[8], A24minus[8], A24[8];
+    f2elm_x8_t PKA_x8[3], A24plus_x8, A24minus_x8, A24_x8;
+    digit_t SecretKeyB[8][NWORDS_ORDER] = {{0}};
+    unsigned int j, k;
+
+    // Initialize images of Alice's basis and constants: A24plus = A+2C, A24minus = A-2C, where C=1, and the ladder constant (A+2)/4
+    for (k = 0; k < 8; k++) {
+        for (j = 0; j < 3; j++) {
+            fp2_decode(PublicKeyA + k*pkstride + j*FP2_ENCODED_BYTES, PKA[j][k]);
+        }
+        get_A(PKA[0][k], PKA[1][k], PKA[2][k], A[k]);
+        ladder_A24(A[k], A24[k]);
+        fp2zero(A24minus[k]);
+        mp_add((digit_t*)&Montgomery_one, (digit_t*)&Montgomery_one, A24minus[k][0], NWORDS_FIELD);
+        mp2_add(A[k], A24minus[k], A24plus[k]);
+        mp2_sub_p2(A[k], A24minus[k], A24minus[k]);
+        decode_to_digits(PrivateKeyB + k*skstride, SecretKeyB[k], SECRETKEY_B_BYTES, NWORDS_ORDER);
+    }
+    for (j = 0; j < 3; j++) {
+        fp2_pack_x8((const f2elm_t*)PKA[j], PKA_x8[j]);
+    }
+    fp2_pack_x8((const f2elm_t*)A24, A24_x8);
+    fp2_pack_x8((const f2elm_t*)A24plus, A24plus_x8);
+    fp2_pack_x8((const f2elm_t*)A24minus, A24minus_x8);
+
+    // Retrieve kernel points
+    LADDER3PT_x8(PKA_x8[0], PKA_x8[1], PKA_x8[2], (const digit_t (*)[NWORDS_ORDER])SecretKeyB, BOB, R, A24_x8);
+
+    // Traverse tree
+    isogeny_traverse_x8(R, A24minus_x8, A24plus_x8, NULL, 0, BOB);
+
+    fp2_unpack_x8(A24plus_x8, A24plus);
+    fp2_unpack_x8(A24minus_x8, A24minus);
+    for (k = 0; k < 8; k++) {
+        fp2add(A24plus[k], A24minus[k], A[k]);
+        fp2add(A[k], A[k], A[k]);
+        fp2sub(A24plus[k], A24minus[k], C[k]);
+    }
+}
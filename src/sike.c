@@ -10,11 +10,29 @@
 
 #include <string.h>
 #include "sha3/fips202.h"
+#include "sha3/fips202x4.h"
 
 #ifdef DO_VALGRIND_CHECK
 #include <valgrind/memcheck.h>
 #endif
 
+#define KEM_BATCH_CHUNK    16      // Number of operations that share field inversions in the batched API
+
+typedef struct {
+    digit_t SecretKeyB[NWORDS_ORDER];            // Bob's secret key decoded to digits
+    unsigned char s[MSG_BYTES];                  // Random value s used for implicit rejection
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES];     // Public key, hashed in G(m||pk)
+} expanded_sk_t;
+
+typedef char expanded_sk_size_check[(sizeof(expanded_sk_t) <= CRYPTO_EXPANDEDSECRETKEYBYTES) ? 1 : -1];
+
+typedef struct {
+    public_key_B_context_t ctx;                  // Decoded public key, curve coefficient and ladder table
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES];     // Public key, hashed in G(m||pk)
+} expanded_pk_t;
+
+typedef char expanded_pk_size_check[(sizeof(expanded_pk_t) <= CRYPTO_EXPANDEDPUBLICKEYBYTES) ? 1 : -1];
+
 
 int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
 { // SIKE's key generation
@@ -49,15 +67,19 @@ int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk
     unsigned char ephemeralsk[SECRETKEY_A_BYTES];
     unsigned char jinvariant[FP2_ENCODED_BYTES];
     unsigned char h[MSG_BYTES];
-    unsigned char temp[CRYPTO_CIPHERTEXTBYTES+MSG_BYTES];
+    unsigned char temp[MSG_BYTES];
+    shake256incctx state;
 
     // Generate ephemeralsk <- G(m||pk) mod oA 
     randombytes(temp, MSG_BYTES);
 #ifdef DO_VALGRIND_CHECK
     VALGRIND_MAKE_MEM_UNDEFINED(temp, MSG_BYTES);
 #endif
-    memcpy(&temp[MSG_BYTES], pk, CRYPTO_PUBLICKEYBYTES);
-    shake256(ephemeralsk, SECRETKEY_A_BYTES, temp, CRYPTO_PUBLICKEYBYTES+MSG_BYTES);
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, temp, MSG_BYTES);
+    shake256_inc_absorb(&state, pk, CRYPTO_PUBLICKEYBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(ephemeralsk, SECRETKEY_A_BYTES, &state);
     ephemeralsk[SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
 
     // Encrypt
@@ -69,8 +91,11 @@ int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk
     }
 
     // Generate shared secret ss <- H(m||ct)
-    memcpy(&temp[MSG_BYTES], ct, CRYPTO_CIPHERTEXTBYTES);
-    shake256(ss, CRYPTO_BYTES, temp, CRYPTO_CIPHERTEXTBYTES+MSG_BYTES);
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, temp, MSG_BYTES);
+    shake256_inc_absorb(&state, ct, CRYPTO_CIPHERTEXTBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(ss, CRYPTO_BYTES, &state);
 
 #ifdef DO_VALGRIND_CHECK
     VALGRIND_MAKE_MEM_DEFINED(temp, MSG_BYTES);
@@ -88,7 +113,8 @@ int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned ch
     unsigned char jinvariant_[FP2_ENCODED_BYTES];
     unsigned char h_[MSG_BYTES];
     unsigned char c0_[CRYPTO_PUBLICKEYBYTES];
-    unsigned char temp[CRYPTO_CIPHERTEXTBYTES+MSG_BYTES];
+    unsigned char temp[MSG_BYTES];
+    shake256incctx state;
 #ifdef DO_VALGRIND_CHECK
     VALGRIND_MAKE_MEM_UNDEFINED(sk, CRYPTO_SECRETKEYBYTES);
 #endif
@@ -101,8 +127,11 @@ int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned ch
     }
 
     // Generate ephemeralsk_ <- G(m||pk) mod oA
-    memcpy(&temp[MSG_BYTES], &sk[MSG_BYTES + SECRETKEY_B_BYTES], CRYPTO_PUBLICKEYBYTES);
-    shake256(ephemeralsk_, SECRETKEY_A_BYTES, temp, CRYPTO_PUBLICKEYBYTES+MSG_BYTES);
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, temp, MSG_BYTES);
+    shake256_inc_absorb(&state, &sk[MSG_BYTES + SECRETKEY_B_BYTES], CRYPTO_PUBLICKEYBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(ephemeralsk_, SECRETKEY_A_BYTES, &state);
     ephemeralsk_[SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
     
     // Generate shared secret ss <- H(m||ct), or output ss <- H(s||ct) in case of ct verification failure
@@ -110,11 +139,335 @@ int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned ch
     // If selector = 0 then do ss = H(m||ct), else if selector = -1 load s to do ss = H(s||ct)
     int8_t selector = ct_compare(c0_, ct, CRYPTO_PUBLICKEYBYTES);
     ct_cmov(temp, sk, MSG_BYTES, selector);
-    memcpy(&temp[MSG_BYTES], ct, CRYPTO_CIPHERTEXTBYTES);
-    shake256(ss, CRYPTO_BYTES, temp, CRYPTO_CIPHERTEXTBYTES+MSG_BYTES);
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, temp, MSG_BYTES);
+    shake256_inc_absorb(&state, ct, CRYPTO_CIPHERTEXTBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(ss, CRYPTO_BYTES, &state);
     
 #ifdef DO_VALGRIND_CHECK
     VALGRIND_MAKE_MEM_DEFINED(sk, CRYPTO_SECRETKEYBYTES);
 #endif
     return 0;
-}
\ No newline at end of file
+}
+
+
+int crypto_kem_expand_pk(unsigned char *epk, const unsigned char *pk)
+{ // SIKE's public key expansion for repeated encapsulation
+  // Input:   public key pk          (CRYPTO_PUBLICKEYBYTES bytes)
+  // Output:  expanded public key epk (CRYPTO_EXPANDEDPUBLICKEYBYTES bytes, aligned to 8 bytes)
+    expanded_pk_t *expanded = (expanded_pk_t*)epk;
+
+    memset(epk, 0, CRYPTO_EXPANDEDPUBLICKEYBYTES);
+    PublicKeyB_context_init(pk, &expanded->ctx);
+    memcpy(expanded->pk, pk, CRYPTO_PUBLICKEYBYTES);
+
+    return 0;
+}
+
+
+int crypto_kem_enc_expanded(unsigned char *ct, unsigned char *ss, const unsigned char *epk)
+{ // SIKE's encapsulation using an expanded public key
+  // Input:   expanded public key epk (CRYPTO_EXPANDEDPUBLICKEYBYTES bytes, computed with crypto_kem_expand_pk)
+  // Outputs: shared secret ss        (CRYPTO_BYTES bytes)
+  //          ciphertext message ct   (CRYPTO_CIPHERTEXTBYTES = CRYPTO_PUBLICKEYBYTES + MSG_BYTES bytes)
+    const expanded_pk_t *expanded = (const expanded_pk_t*)epk;
+    f2elm_t A, C, jinv;
+    unsigned char ephemeralsk[SECRETKEY_A_BYTES];
+    unsigned char jinvariant[FP2_ENCODED_BYTES];
+    unsigned char h[MSG_BYTES];
+    unsigned char temp[MSG_BYTES];
+    shake256incctx state;
+
+    // Generate ephemeralsk <- G(m||pk) mod oA 
+    randombytes(temp, MSG_BYTES);
+#ifdef DO_VALGRIND_CHECK
+    VALGRIND_MAKE_MEM_UNDEFINED(temp, MSG_BYTES);
+#endif
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, temp, MSG_BYTES);
+    shake256_inc_absorb(&state, expanded->pk, CRYPTO_PUBLICKEYBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(ephemeralsk, SECRETKEY_A_BYTES, &state);
+    ephemeralsk[SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
+
+    // Encrypt
+    EphemeralKeyGeneration_A(ephemeralsk, ct);
+    EphemeralSecretAgreement_A_context_proj(ephemeralsk, &expanded->ctx, A, C);
+    j_inv(A, C, jinv);
+    fp2_encode(jinv, jinvariant);
+    shake256(h, MSG_BYTES, jinvariant, FP2_ENCODED_BYTES);
+    for (int i = 0; i < MSG_BYTES; i++) {
+        ct[i + CRYPTO_PUBLICKEYBYTES] = temp[i] ^ h[i];
+    }
+
+    // Generate shared secret ss <- H(m||ct)
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, temp, MSG_BYTES);
+    shake256_inc_absorb(&state, ct, CRYPTO_CIPHERTEXTBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(ss, CRYPTO_BYTES, &state);
+
+#ifdef DO_VALGRIND_CHECK
+    VALGRIND_MAKE_MEM_DEFINED(temp, MSG_BYTES);
+#endif
+    return 0;
+}
+
+
+int crypto_kem_expand_sk(unsigned char *esk, const unsigned char *sk)
+{ // SIKE's secret key expansion for repeated decapsulation
+  // Input:   secret key sk          (CRYPTO_SECRETKEYBYTES = MSG_BYTES + SECRETKEY_B_BYTES + CRYPTO_PUBLICKEYBYTES bytes)
+  // Output:  expanded secret key esk (CRYPTO_EXPANDEDSECRETKEYBYTES bytes, aligned to 8 bytes)
+    expanded_sk_t *expanded = (expanded_sk_t*)esk;
+
+    memset(esk, 0, CRYPTO_EXPANDEDSECRETKEYBYTES);
+    memcpy(expanded->s, sk, MSG_BYTES);
+    decode_to_digits(sk + MSG_BYTES, expanded->SecretKeyB, SECRETKEY_B_BYTES, NWORDS_ORDER);
+    memcpy(expanded->pk, &sk[MSG_BYTES + SECRETKEY_B_BYTES], CRYPTO_PUBLICKEYBYTES);
+
+    return 0;
+}
+
+
+int crypto_kem_dec_expanded(unsigned char *ss, const unsigned char *ct, const unsigned char *esk)
+{ // SIKE's decapsulation using an expanded secret key
+  // Input:   expanded secret key esk (CRYPTO_EXPANDEDSECRETKEYBYTES bytes, computed with crypto_kem_expand_sk)
+  //          ciphertext message ct   (CRYPTO_CIPHERTEXTBYTES = CRYPTO_PUBLICKEYBYTES + MSG_BYTES bytes) 
+  // Outputs: shared secret ss        (CRYPTO_BYTES bytes)
+    const expanded_sk_t *expanded = (const expanded_sk_t*)esk;
+    f2elm_t A, C, jinv;
+    unsigned char ephemeralsk_[SECRETKEY_A_BYTES];
+    unsigned char jinvariant_[FP2_ENCODED_BYTES];
+    unsigned char h_[MSG_BYTES];
+    unsigned char c0_[CRYPTO_PUBLICKEYBYTES];
+    unsigned char temp[MSG_BYTES];
+    shake256incctx state;
+
+#ifdef DO_VALGRIND_CHECK
+    VALGRIND_MAKE_MEM_UNDEFINED(esk, CRYPTO_EXPANDEDSECRETKEYBYTES);
+#endif
+
+    // Decrypt
+    EphemeralSecretAgreement_B_digits_proj(expanded->SecretKeyB, ct, A, C);
+    j_inv(A, C, jinv);
+    fp2_encode(jinv, jinvariant_);
+    shake256(h_, MSG_BYTES, jinvariant_, FP2_ENCODED_BYTES);
+    for (int i = 0; i < MSG_BYTES; i++) {
+        temp[i] = ct[i + CRYPTO_PUBLICKEYBYTES] ^ h_[i];
+    }
+
+    // Generate ephemeralsk_ <- G(m||pk) mod oA
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, temp, MSG_BYTES);
+    shake256_inc_absorb(&state, expanded->pk, CRYPTO_PUBLICKEYBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(ephemeralsk_, SECRETKEY_A_BYTES, &state);
+    ephemeralsk_[SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
+
+    // Generate shared secret ss <- H(m||ct), or output ss <- H(s||ct) in case of ct verification failure
+    EphemeralKeyGeneration_A(ephemeralsk_, c0_);
+    // If selector = 0 then do ss = H(m||ct), else if selector = -1 load s to do ss = H(s||ct)
+    int8_t selector = ct_compare(c0_, ct, CRYPTO_PUBLICKEYBYTES);
+    ct_cmov(temp, expanded->s, MSG_BYTES, selector);
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, temp, MSG_BYTES);
+    shake256_inc_absorb(&state, ct, CRYPTO_CIPHERTEXTBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(ss, CRYPTO_BYTES, &state);
+
+#ifdef DO_VALGRIND_CHECK
+    VALGRIND_MAKE_MEM_DEFINED(esk, CRYPTO_EXPANDEDSECRETKEYBYTES);
+#endif
+
+    return 0;
+}
+
+
+int crypto_kem_enc_batch(unsigned char *ct, unsigned char *ss, const unsigned char *pk, unsigned int count)
+{ // SIKE's batched encapsulation
+  // Input:   count public keys pk          (count*CRYPTO_PUBLICKEYBYTES bytes)
+  // Outputs: count shared secrets ss       (count*CRYPTO_BYTES bytes)
+  //          count ciphertext messages ct  (count*CRYPTO_CIPHERTEXTBYTES bytes)
+  // The i-th ciphertext and shared secret are computed under the i-th public key, as in crypto_kem_enc. Operations are processed 
+  // in chunks of KEM_BATCH_CHUNK that share the sampling of m and a single inversion for the public key and j-invariant normalizations. 
+  // The SHAKE256 evaluations of a chunk are computed four at a time. With USE_IFMA=TRUE, the isogeny computations of a chunk are
+  // run eight at a time on the 8-way AVX-512 IFMA arithmetic, if the processor supports it.
+    point_proj_t phi[3*KEM_BATCH_CHUNK];
+    f2elm_t jinv[KEM_BATCH_CHUNK], A[KEM_BATCH_CHUNK], C[KEM_BATCH_CHUNK], den[4*KEM_BATCH_CHUNK], inv[4*KEM_BATCH_CHUNK];
+    unsigned char ephemeralsk[KEM_BATCH_CHUNK*SECRETKEY_A_BYTES];
+    unsigned char jinvariant[KEM_BATCH_CHUNK*FP2_ENCODED_BYTES];
+    unsigned char h[KEM_BATCH_CHUNK*MSG_BYTES];
+    unsigned char m[KEM_BATCH_CHUNK*MSG_BYTES];
+    unsigned int i, j, k, n;
+
+    for (i = 0; i < count; i += n) {
+        n = count - i;
+        if (n > KEM_BATCH_CHUNK) n = KEM_BATCH_CHUNK;
+
+        randombytes(m, n*MSG_BYTES);
+#ifdef DO_VALGRIND_CHECK
+        VALGRIND_MAKE_MEM_UNDEFINED(m, n*MSG_BYTES);
+#endif
+        // Generate ephemeralsk <- G(m||pk) mod oA 
+        shake256_batch_concat(ephemeralsk, SECRETKEY_A_BYTES, m, MSG_BYTES, pk + i*CRYPTO_PUBLICKEYBYTES, CRYPTO_PUBLICKEYBYTES, CRYPTO_PUBLICKEYBYTES, n);
+        for (j = 0; j < n; j++) {
+            ephemeralsk[j*SECRETKEY_A_BYTES + SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
+        }
+
+        // Encrypt, leaving the results in projective form
+        j = 0;
+#if defined(_IFMA_)
+        for (; ifma_supported && j + 8 <= n; j += 8) {
+            EphemeralKeyGeneration_A_proj_x8(&ephemeralsk[j*SECRETKEY_A_BYTES], &phi[3*j]);
+            EphemeralSecretAgreement_A_proj_x8(&ephemeralsk[j*SECRETKEY_A_BYTES], pk + (i+j)*CRYPTO_PUBLICKEYBYTES, CRYPTO_PUBLICKEYBYTES, &A[j], &C[j]);
+        }
+#endif
+        for (; j < n; j++) {
+            EphemeralKeyGeneration_A_proj(&ephemeralsk[j*SECRETKEY_A_BYTES], phi[3*j], phi[3*j+1], phi[3*j+2]);
+            EphemeralSecretAgreement_A_proj(&ephemeralsk[j*SECRETKEY_A_BYTES], pk + (i+j)*CRYPTO_PUBLICKEYBYTES, A[j], C[j]);
+        }
+        for (j = 0; j < n; j++) {
+            j_inv_proj(A[j], C[j], jinv[j], den[4*j+3]);
+            for (k = 0; k < 3; k++) {
+                fp2copy(phi[3*j+k]->Z, den[4*j+k]);
+            }
+        }
+
+        mont_n_way_inv_ct(den, 4*n, inv);
+
+        for (j = 0; j < n; j++) {
+            unsigned char *ctj = ct + (i+j)*CRYPTO_CIPHERTEXTBYTES;
+
+            // Format public key
+            for (k = 0; k < 3; k++) {
+                fp2mul_mont(phi[3*j+k]->X, inv[4*j+k], phi[3*j+k]->X);
+                fp2_encode(phi[3*j+k]->X, ctj + k*FP2_ENCODED_BYTES);
+            }
+            fp2mul_mont(jinv[j], inv[4*j+3], jinv[j]);
+            fp2_encode(jinv[j], &jinvariant[j*FP2_ENCODED_BYTES]);
+        }
+        shake256_batch(h, MSG_BYTES, jinvariant, FP2_ENCODED_BYTES, n);
+
+        for (j = 0; j < n; j++) {
+            unsigned char *ctj = ct + (i+j)*CRYPTO_CIPHERTEXTBYTES;
+
+            for (k = 0; k < MSG_BYTES; k++) {
+                ctj[k + CRYPTO_PUBLICKEYBYTES] = m[j*MSG_BYTES + k] ^ h[j*MSG_BYTES + k];
+            }
+        }
+
+        // Generate shared secrets ss <- H(m||ct)
+        shake256_batch_concat(ss + i*CRYPTO_BYTES, CRYPTO_BYTES, m, MSG_BYTES, ct + i*CRYPTO_CIPHERTEXTBYTES, CRYPTO_CIPHERTEXTBYTES, CRYPTO_CIPHERTEXTBYTES, n);
+#ifdef DO_VALGRIND_CHECK
+        VALGRIND_MAKE_MEM_DEFINED(m, n*MSG_BYTES);
+#endif
+    }
+
+    return 0;
+}
+
+
+int crypto_kem_dec_batch(unsigned char *ss, const unsigned char *ct, const unsigned char *sk, unsigned int count)
+{ // SIKE's batched decapsulation
+  // Input:   count secret keys sk          (count*CRYPTO_SECRETKEYBYTES bytes)
+  //          count ciphertext messages ct  (count*CRYPTO_CIPHERTEXTBYTES bytes) 
+  // Outputs: count shared secrets ss       (count*CRYPTO_BYTES bytes)
+  // The i-th ciphertext is decapsulated with the i-th secret key, as in crypto_kem_dec. Operations are processed in chunks of 
+  // KEM_BATCH_CHUNK that share one inversion for the j-invariants and one inversion for the re-encryption normalizations.
+  // The SHAKE256 evaluations of a chunk are computed four at a time. With USE_IFMA=TRUE, the isogeny computations of a chunk are
+  // run eight at a time on the 8-way AVX-512 IFMA arithmetic, if the processor supports it. A malformed ciphertext only affects
+  // its own shared secret.
+    point_proj_t phi[3*KEM_BATCH_CHUNK];
+    f2elm_t jinv[KEM_BATCH_CHUNK], A[KEM_BATCH_CHUNK], C[KEM_BATCH_CHUNK], den[3*KEM_BATCH_CHUNK], inv[3*KEM_BATCH_CHUNK];
+    unsigned char ephemeralsk_[KEM_BATCH_CHUNK*SECRETKEY_A_BYTES];
+    unsigned char jinvariant_[KEM_BATCH_CHUNK*FP2_ENCODED_BYTES];
+    unsigned char h_[KEM_BATCH_CHUNK*MSG_BYTES];
+    unsigned char c0_[CRYPTO_PUBLICKEYBYTES];
+    unsigned char m_[KEM_BATCH_CHUNK*MSG_BYTES];
+    unsigned int i, j, k, n;
+#ifdef DO_VALGRIND_CHECK
+    VALGRIND_MAKE_MEM_UNDEFINED(sk, count*CRYPTO_SECRETKEYBYTES);
+#endif
+
+    for (i = 0; i < count; i += n) {
+        n = count - i;
+        if (n > KEM_BATCH_CHUNK) n = KEM_BATCH_CHUNK;
+
+        // Decrypt, leaving the j-invariants in projective form
+        j = 0;
+#if defined(_IFMA_)
+        for (; ifma_supported && j + 8 <= n; j += 8) {
+            EphemeralSecretAgreement_B_proj_x8(sk + (i+j)*CRYPTO_SECRETKEYBYTES + MSG_BYTES, CRYPTO_SECRETKEYBYTES, ct + (i+j)*CRYPTO_CIPHERTEXTBYTES, CRYPTO_CIPHERTEXTBYTES, &A[j], &C[j]);
+        }
+#endif
+        for (; j < n; j++) {
+            EphemeralSecretAgreement_B_proj(sk + (i+j)*CRYPTO_SECRETKEYBYTES + MSG_BYTES, ct + (i+j)*CRYPTO_CIPHERTEXTBYTES, A[j], C[j]);
+        }
+        for (j = 0; j < n; j++) {
+            j_inv_proj(A[j], C[j], jinv[j], den[j]);
+        }
+
+        mont_n_way_inv_ct(den, n, inv);
+
+        for (j = 0; j < n; j++) {
+            fp2mul_mont(jinv[j], inv[j], jinv[j]);
+            fp2_encode(jinv[j], &jinvariant_[j*FP2_ENCODED_BYTES]);
+        }
+        shake256_batch(h_, MSG_BYTES, jinvariant_, FP2_ENCODED_BYTES, n);
+
+        // Generate ephemeralsk_ <- G(m||pk) mod oA
+        for (j = 0; j < n; j++) {
+            const unsigned char *ctj = ct + (i+j)*CRYPTO_CIPHERTEXTBYTES;
+
+            for (k = 0; k < MSG_BYTES; k++) {
+                m_[j*MSG_BYTES + k] = ctj[k + CRYPTO_PUBLICKEYBYTES] ^ h_[j*MSG_BYTES + k];
+            }
+        }
+        shake256_batch_concat(ephemeralsk_, SECRETKEY_A_BYTES, m_, MSG_BYTES, sk + i*CRYPTO_SECRETKEYBYTES + MSG_BYTES + SECRETKEY_B_BYTES, CRYPTO_PUBLICKEYBYTES, CRYPTO_SECRETKEYBYTES, n);
+        for (j = 0; j < n; j++) {
+            ephemeralsk_[j*SECRETKEY_A_BYTES + SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
+        }
+
+        j = 0;
+#if defined(_IFMA_)
+        for (; ifma_supported && j + 8 <= n; j += 8) {
+            EphemeralKeyGeneration_A_proj_x8(&ephemeralsk_[j*SECRETKEY_A_BYTES], &phi[3*j]);
+        }
+#endif
+        for (; j < n; j++) {
+            EphemeralKeyGeneration_A_proj(&ephemeralsk_[j*SECRETKEY_A_BYTES], phi[3*j], phi[3*j+1], phi[3*j+2]);
+        }
+        for (j = 0; j < 3*n; j++) {
+            fp2copy(phi[j]->Z, den[j]);
+        }
+
+        mont_n_way_inv_ct(den, 3*n, inv);
+
+        for (j = 0; j < n; j++) {
+            const unsigned char *ctj = ct + (i+j)*CRYPTO_CIPHERTEXTBYTES;
+            const unsigned char *skj = sk + (i+j)*CRYPTO_SECRETKEYBYTES;
+
+            for (k = 0; k < 3; k++) {
+                fp2mul_mont(phi[3*j+k]->X, inv[3*j+k], phi[3*j+k]->X);
+                fp2_encode(phi[3*j+k]->X, c0_ + k*FP2_ENCODED_BYTES);
+            }
+
+            // Generate shared secret ss <- H(m||ct), or output ss <- H(s||ct) in case of ct verification failure
+            // If selector = 0 then do ss = H(m||ct), else if selector = -1 load s to do ss = H(s||ct)
+            int8_t selector = ct_compare(c0_, ctj, CRYPTO_PUBLICKEYBYTES);
+            ct_cmov(&m_[j*MSG_BYTES], skj, MSG_BYTES, selector);
+        }
+        shake256_batch_concat(ss + i*CRYPTO_BYTES, CRYPTO_BYTES, m_, MSG_BYTES, ct + i*CRYPTO_CIPHERTEXTBYTES, CRYPTO_CIPHERTEXTBYTES, CRYPTO_CIPHERTEXTBYTES, n);
+    }
+
+#ifdef DO_VALGRIND_CHECK
+    VALGRIND_MAKE_MEM_DEFINED(sk, count*CRYPTO_SECRETKEYBYTES);
+#endif
+    return 0;
+}
+
+
+#if defined(_THREADS_)
+    #include "keypair_pool.c"
+#endif
@@ -0,0 +1,184 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: persistent thread pool for the parallel evaluation of isogenies
+*           Workers spin for a short time waiting for new tasks before going to sleep, which keeps the
+*           synchronization latency low between consecutive levels of the isogeny tree traversal.
+*********************************************************************************************/ 
+
+#include "threadpool.h"
+#include <pthread.h>
+#include <sched.h>
+
+#define SPIN_ITERATIONS   (1 << 14)     // Number of polling iterations before a waiting worker goes to sleep
+#define YIELD_INTERVAL    64            // Polling iterations between yields of the processor, in case there are more threads than cores
+
+#if defined(__x86_64__) || defined(__i386__)
+    #define cpu_relax()   __asm__ __volatile__("pause" ::: "memory")
+#elif defined(__aarch64__)
+    #define cpu_relax()   __asm__ __volatile__("yield" ::: "memory")
+#else
+    #define cpu_relax()   __asm__ __volatile__("" ::: "memory")
+#endif
+
+
+static struct {
+    pthread_mutex_t lock;               // Protects the job description below
+    pthread_cond_t wakeup;              // Signaled when a new job is posted or on shutdown
+    pthread_mutex_t run_lock;           // Held by the thread that owns the pool during threadpool_run and during resizing
+    pthread_t workers[THREADPOOL_MAX_THREADS-1];
+    unsigned int nworkers;
+    unsigned int nsleeping;
+    unsigned int generation;            // Incremented for each new job
+    unsigned int shutdown;
+    threadpool_task_t task;
+    void* arg;
+    unsigned int ntasks;
+    unsigned int next;                  // Index of the next task to be started
+    unsigned int pending;               // Number of tasks not yet finished
+} pool = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_MUTEX_INITIALIZER };
+
+
+static void run_tasks(void)
+{ // Run tasks from the current job until there are none left. Must be called holding pool.lock.
+    unsigned int index;
+    threadpool_task_t task = pool.task;
+    void* arg = pool.arg;
+
+    while (pool.next < pool.ntasks) {
+        index = pool.next++;
+        pthread_mutex_unlock(&pool.lock);
+        task(arg, index);
+        pthread_mutex_lock(&pool.lock);
+        __atomic_sub_fetch(&pool.pending, 1, __ATOMIC_RELEASE);
+    }
+}
+
+
+static void* worker(void* unused)
+{ // Worker thread main loop
+    unsigned int seen, spins;
+    (void)unused;
+
+    pthread_mutex_lock(&pool.lock);
+    seen = pool.generation;
+    while (1) {
+        while (pool.generation == seen && pool.shutdown == 0) {
+            pthread_mutex_unlock(&pool.lock);
+            for (spins = 0; spins < SPIN_ITERATIONS; spins++) {
+                if (__atomic_load_n(&pool.generation, __ATOMIC_ACQUIRE) != seen || __atomic_load_n(&pool.shutdown, __ATOMIC_ACQUIRE) != 0) {
+                    break;
+                }
+                cpu_relax();
+                if ((spins % YIELD_INTERVAL) == YIELD_INTERVAL-1) {
+                    sched_yield();
+                }
+            }
+            pthread_mutex_lock(&pool.lock);
+            if (pool.generation == seen && pool.shutdown == 0) {
+                pool.nsleeping++;
+                pthread_cond_wait(&pool.wakeup, &pool.lock);
+                pool.nsleeping--;
+            }
+        }
+        if (pool.shutdown != 0) {
+            break;
+        }
+        seen = pool.generation;
+        run_tasks();
+    }
+    pthread_mutex_unlock(&pool.lock);
+
+    return NULL;
+}
+
+
+static void stop_workers(void)
+{ // Stop and join all worker threads. Must be called holding pool.run_lock.
+    unsigned int i;
+
+    pthread_mutex_lock(&pool.lock);
+    __atomic_store_n(&pool.shutdown, 1, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&pool.wakeup);
+    pthread_mutex_unlock(&pool.lock);
+
+    for (i = 0; i < pool.nworkers; i++) {
+        pthread_join(pool.workers[i], NULL);
+    }
+    pool.nworkers = 0;
+    pool.shutdown = 0;
+}
+
+
+int threadpool_set_num_threads(unsigned int nthreads)
+{ // Set the number of threads used for the parallel isogeny evaluations, including the calling thread
+    int status = 0;
+
+    if (nthreads < 1 || nthreads > THREADPOOL_MAX_THREADS) {
+        return 1;
+    }
+
+    pthread_mutex_lock(&pool.run_lock);
+    stop_workers();
+    while (pool.nworkers < nthreads-1) {
+        if (pthread_create(&pool.workers[pool.nworkers], NULL, worker, NULL) != 0) {
+            status = 1;
+            break;
+        }
+        pool.nworkers++;
+    }
+    pthread_mutex_unlock(&pool.run_lock);
+
+    return status;
+}
+
+
+unsigned int threadpool_get_num_threads(void)
+{ // Get the number of threads used for the parallel isogeny evaluations, including the calling thread
+    return pool.nworkers + 1;
+}
+
+
+void threadpool_run(threadpool_task_t task, void* arg, unsigned int ntasks)
+{ // Run task(arg, index) for index = 0, ..., ntasks-1 using the worker threads and the calling thread
+    unsigned int i, spins = 0;
+
+    if (ntasks < 2 || pthread_mutex_trylock(&pool.run_lock) != 0) {
+        for (i = 0; i < ntasks; i++) {
+            task(arg, i);
+        }
+        return;
+    }
+    if (pool.nworkers == 0) {
+        pthread_mutex_unlock(&pool.run_lock);
+        for (i = 0; i < ntasks; i++) {
+            task(arg, i);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    pool.task = task;
+    pool.arg = arg;
+    pool.ntasks = ntasks;
+    pool.next = 0;
+    __atomic_store_n(&pool.pending, ntasks, __ATOMIC_RELAXED);
+    __atomic_store_n(&pool.generation, pool.generation + 1, __ATOMIC_RELEASE);
+    if (pool.nsleeping > 0) {
+        pthread_cond_broadcast(&pool.wakeup);
+    }
+    run_tasks();
+    pthread_mutex_unlock(&pool.lock);
+
+    while (__atomic_load_n(&pool.pending, __ATOMIC_ACQUIRE) != 0) {    // Wait for the tasks still running on the workers
+        cpu_relax();
+        if ((++spins % YIELD_INTERVAL) == 0) {
+            sched_yield();
+        }
+    }
+    pthread_mutex_unlock(&pool.run_lock);
+}
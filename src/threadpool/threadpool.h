@@ -0,0 +1,23 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+
+// Maximum number of threads, including the calling thread
+#define THREADPOOL_MAX_THREADS   64
+
+// Task executed by the thread pool, where index is in the range [0, ntasks-1]
+typedef void (*threadpool_task_t)(void* arg, unsigned int index);
+
+// Set the number of threads used for the parallel isogeny evaluations, including the calling thread.
+// nthreads = 1 (default) disables parallelism. Returns 0 on success. It must not be called concurrently with other library functions.
+int threadpool_set_num_threads(unsigned int nthreads);
+
+// Get the number of threads used for the parallel isogeny evaluations, including the calling thread
+unsigned int threadpool_get_num_threads(void);
+
+// Run task(arg, index) for index = 0, ..., ntasks-1 using the worker threads and the calling thread, and wait until all tasks are done.
+// Tasks are started in increasing order of index. If the pool is busy with a call from another thread, the tasks are run sequentially.
+void threadpool_run(threadpool_task_t task, void* arg, unsigned int ntasks);
+
+
+#endif
@@ -27,10 +27,25 @@
 #endif
 
 
+static unsigned char euler_is_sqr(const felm_t ma)
+{ // Returns 1 if a is a square in GF(p751) (also for a = 0), 0 otherwise, using Euler's criterion a^((p-1)/2) = 1
+    felm_t t, one = {0};
+
+    fpcopy751(ma, t);
+    fpinv751_chain_mont(t);                                     // t = a^((p-3)/4)
+    fpsqr751_mont(t, t);
+    fpmul751_mont(ma, t, t);                                    // t = a^((p-1)/2)
+    from_mont(t, t);
+    if (compare_words(t, one, NWORDS_FIELD) == 0) return 1;
+    one[0] = 1;
+    return (compare_words(t, one, NWORDS_FIELD) == 0);
+}
+
+
 bool fp_test()
 { // Tests for the field arithmetic
     bool OK = true;
-    int n, passed;
+    int i, n, passed;
     felm_t a, b, c, d, e, f, ma, mb, mc, md, me, mf;
 
     printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
@@ -187,6 +202,36 @@ bool fp_test()
     if (passed==1) printf("  GF(p) inversion tests............................................ PASSED");
     else { printf("  GF(p) inversion tests... FAILED"); printf("\n"); return false; }
     printf("\n");
+
+    // Square test over the prime p751, compared with Euler's criterion
+    passed = 1;
+    fpzero751(a); fpzero751(b); b[0] = 1;
+    fpsub751(a, b, c); fpcorrection751(c);                      // c = p-1
+    for (n=0; n<2*NBITS_FIELD+256; n++)
+    {
+        fpzero751(a);
+        if (n < 256) {
+            a[0] = (digit_t)n;                                  // a = 0,...,255
+        } else if (n < 256+NBITS_FIELD) {
+            for (i = 0; i < n-256; i++) a[i/RADIX] |= (digit_t)1 << (i%RADIX);    // a = 2^k-1, k = 0,...,NBITS_FIELD-1
+        } else {
+            fprandom751_test(a);
+            if (n & 1) {
+                for (i = 1+(n/2)%(NWORDS_FIELD-1); i < NWORDS_FIELD; i++) a[i] = 0;    // Top words of a are zero
+            }
+        }
+        if (is_sqr_fp751(a) != euler_is_sqr(a)) { passed=0; break; }
+        if (n == 0 && is_sqr_fp751(c) != euler_is_sqr(c)) { passed=0; break; }
+
+        fprandom751_test(a);
+        to_mont(a, ma);
+        fpsqr751_mont(ma, mb);                                  // b = a^2
+        fpcopy751(mb, mc); fpneg751(mc);                        // c = -a^2, a non-square since p = 3 mod 4
+        if (is_sqr_fp751(ma) != euler_is_sqr(ma) || is_sqr_fp751(mb) != 1 || is_sqr_fp751(mc) != 0) { passed=0; break; }
+    }
+    if (passed==1) printf("  GF(p) square tests .............................................. PASSED");
+    else { printf("  GF(p) square tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
     
     return OK;
 }
@@ -344,6 +389,26 @@ bool fp2_test()
     if (passed==1) printf("  GF(p^2) inversion tests.......................................... PASSED");
     else { printf("  GF(p^2) inversion tests... FAILED"); printf("\n"); return false; }
     printf("\n");
+
+    // Square test over GF(p751^2), compared with Euler's criterion on the norm
+    passed = 1;
+    do {
+        fp2random751_test((digit_t*)a);
+        to_fp2mont(a, mc);                                      // c = a non-square
+        fpsqr751_mont(mc[0], me[0]); fpsqr751_mont(mc[1], me[1]); fpadd751(me[0], me[1], me[0]);
+    } while (euler_is_sqr(me[0]) == 1);
+    for (n=0; n<TEST_LOOPS; n++)
+    {
+        fp2random751_test((digit_t*)a);
+        to_fp2mont(a, ma);
+        fpsqr751_mont(ma[0], me[0]); fpsqr751_mont(ma[1], me[1]); fpadd751(me[0], me[1], me[0]);    // e = a0^2 + a1^2
+        fp2sqr751_mont(ma, mb);                                 // b = a^2
+        fp2mul751_mont(mb, mc, md);                             // d = a^2*c
+        if (is_sqr_fp2_751(ma) != euler_is_sqr(me[0]) || is_sqr_fp2_751(mb) != 1 || is_sqr_fp2_751(md) != 0) { passed=0; break; }
+    }
+    if (passed==1) printf("  GF(p^2) square tests ............................................ PASSED");
+    else { printf("  GF(p^2) square tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
     
     return OK;
 }
@@ -398,6 +463,18 @@ bool fp_run()
     printf("  GF(p) multiplication runs in .................................... %7lld ", cycles/BENCH_LOOPS); print_unit;
     printf("\n");
 
+    // GF(p) squaring using p751
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        fpsqr751_mont(a, c);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  GF(p) squaring runs in .......................................... %7lld ", cycles/BENCH_LOOPS); print_unit;
+    printf("\n");
+
     // GF(p) reduction using p751
     cycles = 0;
     for (n=0; n<BENCH_LOOPS; n++)
@@ -421,7 +498,7 @@ bool fp_run()
         cycles2 = cpucycles();
         cycles = cycles+(cycles2-cycles1);
     }
-    printf("  GF(p) inversion (exponentiation) runs in ........................ %7lld ", cycles/SMALL_BENCH_LOOPS); print_unit;
+    printf("  GF(p) inversion runs in ......................................... %7lld ", cycles/SMALL_BENCH_LOOPS); print_unit;
     printf("\n");
     
     return OK;
@@ -497,13 +574,256 @@ bool fp2_run()
         cycles2 = cpucycles();
         cycles = cycles+(cycles2-cycles1);
     }
-    printf("  GF(p^2) inversion (exponentiation) runs in ...................... %7lld ", cycles/SMALL_BENCH_LOOPS); print_unit;
+    printf("  GF(p^2) inversion runs in ....................................... %7lld ", cycles/SMALL_BENCH_LOOPS); print_unit;
     printf("\n"); 
     
     return OK;
 }
 
 
+#if defined(_IFMA_)
+bool fp2_x8_test()
+{ // Tests for the 8-way arithmetic over GF(p751^2), compared against the scalar functions
+    bool OK = true;
+    int n, k, r, passed;
+    f2elm_t a[8], b[8], c[8], d[8];
+    f2elm_x8_t va, vb, vc, vd;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing 8-way arithmetic over GF(p751^2) using AVX-512 IFMA: \n\n"); 
+    if (!__builtin_cpu_supports("avx512ifma")) {
+        printf("  AVX-512 IFMA is not supported by this processor, tests skipped\n");
+        return OK;
+    }
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS; n++)
+    {
+        for (k=0; k<8; k++) {
+            fp2random751_test((digit_t*)a[k]); fp2random751_test((digit_t*)b[k]);
+        }
+        fp2_pack751_x8(a, va);
+        fp2_unpack751_x8(va, c);                                // c = a
+        for (k=0; k<8; k++) {
+            fp2correction751(c[k]);
+            if (compare_words((digit_t*)a[k], (digit_t*)c[k], 2*NWORDS_FIELD)!=0) { passed=0; break; }
+        }
+        if (passed==0) break;
+
+        fp2_pack751_x8(b, vb);
+        fp2add751_x8(va, vb, vc);                               // c = a+b
+        fp2_unpack751_x8(vc, c);
+        for (k=0; k<8; k++) {
+            fp2add751(a[k], b[k], d[k]);
+            fp2correction751(c[k]); fp2correction751(d[k]);
+            if (compare_words((digit_t*)c[k], (digit_t*)d[k], 2*NWORDS_FIELD)!=0) { passed=0; break; }
+        }
+        if (passed==0) break;
+
+        fp2sub751_x8(va, vb, vc);                               // c = a-b
+        fp2_unpack751_x8(vc, c);
+        for (k=0; k<8; k++) {
+            fp2sub751(a[k], b[k], d[k]);
+            fp2correction751(c[k]); fp2correction751(d[k]);
+            if (compare_words((digit_t*)c[k], (digit_t*)d[k], 2*NWORDS_FIELD)!=0) { passed=0; break; }
+        }
+        if (passed==0) break;
+    }
+    if (passed==1) printf("  8-way GF(p^2) addition and subtraction tests .................... PASSED");
+    else { printf("  8-way GF(p^2) addition and subtraction tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS; n++)
+    {
+        for (k=0; k<8; k++) {
+            fp2random751_test((digit_t*)a[k]); fp2random751_test((digit_t*)b[k]);
+        }
+        fp2zero751(a[7]);                                       // Include a zero lane
+        fp2_pack751_x8(a, va);
+        fp2_pack751_x8(b, vb);
+        fp2mul751_mont_x8(va, vb, vc);                          // c = a*b
+        fp2_unpack751_x8(vc, c);
+        for (k=0; k<8; k++) {
+            fp2mul751_mont(a[k], b[k], d[k]);
+            fp2correction751(c[k]); fp2correction751(d[k]);
+            if (compare_words((digit_t*)c[k], (digit_t*)d[k], 2*NWORDS_FIELD)!=0) { passed=0; break; }
+        }
+        if (passed==0) break;
+    }
+    if (passed==1) printf("  8-way GF(p^2) multiplication tests .............................. PASSED");
+    else { printf("  8-way GF(p^2) multiplication tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS; n++)
+    {
+        for (k=0; k<8; k++) {
+            fp2random751_test((digit_t*)a[k]);
+        }
+        fp2_pack751_x8(a, va);
+        fp2sqr751_mont_x8(va, vc);                              // c = a^2
+        fp2_unpack751_x8(vc, c);
+        for (k=0; k<8; k++) {
+            fp2sqr751_mont(a[k], d[k]);
+            fp2correction751(c[k]); fp2correction751(d[k]);
+            if (compare_words((digit_t*)c[k], (digit_t*)d[k], 2*NWORDS_FIELD)!=0) { passed=0; break; }
+        }
+        if (passed==0) break;
+    }
+    if (passed==1) printf("  8-way GF(p^2) squaring tests .................................... PASSED");
+    else { printf("  8-way GF(p^2) squaring tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS; n++)
+    {
+        for (k=0; k<8; k++) {
+            fp2random751_test((digit_t*)a[k]); fp2random751_test((digit_t*)b[k]);
+            if (k & 1) {                                        // Odd lanes start with coordinates in [p, 2p)
+                fpneg751(a[k][0]); fpneg751(a[k][1]); fpneg751(b[k][0]); fpneg751(b[k][1]);
+            }
+        }
+        fp2_pack751_x8(a, va);
+        fp2_pack751_x8(b, vb);
+        for (r=0; r<16; r++) {                                  // Outputs in [0, 2p) are fed back as inputs
+            fp2mul751_mont_x8(va, vb, vc);                      // c = a*b
+            fp2sqr751_mont_x8(vc, vd);                          // d = c^2
+            fp2add751_x8(vc, vd, va);                           // a = c+d
+            fp2sub751_x8(vd, va, vb);                           // b = d-a
+            for (k=0; k<8; k++) {
+                fp2mul751_mont(a[k], b[k], c[k]);
+                fp2sqr751_mont(c[k], d[k]);
+                fp2add751(c[k], d[k], a[k]);
+                fp2sub751(d[k], a[k], b[k]);
+            }
+        }
+        fp2_unpack751_x8(va, c);
+        fp2_unpack751_x8(vb, d);
+        for (k=0; k<8; k++) {
+            fp2correction751(a[k]); fp2correction751(b[k]); fp2correction751(c[k]); fp2correction751(d[k]);
+            if (compare_words((digit_t*)a[k], (digit_t*)c[k], 2*NWORDS_FIELD)!=0 || compare_words((digit_t*)b[k], (digit_t*)d[k], 2*NWORDS_FIELD)!=0) { passed=0; break; }
+        }
+        if (passed==0) break;
+    }
+    if (passed==1) printf("  8-way GF(p^2) chained operation tests ........................... PASSED");
+    else { printf("  8-way GF(p^2) chained operation tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+    
+    return OK;
+}
+
+
+bool fp2_x8_run()
+{
+    bool OK = true;
+    int n, k;
+    unsigned long long cycles, cycles1, cycles2;
+    f2elm_t a[8];
+    f2elm_x8_t va, vb, vc;
+        
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Benchmarking 8-way arithmetic over GF(p751^2) using AVX-512 IFMA (cycles per 8 operations): \n\n"); 
+    if (!__builtin_cpu_supports("avx512ifma")) {
+        printf("  AVX-512 IFMA is not supported by this processor, benchmarks skipped\n");
+        return OK;
+    }
+    
+    for (k=0; k<8; k++) {
+        fp2random751_test((digit_t*)a[k]);
+    }
+    fp2_pack751_x8(a, va); 
+    fp2_pack751_x8(a, vb);
+
+    // 8-way GF(p^2) addition
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        fp2add751_x8(va, vb, vc);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  8-way GF(p^2) addition runs in .................................. %7lld ", cycles/BENCH_LOOPS); print_unit;
+    printf("\n");
+
+    // 8-way GF(p^2) multiplication
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        fp2mul751_mont_x8(va, vb, vc);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  8-way GF(p^2) multiplication runs in ............................ %7lld ", cycles/BENCH_LOOPS); print_unit;
+    printf("\n");
+
+    // 8-way GF(p^2) squaring
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        fp2sqr751_mont_x8(va, vc);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  8-way GF(p^2) squaring runs in .................................. %7lld ", cycles/BENCH_LOOPS); print_unit;
+    printf("\n");
+    
+    return OK;
+}
+#endif
+
+
+#if defined(_MULX_) && defined(_ADX_) && !defined(_DISPATCH_)
+bool ecchain_test()
+{ // Tests for the x64 assembly doubling and tripling chains, compared against e calls to xDBL and xTPL for e = 1 to 64
+    bool OK = true;
+    int n, e, passed;
+    f2elm_t A24plus, A24minus, C24;
+    point_proj_t P, Q, R;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing doubling and tripling chains over GF(p751^2) using x64 assembly: \n\n"); 
+
+    passed = 1;
+    for (e=1; e<=64; e++)
+    {
+        fp2random751_test((digit_t*)A24plus); fp2random751_test((digit_t*)C24); fp2random751_test((digit_t*)P->X); fp2random751_test((digit_t*)P->Z);
+
+        copy_words((digit_t*)P, (digit_t*)Q, 2*2*NWORDS_FIELD);
+        for (n=0; n<e; n++) xDBL(Q, Q, A24plus, C24);                       // Q = [2^e]P
+        xDBLe751_asm((digit_t*)P, (digit_t*)R, (digit_t*)A24plus, (digit_t*)C24, e);
+        if (compare_words((digit_t*)Q, (digit_t*)R, 2*2*NWORDS_FIELD)!=0) { passed=0; break; }
+        xDBLe751_asm((digit_t*)P, (digit_t*)P, (digit_t*)A24plus, (digit_t*)C24, e);    // In place
+        if (compare_words((digit_t*)Q, (digit_t*)P, 2*2*NWORDS_FIELD)!=0) { passed=0; break; }
+    }
+    if (passed==1) printf("  Doubling chain tests ............................................ PASSED");
+    else { printf("  Doubling chain tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
+    passed = 1;
+    for (e=1; e<=64; e++)
+    {
+        fp2random751_test((digit_t*)A24minus); fp2random751_test((digit_t*)A24plus); fp2random751_test((digit_t*)P->X); fp2random751_test((digit_t*)P->Z);
+
+        copy_words((digit_t*)P, (digit_t*)Q, 2*2*NWORDS_FIELD);
+        for (n=0; n<e; n++) xTPL(Q, Q, A24minus, A24plus);                  // Q = [3^e]P
+        xTPLe751_asm((digit_t*)P, (digit_t*)R, (digit_t*)A24minus, (digit_t*)A24plus, e);
+        if (compare_words((digit_t*)Q, (digit_t*)R, 2*2*NWORDS_FIELD)!=0) { passed=0; break; }
+        xTPLe751_asm((digit_t*)P, (digit_t*)P, (digit_t*)A24minus, (digit_t*)A24plus, e);   // In place
+        if (compare_words((digit_t*)Q, (digit_t*)P, 2*2*NWORDS_FIELD)!=0) { passed=0; break; }
+    }
+    if (passed==1) printf("  Tripling chain tests ............................................ PASSED");
+    else { printf("  Tripling chain tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+    
+    return OK;
+}
+#endif
+
+
 bool ecisog_run()
 {
     bool OK = true;
@@ -610,6 +930,13 @@ int main()
 
     OK = OK && fp2_test();         // Test arithmetic functions over GF(p751^2)
     OK = OK && fp2_run();          // Benchmark arithmetic functions over GF(p751^2)
+#if defined(_IFMA_)
+    OK = OK && fp2_x8_test();      // Test 8-way arithmetic functions over GF(p751^2)
+    OK = OK && fp2_x8_run();       // Benchmark 8-way arithmetic functions over GF(p751^2)
+#endif
+#if defined(_MULX_) && defined(_ADX_) && !defined(_DISPATCH_)
+    OK = OK && ecchain_test();     // Test x64 assembly doubling and tripling chains over GF(p751^2)
+#endif
     
     OK = OK && ecisog_run();       // Benchmark elliptic curve and isogeny functions
 
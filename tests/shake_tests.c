@@ -0,0 +1,169 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: testing code for the 4-way SHAKE256
+*           Compares each lane of shake256x4 and each output of shake256_batch and shake256_batch_concat with shake256,
+*           for input lengths around multiples of the 136-byte rate and several output lengths. Built with -D _SHAKE_AVX2_ against the AVX2
+*           permutation (shake_tests-avx2), and without it against the scalar fallback (shake_tests-scalar).
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "../src/sha3/fips202x4.h"
+
+
+#define MAX_BATCH       9                    // Largest batch count of shake256_batch, covering two 4-way calls and a remainder
+#define GUARD_BYTES    16                    // Bytes past each output that must be left untouched
+#define GUARD_VALUE  0xA5
+
+static const unsigned long long inlens[] = { 0, 1, 8, 135, 136, 137, 271, 272, 273, 408 };
+static const unsigned long long outlens[] = { 0, 1, 32, 135, 136, 137, 272, 300 };
+static const unsigned long long prefixlens[] = { 0, 16, 135, 136, 200 };
+
+#define NINLENS     (sizeof(inlens)/sizeof(inlens[0]))
+#define NOUTLENS    (sizeof(outlens)/sizeof(outlens[0]))
+#define NPREFIXLENS (sizeof(prefixlens)/sizeof(prefixlens[0]))
+#define MAX_PREFIXLEN 200
+#define STRIDE_GAP    3                      // Bytes between consecutive inputs of shake256_batch_concat
+#define MAX_INLEN   408
+#define MAX_OUTLEN  300
+
+
+static bool guard_intact(const unsigned char* guard)
+{ // Checks that the GUARD_BYTES bytes at guard still hold GUARD_VALUE
+    unsigned int i;
+
+    for (i = 0; i < GUARD_BYTES; i++) {
+        if (guard[i] != GUARD_VALUE) return false;
+    }
+    return true;
+}
+
+
+static bool shake256x4_test(void)
+{ // Each lane of shake256x4 against shake256
+    unsigned char in[4][MAX_INLEN], out[4][MAX_OUTLEN+GUARD_BYTES], ref[MAX_OUTLEN];
+    unsigned int i, j, k, n;
+
+    for (i = 0; i < NINLENS; i++) {
+        for (k = 0; k < NOUTLENS; k++) {
+            for (j = 0; j < 4; j++) {
+                for (n = 0; n < inlens[i]; n++) in[j][n] = (unsigned char)rand();
+            }
+            memset(out, GUARD_VALUE, sizeof(out));
+            shake256x4(out[0], out[1], out[2], out[3], outlens[k], in[0], in[1], in[2], in[3], inlens[i]);
+            for (j = 0; j < 4; j++) {
+                shake256(ref, outlens[k], in[j], inlens[i]);
+                if (memcmp(out[j], ref, outlens[k]) != 0 || !guard_intact(out[j] + outlens[k])) {
+                    printf("\n  Lane %u differs from shake256 for inlen = %llu, outlen = %llu\n", j, inlens[i], outlens[k]);
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+
+static bool shake256_batch_test(void)
+{ // Each output of shake256_batch against shake256, for batch counts 1 to MAX_BATCH
+    unsigned char in[MAX_BATCH*MAX_INLEN], out[MAX_BATCH*MAX_OUTLEN+GUARD_BYTES], ref[MAX_OUTLEN];
+    unsigned int i, j, k, count;
+
+    for (count = 1; count <= MAX_BATCH; count++) {
+        for (i = 0; i < NINLENS; i++) {
+            for (k = 0; k < NOUTLENS; k++) {
+                for (j = 0; j < count*inlens[i]; j++) in[j] = (unsigned char)rand();
+                memset(out, GUARD_VALUE, sizeof(out));
+                shake256_batch(out, outlens[k], in, inlens[i], count);
+                for (j = 0; j < count; j++) {
+                    shake256(ref, outlens[k], in + j*inlens[i], inlens[i]);
+                    if (memcmp(out + j*outlens[k], ref, outlens[k]) != 0) {
+                        printf("\n  Output %u of %u differs from shake256 for inlen = %llu, outlen = %llu\n", j, count, inlens[i], outlens[k]);
+                        return false;
+                    }
+                }
+                if (!guard_intact(out + count*outlens[k])) {
+                    printf("\n  Write past the %u outputs for inlen = %llu, outlen = %llu\n", count, inlens[i], outlens[k]);
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+
+static bool shake256_batch_concat_test(void)
+{ // Each output of shake256_batch_concat against shake256 on the concatenated prefix and input, for batch counts 1 to MAX_BATCH
+    unsigned char prefix[MAX_BATCH*MAX_PREFIXLEN], in[MAX_BATCH*(MAX_INLEN+STRIDE_GAP)], out[MAX_BATCH*MAX_OUTLEN+GUARD_BYTES];
+    unsigned char cat[MAX_PREFIXLEN+MAX_INLEN], ref[MAX_OUTLEN];
+    unsigned long long plen, stride;
+    unsigned int i, j, k, p, count;
+
+    for (count = 1; count <= MAX_BATCH; count++) {
+        for (p = 0; p < NPREFIXLENS; p++) {
+            plen = prefixlens[p];
+            for (i = 0; i < NINLENS; i++) {
+                stride = inlens[i] + STRIDE_GAP;
+                for (k = 0; k < NOUTLENS; k++) {
+                    for (j = 0; j < count*plen; j++) prefix[j] = (unsigned char)rand();
+                    for (j = 0; j < count*stride; j++) in[j] = (unsigned char)rand();
+                    memset(out, GUARD_VALUE, sizeof(out));
+                    shake256_batch_concat(out, outlens[k], prefix, plen, in, inlens[i], stride, count);
+                    for (j = 0; j < count; j++) {
+                        memcpy(cat, prefix + j*plen, plen);
+                        memcpy(cat + plen, in + j*stride, inlens[i]);
+                        shake256(ref, outlens[k], cat, plen + inlens[i]);
+                        if (memcmp(out + j*outlens[k], ref, outlens[k]) != 0) {
+                            printf("\n  Output %u of %u differs from shake256 for prefixlen = %llu, inlen = %llu, outlen = %llu\n", j, count, plen, inlens[i], outlens[k]);
+                            return false;
+                        }
+                    }
+                    if (!guard_intact(out + count*outlens[k])) {
+                        printf("\n  Write past the %u outputs for prefixlen = %llu, inlen = %llu, outlen = %llu\n", count, plen, inlens[i], outlens[k]);
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+
+int main(void)
+{
+    bool OK = true;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n");
+#if defined(_SHAKE_AVX2_)
+    printf("Testing 4-way SHAKE256 with the AVX2 permutation: \n\n");
+    if (!__builtin_cpu_supports("avx2")) {
+        printf("  AVX2 is not supported by this processor, tests skipped\n");
+        return 0;
+    }
+#else
+    printf("Testing 4-way SHAKE256 with the scalar permutation: \n\n");
+#endif
+
+    OK = shake256x4_test();
+    if (OK) printf("  SHAKE256 4-way tests ............................................ PASSED\n");
+    else { printf("  SHAKE256 4-way tests... FAILED\n"); return 1; }
+
+    OK = shake256_batch_test();
+    if (OK) printf("  SHAKE256 batch tests ............................................ PASSED\n");
+    else { printf("  SHAKE256 batch tests... FAILED\n"); return 1; }
+
+    OK = shake256_batch_concat_test();
+    if (OK) printf("  SHAKE256 batch concatenation tests .............................. PASSED\n");
+    else { printf("  SHAKE256 batch concatenation tests... FAILED\n"); return 1; }
+
+    return 0;
+}
@@ -22,5 +22,7 @@
 #define EphemeralKeyGeneration_B      EphemeralKeyGeneration_B_SIDHp751_Compressed
 #define EphemeralSecretAgreement_A    EphemeralSecretAgreement_A_SIDHp751_Compressed
 #define EphemeralSecretAgreement_B    EphemeralSecretAgreement_B_SIDHp751_Compressed
+#define tables_load                   tables_load_SIDHp751_compressed
+#define TABLES_BLOB_FILE              "src/P751/P751_compressed_tables.bin"
 
 #include "test_sidh.c"
\ No newline at end of file
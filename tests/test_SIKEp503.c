@@ -19,5 +19,14 @@
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp503
 #define crypto_kem_enc                crypto_kem_enc_SIKEp503
 #define crypto_kem_dec                crypto_kem_dec_SIKEp503
+#define crypto_kem_enc_batch          crypto_kem_enc_batch_SIKEp503
+#define crypto_kem_dec_batch          crypto_kem_dec_batch_SIKEp503
+#define crypto_kem_expand_pk          crypto_kem_expand_pk_SIKEp503
+#define crypto_kem_enc_expanded       crypto_kem_enc_expanded_SIKEp503
+#define crypto_kem_expand_sk          crypto_kem_expand_sk_SIKEp503
+#define crypto_kem_dec_expanded       crypto_kem_dec_expanded_SIKEp503
+#define crypto_kem_pool_start         crypto_kem_pool_start_SIKEp503
+#define crypto_kem_pool_stop          crypto_kem_pool_stop_SIKEp503
+#define crypto_kem_keypair_pooled     crypto_kem_keypair_pooled_SIKEp503
 
 #include "test_sike.c"
\ No newline at end of file
@@ -19,5 +19,10 @@
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp503_compressed
 #define crypto_kem_enc                crypto_kem_enc_SIKEp503_compressed
 #define crypto_kem_dec                crypto_kem_dec_SIKEp503_compressed
+#define crypto_kem_enc_batch          crypto_kem_enc_batch_SIKEp503_compressed
+#define crypto_kem_dec_batch          crypto_kem_dec_batch_SIKEp503_compressed
+#define crypto_kem_pool_start         crypto_kem_pool_start_SIKEp503_compressed
+#define crypto_kem_pool_stop          crypto_kem_pool_stop_SIKEp503_compressed
+#define crypto_kem_keypair_pooled     crypto_kem_keypair_pooled_SIKEp503_compressed
 
 #include "test_sike.c"
@@ -19,5 +19,10 @@
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp610_compressed
 #define crypto_kem_enc                crypto_kem_enc_SIKEp610_compressed
 #define crypto_kem_dec                crypto_kem_dec_SIKEp610_compressed
+#define crypto_kem_enc_batch          crypto_kem_enc_batch_SIKEp610_compressed
+#define crypto_kem_dec_batch          crypto_kem_dec_batch_SIKEp610_compressed
+#define crypto_kem_pool_start         crypto_kem_pool_start_SIKEp610_compressed
+#define crypto_kem_pool_stop          crypto_kem_pool_stop_SIKEp610_compressed
+#define crypto_kem_keypair_pooled     crypto_kem_keypair_pooled_SIKEp610_compressed
 
 #include "test_sike.c"
@@ -112,6 +112,13 @@ int main()
 {
     int Status = PASSED;
     
+#if defined(_TABLE_BLOB_) && defined(TABLES_BLOB_FILE)
+    if (tables_load(TABLES_BLOB_FILE) != 0) {      // The path is ignored with USE_TABLE_BLOB=INCBIN
+        printf("\n\n   Error detected: the tables of key compression could not be loaded from %s \n\n", TABLES_BLOB_FILE);
+        return FAILED;
+    }
+#endif
+
     Status = cryptotest_kex();             // Test key exchange
     if (Status != PASSED) {
         printf("\n\n   Error detected: KEX_ERROR_SHARED_KEY \n\n");
@@ -30,6 +30,30 @@
     #define BENCH_LOOPS     1000    
 #endif
 
+#ifdef DO_VALGRIND_CHECK
+    #define BATCH_TEST_SIZE    2
+#else
+    #define BATCH_TEST_SIZE   20      // Number of operations per batched test, spanning more than one internal chunk
+#endif
+
+#if defined(GENERIC_IMPLEMENTATION) || (OS_TARGET == OS_WIN) || (TARGET == TARGET_ARM) 
+    #define BATCH_BENCH_LOOPS  1      // Number of batches per batched bench 
+#else
+    #define BATCH_BENCH_LOOPS 10    
+#endif
+#define BATCH_BENCH_MAX       64      // Largest batch size benchmarked
+
+#if defined(_THREADS_)
+#if defined(GENERIC_IMPLEMENTATION) || (OS_TARGET == OS_WIN) || (TARGET == TARGET_ARM) 
+    #define THREADS_BENCH_LOOPS  5    // Number of iterations per bench with multiple threads
+#else
+    #define THREADS_BENCH_LOOPS 100    
+#endif
+#define THREADS_TEST_MAX      8      // Largest number of threads tested
+#define THREADS_BENCH_MAX     8      // Largest number of threads benchmarked
+#define POOL_TEST_SIZE        8      // Number of keypairs taken from the pool, more than the high water mark
+#endif
+
 
 int cryptotest_kem()
 { // Testing KEM
@@ -93,6 +117,268 @@ int cryptotest_kem()
 }
 
 
+int cryptotest_kem_batch()
+{ // Testing batched KEM
+    unsigned int i, j;
+    unsigned char sk[BATCH_TEST_SIZE*CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char pk[BATCH_TEST_SIZE*CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char ct[BATCH_TEST_SIZE*CRYPTO_CIPHERTEXTBYTES] = {0};
+    unsigned char ss[BATCH_TEST_SIZE*CRYPTO_BYTES] = {0};
+    unsigned char ss_[BATCH_TEST_SIZE*CRYPTO_BYTES] = {0};
+    unsigned char ss1[CRYPTO_BYTES] = {0};
+    unsigned char bytes[4];
+    uint32_t* pos = (uint32_t*)bytes;
+    bool passed = true;
+
+    // A few distinct key pairs, reused cyclically across the batch
+    for (i = 0; i < BATCH_TEST_SIZE; i++) {
+        if (i < 4) {
+            crypto_kem_keypair(&pk[i*CRYPTO_PUBLICKEYBYTES], &sk[i*CRYPTO_SECRETKEYBYTES]);
+        } else {
+            memcpy(&pk[i*CRYPTO_PUBLICKEYBYTES], &pk[(i%4)*CRYPTO_PUBLICKEYBYTES], CRYPTO_PUBLICKEYBYTES);
+            memcpy(&sk[i*CRYPTO_SECRETKEYBYTES], &sk[(i%4)*CRYPTO_SECRETKEYBYTES], CRYPTO_SECRETKEYBYTES);
+        }
+    }
+
+    // Batched encapsulation must agree with single decapsulation, and batched decapsulation with both
+    crypto_kem_enc_batch(ct, ss, pk, BATCH_TEST_SIZE);
+    crypto_kem_dec_batch(ss_, ct, sk, BATCH_TEST_SIZE);
+    for (i = 0; i < BATCH_TEST_SIZE && passed == true; i++) {
+        crypto_kem_dec(ss1, &ct[i*CRYPTO_CIPHERTEXTBYTES], &sk[i*CRYPTO_SECRETKEYBYTES]);
+#ifdef DO_VALGRIND_CHECK
+        VALGRIND_MAKE_MEM_DEFINED(ss, sizeof(ss));
+        VALGRIND_MAKE_MEM_DEFINED(ss_, sizeof(ss_));
+        VALGRIND_MAKE_MEM_DEFINED(ss1, CRYPTO_BYTES);
+#endif
+        if (memcmp(&ss[i*CRYPTO_BYTES], ss1, CRYPTO_BYTES) != 0 || memcmp(&ss_[i*CRYPTO_BYTES], ss1, CRYPTO_BYTES) != 0) {
+            passed = false;
+        }
+    }
+
+    // Changing one bit of a ciphertext must only affect its own shared secret
+    if (passed == true) {
+        randombytes(bytes, 4);
+        j = *pos % BATCH_TEST_SIZE;
+        *pos = (*pos >> 8) % CRYPTO_CIPHERTEXTBYTES;
+        ct[j*CRYPTO_CIPHERTEXTBYTES + *pos] ^= 1;
+        crypto_kem_dec_batch(ss_, ct, sk, BATCH_TEST_SIZE);
+        crypto_kem_dec(ss1, &ct[j*CRYPTO_CIPHERTEXTBYTES], &sk[j*CRYPTO_SECRETKEYBYTES]);
+#ifdef DO_VALGRIND_CHECK
+        VALGRIND_MAKE_MEM_DEFINED(ss_, sizeof(ss_));
+        VALGRIND_MAKE_MEM_DEFINED(ss1, CRYPTO_BYTES);
+#endif
+        for (i = 0; i < BATCH_TEST_SIZE; i++) {
+            if ((i == j && (memcmp(&ss_[i*CRYPTO_BYTES], ss1, CRYPTO_BYTES) != 0 || memcmp(&ss_[i*CRYPTO_BYTES], &ss[i*CRYPTO_BYTES], CRYPTO_BYTES) == 0)) ||
+                (i != j && memcmp(&ss_[i*CRYPTO_BYTES], &ss[i*CRYPTO_BYTES], CRYPTO_BYTES) != 0)) {
+                passed = false;
+                break;
+            }
+        }
+    }
+
+    if (passed == true) printf("  Batched KEM tests ............................................ PASSED");
+    else { printf("  Batched KEM tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+
+    return PASSED;
+}
+
+
+#if defined(crypto_kem_enc_expanded)
+
+int cryptotest_kem_expanded_pk()
+{ // Testing encapsulation with expanded public keys
+    unsigned int i;
+    unsigned char sk[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char ct[CRYPTO_CIPHERTEXTBYTES] = {0};
+    unsigned char ss[CRYPTO_BYTES] = {0};
+    unsigned char ss_[CRYPTO_BYTES] = {0};
+    uint64_t epk[(CRYPTO_EXPANDEDPUBLICKEYBYTES+7)/8] = {0};
+    bool passed = true;
+
+    for (i = 0; i < TEST_LOOPS; i++) 
+    {
+        if (i % 2 == 0) {
+            crypto_kem_keypair(pk, sk);
+            crypto_kem_expand_pk((unsigned char*)epk, pk);
+        }
+        crypto_kem_enc_expanded(ct, ss, (unsigned char*)epk);
+        crypto_kem_dec(ss_, ct, sk);
+#ifdef DO_VALGRIND_CHECK
+        VALGRIND_MAKE_MEM_DEFINED(ss, CRYPTO_BYTES);
+        VALGRIND_MAKE_MEM_DEFINED(ss_, CRYPTO_BYTES);
+#endif
+        if (memcmp(ss, ss_, CRYPTO_BYTES) != 0) {
+            passed = false;
+            break;
+        }
+    }
+
+    if (passed == true) printf("  KEM tests with expanded public keys .......................... PASSED");
+    else { printf("  KEM tests with expanded public keys ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+
+    return PASSED;
+}
+
+#endif
+
+
+#if defined(crypto_kem_dec_expanded)
+
+int cryptotest_kem_expanded()
+{ // Testing decapsulation with expanded secret keys
+    unsigned int i;
+    unsigned char sk[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char ct[CRYPTO_CIPHERTEXTBYTES] = {0};
+    unsigned char ss[CRYPTO_BYTES] = {0};
+    unsigned char ss_[CRYPTO_BYTES] = {0};
+    uint64_t esk[(CRYPTO_EXPANDEDSECRETKEYBYTES+7)/8] = {0};
+    unsigned char bytes[4];
+    uint32_t* pos = (uint32_t*)bytes;
+    bool passed = true;
+
+    crypto_kem_keypair(pk, sk);
+    crypto_kem_expand_sk((unsigned char*)esk, sk);
+    for (i = 0; i < TEST_LOOPS; i++) 
+    {
+        crypto_kem_enc(ct, ss, pk);
+        crypto_kem_dec_expanded(ss_, ct, (unsigned char*)esk);
+#ifdef DO_VALGRIND_CHECK
+        VALGRIND_MAKE_MEM_DEFINED(ss, CRYPTO_BYTES);
+        VALGRIND_MAKE_MEM_DEFINED(ss_, CRYPTO_BYTES);
+#endif
+        if (memcmp(ss, ss_, CRYPTO_BYTES) != 0) {
+            passed = false;
+            break;
+        }
+
+        // An invalid ciphertext must produce the same implicit rejection as crypto_kem_dec
+        randombytes(bytes, 4);
+        *pos %= CRYPTO_CIPHERTEXTBYTES;
+        ct[*pos] ^= 1;
+        crypto_kem_dec(ss, ct, sk);
+        crypto_kem_dec_expanded(ss_, ct, (unsigned char*)esk);
+#ifdef DO_VALGRIND_CHECK
+        VALGRIND_MAKE_MEM_DEFINED(ss, CRYPTO_BYTES);
+        VALGRIND_MAKE_MEM_DEFINED(ss_, CRYPTO_BYTES);
+#endif
+        if (memcmp(ss, ss_, CRYPTO_BYTES) != 0) {
+            passed = false;
+            break;
+        }
+    }
+
+    if (passed == true) printf("  KEM tests with expanded secret keys .......................... PASSED");
+    else { printf("  KEM tests with expanded secret keys ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+
+    return PASSED;
+}
+
+#endif
+
+
+#if defined(_THREADS_)
+
+int cryptotest_kem_threads()
+{ // Testing KEM with parallel isogeny evaluation
+    unsigned int i;
+    unsigned char sk[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char ct[CRYPTO_CIPHERTEXTBYTES] = {0};
+    unsigned char ss[CRYPTO_BYTES] = {0};
+    unsigned char ss_[CRYPTO_BYTES] = {0};
+    bool passed = true;
+
+    for (i = 0; i < TEST_LOOPS; i++) 
+    {
+        threadpool_set_num_threads(2 << (i % 3));    // Cycle through the strategies for 2, 4 and 8 threads
+        crypto_kem_keypair(pk, sk);
+        crypto_kem_enc(ct, ss, pk);
+        crypto_kem_dec(ss_, ct, sk);
+        if (memcmp(ss, ss_, CRYPTO_BYTES) != 0) {
+            passed = false;
+            break;
+        }
+
+        // Decapsulation with a single thread must produce the same shared secret
+        threadpool_set_num_threads(1);
+        crypto_kem_dec(ss_, ct, sk);
+        if (memcmp(ss, ss_, CRYPTO_BYTES) != 0) {
+            passed = false;
+            break;
+        }
+    }
+    threadpool_set_num_threads(1);
+
+    if (passed == true) printf("  KEM tests with up to %d threads ............................... PASSED", THREADS_TEST_MAX);
+    else { printf("  KEM tests with up to %d threads... FAILED", THREADS_TEST_MAX); printf("\n"); return FAILED; }
+    printf("\n"); 
+
+    return PASSED;
+}
+
+#endif
+
+
+#if defined(_THREADS_)
+
+int cryptotest_kem_pool()
+{ // Testing KEM with keypairs generated in the background
+    unsigned int i, j;
+    unsigned char sk[POOL_TEST_SIZE][CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char pk[POOL_TEST_SIZE][CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char ct[CRYPTO_CIPHERTEXTBYTES] = {0};
+    unsigned char ss[CRYPTO_BYTES] = {0};
+    unsigned char ss_[CRYPTO_BYTES] = {0};
+    bool passed = true;
+
+    if (crypto_kem_pool_start(2, 2, 4) != 0) {
+        passed = false;
+    }
+    // A running pool cannot be started again, invalid water marks are rejected
+    if (crypto_kem_pool_start(1, 2, 4) == 0 || crypto_kem_pool_start(1, 4, 4) == 0) {
+        passed = false;
+    }
+
+    // More keypairs than the high water mark, so that some of them may be generated synchronously
+    for (i = 0; i < POOL_TEST_SIZE && passed == true; i++) 
+    {
+        crypto_kem_keypair_pooled(pk[i], sk[i]);
+        crypto_kem_enc(ct, ss, pk[i]);
+        crypto_kem_dec(ss_, ct, sk[i]);
+        if (memcmp(ss, ss_, CRYPTO_BYTES) != 0) {
+            passed = false;
+        }
+        for (j = 0; j < i; j++) {
+            if (memcmp(pk[i], pk[j], CRYPTO_PUBLICKEYBYTES) == 0) {
+                passed = false;
+            }
+        }
+    }
+    crypto_kem_pool_stop();
+
+    // Once the pool is stopped, keypairs are generated synchronously
+    crypto_kem_keypair_pooled(pk[0], sk[0]);
+    crypto_kem_enc(ct, ss, pk[0]);
+    crypto_kem_dec(ss_, ct, sk[0]);
+    if (memcmp(ss, ss_, CRYPTO_BYTES) != 0) {
+        passed = false;
+    }
+
+    if (passed == true) printf("  KEM tests with keypairs from the pool ........................ PASSED");
+    else { printf("  KEM tests with keypairs from the pool... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+
+    return PASSED;
+}
+
+#endif
+
+
 int cryptorun_kem()
 { // Benchmarking key exchange
     unsigned int n;
@@ -134,19 +420,194 @@ int cryptorun_kem()
     printf("  Decapsulation runs in ........................................ %10lld ", cycles_decaps/BENCH_LOOPS); print_unit;
     printf("\n");
 
+#if defined(crypto_kem_enc_expanded)
+    uint64_t epk[(CRYPTO_EXPANDEDPUBLICKEYBYTES+7)/8] = {0};
+
+    crypto_kem_expand_pk((unsigned char*)epk, pk);
+    cycles_encaps = 0;
+    for (n = 0; n < BENCH_LOOPS; n++)
+    {
+        // Benchmarking encapsulation with an expanded public key
+        cycles1 = cpucycles();
+        crypto_kem_enc_expanded(ct, ss, (unsigned char*)epk);
+        cycles2 = cpucycles();
+        cycles_encaps = cycles_encaps+(cycles2-cycles1);
+    }
+
+    printf("  Encapsulation with expanded public key runs in ............... %10lld ", cycles_encaps/BENCH_LOOPS); print_unit;
+    printf("\n");
+#endif
+
+#if defined(crypto_kem_dec_expanded)
+    uint64_t esk[(CRYPTO_EXPANDEDSECRETKEYBYTES+7)/8] = {0};
+
+    crypto_kem_expand_sk((unsigned char*)esk, sk);
+    cycles_decaps = 0;
+    for (n = 0; n < BENCH_LOOPS; n++)
+    {
+        // Benchmarking decapsulation with an expanded secret key
+        cycles1 = cpucycles();
+        crypto_kem_dec_expanded(ss_, ct, (unsigned char*)esk);   
+        cycles2 = cpucycles();
+        cycles_decaps = cycles_decaps+(cycles2-cycles1);
+    }
+
+    printf("  Decapsulation with expanded secret key runs in ............... %10lld ", cycles_decaps/BENCH_LOOPS); print_unit;
+    printf("\n");
+#endif
+
+    return PASSED;
+}
+
+
+int cryptorun_kem_batch()
+{ // Benchmarking batched key exchange
+    unsigned int i, n, size;
+    unsigned char sk[BATCH_BENCH_MAX*CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char pk[BATCH_BENCH_MAX*CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char ct[BATCH_BENCH_MAX*CRYPTO_CIPHERTEXTBYTES] = {0};
+    unsigned char ss[BATCH_BENCH_MAX*CRYPTO_BYTES] = {0};
+    unsigned long long cycles_encaps, cycles_decaps, cycles1, cycles2;
+
+    crypto_kem_keypair(pk, sk);
+    for (i = 1; i < BATCH_BENCH_MAX; i++) {
+        memcpy(&pk[i*CRYPTO_PUBLICKEYBYTES], pk, CRYPTO_PUBLICKEYBYTES);
+        memcpy(&sk[i*CRYPTO_SECRETKEYBYTES], sk, CRYPTO_SECRETKEYBYTES);
+    }
+
+    for (size = 8; size <= BATCH_BENCH_MAX; size *= 2) {
+        cycles_encaps = 0;
+        cycles_decaps = 0;
+        for (n = 0; n < BATCH_BENCH_LOOPS; n++)
+        {
+            // Benchmarking batched encapsulation    
+            cycles1 = cpucycles();
+            crypto_kem_enc_batch(ct, ss, pk, size);
+            cycles2 = cpucycles();
+            cycles_encaps = cycles_encaps+(cycles2-cycles1);
+
+            // Benchmarking batched decapsulation
+            cycles1 = cpucycles();
+            crypto_kem_dec_batch(ss, ct, sk, size);   
+            cycles2 = cpucycles();
+            cycles_decaps = cycles_decaps+(cycles2-cycles1);
+        }
+
+        printf("  Batched encapsulation (%2d per batch) runs in ................. %10lld ", size, cycles_encaps/(BATCH_BENCH_LOOPS*size)); print_unit;
+        printf(" per operation\n");        
+        printf("  Batched decapsulation (%2d per batch) runs in ................. %10lld ", size, cycles_decaps/(BATCH_BENCH_LOOPS*size)); print_unit;
+        printf(" per operation\n");
+    }
+
+    return PASSED;
+}
+
+
+#if defined(_THREADS_)
+
+int cryptorun_kem_threads()
+{ // Benchmarking latency of key exchange with parallel isogeny evaluation
+    unsigned int n, nthreads;
+    unsigned char sk[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char ct[CRYPTO_CIPHERTEXTBYTES] = {0};
+    unsigned char ss[CRYPTO_BYTES] = {0};
+    unsigned char ss_[CRYPTO_BYTES] = {0};
+    unsigned long long cycles_keygen, cycles_encaps, cycles_decaps, cycles1, cycles2;
+
+    printf("\n");
+    for (nthreads = 1; nthreads <= THREADS_BENCH_MAX; nthreads *= 2) {
+        if (threadpool_set_num_threads(nthreads) != 0) {
+            break;
+        }
+        cycles_keygen = 0;
+        cycles_encaps = 0;
+        cycles_decaps = 0;
+        for (n = 0; n < THREADS_BENCH_LOOPS; n++)
+        {
+            cycles1 = cpucycles();
+            crypto_kem_keypair(pk, sk);
+            cycles2 = cpucycles();
+            cycles_keygen = cycles_keygen+(cycles2-cycles1);
+
+            cycles1 = cpucycles();
+            crypto_kem_enc(ct, ss, pk);
+            cycles2 = cpucycles();
+            cycles_encaps = cycles_encaps+(cycles2-cycles1);
+
+            cycles1 = cpucycles();
+            crypto_kem_dec(ss_, ct, sk);   
+            cycles2 = cpucycles();
+            cycles_decaps = cycles_decaps+(cycles2-cycles1);
+        }
+
+        printf("  Key generation with %d threads runs in ....................... %10lld ", nthreads, cycles_keygen/THREADS_BENCH_LOOPS); print_unit;
+        printf("\n");
+        printf("  Encapsulation with %d threads runs in ........................ %10lld ", nthreads, cycles_encaps/THREADS_BENCH_LOOPS); print_unit;
+        printf("\n");        
+        printf("  Decapsulation with %d threads runs in ........................ %10lld ", nthreads, cycles_decaps/THREADS_BENCH_LOOPS); print_unit;
+        printf("\n");
+    }
+    threadpool_set_num_threads(1);
+
     return PASSED;
 }
 
+#endif
+
 
 int main(int argc, char **argv)
 {
     int Status = PASSED;
     
+#if defined(_TABLE_BLOB_) && defined(TABLES_BLOB_FILE)
+    if (tables_load(TABLES_BLOB_FILE) != 0) {      // The path is ignored with USE_TABLE_BLOB=INCBIN
+        printf("\n\n   Error detected: the tables of key compression could not be loaded from %s \n\n", TABLES_BLOB_FILE);
+        return FAILED;
+    }
+#endif
+
     Status = cryptotest_kem();     // Test key encapsulation mechanism
     if (Status != PASSED) {
         printf("\n\n   Error detected: KEM_ERROR_SHARED_KEY \n\n");
         return FAILED;
     }
+
+    Status = cryptotest_kem_batch();  // Test batched key encapsulation mechanism
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: KEM_ERROR_SHARED_KEY \n\n");
+        return FAILED;
+    }
+
+#if defined(crypto_kem_enc_expanded)
+    Status = cryptotest_kem_expanded_pk();  // Test encapsulation with expanded public keys
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: KEM_ERROR_SHARED_KEY \n\n");
+        return FAILED;
+    }
+#endif
+
+#if defined(crypto_kem_dec_expanded)
+    Status = cryptotest_kem_expanded();  // Test decapsulation with expanded secret keys
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: KEM_ERROR_SHARED_KEY \n\n");
+        return FAILED;
+    }
+#endif
+
+#if defined(_THREADS_)
+    Status = cryptotest_kem_threads();  // Test key encapsulation mechanism with multiple threads
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: KEM_ERROR_SHARED_KEY \n\n");
+        return FAILED;
+    }
+
+    Status = cryptotest_kem_pool();  // Test key encapsulation mechanism with keypairs generated in the background
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: KEM_ERROR_SHARED_KEY \n\n");
+        return FAILED;
+    }
+#endif
     
     if ((argc > 1) && (strcmp("nobench", argv[1]) == 0)) {}
     else {
@@ -155,6 +616,20 @@ int main(int argc, char **argv)
             printf("\n\n   Error detected: KEM_ERROR_SHARED_KEY \n\n");
             return FAILED;
         }
+
+        Status = cryptorun_kem_batch();  // Benchmark batched key encapsulation mechanism
+        if (Status != PASSED) {
+            printf("\n\n   Error detected: KEM_ERROR_SHARED_KEY \n\n");
+            return FAILED;
+        }
+
+#if defined(_THREADS_)
+        Status = cryptorun_kem_threads();  // Benchmark key encapsulation mechanism with multiple threads
+        if (Status != PASSED) {
+            printf("\n\n   Error detected: KEM_ERROR_SHARED_KEY \n\n");
+            return FAILED;
+        }
+#endif
     }
 
     return Status;
@@ -0,0 +1,135 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: benchmark of the xDBLe and xTPLe chains
+*           For chain lengths 1 to BENCH_MAX_CHAIN, compares the cycles per step of xDBLe and xTPLe with the same
+*           number of separate calls to xDBL and xTPL. On x64 with MULX and ADX, the assembly chain kernels xDBLe_asm
+*           and xTPLe_asm are first checked against the separate calls and then timed as well.
+*
+*           Usage: bench_chains-pXXX
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define BENCH_RUNS         101       // Number of timing runs, the median is taken
+#define BENCH_MAX_CHAIN    64        // Longest chain that is measured
+
+
+static int compare_cycles(const void* a, const void* b)
+{
+    unsigned long long x = *(const unsigned long long*)a, y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+
+static double median_cycles(unsigned long long* cycles, const int e)
+{ // Median number of cycles per step over the timing runs
+    qsort(cycles, BENCH_RUNS, sizeof(unsigned long long), compare_cycles);
+    return (double)cycles[BENCH_RUNS/2] / e;
+}
+
+
+int main(void)
+{
+    int r, i, e;
+    unsigned long long cycles[BENCH_RUNS], cycles1, cycles2;
+    double calls_dbl, chain_dbl, calls_tpl, chain_tpl;
+    f2elm_t A24plus, C24, A24minus;
+    point_proj_t P;
+#if defined(_MULX_) && defined(_ADX_)
+    double asm_dbl, asm_tpl;
+    point_proj_t Q, R;
+#endif
+
+    fp2random_test((digit_t*)A24plus); fp2random_test((digit_t*)C24); fp2random_test((digit_t*)A24minus);
+    fp2random_test((digit_t*)P->X); fp2random_test((digit_t*)P->Z);
+
+    printf("\n  %s: cycles per step\n\n", BENCH_NAME);
+
+#if defined(_MULX_) && defined(_ADX_)
+    for (e = 0; e <= BENCH_MAX_CHAIN; e++) {
+        copy_words((digit_t*)P, (digit_t*)Q, 2*2*NWORDS_FIELD);
+        for (i = 0; i < e; i++) xDBL(Q, Q, A24plus, C24);
+        xDBLe_asm((digit_t*)P, (digit_t*)R, (digit_t*)A24plus, (digit_t*)C24, e);
+        if (memcmp(Q, R, sizeof(point_proj_t)) != 0) {
+            printf("  xDBLe_asm differs from %d calls to xDBL ... FAILED\n", e);
+            return 1;
+        }
+        copy_words((digit_t*)P, (digit_t*)Q, 2*2*NWORDS_FIELD);
+        for (i = 0; i < e; i++) xTPL(Q, Q, A24minus, A24plus);
+        xTPLe_asm((digit_t*)P, (digit_t*)R, (digit_t*)A24minus, (digit_t*)A24plus, e);
+        if (memcmp(Q, R, sizeof(point_proj_t)) != 0) {
+            printf("  xTPLe_asm differs from %d calls to xTPL ... FAILED\n", e);
+            return 1;
+        }
+    }
+    printf("  Assembly chains against xDBL and xTPL calls .................... PASSED\n\n");
+    printf("     e      xDBL calls       xDBLe   xDBLe_asm      xTPL calls       xTPLe   xTPLe_asm\n");
+#else
+    printf("     e      xDBL calls       xDBLe      xTPL calls       xTPLe\n");
+#endif
+    for (e = 1; e <= BENCH_MAX_CHAIN; e++) {
+        for (r = 0; r < BENCH_RUNS; r++) {
+            cycles1 = cpucycles();
+            for (i = 0; i < e; i++) xDBL(P, P, A24plus, C24);
+            cycles2 = cpucycles();
+            cycles[r] = cycles2 - cycles1;
+        }
+        calls_dbl = median_cycles(cycles, e);
+
+        for (r = 0; r < BENCH_RUNS; r++) {
+            cycles1 = cpucycles();
+            xDBLe(P, P, A24plus, C24, e);
+            cycles2 = cpucycles();
+            cycles[r] = cycles2 - cycles1;
+        }
+        chain_dbl = median_cycles(cycles, e);
+
+        for (r = 0; r < BENCH_RUNS; r++) {
+            cycles1 = cpucycles();
+            for (i = 0; i < e; i++) xTPL(P, P, A24minus, A24plus);
+            cycles2 = cpucycles();
+            cycles[r] = cycles2 - cycles1;
+        }
+        calls_tpl = median_cycles(cycles, e);
+
+        for (r = 0; r < BENCH_RUNS; r++) {
+            cycles1 = cpucycles();
+            xTPLe(P, P, A24minus, A24plus, e);
+            cycles2 = cpucycles();
+            cycles[r] = cycles2 - cycles1;
+        }
+        chain_tpl = median_cycles(cycles, e);
+
+#if defined(_MULX_) && defined(_ADX_)
+        for (r = 0; r < BENCH_RUNS; r++) {
+            cycles1 = cpucycles();
+            xDBLe_asm((digit_t*)P, (digit_t*)P, (digit_t*)A24plus, (digit_t*)C24, e);
+            cycles2 = cpucycles();
+            cycles[r] = cycles2 - cycles1;
+        }
+        asm_dbl = median_cycles(cycles, e);
+
+        for (r = 0; r < BENCH_RUNS; r++) {
+            cycles1 = cpucycles();
+            xTPLe_asm((digit_t*)P, (digit_t*)P, (digit_t*)A24minus, (digit_t*)A24plus, e);
+            cycles2 = cpucycles();
+            cycles[r] = cycles2 - cycles1;
+        }
+        asm_tpl = median_cycles(cycles, e);
+
+        printf("  %4d  %14.0f  %10.0f  %10.0f  %14.0f  %10.0f  %10.0f\n", e, calls_dbl, chain_dbl, asm_dbl, calls_tpl, chain_tpl, asm_tpl);
+#else
+        printf("  %4d  %14.0f  %10.0f  %14.0f  %10.0f\n", e, calls_dbl, chain_dbl, calls_tpl, chain_tpl);
+#endif
+    }
+
+    return 0;
+}
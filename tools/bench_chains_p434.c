@@ -0,0 +1,22 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: benchmark of the xDBLe and xTPLe chains for SIDHp434
+*********************************************************************************************/
+
+#include "../src/config.h"
+#include "../src/P434/P434_internal.h"
+#include "../src/internal.h"
+#include "../tests/test_extras.h"
+
+
+#define BENCH_NAME                "SIDHp434"
+#define fp2random_test            fp2random434_test
+#define xDBLe_asm                 xDBLe434_asm
+#define xTPLe_asm                 xTPLe434_asm
+
+#include "bench_chains.c"
@@ -0,0 +1,22 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: benchmark of the xDBLe and xTPLe chains for SIDHp503
+*********************************************************************************************/
+
+#include "../src/config.h"
+#include "../src/P503/P503_internal.h"
+#include "../src/internal.h"
+#include "../tests/test_extras.h"
+
+
+#define BENCH_NAME                "SIDHp503"
+#define fp2random_test            fp2random503_test
+#define xDBLe_asm                 xDBLe503_asm
+#define xTPLe_asm                 xTPLe503_asm
+
+#include "bench_chains.c"
@@ -0,0 +1,22 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: benchmark of the xDBLe and xTPLe chains for SIDHp610
+*********************************************************************************************/
+
+#include "../src/config.h"
+#include "../src/P610/P610_internal.h"
+#include "../src/internal.h"
+#include "../tests/test_extras.h"
+
+
+#define BENCH_NAME                "SIDHp610"
+#define fp2random_test            fp2random610_test
+#define xDBLe_asm                 xDBLe610_asm
+#define xTPLe_asm                 xTPLe610_asm
+
+#include "bench_chains.c"
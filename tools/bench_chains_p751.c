@@ -0,0 +1,22 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: benchmark of the xDBLe and xTPLe chains for SIDHp751
+*********************************************************************************************/
+
+#include "../src/config.h"
+#include "../src/P751/P751_internal.h"
+#include "../src/internal.h"
+#include "../tests/test_extras.h"
+
+
+#define BENCH_NAME                "SIDHp751"
+#define fp2random_test            fp2random751_test
+#define xDBLe_asm                 xDBLe751_asm
+#define xTPLe_asm                 xTPLe751_asm
+
+#include "bench_chains.c"
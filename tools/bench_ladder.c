@@ -0,0 +1,113 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: test and benchmark of the assembly step of the three-point ladder
+*           Checks ladder3pt_step_asm against swap_points + xDBLADD over a run of random swap masks, then compares
+*           the cycles per step of both over BENCH_STEPS steps.
+*
+*           Usage: bench_ladder-pXXX
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define BENCH_RUNS         101       // Number of timing runs, the median is taken
+#define BENCH_STEPS        256       // Number of ladder steps per timing run
+#define TEST_STEPS         1000      // Number of ladder steps that are checked
+
+
+static void swap_points_ref(point_proj_t P, point_proj_t Q, const digit_t option)
+{ // Swap points, as swap_points in ec_isogeny.c
+    digit_t temp, *p = (digit_t*)P, *q = (digit_t*)Q;
+    unsigned int i;
+
+    for (i = 0; i < 2*2*NWORDS_FIELD; i++) {
+        temp = option & (p[i] ^ q[i]);
+        p[i] = temp ^ p[i];
+        q[i] = temp ^ q[i];
+    }
+}
+
+
+static void ladder_step_ref(point_proj_t R0, point_proj_t R2, point_proj_t R, const f2elm_t A24, const digit_t mask)
+{
+    swap_points_ref(R, R2, mask);
+    xDBLADD(R0, R2, R->X, R->Z, A24);
+}
+
+
+static int compare_cycles(const void* a, const void* b)
+{
+    unsigned long long x = *(const unsigned long long*)a, y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+
+static double median_cycles(unsigned long long* cycles)
+{ // Median number of cycles per step over the timing runs
+    qsort(cycles, BENCH_RUNS, sizeof(unsigned long long), compare_cycles);
+    return (double)cycles[BENCH_RUNS/2] / BENCH_STEPS;
+}
+
+
+int main(void)
+{
+    int r, i;
+    unsigned long long cycles[BENCH_RUNS], cycles1, cycles2;
+    double ref, fused;
+    f2elm_t A24;
+    point_proj_t R0, R2, R, S0, S2, S;
+    digit_t mask, masks[BENCH_STEPS];
+
+    printf("\n  %s: three-point ladder step\n\n", BENCH_NAME);
+
+#if defined(_MULX_) && defined(_ADX_)
+    fp2random_test((digit_t*)A24);
+    fp2random_test((digit_t*)R0->X); fp2random_test((digit_t*)R0->Z);
+    fp2random_test((digit_t*)R2->X); fp2random_test((digit_t*)R2->Z);
+    fp2random_test((digit_t*)R->X); fp2random_test((digit_t*)R->Z);
+    memcpy(S0, R0, sizeof(point_proj_t)); memcpy(S2, R2, sizeof(point_proj_t)); memcpy(S, R, sizeof(point_proj_t));
+
+    for (i = 0; i < TEST_STEPS; i++) {
+        mask = 0 - (digit_t)(rand() & 1);
+        ladder_step_ref(R0, R2, R, A24, mask);
+        ladder3pt_step_asm((digit_t*)S0, (digit_t*)S2, (digit_t*)S, (digit_t*)A24, mask);
+        if (memcmp(R0, S0, sizeof(point_proj_t)) != 0 || memcmp(R2, S2, sizeof(point_proj_t)) != 0 || memcmp(R, S, sizeof(point_proj_t)) != 0) {
+            printf("  Assembly step differs from swap_points + xDBLADD at step %d ... FAILED\n", i);
+            return 1;
+        }
+    }
+    printf("  Assembly step against swap_points + xDBLADD ...................... PASSED\n\n");
+
+    for (i = 0; i < BENCH_STEPS; i++) masks[i] = 0 - (digit_t)(rand() & 1);
+
+    for (r = 0; r < BENCH_RUNS; r++) {
+        cycles1 = cpucycles();
+        for (i = 0; i < BENCH_STEPS; i++) ladder_step_ref(R0, R2, R, A24, masks[i]);
+        cycles2 = cpucycles();
+        cycles[r] = cycles2 - cycles1;
+    }
+    ref = median_cycles(cycles);
+
+    for (r = 0; r < BENCH_RUNS; r++) {
+        cycles1 = cpucycles();
+        for (i = 0; i < BENCH_STEPS; i++) ladder3pt_step_asm((digit_t*)R0, (digit_t*)R2, (digit_t*)R, (digit_t*)A24, masks[i]);
+        cycles2 = cpucycles();
+        cycles[r] = cycles2 - cycles1;
+    }
+    fused = median_cycles(cycles);
+
+    printf("  swap_points + xDBLADD runs in ................................ %7.0f cycles\n", ref);
+    printf("  Assembly ladder step runs in ................................. %7.0f cycles\n", fused);
+#else
+    printf("  The assembly ladder step needs an x64 build with MULX and ADX, skipped\n");
+#endif
+
+    return 0;
+}
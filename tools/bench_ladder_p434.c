@@ -0,0 +1,21 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: test and benchmark of the assembly step of the three-point ladder for SIDHp434
+*********************************************************************************************/
+
+#include "../src/config.h"
+#include "../src/P434/P434_internal.h"
+#include "../src/internal.h"
+#include "../tests/test_extras.h"
+
+
+#define BENCH_NAME                "SIDHp434"
+#define fp2random_test            fp2random434_test
+#define ladder3pt_step_asm        ladder3pt_step434_asm
+
+#include "bench_ladder.c"
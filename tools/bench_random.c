@@ -0,0 +1,100 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: benchmark of randombytes with multiple threads
+*           Each thread requests BENCH_REQUESTS blocks of BENCH_BYTES bytes (the size of a SIKE message), first from the
+*           buffered generator in src/random/random.c and then with one getrandom() call per request. The number of
+*           system calls issued and the throughput are reported for both.
+*
+*           Usage: bench_random [nthreads]
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+static unsigned long long random_syscalls = 0;
+#define RANDOM_COUNT_SYSCALL() __atomic_fetch_add(&random_syscalls, 1, __ATOMIC_RELAXED)
+#include "../src/random/random.c"
+
+
+#define BENCH_THREADS       32
+#define BENCH_MAX_THREADS   256
+#define BENCH_REQUESTS      100000
+#define BENCH_BYTES         32
+
+
+static void* bench_buffered(void* arg)
+{
+    unsigned char bytes[BENCH_BYTES];
+    unsigned int i;
+
+    for (i = 0; i < BENCH_REQUESTS; i++) {
+        randombytes(bytes, BENCH_BYTES);
+    }
+    *(unsigned char*)arg = bytes[0];
+    return NULL;
+}
+
+
+static void* bench_syscall(void* arg)
+{
+    unsigned char bytes[BENCH_BYTES];
+    unsigned int i;
+
+    for (i = 0; i < BENCH_REQUESTS; i++) {
+        random_os_read(bytes, BENCH_BYTES);
+    }
+    *(unsigned char*)arg = bytes[0];
+    return NULL;
+}
+
+
+static void run(const char* name, void* (*worker)(void*), const unsigned int nthreads)
+{ // Runs worker on nthreads threads and reports the number of system calls and the throughput
+    pthread_t threads[BENCH_MAX_THREADS];
+    unsigned char sink[BENCH_MAX_THREADS];
+    struct timespec t1, t2;
+    unsigned long long total = (unsigned long long)nthreads*BENCH_REQUESTS;
+    unsigned int t;
+    double seconds;
+
+    random_syscalls = 0;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    for (t = 0; t < nthreads; t++) {
+        pthread_create(&threads[t], NULL, worker, &sink[t]);
+    }
+    for (t = 0; t < nthreads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    seconds = (double)(t2.tv_sec - t1.tv_sec) + (double)(t2.tv_nsec - t1.tv_nsec)*1e-9;
+
+    printf("  %-28s %10llu syscalls (%.4f per request), %8.2f MB/s, %10.0f requests/s \n", name, random_syscalls,
+           (double)random_syscalls/total, (double)total*BENCH_BYTES/seconds/1e6, (double)total/seconds);
+}
+
+
+int main(int argc, char** argv)
+{
+    unsigned int nthreads = BENCH_THREADS;
+
+    if (argc > 1) nthreads = (unsigned int)atoi(argv[1]);
+    if (nthreads < 1 || nthreads > BENCH_MAX_THREADS) {
+        fprintf(stderr, "Usage: %s [nthreads], with at most %d threads\n", argv[0], BENCH_MAX_THREADS);
+        return 1;
+    }
+
+    printf("\nBenchmarking randombytes: %u threads, %d requests of %d bytes per thread \n", nthreads, BENCH_REQUESTS, BENCH_BYTES);
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+    run("Buffered SHAKE256 generator", bench_buffered, nthreads);
+    run("One system call per request", bench_syscall, nthreads);
+    printf("\n");
+
+    return 0;
+}
@@ -0,0 +1,426 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the Pohlig-Hellman tables of key compression for other window sizes
+*           Prints a header with the traversal paths and the tables of the discrete logs in the 2^eA- and 3^eB-torsion
+*           for the window sizes W_2 and W_3, which replaces the built-in tables of the compressed variants when compiling
+*           with USE_DLOG_TABLES=TRUE. The generator g of each group is recovered from the first entry of the tables the
+*           tool is compiled with, which holds g^-1 for any window size.
+*           With "bench", it measures solve_dlog with the tables it is compiled with instead.
+*
+*           Usage: dlog_tables-pXXX W_2 W_3
+*                  dlog_tables-pXXX bench
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+#define DLOG_MIN_W_2       4         // The leaf dlog in the 2^eA-torsion needs at least one entry in ph2_Texp
+#define DLOG_MAX_W_2       8
+#define DLOG_MIN_W_3       2
+#define DLOG_MAX_W_3       5
+#define DLOG_BENCH_RUNS    101       // Number of timing runs, the median is taken
+
+// Cost of the edges of the traversal in field multiplications, which give the built-in paths: a left edge in the
+// 2^eA-torsion is w squarings on the torus of 2 multiplications each and a right edge one mixed multiplication of about
+// 3 multiplications including the reductions. In the 3^eB-torsion, a cyclotomic cubing costs about one multiplication in GF(p^2).
+#define DLOG_COST_LEFT_2(w)   (2*(w))
+#define DLOG_COST_RIGHT_2     3
+#define DLOG_COST_LEFT_3(w)   (w)
+#define DLOG_COST_RIGHT_3     1
+
+
+static void generator_inv(const int ell, f2elm_t ginv)
+{ // The inverse of the generator g of the pairing values in the ell^e-torsion, the first entry of the compiled-in tables
+    felm_t proj[2];
+
+    if (ell == 2) {
+        fpcopy((digit_t*)ph2_CT, proj[0]);
+        fpcopy((digit_t*)&Montgomery_one, proj[1]);
+        fromproj(proj, ginv);
+    } else {
+#if (OBOB_EXPON % W_3 == 0)
+        fp2copy((felm_t*)ph3_T, ginv);
+#else
+        fp2copy((felm_t*)ph3_T1, ginv);
+#endif
+    }
+}
+
+
+static void pow_ell(f2elm_t a, const int ell, const unsigned int n)
+{ // a <- a^(ell^n) for a in the cyclotomic subgroup
+    felm_t one;
+    unsigned int i;
+
+    fpcopy((digit_t*)&Montgomery_one, one);
+    for (i = 0; i < n; i++) {
+        if (ell == 2) {
+            sqr_Fp2_cycl(a, one);
+        } else {
+            cube_Fp2_cycl(a, one);
+        }
+    }
+    fp2correction(a);
+}
+
+
+static void torus_alpha(const f2elm_t a, felm_t alpha)
+{ // The torus representation [alpha:1] of a = (alpha + i)/(alpha - i) used by the tables in the 2^eA-torsion. a = -1 gives alpha = 0.
+    felm_t t;
+
+    fpcopy(a[1], t);
+    fpcorrection(t);
+    if (is_felm_zero(t)) {
+        fpzero(alpha);
+        return;
+    }
+    fpinv_mont(t);
+    fpadd(a[0], (digit_t*)&Montgomery_one, alpha);
+    fpmul_mont(alpha, t, alpha);
+    fpcorrection(alpha);
+}
+
+
+static int fp_sqrt(const felm_t a, felm_t r)
+{ // r = a^((p+1)/4). Returns 1 if a is not a square.
+    felm_t t, u;
+
+    fpcopy(a, t);
+    fpinv_chain_mont(t);
+    fpmul_mont(a, t, r);
+    fpcorrection(r);
+    fpsqr_mont(r, t);
+    fpcorrection(t);
+    fpcopy(a, u);
+    fpcorrection(u);
+    return (memcmp(t, u, NBITS_TO_NBYTES(NBITS_FIELD)) != 0);
+}
+
+
+static void signed_table(const int ell, const unsigned int w, const unsigned int shift, const unsigned int nrows, felm_t* T)
+{ // T[m*(ell^w/2) + d-1] = g^(-d*ell^(w*m + shift)) for m = 0,...,nrows-1 and d = 1,...,ell^w/2, in the torus
+  // representation for ell = 2 and as GF(p^2) elements for ell = 3
+    unsigned int half = 1, m, d;
+    f2elm_t base, a;
+
+    for (d = 0; d < w; d++) half *= ell;
+    half /= 2;
+    generator_inv(ell, base);
+    pow_ell(base, ell, shift);
+    for (m = 0; m < nrows; m++) {
+        fp2copy(base, a);
+        for (d = 1; d <= half; d++) {
+            if (ell == 2) {
+                torus_alpha(a, T[m*half + d-1]);
+            } else {
+                fp2copy(a, (felm_t*)T + 2*(m*half + d-1));
+            }
+            fp2mul_mont(a, base, a);
+            fp2correction(a);
+        }
+        pow_ell(base, ell, w);
+    }
+}
+
+
+static void optimal_path(const unsigned int len, const double left, const double right, unsigned int* P)
+{ // Optimal strategy for the Pohlig-Hellman traversal: P[z] is the number of leaves of the left subtree of a tree with z leaves
+    double* C = calloc(len, sizeof(double)), c;
+    unsigned int z, t;
+
+    P[0] = 0;
+    P[1] = 0;
+    for (z = 2; z < len; z++) {
+        C[z] = -1;
+        for (t = 1; t < z; t++) {
+            c = C[t] + C[z-t] + (z-t)*left + t*right;
+            if (C[z] < 0 || c < C[z]) {
+                C[z] = c;
+                P[z] = t;
+            }
+        }
+    }
+    free(C);
+}
+
+
+static int ell2_leaf_tables(const unsigned int w, felm_t* Texp, int* Log, felm_t* G)
+{ // Tables of the leaf dlog in the 2^eA-torsion (ord2w_dloghyb with W_2_1 = w-1) for the generator rho = g^(2^(eA-w)).
+  // ord2w_dlog matches alpha(rho^2k) against +-S, where the values S at the nodes of level j of a binary tree are the values
+  // s at their parent plus and minus Texp = sqrt(1 + s^2), starting from S = 1 = alpha(i). G holds alpha of the square roots
+  // ord2w_dloghyb compares with to recover the last bit.
+    unsigned int w1 = w - 1, n1 = 1 << w1, j, i, L, k, d;
+    felm_t *alpha = calloc(n1, sizeof(felm_t)), *S = calloc(n1, sizeof(felm_t)), *target = calloc(n1, sizeof(felm_t)), s;
+    f2elm_t rho, rho2, a;
+    int error = 0;
+
+    // alpha[k] = alpha(rho^2k) for k = 1,...,2^w1-1
+    generator_inv(2, rho);
+    fpneg(rho[1]);
+    pow_ell(rho, 2, OALICE_BITS - w);
+    fp2copy(rho, rho2);
+    pow_ell(rho2, 2, 1);
+    fp2copy(rho2, a);
+    for (k = 1; k < n1; k++) {
+        torus_alpha(a, alpha[k]);
+        fp2mul_mont(a, rho2, a);
+        fp2correction(a);
+    }
+
+    // S[2^(j-1)-1 + i] is the value at node i of level j, Texp[2^(j-2)-1 + m] is used by the children of node m of level j-1
+    fpcopy((digit_t*)&Montgomery_one, S[0]);
+    for (j = 2; j < w1; j++) {
+        for (i = 0; i < (1u << (j-2)); i++) {
+            k = (1 << (j-2)) - 1 + i;
+            fpsqr_mont(S[k], s);
+            fpadd(s, (digit_t*)&Montgomery_one, s);
+            error |= fp_sqrt(s, Texp[k]);
+            fpadd(S[k], Texp[k], S[(1 << (j-1)) - 1 + 2*i]);
+            fpsub(S[k], Texp[k], S[(1 << (j-1)) - 1 + 2*i + 1]);
+            fpcorrection(S[(1 << (j-1)) - 1 + 2*i]);
+            fpcorrection(S[(1 << (j-1)) - 1 + 2*i + 1]);
+        }
+    }
+
+    // Log[] is the signed log to the base rho^2 of the element that ord2w_dlog identifies with that entry
+    fpzero(target[0]);
+    fpcopy(S[0], target[1]);
+    fpcopy(S[0], target[2]);
+    fpneg(target[2]);
+    for (j = 2; j < w1; j++) {
+        for (i = 0; i < (1u << (j-1)); i++) {
+            fpcopy(S[(1 << (j-1)) - 1 + i], target[(1 << j) + i - 1]);
+            fpcopy(S[(1 << (j-1)) - 1 + i], target[(1 << (j+1)) - i - 2]);
+            fpneg(target[(1 << (j+1)) - i - 2]);
+        }
+    }
+    for (i = 0; i < n1 - 1; i++) {
+        fpcorrection(target[i]);
+        Log[i] = 0;
+        for (k = 1; k < n1; k++) {
+            if (memcmp(target[i], alpha[k], NBITS_TO_NBYTES(NBITS_FIELD)) == 0) {
+                Log[i] = (k <= n1/2) ? (int)k : (int)k - (int)n1;
+            }
+        }
+        error |= (Log[i] == 0);
+    }
+
+    // G[0] = alpha(rho^(2^(w-2))) and G[2^(L-3) + i] = alpha(rho^d) with d = (2*reverse_bits(i, L-2) + 1)*2^(w-L), for L = 3,...,w
+    fp2copy(rho, a);
+    pow_ell(a, 2, w - 2);
+    torus_alpha(a, G[0]);
+    for (L = 3; L <= w; L++) {
+        for (i = 0; i < (1u << (L-3)); i++) {
+            d = (2*reverse_bits(i, L-2) + 1) << (w - L);
+            fp2copy(rho, a);
+            for (k = 1; k < d; k++) {
+                fp2mul_mont(a, rho, a);
+            }
+            fp2correction(a);
+            torus_alpha(a, G[(1 << (L-3)) + i]);
+        }
+    }
+    free(alpha);
+    free(S);
+    free(target);
+    return error;
+}
+
+
+static void print_words(const char* decl, const felm_t* T, const unsigned int nelms, const unsigned int nwords)
+{ // Prints nelms elements of nwords 64-bit words each, one element per line
+    const uint64_t* t = (const uint64_t*)T;
+    unsigned int i, j;
+
+    printf("const uint64_t %s = {\n", decl);
+    for (i = 0; i < nelms; i++) {
+        printf("    ");
+        for (j = 0; j < nwords; j++) {
+            printf("0x%016llX%s", (unsigned long long)t[i*nwords + j], (i == nelms-1 && j == nwords-1) ? "" : ",");
+        }
+        printf("\n");
+    }
+    printf("};\n\n");
+}
+
+
+static void print_path(const char* decl, const unsigned int* P, const unsigned int len)
+{
+    unsigned int i;
+
+    printf("const unsigned int %s = {\n    ", decl);
+    for (i = 0; i < len; i++) {
+        printf("%u%s", P[i], (i == len-1) ? "\n" : ", ");
+    }
+    printf("};\n\n");
+}
+
+
+static int generate(const unsigned int w2, const unsigned int w3)
+{
+    unsigned int half2 = 1 << (w2-1), half3 = 1, ell3w = 1, ell3emodw = 1, i;
+    unsigned int dlen2 = OALICE_BITS/w2, dlen3 = (OBOB_EXPON + w3 - 1)/w3;
+    unsigned int *P2 = calloc(dlen2 + 1, sizeof(unsigned int)), *P3 = calloc(dlen3 + 1, sizeof(unsigned int));
+    felm_t *CT = calloc(dlen2*half2, sizeof(felm_t)), *Texp, *G, *T1, *T2;
+    int *Log;
+
+    for (i = 0; i < w3; i++) ell3w *= 3;
+    for (i = 0; i < OBOB_EXPON % w3; i++) ell3emodw *= 3;
+    half3 = ell3w/2;
+    Texp = calloc((1 << (w2-3)) - 1, sizeof(felm_t));
+    Log = calloc((1 << (w2-1)) - 1, sizeof(int));
+    G = calloc(1 << (w2-2), sizeof(felm_t));
+    T1 = calloc(2*dlen3*half3, sizeof(felm_t));
+    T2 = calloc(2*dlen3*half3, sizeof(felm_t));
+
+    if (ell2_leaf_tables(w2, Texp, Log, G) != 0) {
+        fprintf(stderr, "Error: the leaf tables in the 2^eA-torsion could not be generated\n");
+        return 1;
+    }
+    signed_table(2, w2, 0, dlen2, CT);
+    signed_table(3, w3, 0, dlen3, T1);
+    if (OBOB_EXPON % w3 != 0) {
+        // T2[m] = g^(-d*3^(w*(m-1) + eB mod w)) is used after the first left edge of the traversal, which raises to 3^(eB mod w)
+        // instead of 3^w. T2[0] is not used.
+        signed_table(3, w3, OBOB_EXPON % w3, dlen3 - 1, T2 + 2*half3);
+    }
+    optimal_path(dlen2 + 1, DLOG_COST_LEFT_2(w2), DLOG_COST_RIGHT_2, P2);
+    optimal_path(dlen3 + 1, DLOG_COST_LEFT_3(w3), DLOG_COST_RIGHT_3, P3);
+
+    printf("/********************************************************************************************\n");
+    printf("* Pohlig-Hellman tables for %s with W_2 = %u and W_3 = %u, generated by \"make dlog_tables\"\n", DLOG_NAME, w2, w3);
+    printf("*\n");
+    printf("* Table sizes: %u bytes in the 2^eA-torsion, %u bytes in the 3^eB-torsion\n",
+           (unsigned int)(((dlen2*half2 + (1 << (w2-3)) - 1 + (1 << (w2-2)))*NWORDS64_FIELD*8 + ((1 << (w2-1)) - 1)*sizeof(int))),
+           (unsigned int)(((OBOB_EXPON % w3 != 0) ? 2 : 1)*dlen3*half3*2*NWORDS64_FIELD*8));
+    printf("*********************************************************************************************/\n\n");
+
+    printf("#if !defined(DLOG_TABLES_DATA)\n\n");
+    printf("#define W_2 %u\n#define W_3 %u\n", w2, w3);
+    printf("#define ELL2_W (1 << W_2)\n#define ELL3_W %u\n", ell3w);
+    printf("#define ELL2_EMODW (1 << (OALICE_BITS %% W_2))\n#define ELL3_EMODW %u\n", ell3emodw);
+    printf("#define DLEN_2 ((OALICE_BITS+W_2-1)/W_2)\n#define DLEN_3 ((OBOB_EXPON+W_3-1)/W_3)\n");
+    printf("#define COMPRESSED_TABLES\n#define ELL2_TORUS\n#define ELL3_FULL_SIGNED\n");
+    printf("#define PLEN_2 %u\n#define W_2_1 %u\n#define PLEN_3 %u\n\n", dlen2 + 1, w2 - 1, dlen3 + 1);
+    printf("#else\n\n");
+
+    print_path("ph2_path[PLEN_2]", P2, dlen2 + 1);
+    print_path("ph3_path[PLEN_3]", P3, dlen3 + 1);
+    printf("#if !defined(_TABLE_BLOB_)     // Otherwise the tables are loaded from the blob written by \"make tables_blob\"\n\n");
+    print_words("ph2_Texp[((1<<(W_2_1-2))-1)*NWORDS64_FIELD]", Texp, (1 << (w2-3)) - 1, NWORDS64_FIELD);
+    printf("const int ph2_Log[(1<<(W_2_1))-1] = {\n    ");
+    for (i = 0; i < (1u << (w2-1)) - 1; i++) {
+        printf("%d%s", Log[i], (i == (1u << (w2-1)) - 2) ? "\n" : ", ");
+    }
+    printf("};\n\n");
+    print_words("ph2_G[(1<<(W_2-2))*NWORDS64_FIELD]", G, 1 << (w2-2), NWORDS64_FIELD);
+    print_words("ph2_CT[DLEN_2*(ELL2_W >> 1)*NWORDS64_FIELD]", CT, dlen2*half2, NWORDS64_FIELD);
+    if (OBOB_EXPON % w3 == 0) {
+        print_words("ph3_T[DLEN_3*(ELL3_W>>1)*2*NWORDS64_FIELD]", T1, dlen3*half3, 2*NWORDS64_FIELD);
+        printf("const uint64_t *ph3_T1 = {0};\nconst uint64_t *ph3_T2 = {0};\n\n");
+    } else {
+        printf("const uint64_t *ph3_T = {0};\n");
+        print_words("ph3_T1[DLEN_3*(ELL3_W>>1)*2*NWORDS64_FIELD]", T1, dlen3*half3, 2*NWORDS64_FIELD);
+        print_words("ph3_T2[DLEN_3*(ELL3_W>>1)*2*NWORDS64_FIELD]", T2, dlen3*half3, 2*NWORDS64_FIELD);
+    }
+    printf("#endif\n\n#endif\n");
+
+    free(P2); free(P3); free(CT); free(Texp); free(Log); free(G); free(T1); free(T2);
+    return 0;
+}
+
+
+static int compare_cycles(const void* a, const void* b)
+{
+    unsigned long long x = *(const unsigned long long*)a, y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+
+static int bench(void)
+{ // Median cycles of solve_dlog for random logs with the compiled-in tables. Each log is checked against the exponent.
+    unsigned long long cycles[2][DLOG_BENCH_RUNS], cycles1, cycles2;
+    digit_t d[NWORDS_ORDER], e[NWORDS_ORDER];
+    int D[(DLEN_2 > DLEN_3) ? DLEN_2 : DLEN_3], ell, r, i;
+    f2elm_t g, a;
+    felm_t one;
+    size_t bytes[2];
+
+    fpcopy((digit_t*)&Montgomery_one, one);
+    for (ell = 2; ell <= 3; ell++) {
+        generator_inv(ell, g);
+        fpneg(g[1]);
+        for (r = 0; r < DLOG_BENCH_RUNS; r++) {
+            memset(d, 0, sizeof(d));
+            memset(e, 0, sizeof(e));
+            if (ell == 2) {
+                random_mod_order_A((unsigned char*)d);
+            } else {
+                random_mod_order_B((unsigned char*)d);
+            }
+            fp2zero(a);
+            fpcopy(one, a[0]);
+            for (i = NWORDS_ORDER*RADIX - 1; i >= 0; i--) {
+                sqr_Fp2_cycl(a, one);
+                if ((d[i/RADIX] >> (i % RADIX)) & 1) {
+                    fp2mul_mont(a, g, a);
+                }
+            }
+            fp2correction(a);
+
+            cycles1 = cpucycles();
+            solve_dlog(a, D, e, ell);
+            cycles2 = cpucycles();
+            cycles[ell-2][r] = cycles2 - cycles1;
+            for (i = OALICE_BITS; ell == 2 && i < NWORDS_ORDER*RADIX; i++) {
+                e[i/RADIX] &= ~((digit_t)1 << (i % RADIX));     // The log in the 2^eA-torsion is only defined modulo 2^eA
+            }
+            if (memcmp(d, e, sizeof(d)) != 0) {
+                fprintf(stderr, "Error: wrong discrete log in the %d-torsion\n", ell);
+                return 1;
+            }
+        }
+        qsort(cycles[ell-2], DLOG_BENCH_RUNS, sizeof(unsigned long long), compare_cycles);
+    }
+    bytes[0] = sizeof(ph2_CT) + sizeof(ph2_Texp) + sizeof(ph2_Log) + sizeof(ph2_G);
+#if (OBOB_EXPON % W_3 == 0)
+    bytes[1] = sizeof(ph3_T);
+#else
+    bytes[1] = sizeof(ph3_T1) + sizeof(ph3_T2);
+#endif
+
+    printf("  %-9s W_2 = %d, W_3 = %d: %10llu cycles, %8zu table bytes (2^eA)   %10llu cycles, %8zu table bytes (3^eB)\n", DLOG_NAME, W_2, W_3,
+           cycles[0][DLOG_BENCH_RUNS/2], bytes[0], cycles[1][DLOG_BENCH_RUNS/2], bytes[1]);
+    return 0;
+}
+
+
+int main(int argc, char** argv)
+{
+    int w2, w3;
+
+    if (argc == 2 && strcmp(argv[1], "bench") == 0) {
+        return bench();
+    }
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s W_2 W_3\n       %s bench\n", argv[0], argv[0]);
+        return 1;
+    }
+    w2 = atoi(argv[1]);
+    w3 = atoi(argv[2]);
+    if (w2 < DLOG_MIN_W_2 || w2 > DLOG_MAX_W_2 || OALICE_BITS % w2 != 0) {
+        fprintf(stderr, "Error: W_2 must divide eA = %d and be between %d and %d\n", OALICE_BITS, DLOG_MIN_W_2, DLOG_MAX_W_2);
+        return 1;
+    }
+    if (w3 < DLOG_MIN_W_3 || w3 > DLOG_MAX_W_3) {
+        fprintf(stderr, "Error: W_3 must be between %d and %d\n", DLOG_MIN_W_3, DLOG_MAX_W_3);
+        return 1;
+    }
+    return generate((unsigned int)w2, (unsigned int)w3);
+}
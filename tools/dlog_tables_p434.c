@@ -0,0 +1,18 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the Pohlig-Hellman tables for SIDHp434_compressed
+*********************************************************************************************/
+
+#undef _TABLE_BLOB_                 // The tool reads and measures the compiled-in tables
+#include "../src/P434/P434_compressed.c"
+#include "../tests/test_extras.h"
+
+
+#define DLOG_NAME         "SIDHp434"
+
+#include "dlog_tables.c"
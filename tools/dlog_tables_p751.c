@@ -0,0 +1,18 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the Pohlig-Hellman tables for SIDHp751_compressed
+*********************************************************************************************/
+
+#undef _TABLE_BLOB_                 // The tool reads and measures the compiled-in tables
+#include "../src/P751/P751_compressed.c"
+#include "../tests/test_extras.h"
+
+
+#define DLOG_NAME         "SIDHp751"
+
+#include "dlog_tables.c"
@@ -0,0 +1,246 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of larger Elligator tables for the torsion basis generation of key compression
+*           Prints a header with the values v = 1/(1 + U*r^2) for the counters r = 0,...,V3_LEN-1 of the 3^eB-torsion basis
+*           (for r+1 instead of r when r < 20, as in the built-in table), and with the next R_EXT_LEN candidates r of each
+*           quadratic class of the 2^eA-torsion basis after the built-in tables of TABLE_R_LEN entries. The header replaces
+*           and extends the built-in tables of the compressed variants when compiling with USE_ELLIGATOR_TABLES=TRUE.
+*           The counters stored in public keys do not depend on the table sizes, and the entries shared with the
+*           compiled-in tables are checked against them.
+*           With "hist", it generates public keys and prints histograms of the Elligator counters they consume instead.
+*
+*           Usage: elligator_tables-pXXX V3_LEN R_EXT_LEN
+*                  elligator_tables-pXXX hist [nkeys]
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+#define ELLIGATOR_MAX_V3_LEN   255       // The counter of the second point of the 3^eB-torsion basis is stored in one byte
+#define ELLIGATOR_MAX_STEPS    (255 - (TABLE_R_LEN - 1))    // Index of the 2^eA-torsion basis after the tables, stored in one byte
+#define ELLIGATOR_HIST_KEYS    1000
+#define ELLIGATOR_V3_SHIFTED   20        // The counters r < 20 of the built-in table in the 3^eB-torsion use the value for r+1
+
+
+static void elligator_v(const felm_t* U, const unsigned int r, f2elm_t v)
+{ // v = 1/(1 + U*r^2)
+    felm_t t;
+
+    fpzero(t);
+    t[0] = (digit_t)r;
+    to_mont(t, t);
+    fpsqr_mont(t, t);
+    fpmul_mont(U[0], t, v[0]);
+    fpmul_mont(U[1], t, v[1]);
+    fpadd(v[0], (digit_t*)&Montgomery_one, v[0]);
+    fp2inv_mont(v);
+    fp2correction(v);
+}
+
+
+static int fp_equal(const felm_t a, const felm_t b)
+{
+    felm_t s, t;
+
+    fpcopy(a, s);
+    fpcopy(b, t);
+    fpcorrection(s);
+    fpcorrection(t);
+    return (memcmp(s, t, NBITS_TO_NBYTES(NBITS_FIELD)) == 0);
+}
+
+
+static void print_words(const char* decl, const felm_t* T, const unsigned int nelms, const unsigned int nwords)
+{ // Prints nelms elements of nwords 64-bit words each, one element per line
+    const uint64_t* t = (const uint64_t*)T;
+    unsigned int i, j;
+
+    printf("const uint64_t %s = {\n", decl);
+    for (i = 0; i < nelms; i++) {
+        printf("    ");
+        for (j = 0; j < nwords; j++) {
+            printf("0x%016llX%s", (unsigned long long)t[i*nwords + j], (i == nelms-1 && j == nwords-1) ? "" : ",");
+        }
+        printf("\n");
+    }
+    printf("};\n\n");
+}
+
+
+static void print_steps(const char* decl, const unsigned int* S, const unsigned int len)
+{
+    unsigned int i;
+
+    printf("const unsigned char %s = {\n    ", decl);
+    for (i = 0; i < len; i++) {
+        printf("%u%s", S[i], (i == len-1) ? "\n" : ", ");
+    }
+    printf("};\n\n");
+}
+
+
+static int generate(const unsigned int v3_len, const unsigned int ext_len)
+{
+    unsigned int n = TABLE_R_LEN + ext_len, len[2] = {0}, *S[2], c, i, r;
+    felm_t *R[2], *u = (felm_t*)u_entang, t;
+    f2elm_t *V[2], *V3, v;
+    int error = 0;
+
+    V3 = calloc(v3_len, sizeof(f2elm_t));
+    for (c = 0; c < 2; c++) {
+        R[c] = calloc(n, sizeof(felm_t));
+        V[c] = calloc(n, sizeof(f2elm_t));
+        S[c] = calloc(n, sizeof(unsigned int));
+    }
+
+    // 3^eB-torsion: v = 1/(1 + U*r^2) for the counters r = 0,1,..., which must agree with the online values beyond the built-in table
+    for (r = 0; r < v3_len; r++) {
+        elligator_v((felm_t*)U3, (r < ELLIGATOR_V3_SHIFTED) ? r + 1 : r, V3[r]);
+        if (r < TABLE_V3_LEN) {
+            error |= !fp_equal(V3[r][0], ((f2elm_t*)v_3_torsion)[r][0]) | !fp_equal(V3[r][1], ((f2elm_t*)v_3_torsion)[r][1]);
+        }
+    }
+
+    // 2^eA-torsion: the counters r = 1,2,... are split by the quadratic class of v = 1/(1 + u*r^2), class 1 holding the non-squares
+    for (r = 1; len[0] < n || len[1] < n; r++) {
+        elligator_v(u, r, v);
+        c = (is_sqr_fp2(v) == 0);
+        if (len[c] == n) continue;
+        fpzero(t);
+        t[0] = (digit_t)r;
+        to_mont(t, t);
+        fpcorrection(t);
+        fpcopy(t, R[c][len[c]]);
+        fp2copy(v, V[c][len[c]]);
+        S[c][len[c]] = r;
+        len[c]++;
+    }
+    for (c = 0; c < 2; c++) {
+        for (i = 0; i < TABLE_R_LEN; i++) {
+            error |= !fp_equal(R[c][i], ((felm_t*)(c ? table_r_qnr : table_r_qr))[i]);
+            error |= !fp_equal(V[c][i][0], ((f2elm_t*)(c ? table_v_qnr : table_v_qr))[i][0]);
+            error |= !fp_equal(V[c][i][1], ((f2elm_t*)(c ? table_v_qnr : table_v_qr))[i][1]);
+        }
+        for (i = n; i-- > TABLE_R_LEN; ) {
+            S[c][i] -= S[c][TABLE_R_LEN-1];    // Steps after the last entry of the built-in table
+        }
+        if (ext_len > 0 && S[c][n-1] > ELLIGATOR_MAX_STEPS) {
+            fprintf(stderr, "Error: the extension reaches %u steps after the tables, at most %d can be encoded\n", S[c][n-1], ELLIGATOR_MAX_STEPS);
+            return 1;
+        }
+    }
+    if (error != 0) {
+        fprintf(stderr, "Error: the generated entries do not match the compiled-in tables\n");
+        return 1;
+    }
+
+    printf("/********************************************************************************************\n");
+    printf("* Elligator tables for %s with TABLE_V3_LEN = %u and TABLE_R_EXT_LEN = %u, generated by \"make elligator_tables\"\n", ELLIGATOR_NAME, v3_len, ext_len);
+    printf("*\n");
+    printf("* Table sizes: %u bytes in the 3^eB-torsion, %u bytes of extension in the 2^eA-torsion\n",
+           (unsigned int)(v3_len*2*NWORDS64_FIELD*8), (unsigned int)(2*ext_len*(3*NWORDS64_FIELD*8 + 1)));
+    printf("*********************************************************************************************/\n\n");
+
+    printf("#if !defined(ELLIGATOR_TABLES_DATA)\n\n");
+    printf("#define TABLE_V3_LEN %u\n#define TABLE_R_EXT_LEN %u\n\n", v3_len, ext_len);
+    printf("#else\n\n");
+
+    print_words("v_3_torsion[TABLE_V3_LEN][2*NWORDS64_FIELD]", (felm_t*)V3, v3_len, 2*NWORDS64_FIELD);
+    if (ext_len > 0) {
+        printf("// Next candidates after table_r_qr and table_r_qnr, and their number of steps after the last entry of these tables\n\n");
+        print_words("table_r_qr_ext[TABLE_R_EXT_LEN][NWORDS64_FIELD]", R[0] + TABLE_R_LEN, ext_len, NWORDS64_FIELD);
+        print_words("table_r_qnr_ext[TABLE_R_EXT_LEN][NWORDS64_FIELD]", R[1] + TABLE_R_LEN, ext_len, NWORDS64_FIELD);
+        print_words("table_v_qr_ext[TABLE_R_EXT_LEN][2*NWORDS64_FIELD]", (felm_t*)(V[0] + TABLE_R_LEN), ext_len, 2*NWORDS64_FIELD);
+        print_words("table_v_qnr_ext[TABLE_R_EXT_LEN][2*NWORDS64_FIELD]", (felm_t*)(V[1] + TABLE_R_LEN), ext_len, 2*NWORDS64_FIELD);
+        print_steps("table_s_qr_ext[TABLE_R_EXT_LEN]", S[0] + TABLE_R_LEN, ext_len);
+        print_steps("table_s_qnr_ext[TABLE_R_EXT_LEN]", S[1] + TABLE_R_LEN, ext_len);
+    }
+    printf("#endif\n");
+
+    free(V3);
+    for (c = 0; c < 2; c++) {
+        free(R[c]); free(V[c]); free(S[c]);
+    }
+    return 0;
+}
+
+
+static void print_hist(const char* title, const unsigned int* H, const unsigned int nkeys, const unsigned int online)
+{ // Prints the nonzero counts of H with their cumulative share, and the number of keys that needed online inversions
+    unsigned int i, sum = 0;
+
+    printf("  %s\n", title);
+    for (i = 0; i < 256; i++) {
+        if (H[i] == 0) continue;
+        sum += H[i];
+        printf("    %3u: %8u  %9.4f%%\n", i, H[i], 100.0*sum/nkeys);
+    }
+    printf("    %u of %u keys (%.4f%%) go beyond the tables\n\n", online, nkeys, 100.0*online/nkeys);
+}
+
+
+static int hist(const unsigned int nkeys)
+{ // Histograms of the Elligator counters in nkeys public keys: the counter r of the second point of the 3^eB-torsion basis, the
+  // number of candidates consumed, and the index of the 2^eA-torsion basis, which counts the steps after the built-in tables
+  // from TABLE_R_LEN-1 on
+    unsigned char skA[SECRETKEY_A_BYTES], skB[SECRETKEY_B_BYTES], pk[SIDH_PUBLICKEYBYTES];
+    unsigned int H3[256] = {0}, H2[256] = {0}, online3 = 0, online2 = 0, last, k, qnr, ind;
+
+    for (k = 0; k < nkeys; k++) {
+        random_mod_order_A(skA);
+        EphemeralKeyGeneration_A(skA, pk);
+        last = pk[3*ORDER_B_ENCODED_BYTES + FP2_ENCODED_BYTES + 1];
+        H3[last]++;
+        online3 += (last > TABLE_V3_LEN);
+
+        random_mod_order_B(skB);
+        EphemeralKeyGeneration_B(skB, pk);
+        qnr = pk[3*ORDER_A_ENCODED_BYTES + FP2_ENCODED_BYTES] & 0x01;
+        ind = pk[3*ORDER_A_ENCODED_BYTES + FP2_ENCODED_BYTES + 1];
+        H2[ind]++;
+        last = TABLE_R_LEN - 1;
+#if (TABLE_R_EXT_LEN > 0)
+        last += (qnr ? table_s_qnr_ext : table_s_qr_ext)[TABLE_R_EXT_LEN-1];
+#else
+        (void)qnr;
+#endif
+        online2 += (ind > last);
+    }
+
+    printf("\n%s: %u public keys, TABLE_V3_LEN = %d, TABLE_R_LEN = %d, TABLE_R_EXT_LEN = %d\n", ELLIGATOR_NAME, nkeys, TABLE_V3_LEN, TABLE_R_LEN, TABLE_R_EXT_LEN);
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+    print_hist("Candidates consumed by the 3^eB-torsion basis:", H3, nkeys, online3);
+    print_hist("Index of the 2^eA-torsion basis:", H2, nkeys, online2);
+    return 0;
+}
+
+
+int main(int argc, char** argv)
+{
+    int v3_len, ext_len;
+
+    if (argc >= 2 && strcmp(argv[1], "hist") == 0) {
+        return hist((argc == 3) ? (unsigned int)atoi(argv[2]) : ELLIGATOR_HIST_KEYS);
+    }
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s V3_LEN R_EXT_LEN\n       %s hist [nkeys]\n", argv[0], argv[0]);
+        return 1;
+    }
+    v3_len = atoi(argv[1]);
+    ext_len = atoi(argv[2]);
+    if (v3_len < 1 || v3_len > ELLIGATOR_MAX_V3_LEN) {
+        fprintf(stderr, "Error: V3_LEN must be between 1 and %d\n", ELLIGATOR_MAX_V3_LEN);
+        return 1;
+    }
+    if (ext_len < 0 || ext_len > ELLIGATOR_MAX_STEPS) {
+        fprintf(stderr, "Error: R_EXT_LEN must be between 0 and %d\n", ELLIGATOR_MAX_STEPS);
+        return 1;
+    }
+    return generate((unsigned int)v3_len, (unsigned int)ext_len);
+}
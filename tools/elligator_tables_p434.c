@@ -0,0 +1,17 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the Elligator tables for SIDHp434_compressed
+*********************************************************************************************/
+
+#undef _TABLE_BLOB_                 // The tool reads the compiled-in tables
+#include "../src/P434/P434_compressed.c"
+
+
+#define ELLIGATOR_NAME    "SIDHp434"
+
+#include "elligator_tables.c"
@@ -0,0 +1,17 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the Elligator tables for SIDHp503_compressed
+*********************************************************************************************/
+
+#undef _TABLE_BLOB_                 // The tool reads the compiled-in tables
+#include "../src/P503/P503_compressed.c"
+
+
+#define ELLIGATOR_NAME    "SIDHp503"
+
+#include "elligator_tables.c"
@@ -0,0 +1,17 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the Elligator tables for SIDHp610_compressed
+*********************************************************************************************/
+
+#undef _TABLE_BLOB_                 // The tool reads the compiled-in tables
+#include "../src/P610/P610_compressed.c"
+
+
+#define ELLIGATOR_NAME    "SIDHp610"
+
+#include "elligator_tables.c"
@@ -0,0 +1,17 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the Elligator tables for SIDHp751_compressed
+*********************************************************************************************/
+
+#undef _TABLE_BLOB_                 // The tool reads the compiled-in tables
+#include "../src/P751/P751_compressed.c"
+
+
+#define ELLIGATOR_NAME    "SIDHp751"
+
+#include "elligator_tables.c"
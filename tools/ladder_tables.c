@@ -0,0 +1,130 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the tables of the fixed-base three-point ladder
+*           Prints the source file with the affine x-coordinates of [2^i]QA and [2^i]QB on E0 for the ladder steps of
+*           LADDER3PT_fixed_base, where QA and QB are the generators in A_gen and B_gen. The tables are used in the
+*           uncompressed variants when compiling with USE_FIXED_BASE=TRUE.
+*           Before printing, the ladder with the generated tables is checked against LADDER3PT on the bases A_gen and
+*           B_gen for LADDER_CHECK_KEYS random scalars of each party.
+*
+*           Usage: ladder_tables-pXXX
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+#define LADDER_CHECK_KEYS    32
+
+
+static void ladder_table(const digit_t* gen, const unsigned int nbits, f2elm_t* table)
+{ // table[i] = x([2^i]Q) for i = 0,...,nbits-1, where Q is the second point of the basis gen on E0: y^2 = x^3 + 6x^2 + x
+    point_proj_t Q;
+    f2elm_t XP, XR, A24plus = {0}, C24 = {0}, t;
+    unsigned int i;
+
+    init_basis((digit_t*)gen, XP, Q->X, XR);
+    fp2zero(Q->Z);
+    fpcopy((digit_t*)&Montgomery_one, Q->Z[0]);
+
+    // A24plus = A+2C, C24 = 4C, where A=6, C=1
+    fpcopy((digit_t*)&Montgomery_one, C24[0]);
+    mp2_add(C24, C24, C24);
+    mp2_add(C24, C24, C24);
+    mp2_add(C24, C24, A24plus);
+
+    for (i = 0; i < nbits; i++) {
+        fp2copy(Q->Z, t);
+        fp2inv_mont(t);
+        fp2mul_mont(Q->X, t, table[i]);
+        fp2correction(table[i]);
+        xDBL(Q, Q, A24plus, C24);
+    }
+}
+
+
+static int ladder_check(const digit_t* gen, const f2elm_t* table, const unsigned int AliceOrBob)
+{ // Compares P+[m]Q computed by LADDER3PT_fixed_base with the table and by LADDER3PT for random scalars m. Returns 0 if all agree.
+    unsigned char sk[SECRETKEY_A_BYTES > SECRETKEY_B_BYTES ? SECRETKEY_A_BYTES : SECRETKEY_B_BYTES];
+    digit_t m[NWORDS_ORDER];
+    point_proj_t R0, R1;
+    f2elm_t XP, XQ, XR, A = {0}, t0, t1;
+    unsigned int k;
+    int error = 0;
+
+    init_basis((digit_t*)gen, XP, XQ, XR);
+    fpcopy((digit_t*)&Montgomery_one, A[0]);     // A = 6
+    mp2_add(A, A, t0);
+    mp2_add(t0, A, A);
+    mp2_add(A, A, A);
+
+    for (k = 0; k < LADDER_CHECK_KEYS; k++) {
+        memset(m, 0, sizeof(m));
+        if (AliceOrBob == ALICE) {
+            random_mod_order_A(sk);
+            decode_to_digits(sk, m, SECRETKEY_A_BYTES, NWORDS_ORDER);
+        } else {
+            random_mod_order_B(sk);
+            decode_to_digits(sk, m, SECRETKEY_B_BYTES, NWORDS_ORDER);
+        }
+        LADDER3PT(XP, XQ, XR, m, AliceOrBob, R0, A);
+        LADDER3PT_fixed_base(XP, XR, (const digit_t*)table, m, AliceOrBob, R1);
+
+        fp2mul_mont(R0->X, R1->Z, t0);           // X0/Z0 = X1/Z1
+        fp2mul_mont(R1->X, R0->Z, t1);
+        fp2correction(t0);
+        fp2correction(t1);
+        error |= (memcmp(t0, t1, sizeof(f2elm_t)) != 0);
+    }
+    return error;
+}
+
+
+static void print_table(const char* decl, const char* name, const char* range, const f2elm_t* table, const unsigned int nbits)
+{ // Prints the table as 64-bit words, four per line
+    const uint64_t* t = (const uint64_t*)table;
+    unsigned int i, n = nbits*2*NWORDS64_FIELD;
+
+    printf("// x-coordinates of [2^i]%s for i = 0, ..., %s in Montgomery representation, where %s is the generator in %c_gen.\n", name, range, name, name[1]);
+    printf("// Each entry is an element of GF(p^2) stored as 2*NWORDS64_FIELD words.\n");
+    printf("const uint64_t %s = {\n", decl);
+    for (i = 0; i < n; i++) {
+        printf("0x%016llX%s", (unsigned long long)t[i], (i == n-1) ? " };\n" : ((i % 4 == 3) ? ",\n" : ", "));
+    }
+}
+
+
+int main(void)
+{
+    f2elm_t *TA = calloc(OALICE_BITS, sizeof(f2elm_t)), *TB = calloc(OBOB_BITS-1, sizeof(f2elm_t));
+
+    ladder_table((digit_t*)A_gen, OALICE_BITS, TA);
+    ladder_table((digit_t*)B_gen, OBOB_BITS-1, TB);
+    if (ladder_check((digit_t*)A_gen, TA, ALICE) != 0 || ladder_check((digit_t*)B_gen, TB, BOB) != 0) {
+        fprintf(stderr, "Error: the fixed-base ladder with the generated tables does not agree with LADDER3PT\n");
+        return 1;
+    }
+
+    printf("/********************************************************************************************\n");
+    printf("* SIDH: an efficient supersingular isogeny cryptography library\n");
+    printf("* Copyright (c) Microsoft Corporation\n");
+    printf("*\n");
+    printf("* Website: https://github.com/microsoft/PQCrypto-SIDH\n");
+    printf("* Released under MIT license\n");
+    printf("*\n");
+    printf("* Abstract: precomputed tables for the fixed-base three-point ladder on E0: y^2 = x^3 + 6x^2 + x\n");
+    printf("*           Generated for %s by \"make ladder_tables\"\n", LADDER_NAME);
+    printf("*********************************************************************************************/\n\n\n");
+    print_table("A_gen_ladder[OALICE_BITS*2*NWORDS64_FIELD]", "QA", "OALICE_BITS-1", TA, OALICE_BITS);
+    printf("\n");
+    print_table("B_gen_ladder[(OBOB_BITS-1)*2*NWORDS64_FIELD]", "QB", "(OBOB_BITS-1)-1", TB, OBOB_BITS-1);
+
+    free(TA);
+    free(TB);
+    return 0;
+}
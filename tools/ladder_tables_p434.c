@@ -0,0 +1,17 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the fixed-base ladder tables for SIDHp434
+*********************************************************************************************/
+
+#undef _FIXED_BASE_                 // The tool does not read the compiled-in tables
+#include "../src/P434/P434.c"
+
+
+#define LADDER_NAME       "SIDHp434"
+
+#include "ladder_tables.c"
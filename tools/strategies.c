@@ -0,0 +1,191 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generator of optimal strategies for the isogeny tree traversal
+*           For a single thread, the strategy is obtained with the standard dynamic program using the cost p of a
+*           multiplication step (2*xDBL for Alice, xTPL for Bob) and the cost q of an isogeny evaluation (eval_4_isog
+*           for Alice, eval_3_isog for Bob). For k threads, candidate strategies are obtained with the same dynamic
+*           program using scaled evaluation costs, and the one with the lowest cost under a simulation of the parallel
+*           traversal in src/sidh.c (with and without the three points pushed through the isogeny) is selected.
+*
+*           Usage: strategies <name> <MAX> <p> <q> [nthreads] [sync overhead]
+*           Define STRATEGIES_NO_MAIN to include the generator in other programs (see tools/tune_strategies.c).
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STRATEGY_SCALES      256     // Number of scaled evaluation costs tried for k > 1 threads
+#define STRATEGY_MAX_THREADS 64
+#define STRATEGY_PER_LINE    46      // Number of strategy entries per line of output
+
+
+static void optimal_strategy(const unsigned int n, const double p, const double q, unsigned int* strat)
+{ // Optimal strategy for a tree with n leaves, where p is the cost of a multiplication step and q is the cost of an isogeny evaluation.
+  // The output strat has n-1 entries, in the order in which they are consumed by the tree traversal.
+    double* C = calloc(n+1, sizeof(double));
+    unsigned int* split = calloc(n+1, sizeof(unsigned int));
+    unsigned int* stack = calloc(2*n+1, sizeof(unsigned int));
+    unsigned int i, b, top = 0, len = 0;
+    double cost;
+
+    for (i = 2; i <= n; i++) {
+        C[i] = -1;
+        for (b = 1; b < i; b++) {
+            cost = C[i-b] + C[b] + b*p + (i-b)*q;
+            if (C[i] < 0 || cost < C[i]) {
+                C[i] = cost;
+                split[i] = b;
+            }
+        }
+    }
+
+    // strat(n) = [b] || strat(n-b) || strat(b)
+    stack[top++] = n;
+    while (top > 0) {
+        i = stack[--top];
+        if (i > 1) {
+            strat[len++] = split[i];
+            stack[top++] = split[i];
+            stack[top++] = i - split[i];
+        }
+    }
+
+    free(C);
+    free(split);
+    free(stack);
+}
+
+
+static double traversal_cost(const unsigned int max, const unsigned int* strat, const double p, const double q, const unsigned int nthreads, const unsigned int nphis, const double sync, unsigned int* max_pts)
+{ // Cost of the tree traversal following strat with nthreads threads and nphis points pushed through the isogeny, as scheduled by isogeny_tree_traverse().
+  // At each level, task 0 evaluates the last intermediate point and computes the multiples for the next row, the other tasks evaluate one point each.
+  // Tasks are started in increasing order, each one on the thread that becomes available first. Also returns the maximum number of intermediate points.
+    unsigned int* pts_index = calloc(max, sizeof(unsigned int));
+    unsigned int npts = 0, index = 0, row = 1, ii = 0, neval, i, j, t;
+    double total = 0, task, busy[STRATEGY_MAX_THREADS], makespan;
+
+    *max_pts = 0;
+    while (index < max - row) {
+        pts_index[npts++] = index;
+        total += strat[ii]*p;
+        index += strat[ii++];
+    }
+
+    while (row <= max) {
+        neval = (row < max) ? npts : 0;
+        for (t = 0; t < nthreads; t++) {
+            busy[t] = 0;
+        }
+        if (npts > *max_pts) {
+            *max_pts = npts;
+        }
+        for (i = 0; i < neval + nphis; i++) {
+            task = q;
+            if (i == 0 && neval > 0) {
+                index = pts_index[neval-1];
+                npts = neval-1;
+                row++;
+                while (index < max - row) {
+                    pts_index[npts++] = index;
+                    task += strat[ii]*p;
+                    index += strat[ii++];
+                }
+            }
+            for (t = 0, j = 1; j < nthreads; j++) {
+                if (busy[j] < busy[t]) {
+                    t = j;
+                }
+            }
+            busy[t] += task;
+        }
+        for (makespan = 0, t = 0; t < nthreads; t++) {
+            if (busy[t] > makespan) {
+                makespan = busy[t];
+            }
+        }
+        total += makespan;
+        if (nthreads > 1 && neval + nphis > 1) {
+            total += sync;
+        }
+        if (neval == 0) {
+            break;
+        }
+    }
+
+    free(pts_index);
+    return total;
+}
+
+
+static unsigned int generate_strategy(const unsigned int max, const double p, const double q, const unsigned int nthreads, const double sync, unsigned int* strat, double* cost)
+{ // Strategy with the lowest modeled cost for a tree with max leaves using nthreads threads. Returns the maximum number of intermediate points.
+    unsigned int s, max_pts, best_max_pts = 0;
+    unsigned int* candidate = calloc(max, sizeof(unsigned int));
+    double c;
+
+    *cost = -1;
+    for (s = (nthreads == 1) ? STRATEGY_SCALES : 1; s <= STRATEGY_SCALES; s++) {
+        optimal_strategy(max, p, q*s/STRATEGY_SCALES, candidate);
+        // Key generation pushes three points through the isogeny, the shared secret computation none
+        c = (traversal_cost(max, candidate, p, q, nthreads, 3, sync, &max_pts) + traversal_cost(max, candidate, p, q, nthreads, 0, sync, &max_pts)) / 2;
+        if (*cost < 0 || c < *cost) {
+            *cost = c;
+            best_max_pts = max_pts;
+            memcpy(strat, candidate, (max-1)*sizeof(unsigned int));
+        }
+    }
+
+    free(candidate);
+    return best_max_pts;
+}
+
+
+static void print_strategy(FILE* out, const char* name, const char* max_name, const unsigned int max, const unsigned int* strat)
+{ // Prints the strategy as a C table
+    unsigned int i;
+
+    fprintf(out, "const unsigned int %s[%s-1] = { \n", name, max_name);
+    for (i = 0; i < max-1; i++) {
+        fprintf(out, "%u%s", strat[i], (i == max-2) ? " };\n" : ((i % STRATEGY_PER_LINE) == STRATEGY_PER_LINE-1) ? ", \n" : ", ");
+    }
+}
+
+
+#if !defined(STRATEGIES_NO_MAIN)
+
+int main(int argc, char** argv)
+{
+    unsigned int max, nthreads = 1, max_pts;
+    unsigned int* strat;
+    double p, q, sync = 0, cost;
+
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <name> <MAX> <p> <q> [nthreads] [sync overhead]\n", argv[0]);
+        return 1;
+    }
+    max = (unsigned int)atoi(argv[2]);
+    p = atof(argv[3]);
+    q = atof(argv[4]);
+    if (argc > 5) nthreads = (unsigned int)atoi(argv[5]);
+    if (argc > 6) sync = atof(argv[6]);
+    if (max < 2 || p <= 0 || q <= 0 || nthreads < 1 || nthreads > STRATEGY_MAX_THREADS) {
+        fprintf(stderr, "Invalid parameters\n");
+        return 1;
+    }
+
+    strat = calloc(max, sizeof(unsigned int));
+    max_pts = generate_strategy(max, p, q, nthreads, sync, strat, &cost);
+    printf("// nthreads = %u, p = %.0f, q = %.0f, modeled cost = %.0f, %u intermediate points\n", nthreads, p, q, cost, max_pts);
+    print_strategy(stdout, argv[1], (strncmp(argv[1], "strat_Alice", 11) == 0) ? "MAX_Alice" : "MAX_Bob", max, strat);
+
+    free(strat);
+    return 0;
+}
+
+#endif
@@ -0,0 +1,80 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: writes the precomputed tables of key compression to a binary blob
+*           The blob holds the compiled-in pairing tables and Pohlig-Hellman tables (including the ones generated by
+*           "make dlog_tables" when compiling with USE_DLOG_TABLES=TRUE) in the format of src/compression/tables_blob.c,
+*           and is used instead of them when compiling with USE_TABLE_BLOB=TRUE or USE_TABLE_BLOB=INCBIN.
+*
+*           Usage: tables_blob-pXXX file
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/compression/tables_blob.c"
+
+
+int main(int argc, char** argv)
+{
+    const void* tables[TABLES_BLOB_NTABLES] = { T_tate3, T_tate2_firststep_P, T_tate2_P, T_tate2_firststep_Q, T_tate2_Q,
+                                                ph2_Texp, ph2_Log, ph2_G, ph2_CT, ph3_T, ph3_T1, ph3_T2 };
+    tables_blob_header_t* header;
+    unsigned char* blob;
+    uint64_t size = (sizeof(tables_blob_header_t) + TABLES_BLOB_ALIGN - 1)/TABLES_BLOB_ALIGN*TABLES_BLOB_ALIGN;
+    unsigned int i;
+    FILE* f;
+
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s file\n", argv[0]);
+        return 1;
+    }
+    for (i = 0; i < TABLES_BLOB_NTABLES; i++) {
+        size += (tables_blob_bytes[i] + TABLES_BLOB_ALIGN - 1)/TABLES_BLOB_ALIGN*TABLES_BLOB_ALIGN;
+    }
+    blob = aligned_alloc(TABLES_BLOB_ALIGN, size);
+    if (blob == NULL) {
+        return 1;
+    }
+    memset(blob, 0, size);
+
+    header = (tables_blob_header_t*)blob;
+    memcpy(header->magic, TABLES_BLOB_MAGIC, sizeof(header->magic));
+    header->byte_order = TABLES_BLOB_BYTE_ORDER;
+    header->version = TABLES_BLOB_VERSION;
+    header->ntables = TABLES_BLOB_NTABLES;
+    strncpy(header->name, TABLES_BLOB_NAME, sizeof(header->name) - 1);
+    header->w2 = W_2;
+    header->w3 = W_3;
+    header->size = size;
+    header->tables[0].offset = (sizeof(tables_blob_header_t) + TABLES_BLOB_ALIGN - 1)/TABLES_BLOB_ALIGN*TABLES_BLOB_ALIGN;
+    for (i = 0; i < TABLES_BLOB_NTABLES; i++) {
+        if (i > 0) {
+            header->tables[i].offset = header->tables[i-1].offset + (tables_blob_bytes[i-1] + TABLES_BLOB_ALIGN - 1)/TABLES_BLOB_ALIGN*TABLES_BLOB_ALIGN;
+        }
+        header->tables[i].bytes = tables_blob_bytes[i];
+        if (tables_blob_bytes[i] != 0) {
+            memcpy(blob + header->tables[i].offset, tables[i], tables_blob_bytes[i]);
+        }
+    }
+    shake256(header->checksum, TABLES_BLOB_CHECKSUM_BYTES, blob + offsetof(tables_blob_header_t, byte_order), size - offsetof(tables_blob_header_t, byte_order));
+    if (tables_blob_validate(blob, size) != 0) {
+        fprintf(stderr, "Error: the blob does not pass the checks of the loader\n");
+        free(blob);
+        return 1;
+    }
+
+    f = fopen(argv[1], "wb");
+    if (f == NULL || fwrite(blob, 1, size, f) != size || fclose(f) != 0) {
+        fprintf(stderr, "Error: %s could not be written\n", argv[1]);
+        free(blob);
+        return 1;
+    }
+    printf("  %s: %llu bytes written to %s\n", TABLES_BLOB_NAME, (unsigned long long)size, argv[1]);
+    free(blob);
+
+    return 0;
+}
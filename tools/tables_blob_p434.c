@@ -0,0 +1,14 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: binary blob of the precomputed tables for SIDHp434_compressed
+*********************************************************************************************/
+
+#undef _TABLE_BLOB_                 // The tool writes the compiled-in tables
+#include "../src/P434/P434_compressed.c"
+
+#include "tables_blob.c"
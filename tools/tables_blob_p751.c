@@ -0,0 +1,14 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: binary blob of the precomputed tables for SIDHp751_compressed
+*********************************************************************************************/
+
+#undef _TABLE_BLOB_                 // The tool writes the compiled-in tables
+#include "../src/P751/P751_compressed.c"
+
+#include "tables_blob.c"
@@ -0,0 +1,157 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: auto-tuning of the isogeny strategies for the build host
+*           Measures xDBL, xTPL, eval_4_isog and eval_3_isog and prints a header with the optimal strategies for the
+*           measured costs, which replaces the built-in tables of the uncompressed variants when compiling with
+*           USE_TUNED_STRATEGIES=TRUE.
+*********************************************************************************************/
+
+#define STRATEGIES_NO_MAIN
+#include "strategies.c"
+#if defined(_THREADS_)
+    #include "../src/threadpool/threadpool.h"
+#endif
+
+
+#define TUNE_RUNS          101       // Number of timing runs, the median is taken
+#define TUNE_CALLS         100       // Number of consecutive calls per timing run
+#define TUNE_SYNC_DEFAULT  1000      // Synchronization overhead per level if it cannot be measured
+
+
+static int compare_cycles(const void* a, const void* b)
+{
+    unsigned long long x = *(const unsigned long long*)a, y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+
+static double median_cycles(unsigned long long* cycles)
+{ // Median number of cycles per call over the timing runs
+    qsort(cycles, TUNE_RUNS, sizeof(unsigned long long), compare_cycles);
+    return (double)cycles[TUNE_RUNS/2] / TUNE_CALLS;
+}
+
+
+#if defined(_THREADS_)
+static void empty_task(void* arg, unsigned int index)
+{
+    (void)arg;
+    (void)index;
+}
+
+
+static double measure_sync(const unsigned int nthreads)
+{ // Cost of distributing one level of the tree traversal across nthreads threads
+    unsigned int r, n;
+    unsigned long long cycles[TUNE_RUNS], cycles1, cycles2;
+
+    if (nthreads == 1 || threadpool_set_num_threads(nthreads) != 0) {
+        return TUNE_SYNC_DEFAULT;
+    }
+    for (r = 0; r < TUNE_RUNS; r++) {
+        cycles1 = cpucycles();
+        for (n = 0; n < TUNE_CALLS; n++) {
+            threadpool_run(empty_task, NULL, nthreads);
+        }
+        cycles2 = cpucycles();
+        cycles[r] = cycles2 - cycles1;
+    }
+    threadpool_set_num_threads(1);
+    return median_cycles(cycles);
+}
+#endif
+
+
+int main(void)
+{
+    unsigned int r, n, k, nthreads, max_pts[2];
+    unsigned long long cycles[TUNE_RUNS], cycles1, cycles2;
+    unsigned int *strat_A = calloc(MAX_Alice, sizeof(unsigned int)), *strat_B = calloc(MAX_Bob, sizeof(unsigned int));
+    double cost_dbl, cost_tpl, cost_eval4, cost_eval3, sync, cost;
+    f2elm_t A24plus, C24, A24minus, coeff[3];
+    point_proj_t P;
+    char name[32];
+
+    fp2random_test((digit_t*)A24plus); fp2random_test((digit_t*)C24); fp2random_test((digit_t*)A24minus);
+    fp2random_test((digit_t*)coeff[0]); fp2random_test((digit_t*)coeff[1]); fp2random_test((digit_t*)coeff[2]);
+    fp2random_test((digit_t*)P->X); fp2random_test((digit_t*)P->Z);
+
+    for (r = 0; r < TUNE_RUNS; r++) {
+        cycles1 = cpucycles();
+        for (n = 0; n < TUNE_CALLS; n++) xDBL(P, P, A24plus, C24);
+        cycles2 = cpucycles();
+        cycles[r] = cycles2 - cycles1;
+    }
+    cost_dbl = median_cycles(cycles);
+
+    for (r = 0; r < TUNE_RUNS; r++) {
+        cycles1 = cpucycles();
+        for (n = 0; n < TUNE_CALLS; n++) xTPL(P, P, A24minus, A24plus);
+        cycles2 = cpucycles();
+        cycles[r] = cycles2 - cycles1;
+    }
+    cost_tpl = median_cycles(cycles);
+
+    for (r = 0; r < TUNE_RUNS; r++) {
+        cycles1 = cpucycles();
+        for (n = 0; n < TUNE_CALLS; n++) eval_4_isog(P, coeff);
+        cycles2 = cpucycles();
+        cycles[r] = cycles2 - cycles1;
+    }
+    cost_eval4 = median_cycles(cycles);
+
+    for (r = 0; r < TUNE_RUNS; r++) {
+        cycles1 = cpucycles();
+        for (n = 0; n < TUNE_CALLS; n++) eval_3_isog(P, coeff);
+        cycles2 = cpucycles();
+        cycles[r] = cycles2 - cycles1;
+    }
+    cost_eval3 = median_cycles(cycles);
+
+    printf("/********************************************************************************************\n");
+    printf("* Isogeny strategies for %s tuned for the build host, generated by \"make tune_strategies\"\n", TUNE_NAME);
+    printf("*\n");
+    printf("* xDBL: %.0f, xTPL: %.0f, eval_4_isog: %.0f, eval_3_isog: %.0f (cycles)\n", cost_dbl, cost_tpl, cost_eval4, cost_eval3);
+    printf("*********************************************************************************************/\n\n");
+
+    max_pts[0] = generate_strategy(MAX_Alice, 2*cost_dbl, cost_eval4, 1, 0, strat_A, &cost);
+    max_pts[1] = generate_strategy(MAX_Bob, cost_tpl, cost_eval3, 1, 0, strat_B, &cost);
+    printf("#undef MAX_INT_POINTS_ALICE\n#define MAX_INT_POINTS_ALICE    %u\n", max_pts[0]);
+    printf("#undef MAX_INT_POINTS_BOB\n#define MAX_INT_POINTS_BOB      %u\n\n", max_pts[1]);
+    print_strategy(stdout, "strat_Alice", "MAX_Alice", MAX_Alice, strat_A);
+    printf("\n");
+    print_strategy(stdout, "strat_Bob", "MAX_Bob", MAX_Bob, strat_B);
+
+    // Strategies for the parallel isogeny evaluation, only used by USE_THREADS=TRUE builds. The number of intermediate points also covers the strategies above.
+    printf("\n#if defined(_THREADS_)\n");
+    for (nthreads = 2; nthreads <= 8; nthreads *= 2) {
+#if defined(_THREADS_)
+        sync = measure_sync(nthreads);
+#else
+        sync = TUNE_SYNC_DEFAULT;
+#endif
+        printf("// nthreads = %u, synchronization overhead: %.0f cycles\n", nthreads, sync);
+        k = generate_strategy(MAX_Alice, 2*cost_dbl, cost_eval4, nthreads, sync, strat_A, &cost);
+        max_pts[0] = (k > max_pts[0]) ? k : max_pts[0];
+        sprintf(name, "strat_Alice_%u", nthreads);
+        print_strategy(stdout, name, "MAX_Alice", MAX_Alice, strat_A);
+        printf("\n");
+        k = generate_strategy(MAX_Bob, cost_tpl, cost_eval3, nthreads, sync, strat_B, &cost);
+        max_pts[1] = (k > max_pts[1]) ? k : max_pts[1];
+        sprintf(name, "strat_Bob_%u", nthreads);
+        print_strategy(stdout, name, "MAX_Bob", MAX_Bob, strat_B);
+        printf("\n");
+    }
+    printf("#undef MAX_INT_POINTS_ALICE_THREADS\n#define MAX_INT_POINTS_ALICE_THREADS  %u\n", max_pts[0]);
+    printf("#undef MAX_INT_POINTS_BOB_THREADS\n#define MAX_INT_POINTS_BOB_THREADS    %u\n", max_pts[1]);
+    printf("#endif\n");
+
+    free(strat_A);
+    free(strat_B);
+    return 0;
+}
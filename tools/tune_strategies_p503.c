@@ -0,0 +1,20 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: auto-tuning of the isogeny strategies for SIDHp503
+*********************************************************************************************/
+
+#include "../src/config.h"
+#include "../src/P503/P503_internal.h"
+#include "../src/internal.h"
+#include "../tests/test_extras.h"
+
+
+#define TUNE_NAME         "SIDHp503"
+#define fp2random_test    fp2random503_test
+
+#include "tune_strategies.c"